@@ -22,6 +22,7 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -33,6 +34,21 @@
 
 namespace Audio {
 
+namespace {
+
+/**
+ * How long a stop waits for the audio callback before applying its
+ * commands itself.
+ */
+const uint kCommandAckTimeout = 100;
+
+#ifdef SCUMMVM_THREAD_LOCAL
+/** The mixer whose callback is running on the current thread, if any. */
+SCUMMVM_THREAD_LOCAL MixerImpl *g_mixingMixer = nullptr;
+#endif
+
+} // End of anonymous namespace
+
 #pragma mark -
 #pragma mark --- Channel classes ---
 #pragma mark -
@@ -122,9 +138,12 @@ public:
 	void notifyGlobalVolChange() { updateChannelVolumes(); }
 
 	/**
-	 * Queries how long the channel has been playing.
+	 * Sets where the channel publishes its timing information for
+	 * MixerImpl::getElapsedTime. Must be called from the mixing side.
+	 *
+	 * @param timing timing slot owned by the mixer
 	 */
-	Timestamp getElapsedTime();
+	void setTiming(ChannelTiming *timing);
 
 	/**
 	 * Queries the channel's sound type.
@@ -164,6 +183,9 @@ private:
 	uint32 _pauseStartTime;
 	uint32 _pauseTime;
 
+	ChannelTiming *_timing;
+	void publishTiming();
+
 	RateConverter *_converter;
 	Common::DisposablePtr<AudioStream> _stream;
 };
@@ -173,33 +195,211 @@ private:
 #pragma mark -
 
 MixerImpl::MixerImpl(uint sampleRate)
-	: _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _mixingMutex(), _sampleRate(sampleRate), _mixerReady(0), _handleSeed(0), _soundTypeSettings(),
+	  _queueHead(0), _queueTail(0), _commandsPushed(0), _commandsDone(0), _commandWaiters(0), _commandsAck() {
 
 	assert(sampleRate > 0);
 
-	for (int i = 0; i != NUM_CHANNELS; i++)
+	for (int i = 0; i != NUM_CHANNELS; i++) {
 		_channels[i] = 0;
+		_channelActive[i] = 0;
+		memset(&_channelInfo[i], 0, sizeof(_channelInfo[i]));
+		memset((void *)&_channelTiming[i], 0, sizeof(_channelTiming[i]));
+	}
 }
 
 MixerImpl::~MixerImpl() {
+	// Pick up channels which were queued but never reached the mixer
+	processCommands();
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
 }
 
 void MixerImpl::setReady(bool ready) {
-	Common::StackLock lock(_mutex);
-
-	_mixerReady = ready;
+	Common::atomicStore(&_mixerReady, ready ? 1 : 0);
 }
 
 uint MixerImpl::getOutputRate() const {
 	return _sampleRate;
 }
 
-void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
+int32 MixerImpl::pushCommand(Command::Type type, int index, uint32 handle, int arg, Channel *channel) {
+	// Called with _mutex held, which makes the caller the only producer
+	// until the mutex is released below.
+	int32 tail, next;
+	for (;;) {
+		tail = _queueTail;
+		next = (tail + 1) % COMMAND_QUEUE_SIZE;
+		if (next != Common::atomicLoad(&_queueHead))
+			break;
+
+		// The ring is full: wait for the mixing side to catch up. _mutex
+		// is released meanwhile, as the audio callback may need it to stop
+		// sounds, so other threads may push in between.
+		const int32 pushed = _commandsPushed;
+		_mutex.unlock();
+		waitForCommands(pushed);
+		_mutex.lock();
+	}
+
+	Command &cmd = _commands[tail];
+	cmd.type = type;
+	cmd.index = index;
+	cmd.handle = handle;
+	cmd.arg = arg;
+	cmd.channel = channel;
+
+	Common::atomicStore(&_queueTail, next);
+	return ++_commandsPushed;
+}
+
+bool MixerImpl::commandsDone(int32 count) {
+	// A full barrier, pairing with the one in acknowledgeCommands()
+	return Common::atomicAdd(&_commandsDone, 0) - count >= 0;
+}
+
+void MixerImpl::waitForCommands(int32 count) {
+#ifdef SCUMMVM_THREAD_LOCAL
+	// Called from within the audio callback, e.g. by a stream stopping
+	// another sound: we already own the mixing side.
+	if (g_mixingMixer == this) {
+		processCommands();
+		return;
+	}
+#endif
+
+	while (!commandsDone(count)) {
+		if (isReady()) {
+			Common::atomicAdd(&_commandWaiters, 1);
+			// The callback may have applied our commands before it saw us waiting
+			if (commandsDone(count) || _commandsAck.wait(kCommandAckTimeout))
+				continue;
+		}
+
+		// No callback is running, or it does not answer: audio output is
+		// probably suspended. Apply the commands ourselves.
+		Common::StackLock lock(_mixingMutex);
+#ifdef SCUMMVM_THREAD_LOCAL
+		g_mixingMixer = this;
+#endif
+		processCommands();
+#ifdef SCUMMVM_THREAD_LOCAL
+		g_mixingMixer = nullptr;
+#endif
+	}
+}
+
+void MixerImpl::processCommands() {
+	int32 head = _queueHead;
+	const int32 tail = Common::atomicLoad(&_queueTail);
+
+	while (head != tail) {
+		applyCommand(_commands[head]);
+		head = (head + 1) % COMMAND_QUEUE_SIZE;
+		Common::atomicStore(&_queueHead, head);
+		Common::atomicAdd(&_commandsDone, 1);
+	}
+}
+
+void MixerImpl::acknowledgeCommands() {
+	// Wake up everyone who was waiting; they check themselves whether
+	// their commands are done.
+	int32 waiters = Common::atomicAdd(&_commandWaiters, 0);
+	while (waiters && !Common::atomicCompareExchange(&_commandWaiters, waiters, 0))
+		waiters = Common::atomicAdd(&_commandWaiters, 0);
+
+	while (waiters--)
+		_commandsAck.post();
+}
+
+void MixerImpl::applyCommand(const Command &cmd) {
+	switch (cmd.type) {
+	case Command::kPlay:
+		assert(!_channels[cmd.index]);
+		_channels[cmd.index] = cmd.channel;
+		cmd.channel->setTiming(&_channelTiming[cmd.index]);
+		break;
+
+	case Command::kStopAll:
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != 0 && !_channels[i]->isPermanent())
+				retireChannel(i);
+		}
+		break;
+
+	case Command::kStopID:
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != 0 && _channels[i]->getId() == cmd.arg)
+				retireChannel(i);
+		}
+		break;
+
+	case Command::kStopHandle:
+		if (_channels[cmd.index] && _channels[cmd.index]->getHandle()._val == cmd.handle)
+			retireChannel(cmd.index);
+		break;
+
+	case Command::kPauseAll:
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != 0)
+				_channels[i]->pause(cmd.arg != 0);
+		}
+		break;
+
+	case Command::kPauseID:
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != 0 && _channels[i]->getId() == cmd.index) {
+				_channels[i]->pause(cmd.arg != 0);
+				break;
+			}
+		}
+		break;
+
+	case Command::kPauseHandle:
+		if (_channels[cmd.index] && _channels[cmd.index]->getHandle()._val == cmd.handle)
+			_channels[cmd.index]->pause(cmd.arg != 0);
+		break;
+
+	case Command::kSetVolume:
+		if (_channels[cmd.index] && _channels[cmd.index]->getHandle()._val == cmd.handle)
+			_channels[cmd.index]->setVolume(cmd.arg);
+		break;
+
+	case Command::kSetBalance:
+		if (_channels[cmd.index] && _channels[cmd.index]->getHandle()._val == cmd.handle)
+			_channels[cmd.index]->setBalance(cmd.arg);
+		break;
+
+	case Command::kUpdateTypeVolumes:
+		for (int i = 0; i != NUM_CHANNELS; ++i) {
+			if (_channels[i] && _channels[i]->getType() == (SoundType)cmd.arg)
+				_channels[i]->notifyGlobalVolChange();
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void MixerImpl::retireChannel(int index) {
+	delete _channels[index];
+	_channels[index] = 0;
+
+	// Hand the slot back to the engine side
+	Common::atomicStore(&_channelActive[index], 0);
+}
+
+bool MixerImpl::isValidHandle(SoundHandle handle, int &index) const {
+	index = handle._val % NUM_CHANNELS;
+	return Common::atomicLoad(&_channelActive[index]) && _channelInfo[index].handle == handle._val;
+}
+
+void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan, int id, SoundType type, byte volume, int8 balance) {
 	int index = -1;
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] == 0) {
+		if (!Common::atomicLoad(&_channelActive[i])) {
 			index = i;
 			break;
 		}
@@ -210,8 +410,6 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 		return;
 	}
 
-	_channels[index] = chan;
-
 	SoundHandle chanHandle;
 	chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
 
@@ -219,6 +417,17 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	_handleSeed++;
 	if (handle)
 		*handle = chanHandle;
+
+	ChannelInfo &info = _channelInfo[index];
+	info.handle = chanHandle._val;
+	info.id = id;
+	info.type = type;
+	info.volume = volume;
+	info.balance = balance;
+	info.permanent = chan->isPermanent();
+
+	Common::atomicStore(&_channelActive[index], 1);
+	pushCommand(Command::kPlay, index, chanHandle._val, 0, chan);
 }
 
 void MixerImpl::playStream(
@@ -237,12 +446,12 @@ void MixerImpl::playStream(
 	}
 
 
-	assert(_mixerReady);
+	assert(isReady());
 
 	// Prevent duplicate sounds
 	if (id != -1) {
 		for (int i = 0; i != NUM_CHANNELS; i++)
-			if (_channels[i] != 0 && _channels[i]->getId() == id) {
+			if (Common::atomicLoad(&_channelActive[i]) && _channelInfo[i].id == id) {
 				// Delete the stream if were asked to auto-dispose it.
 				// Note: This could cause trouble if the client code does not
 				// yet expect the stream to be gone. The primary example to
@@ -263,32 +472,40 @@ void MixerImpl::playStream(
 	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
-	insertChannel(handle, chan);
+	insertChannel(handle, chan, id, type, volume, balance);
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
+	PROFILE_ZONE("Mixer::mixCallback");
 	assert(samples);
 
-	Common::StackLock lock(_mutex);
-
 	int16 *buf = (int16 *)samples;
 	// we store stereo, 16-bit samples
 	assert(len % 4 == 0);
 	len >>= 2;
 
-	// Since the mixer callback has been called, the mixer must be ready...
-	_mixerReady = true;
-
 	//  zero the buf
 	memset(buf, 0, 2 * len * sizeof(int16));
 
+	// Only contended if an engine thread took over because the callback
+	// did not run for a while
+	Common::StackLock lock(_mixingMutex);
+#ifdef SCUMMVM_THREAD_LOCAL
+	g_mixingMixer = this;
+#endif
+
+	// Since the mixer callback has been called, the mixer must be ready...
+	Common::atomicStore(&_mixerReady, 1);
+
+	processCommands();
+	acknowledgeCommands();
+
 	// mix all channels
 	int res = 0, tmp;
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i]) {
 			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = 0;
+				retireChannel(i);
 			} else if (!_channels[i]->isPaused()) {
 				tmp = _channels[i]->mix(buf, len);
 
@@ -297,90 +514,114 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 			}
 		}
 
+#ifdef SCUMMVM_THREAD_LOCAL
+	g_mixingMixer = nullptr;
+#endif
+
 	return res;
 }
 
 void MixerImpl::stopAll() {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = 0;
+	int32 count = 0;
+	{
+		Common::StackLock lock(_mutex);
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (Common::atomicLoad(&_channelActive[i]) && !_channelInfo[i].permanent) {
+				count = pushCommand(Command::kStopAll);
+				break;
+			}
 		}
 	}
+
+	if (count)
+		waitForCommands(count);
 }
 
 void MixerImpl::stopID(int id) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = 0;
+	int32 count = 0;
+	{
+		Common::StackLock lock(_mutex);
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (Common::atomicLoad(&_channelActive[i]) && _channelInfo[i].id == id) {
+				count = pushCommand(Command::kStopID, 0, 0, id);
+				break;
+			}
 		}
 	}
+
+	if (count)
+		waitForCommands(count);
 }
 
 void MixerImpl::stopHandle(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	int32 count;
+	{
+		Common::StackLock lock(_mutex);
 
-	// Simply ignore stop requests for handles of sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
+		// Simply ignore stop requests for handles of sounds that already terminated
+		int index;
+		if (!isValidHandle(handle, index))
+			return;
 
-	delete _channels[index];
-	_channels[index] = 0;
+		count = pushCommand(Command::kStopHandle, index, handle._val);
+	}
+
+	waitForCommands(count);
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	_soundTypeSettings[type].mute = mute;
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	Common::StackLock lock(_mutex);
+	Common::atomicStore(&_soundTypeSettings[type].mute, mute ? 1 : 0);
+	pushCommand(Command::kUpdateTypeVolumes, 0, 0, type);
 }
 
 bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	return _soundTypeSettings[type].mute;
+	return Common::atomicLoad(&_soundTypeSettings[type].mute) != 0;
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
 	Common::StackLock lock(_mutex);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	int index;
+	if (!isValidHandle(handle, index))
 		return;
 
-	_channels[index]->setVolume(volume);
+	_channelInfo[index].volume = volume;
+	pushCommand(Command::kSetVolume, index, handle._val, volume);
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Common::StackLock lock(_mutex);
+
+	int index;
+	if (!isValidHandle(handle, index))
 		return 0;
 
-	return _channels[index]->getVolume();
+	return _channelInfo[index].volume;
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
 	Common::StackLock lock(_mutex);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	int index;
+	if (!isValidHandle(handle, index))
 		return;
 
-	_channels[index]->setBalance(balance);
+	_channelInfo[index].balance = balance;
+	pushCommand(Command::kSetBalance, index, handle._val, balance);
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Common::StackLock lock(_mutex);
+
+	int index;
+	if (!isValidHandle(handle, index))
 		return 0;
 
-	return _channels[index]->getBalance();
+	return _channelInfo[index].balance;
 }
 
 uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
@@ -388,43 +629,71 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 }
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	Timestamp ts(0, _sampleRate);
+
+	int index;
+	{
+		Common::StackLock lock(_mutex);
+		if (!isValidHandle(handle, index))
+			return ts;
+	}
+
+	// Read a consistent snapshot of the timing published by the mixer
+	const ChannelTiming &timing = _channelTiming[index];
+	int32 seq, chanHandle, samplesConsumed, mixerTimeStamp, pauseStartTime, pauseTime, pauseLevel;
+	do {
+		seq = Common::atomicLoad(&timing.seq);
+		chanHandle = Common::atomicLoad(&timing.handle);
+		samplesConsumed = Common::atomicLoad(&timing.samplesConsumed);
+		mixerTimeStamp = Common::atomicLoad(&timing.mixerTimeStamp);
+		pauseStartTime = Common::atomicLoad(&timing.pauseStartTime);
+		pauseTime = Common::atomicLoad(&timing.pauseTime);
+		pauseLevel = Common::atomicLoad(&timing.pauseLevel);
+	} while ((seq & 1) || seq != Common::atomicLoad(&timing.seq));
+
+	// The channel has not been picked up by the mixer yet
+	if ((uint32)chanHandle != handle._val || mixerTimeStamp == 0)
+		return ts;
+
+	uint32 delta;
+	if (pauseLevel)
+		delta = (uint32)pauseStartTime - (uint32)mixerTimeStamp;
+	else
+		delta = g_system->getMillis(true) - (uint32)mixerTimeStamp - (uint32)pauseTime;
+
+	// Convert the number of samples into a time duration.
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return Timestamp(0, _sampleRate);
+	ts = ts.addFrames((uint32)samplesConsumed);
+	ts = ts.addMsecs(delta);
 
-	return _channels[index]->getElapsedTime();
+	// In theory it would seem like a good idea to limit the approximation
+	// so that it never exceeds the theoretical upper bound set by
+	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
+	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
+	// isn't invoked at the regular intervals that I first imagined.
+
+	return ts;
 }
 
 void MixerImpl::pauseAll(bool paused) {
 	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0) {
-			_channels[i]->pause(paused);
-		}
-	}
+	pushCommand(Command::kPauseAll, 0, 0, paused);
 }
 
 void MixerImpl::pauseID(int id, bool paused) {
 	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && _channels[i]->getId() == id) {
-			_channels[i]->pause(paused);
-			return;
-		}
-	}
+	pushCommand(Command::kPauseID, id, 0, paused);
 }
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
 	Common::StackLock lock(_mutex);
 
 	// Simply ignore (un)pause requests for sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	int index;
+	if (!isValidHandle(handle, index))
 		return;
 
-	_channels[index]->pause(paused);
+	pushCommand(Command::kPauseHandle, index, handle._val, paused);
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
@@ -435,16 +704,17 @@ bool MixerImpl::isSoundIDActive(int id) {
 #endif
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getId() == id)
+		if (Common::atomicLoad(&_channelActive[i]) && _channelInfo[i].id == id)
 			return true;
 	return false;
 }
 
 int MixerImpl::getSoundID(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
-		return _channels[index]->getId();
+
+	int index;
+	if (isValidHandle(handle, index))
+		return _channelInfo[index].id;
 	return 0;
 }
 
@@ -455,14 +725,14 @@ bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
 	g_eventRec.updateSubsystems();
 #endif
 
-	const int index = handle._val % NUM_CHANNELS;
-	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
+	int index;
+	return isValidHandle(handle, index);
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getType() == type)
+		if (Common::atomicLoad(&_channelActive[i]) && _channelInfo[i].type == type)
 			return true;
 	return false;
 }
@@ -477,18 +747,14 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	// scaling? See also Player_V2::setMasterVolume
 
 	Common::StackLock lock(_mutex);
-	_soundTypeSettings[type].volume = volume;
-
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	Common::atomicStore(&_soundTypeSettings[type].volume, volume);
+	pushCommand(Command::kUpdateTypeVolumes, 0, 0, type);
 }
 
 int MixerImpl::getVolumeForSoundType(SoundType type) const {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
 
-	return _soundTypeSettings[type].volume;
+	return Common::atomicLoad(&_soundTypeSettings[type].volume);
 }
 
 
@@ -500,7 +766,7 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
                  DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent)
     : _type(type), _mixer(mixer), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
       _balance(0), _pauseLevel(0), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
-      _pauseStartTime(0), _pauseTime(0), _converter(0), _volL(0), _volR(0),
+      _pauseStartTime(0), _pauseTime(0), _timing(0), _converter(0), _volL(0), _volR(0),
       _stream(stream, autofreeStream) {
 	assert(mixer);
 	assert(stream);
@@ -574,34 +840,27 @@ void Channel::pause(bool paused) {
 			_pauseStartTime = 0;
 		}
 	}
-}
-
-Timestamp Channel::getElapsedTime() {
-	const uint32 rate = _mixer->getOutputRate();
-	uint32 delta = 0;
-
-	Audio::Timestamp ts(0, rate);
-
-	if (_mixerTimeStamp == 0)
-		return ts;
 
-	if (isPaused())
-		delta = _pauseStartTime - _mixerTimeStamp;
-	else
-		delta = g_system->getMillis(true) - _mixerTimeStamp - _pauseTime;
-
-	// Convert the number of samples into a time duration.
+	publishTiming();
+}
 
-	ts = ts.addFrames(_samplesConsumed);
-	ts = ts.addMsecs(delta);
+void Channel::setTiming(ChannelTiming *timing) {
+	_timing = timing;
+	publishTiming();
+}
 
-	// In theory it would seem like a good idea to limit the approximation
-	// so that it never exceeds the theoretical upper bound set by
-	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
-	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
-	// isn't invoked at the regular intervals that I first imagined.
+void Channel::publishTiming() {
+	if (!_timing)
+		return;
 
-	return ts;
+	Common::atomicAdd(&_timing->seq, 1);
+	Common::atomicStore(&_timing->handle, _handle._val);
+	Common::atomicStore(&_timing->samplesConsumed, _samplesConsumed);
+	Common::atomicStore(&_timing->mixerTimeStamp, _mixerTimeStamp);
+	Common::atomicStore(&_timing->pauseStartTime, _pauseStartTime);
+	Common::atomicStore(&_timing->pauseTime, _pauseTime);
+	Common::atomicStore(&_timing->pauseLevel, _pauseLevel);
+	Common::atomicAdd(&_timing->seq, 1);
 }
 
 int Channel::mix(int16 *data, uint len) {
@@ -617,6 +876,7 @@ int Channel::mix(int16 *data, uint len) {
 		_pauseTime = 0;
 		res = _converter->flow(*_stream, data, len, _volL, _volR);
 		_samplesDecoded += res;
+		publishTiming();
 	}
 
 	return res;
@@ -24,11 +24,30 @@
 #define AUDIO_MIXER_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/atomic.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
 
+class MixerTestSuite;
+
 namespace Audio {
 
+/**
+ * Timing information of a channel, published by the mixer thread and read
+ * by engine threads without locking (seqlock protocol: the writer makes
+ * @c seq odd while updating, readers retry until they see the same even
+ * value before and after reading).
+ */
+struct ChannelTiming {
+	volatile int32 seq;
+	volatile int32 handle;
+	volatile int32 samplesConsumed;
+	volatile int32 mixerTimeStamp;
+	volatile int32 pauseStartTime;
+	volatile int32 pauseTime;
+	volatile int32 pauseLevel;
+};
+
 /**
  * The (default) implementation of the ScummVM audio mixing subsystem.
  *
@@ -42,6 +61,14 @@ namespace Audio {
  * 4) Change the mixer into ready mode via setReady(true).
  * 5) Start audio processing (e.g. by resuming the audio thread, if applicable).
  *
+ * Engine side API calls never block the mixing side: state changes are
+ * posted to a lock-free command ring which mixCallback() drains before
+ * mixing, and queries are answered from state kept on the engine side.
+ * The stop methods additionally wait until the audio callback has retired
+ * the stopped channels, since callers may free the sound data right away.
+ * They return at once if nothing is playing which they would stop, and
+ * apply the commands directly when called from within the callback.
+ *
  * In the future, we might make it possible for backends to provide
  * (partial) alternative implementations of the mixer, e.g. to make
  * better use of native sound mixing support on low-end devices.
@@ -49,34 +76,115 @@ namespace Audio {
  * @see OSystem::getMixer()
  */
 class MixerImpl : public Mixer {
+	friend class ::MixerTestSuite;
+
 private:
 	enum {
-		NUM_CHANNELS = 32
+		NUM_CHANNELS = 32,
+		COMMAND_QUEUE_SIZE = 256
+	};
+
+	/**
+	 * A request from an engine thread, applied by whoever currently owns
+	 * the mixing side (normally the audio callback).
+	 */
+	struct Command {
+		enum Type {
+			kPlay,
+			kStopAll,
+			kStopID,
+			kStopHandle,
+			kPauseAll,
+			kPauseID,
+			kPauseHandle,
+			kSetVolume,
+			kSetBalance,
+			kUpdateTypeVolumes
+		};
+
+		Type type;
+		int index;
+		uint32 handle;
+		int arg;
+		Channel *channel;
 	};
 
+	/**
+	 * Engine side view of a channel slot. Only touched with _mutex held.
+	 */
+	struct ChannelInfo {
+		uint32 handle;
+		int id;
+		SoundType type;
+		byte volume;
+		int8 balance;
+		bool permanent;
+	};
+
+	/**
+	 * Serializes the engine side API calls. Engine threads never wait for
+	 * the mixing side while holding it, so the audio callback may stop
+	 * sounds itself without deadlocking.
+	 */
 	Common::Mutex _mutex;
 
+	/**
+	 * Owned by whoever applies commands and mixes. The audio callback holds
+	 * it while it runs; engine threads only take it over when the callback
+	 * does not acknowledge their commands in time, e.g. because audio
+	 * output is suspended.
+	 */
+	Common::Mutex _mixingMutex;
+
 	const uint _sampleRate;
-	bool _mixerReady;
+	volatile int32 _mixerReady;
 	uint32 _handleSeed;
 
 	struct SoundTypeSettings {
-		SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
+		SoundTypeSettings() : mute(0), volume(kMaxMixerVolume) {}
 
-		bool mute;
-		int volume;
+		volatile int32 mute;
+		volatile int32 volume;
 	};
 
 	SoundTypeSettings _soundTypeSettings[4];
-	Channel *_channels[NUM_CHANNELS];
 
+	/** Channels, owned by the mixing side. */
+	Channel *_channels[NUM_CHANNELS];
+	/** Non-zero while a slot is in use, set by the engine side and cleared by the mixing side. */
+	volatile int32 _channelActive[NUM_CHANNELS];
+	ChannelInfo _channelInfo[NUM_CHANNELS];
+	ChannelTiming _channelTiming[NUM_CHANNELS];
+
+	/** Single producer (serialized by _mutex), single consumer command ring. */
+	Command _commands[COMMAND_QUEUE_SIZE];
+	volatile int32 _queueHead;
+	volatile int32 _queueTail;
+
+	/** Number of commands pushed so far, only touched with _mutex held. */
+	int32 _commandsPushed;
+	/** Number of commands applied so far, advanced by the mixing side. */
+	volatile int32 _commandsDone;
+
+	/** Engine threads waiting in waitForCommands(), woken up through _commandsAck. */
+	volatile int32 _commandWaiters;
+	Common::Semaphore _commandsAck;
+
+	int32 pushCommand(Command::Type type, int index = 0, uint32 handle = 0, int arg = 0, Channel *channel = nullptr);
+	void waitForCommands(int32 count);
+	bool commandsDone(int32 count);
+	void processCommands();
+	void acknowledgeCommands();
+	void applyCommand(const Command &cmd);
+	void retireChannel(int index);
+	bool isValidHandle(SoundHandle handle, int &index) const;
 
 public:
 
 	MixerImpl(uint sampleRate);
 	~MixerImpl();
 
-	virtual bool isReady() const { Common::StackLock lock(_mutex); return _mixerReady; }
+	virtual bool isReady() const { return Common::atomicLoad(&_mixerReady) != 0; }
 
 	virtual void playStream(
 		SoundType type,
@@ -119,7 +227,7 @@ public:
 	virtual uint getOutputRate() const;
 
 protected:
-	void insertChannel(SoundHandle *handle, Channel *chan);
+	void insertChannel(SoundHandle *handle, Channel *chan, int id, SoundType type, byte volume, int8 balance);
 
 public:
 	/**
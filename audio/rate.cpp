@@ -30,8 +30,10 @@
 
 #include "audio/audiostream.h"
 #include "audio/rate.h"
+#include "audio/rate_intern.h"
 #include "audio/mixer.h"
 #include "common/frac.h"
+#include "common/simd.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
@@ -57,6 +59,62 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+#pragma mark -
+#pragma mark --- Mixing routines ---
+#pragma mark -
+
+void mixStereoGeneric(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r, bool reverseStereo) {
+	const int left = reverseStereo ? 1 : 0;
+
+	for (; frames > 0; frames--) {
+		// output left channel
+		clampedAdd(obuf[left    ], (ibuf[0] * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+
+		// output right channel
+		clampedAdd(obuf[left ^ 1], (ibuf[1] * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+
+		ibuf += 2;
+		obuf += 2;
+	}
+}
+
+void mixMonoGeneric(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	for (; frames > 0; frames--) {
+		clampedAdd(obuf[0], (*ibuf * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+		clampedAdd(obuf[1], (*ibuf * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+
+		ibuf++;
+		obuf += 2;
+	}
+}
+
+const MixProcs &getMixProcs() {
+	static const MixProcs generic = { mixStereoGeneric, mixMonoGeneric };
+	const MixProcs *neon = nullptr, *sse2 = nullptr, *avx2 = nullptr;
+
+	// The vectorized routines expect signed output samples
+#ifndef OUTPUT_UNSIGNED_AUDIO
+#ifdef SCUMMVM_NEON
+	static const MixProcs neonProcs = { mixStereoNEON, mixMonoNEON };
+	neon = &neonProcs;
+#endif
+#ifdef SCUMMVM_SSE2
+	static const MixProcs sse2Procs = { mixStereoSSE2, mixMonoSSE2 };
+	sse2 = &sse2Procs;
+#endif
+#ifdef SCUMMVM_AVX2
+	static const MixProcs avx2Procs = { mixStereoAVX2, mixMonoAVX2 };
+	avx2 = &avx2Procs;
+#endif
+#endif
+
+	return Common::selectSimdProcs(generic, neon, sse2, avx2);
+}
+
+#pragma mark -
+#pragma mark --- Rate converters ---
+#pragma mark -
+
 /**
  * Audio rate converter based on simple resampling. Used when no
  * interpolation is required.
@@ -70,6 +128,10 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** resampled stereo frames waiting to be mixed into the output */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+	MixStereoProc mixStereo;
+
 	/** position of how far output is ahead of input */
 	/** Holds what would have been opos-ipos */
 	long opos;
@@ -105,6 +167,8 @@ SimpleRateConverter<stereo, reverseStereo>::SimpleRateConverter(st_rate_t inrate
 	opos_inc = inrate / outrate;
 
 	inLen = 0;
+
+	mixStereo = getMixProcs().mixStereo;
 }
 
 /*
@@ -119,37 +183,51 @@ int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 	oend = obuf + osamp * 2;
 
 	while (obuf < oend) {
+		// Resample into outBuf first, then mix it into the output in one go
+		st_sample_t *bufPtr = outBuf;
+		st_sample_t *bufEnd = outBuf + MIN<st_size_t>(oend - obuf, ARRAYSIZE(outBuf));
+		bool endOfInput = false;
+
+		while (bufPtr < bufEnd) {
+
+			// read enough input samples so that opos >= 0
+			do {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				opos--;
+				if (opos >= 0) {
+					inPtr += (stereo ? 2 : 1);
+				}
+			} while (opos >= 0);
+
+			if (endOfInput)
+				break;
 
-		// read enough input samples so that opos >= 0
-		do {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
-			}
-			inLen -= (stereo ? 2 : 1);
-			opos--;
-			if (opos >= 0) {
-				inPtr += (stereo ? 2 : 1);
-			}
-		} while (opos >= 0);
-
-		st_sample_t out0, out1;
-		out0 = *inPtr++;
-		out1 = (stereo ? *inPtr++ : out0);
+			st_sample_t out0, out1;
+			out0 = *inPtr++;
+			out1 = (stereo ? *inPtr++ : out0);
 
-		// Increment output position
-		opos += opos_inc;
+			// Increment output position
+			opos += opos_inc;
 
-		// output left channel
-		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+			bufPtr[0] = out0;
+			bufPtr[1] = out1;
+			bufPtr += 2;
+		}
 
-		// output right channel
-		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+		mixStereo(obuf, outBuf, (bufPtr - outBuf) / 2, vol_l, vol_r, reverseStereo);
+		obuf += bufPtr - outBuf;
 
-		obuf += 2;
+		if (endOfInput)
+			break;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -183,6 +261,10 @@ protected:
 	/** current sample(s) in the input stream (left/right channel) */
 	st_sample_t icur0, icur1;
 
+	/** interpolated stereo frames waiting to be mixed into the output */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+	MixStereoProc mixStereo;
+
 public:
 	LinearRateConverter(st_rate_t inrate, st_rate_t outrate);
 	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
@@ -214,6 +296,8 @@ LinearRateConverter<stereo, reverseStereo>::LinearRateConverter(st_rate_t inrate
 	icur0 = icur1 = 0;
 
 	inLen = 0;
+
+	mixStereo = getMixProcs().mixStereo;
 }
 
 /*
@@ -228,47 +312,61 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 	oend = obuf + osamp * 2;
 
 	while (obuf < oend) {
-
-		// read enough input samples so that opos < 0
-		while ((frac_t)FRAC_ONE_LOW <= opos) {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
+		// Interpolate into outBuf first, then mix it into the output in one go
+		st_sample_t *bufPtr = outBuf;
+		st_sample_t *bufEnd = outBuf + MIN<st_size_t>(oend - obuf, ARRAYSIZE(outBuf));
+		bool endOfInput = false;
+
+		while (bufPtr < bufEnd) {
+
+			// read enough input samples so that opos < 0
+			while ((frac_t)FRAC_ONE_LOW <= opos) {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				ilast0 = icur0;
+				icur0 = *inPtr++;
+				if (stereo) {
+					ilast1 = icur1;
+					icur1 = *inPtr++;
+				}
+				opos -= FRAC_ONE_LOW;
 			}
-			inLen -= (stereo ? 2 : 1);
-			ilast0 = icur0;
-			icur0 = *inPtr++;
-			if (stereo) {
-				ilast1 = icur1;
-				icur1 = *inPtr++;
+
+			if (endOfInput)
+				break;
+
+			// Loop as long as the outpos trails behind, and as long as there is
+			// still space in the output buffer.
+			while (opos < (frac_t)FRAC_ONE_LOW && bufPtr < bufEnd) {
+				// interpolate
+				st_sample_t out0, out1;
+				out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+				out1 = (stereo ?
+							  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
+							  out0);
+
+				bufPtr[0] = out0;
+				bufPtr[1] = out1;
+				bufPtr += 2;
+
+				// Increment output position
+				opos += opos_inc;
 			}
-			opos -= FRAC_ONE_LOW;
 		}
 
-		// Loop as long as the outpos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (opos < (frac_t)FRAC_ONE_LOW && obuf < oend) {
-			// interpolate
-			st_sample_t out0, out1;
-			out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
-			out1 = (stereo ?
-						  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
-						  out0);
-
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+		mixStereo(obuf, outBuf, (bufPtr - outBuf) / 2, vol_l, vol_r, reverseStereo);
+		obuf += bufPtr - outBuf;
 
-			obuf += 2;
-
-			// Increment output position
-			opos += opos_inc;
-		}
+		if (endOfInput)
+			break;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -284,8 +382,9 @@ template<bool stereo, bool reverseStereo>
 class CopyRateConverter : public RateConverter {
 	st_sample_t *_buffer;
 	st_size_t _bufferSize;
+	const MixProcs &_mixProcs;
 public:
-	CopyRateConverter() : _buffer(0), _bufferSize(0) {}
+	CopyRateConverter() : _buffer(0), _bufferSize(0), _mixProcs(getMixProcs()) {}
 	~CopyRateConverter() {
 		free(_buffer);
 	}
@@ -293,11 +392,8 @@ public:
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
 		assert(input.isStereo() == stereo);
 
-		st_sample_t *ptr;
 		st_size_t len;
 
-		st_sample_t *ostart = obuf;
-
 		if (stereo)
 			osamp *= 2;
 
@@ -315,21 +411,14 @@ public:
 		len = input.readBuffer(_buffer, osamp);
 
 		// Mix the data into the output buffer
-		ptr = _buffer;
-		for (; len > 0; len -= (stereo ? 2 : 1)) {
-			st_sample_t out0, out1;
-			out0 = *ptr++;
-			out1 = (stereo ? *ptr++ : out0);
-
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
+		if (stereo) {
+			len /= 2;
+			_mixProcs.mixStereo(obuf, _buffer, len, vol_l, vol_r, reverseStereo);
+		} else {
+			_mixProcs.mixMono(obuf, _buffer, len, vol_l, vol_r);
 		}
-		return (obuf - ostart) / 2;
+
+		return len;
 	}
 
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
@@ -0,0 +1,90 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/mixer.h"
+#include "audio/rate_intern.h"
+
+#ifdef SCUMMVM_AVX2
+
+#include <immintrin.h>
+
+namespace Audio {
+
+/**
+ * Scale sixteen samples by their volume and divide by kMaxMixerVolume,
+ * rounding towards zero like the integer division in the generic code.
+ * The unpack and pack operations work per 128-bit lane, so the sample
+ * order is preserved.
+ */
+static inline __m256i scaleSamples(__m256i samples, __m256i volume) {
+	const __m256i lo16 = _mm256_mullo_epi16(samples, volume);
+	const __m256i hi16 = _mm256_mulhi_epi16(samples, volume);
+	const __m256i bias = _mm256_set1_epi32(Audio::Mixer::kMaxMixerVolume - 1);
+
+	__m256i lo = _mm256_unpacklo_epi16(lo16, hi16);
+	__m256i hi = _mm256_unpackhi_epi16(lo16, hi16);
+	lo = _mm256_add_epi32(lo, _mm256_and_si256(_mm256_srai_epi32(lo, 31), bias));
+	hi = _mm256_add_epi32(hi, _mm256_and_si256(_mm256_srai_epi32(hi, 31), bias));
+	lo = _mm256_srai_epi32(lo, 8);
+	hi = _mm256_srai_epi32(hi, 8);
+
+	return _mm256_packs_epi32(lo, hi);
+}
+
+void mixStereoAVX2(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r, bool reverseStereo) {
+	const st_volume_t first = reverseStereo ? vol_r : vol_l;
+	const st_volume_t second = reverseStereo ? vol_l : vol_r;
+	const __m256i volume = _mm256_set1_epi32((int32)(((uint32)second << 16) | first));
+
+	st_size_t i = 0;
+	for (; i + 8 <= frames; i += 8) {
+		__m256i in = _mm256_loadu_si256((const __m256i *)(ibuf + i * 2));
+		if (reverseStereo) {
+			in = _mm256_shufflelo_epi16(in, _MM_SHUFFLE(2, 3, 0, 1));
+			in = _mm256_shufflehi_epi16(in, _MM_SHUFFLE(2, 3, 0, 1));
+		}
+
+		const __m256i out = _mm256_loadu_si256((const __m256i *)(obuf + i * 2));
+		_mm256_storeu_si256((__m256i *)(obuf + i * 2), _mm256_adds_epi16(out, scaleSamples(in, volume)));
+	}
+
+	mixStereoGeneric(obuf + i * 2, ibuf + i * 2, frames - i, vol_l, vol_r, reverseStereo);
+}
+
+void mixMonoAVX2(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	const __m256i volume = _mm256_set1_epi32((int32)(((uint32)vol_r << 16) | vol_l));
+
+	st_size_t i = 0;
+	for (; i + 8 <= frames; i += 8) {
+		const __m128i in = _mm_loadu_si128((const __m128i *)(ibuf + i));
+		const __m256i dup = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(in, in)), _mm_unpackhi_epi16(in, in), 1);
+
+		const __m256i out = _mm256_loadu_si256((const __m256i *)(obuf + i * 2));
+		_mm256_storeu_si256((__m256i *)(obuf + i * 2), _mm256_adds_epi16(out, scaleSamples(dup, volume)));
+	}
+
+	mixMonoGeneric(obuf + i * 2, ibuf + i, frames - i, vol_l, vol_r);
+}
+
+} // End of namespace Audio
+
+#endif
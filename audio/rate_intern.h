@@ -0,0 +1,77 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_RATE_INTERN_H
+#define AUDIO_RATE_INTERN_H
+
+#include "audio/rate.h"
+
+namespace Audio {
+
+/**
+ * Mix interleaved stereo sample frames into the output buffer.
+ *
+ * For every frame, the left input sample scaled by vol_l / kMaxMixerVolume
+ * and the right input sample scaled by vol_r / kMaxMixerVolume are added to
+ * the output frame with clamping, exactly like clampedAdd() does. With
+ * @p reverseStereo set, the left input goes to the right output and vice
+ * versa.
+ */
+typedef void (*MixStereoProc)(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r, bool reverseStereo);
+
+/**
+ * Mix mono samples into both channels of the output buffer, using the same
+ * scaling and clamping as MixStereoProc.
+ */
+typedef void (*MixMonoProc)(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r);
+
+struct MixProcs {
+	MixStereoProc mixStereo;
+	MixMonoProc mixMono;
+};
+
+void mixStereoGeneric(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r, bool reverseStereo);
+void mixMonoGeneric(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r);
+
+#ifdef SCUMMVM_SSE2
+void mixStereoSSE2(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r, bool reverseStereo);
+void mixMonoSSE2(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r);
+#endif
+
+#ifdef SCUMMVM_AVX2
+void mixStereoAVX2(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r, bool reverseStereo);
+void mixMonoAVX2(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r);
+#endif
+
+#ifdef SCUMMVM_NEON
+void mixStereoNEON(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r, bool reverseStereo);
+void mixMonoNEON(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r);
+#endif
+
+/**
+ * Return the fastest mixing routines the CPU supports.
+ */
+const MixProcs &getMixProcs();
+
+} // End of namespace Audio
+
+#endif
@@ -0,0 +1,82 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/mixer.h"
+#include "audio/rate_intern.h"
+
+#ifdef SCUMMVM_NEON
+
+#include <arm_neon.h>
+
+namespace Audio {
+
+/**
+ * Scale four samples by their volume and divide by kMaxMixerVolume,
+ * rounding towards zero like the integer division in the generic code.
+ */
+static inline int16x4_t scaleSamples(int16x4_t samples, int16x4_t volume) {
+	int32x4_t prod = vmull_s16(samples, volume);
+	prod = vaddq_s32(prod, vandq_s32(vshrq_n_s32(prod, 31), vdupq_n_s32(Audio::Mixer::kMaxMixerVolume - 1)));
+	return vmovn_s32(vshrq_n_s32(prod, 8));
+}
+
+static inline int16x8_t scaleSamples(int16x8_t samples, int16x8_t volume) {
+	return vcombine_s16(scaleSamples(vget_low_s16(samples), vget_low_s16(volume)),
+	                    scaleSamples(vget_high_s16(samples), vget_high_s16(volume)));
+}
+
+void mixStereoNEON(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r, bool reverseStereo) {
+	const int16 first = reverseStereo ? vol_r : vol_l;
+	const int16 second = reverseStereo ? vol_l : vol_r;
+	const int16x8_t volume = vreinterpretq_s16_s32(vdupq_n_s32((int32)(((uint32)(uint16)second << 16) | (uint16)first)));
+
+	st_size_t i = 0;
+	for (; i + 4 <= frames; i += 4) {
+		int16x8_t in = vld1q_s16(ibuf + i * 2);
+		if (reverseStereo)
+			in = vrev32q_s16(in);
+
+		const int16x8_t out = vld1q_s16(obuf + i * 2);
+		vst1q_s16(obuf + i * 2, vqaddq_s16(out, scaleSamples(in, volume)));
+	}
+
+	mixStereoGeneric(obuf + i * 2, ibuf + i * 2, frames - i, vol_l, vol_r, reverseStereo);
+}
+
+void mixMonoNEON(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	const int16x8_t volume = vreinterpretq_s16_s32(vdupq_n_s32((int32)(((uint32)vol_r << 16) | vol_l)));
+
+	st_size_t i = 0;
+	for (; i + 4 <= frames; i += 4) {
+		const int16x4_t in = vld1_s16(ibuf + i);
+		const int16x4x2_t dup = vzip_s16(in, in);
+
+		const int16x8_t out = vld1q_s16(obuf + i * 2);
+		vst1q_s16(obuf + i * 2, vqaddq_s16(out, scaleSamples(vcombine_s16(dup.val[0], dup.val[1]), volume)));
+	}
+
+	mixMonoGeneric(obuf + i * 2, ibuf + i, frames - i, vol_l, vol_r);
+}
+
+} // End of namespace Audio
+
+#endif
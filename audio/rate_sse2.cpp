@@ -0,0 +1,92 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/mixer.h"
+#include "audio/rate_intern.h"
+
+#ifdef SCUMMVM_SSE2
+
+#include <emmintrin.h>
+
+namespace Audio {
+
+/**
+ * Scale eight samples by their volume and divide by kMaxMixerVolume,
+ * rounding towards zero like the integer division in the generic code.
+ * kMaxMixerVolume is 256, hence the shift by 8.
+ */
+static inline __m128i scaleSamples(__m128i samples, __m128i volume) {
+	const __m128i lo16 = _mm_mullo_epi16(samples, volume);
+	const __m128i hi16 = _mm_mulhi_epi16(samples, volume);
+	const __m128i bias = _mm_set1_epi32(Audio::Mixer::kMaxMixerVolume - 1);
+
+	__m128i lo = _mm_unpacklo_epi16(lo16, hi16);
+	__m128i hi = _mm_unpackhi_epi16(lo16, hi16);
+	lo = _mm_add_epi32(lo, _mm_and_si128(_mm_srai_epi32(lo, 31), bias));
+	hi = _mm_add_epi32(hi, _mm_and_si128(_mm_srai_epi32(hi, 31), bias));
+	lo = _mm_srai_epi32(lo, 8);
+	hi = _mm_srai_epi32(hi, 8);
+
+	return _mm_packs_epi32(lo, hi);
+}
+
+void mixStereoSSE2(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r, bool reverseStereo) {
+	// With reversed stereo the input frames are swapped, so the right
+	// output channel receives the left input scaled by vol_l.
+	const __m128i volume = reverseStereo ?
+		_mm_set_epi16(vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r) :
+		_mm_set_epi16(vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l);
+
+	st_size_t i = 0;
+	for (; i + 4 <= frames; i += 4) {
+		__m128i in = _mm_loadu_si128((const __m128i *)(ibuf + i * 2));
+		if (reverseStereo) {
+			in = _mm_shufflelo_epi16(in, _MM_SHUFFLE(2, 3, 0, 1));
+			in = _mm_shufflehi_epi16(in, _MM_SHUFFLE(2, 3, 0, 1));
+		}
+
+		const __m128i out = _mm_loadu_si128((const __m128i *)(obuf + i * 2));
+		_mm_storeu_si128((__m128i *)(obuf + i * 2), _mm_adds_epi16(out, scaleSamples(in, volume)));
+	}
+
+	mixStereoGeneric(obuf + i * 2, ibuf + i * 2, frames - i, vol_l, vol_r, reverseStereo);
+}
+
+void mixMonoSSE2(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	const __m128i volume = _mm_set_epi16(vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l);
+
+	st_size_t i = 0;
+	for (; i + 8 <= frames; i += 8) {
+		const __m128i in = _mm_loadu_si128((const __m128i *)(ibuf + i));
+
+		const __m128i out0 = _mm_loadu_si128((const __m128i *)(obuf + i * 2));
+		const __m128i out1 = _mm_loadu_si128((const __m128i *)(obuf + i * 2 + 8));
+		_mm_storeu_si128((__m128i *)(obuf + i * 2), _mm_adds_epi16(out0, scaleSamples(_mm_unpacklo_epi16(in, in), volume)));
+		_mm_storeu_si128((__m128i *)(obuf + i * 2 + 8), _mm_adds_epi16(out1, scaleSamples(_mm_unpackhi_epi16(in, in), volume)));
+	}
+
+	mixMonoGeneric(obuf + i * 2, ibuf + i, frames - i, vol_l, vol_r);
+}
+
+} // End of namespace Audio
+
+#endif
@@ -58,6 +58,20 @@ void BaseBackend::fillScreen(uint32 col) {
 	unlockScreen();
 }
 
+bool BaseBackend::hasCpuFeature(Feature f) {
+#if defined(SCUMMVM_SSE2) && defined(__GNUC__)
+	if (f == kFeatureCpuSSE2) return __builtin_cpu_supports("sse2");
+#endif
+#if defined(SCUMMVM_AVX2) && defined(__GNUC__)
+	if (f == kFeatureCpuAVX2) return __builtin_cpu_supports("avx2");
+#endif
+#ifdef SCUMMVM_NEON
+	// NEON is part of the base ARMv8 instruction set
+	if (f == kFeatureCpuNEON) return true;
+#endif
+	return false;
+}
+
 void EventsBaseBackend::initBackend() {
 	// Init Event manager
 #ifndef DISABLE_DEFAULT_EVENT_MANAGER
@@ -37,6 +37,15 @@ public:
 	virtual void displayMessageOnOSD(const Common::U32String &msg) override;
 	virtual void displayActivityIconOnOSD(const Graphics::Surface *icon) override {}
 	virtual void fillScreen(uint32 col) override;
+
+protected:
+	/**
+	 * Detect the CPU features ScummVM has SIMD code for, for backends
+	 * without a platform API of their own to query them.
+	 *
+	 * @return true if @p f is a kFeatureCpu* feature the CPU supports.
+	 */
+	static bool hasCpuFeature(Feature f);
 };
 
 class EventsBaseBackend : virtual public BaseBackend, Common::EventSource {
@@ -173,6 +173,15 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Returns the time of the last modification of the file in seconds,
+	 * or 0 if it is unknown.
+	 *
+	 * @note The time base is backend specific, so the value is only good
+	 * for comparing it against earlier values for the same file.
+	 */
+	virtual uint32 getModificationTime() const { return 0; }
+
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -71,6 +71,14 @@ bool POSIXFilesystemNode::isWritable() const {
 	return access(_path.c_str(), W_OK) == 0;
 }
 
+uint32 POSIXFilesystemNode::getModificationTime() const {
+	struct stat st;
+
+	if (stat(_path.c_str(), &st) != 0)
+		return 0;
+	return (uint32)st.st_mtime;
+}
+
 void POSIXFilesystemNode::setFlags() {
 	struct stat st;
 
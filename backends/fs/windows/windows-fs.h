@@ -73,6 +73,7 @@ public:
 	virtual bool isDirectory() const override { return _isDirectory; }
 	virtual bool isReadable() const override;
 	virtual bool isWritable() const override;
+	virtual uint32 getModificationTime() const override;
 
 	virtual AbstractFSNode *getChild(const Common::String &n) const override;
 	virtual bool getChildren(AbstractFSList &list, ListMode mode, bool hidden) const override;
@@ -0,0 +1,134 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "backends/graphics/bench/bench-graphics.h"
+#include "graphics/conversion.h"
+#include "common/util.h"
+
+BenchGraphicsManager::BenchGraphicsManager(FrameListener *listener)
+	: _listener(listener), _screenChangeID(0), _overlayVisible(false), _mouseVisible(false) {
+	memset(_palette, 0, sizeof(_palette));
+	memset(_paletteMap, 0, sizeof(_paletteMap));
+}
+
+BenchGraphicsManager::~BenchGraphicsManager() {
+	_screen.free();
+	_overlay.free();
+	_output.free();
+}
+
+Common::List<Graphics::PixelFormat> BenchGraphicsManager::getSupportedFormats() const {
+	Common::List<Graphics::PixelFormat> list;
+	list.push_back(Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0));
+	list.push_back(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0));
+	list.push_back(Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24));
+	list.push_back(Graphics::PixelFormat(2, 5, 5, 5, 0, 10,  5,  0,  0));
+	list.push_back(Graphics::PixelFormat(2, 5, 5, 5, 1, 10,  5,  0, 15));
+	list.push_back(Graphics::PixelFormat::createFormatCLUT8());
+	return list;
+}
+
+void BenchGraphicsManager::initSize(uint width, uint height, const Graphics::PixelFormat *format) {
+	const Graphics::PixelFormat screenFormat = format ? *format : Graphics::PixelFormat::createFormatCLUT8();
+	if (_screen.w == (int16)width && _screen.h == (int16)height && _screen.format == screenFormat)
+		return;
+
+	_screen.free();
+	_screen.create(width, height, screenFormat);
+
+	// The GUI needs at least 320x200, same as on the other backends
+	_overlay.free();
+	_overlay.create(MAX<uint>(width, 320), MAX<uint>(height, 200), Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+
+	_output.free();
+	_output.create(_overlay.w, _overlay.h, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+
+	for (uint i = 0; i < 256; ++i)
+		_paletteMap[i] = _output.format.RGBToColor(_palette[i * 3], _palette[i * 3 + 1], _palette[i * 3 + 2]);
+
+	++_screenChangeID;
+}
+
+void BenchGraphicsManager::setPalette(const byte *colors, uint start, uint num) {
+	assert(start + num <= 256);
+	memcpy(_palette + start * 3, colors, num * 3);
+	for (uint i = start; i < start + num; ++i)
+		_paletteMap[i] = _output.format.RGBToColor(_palette[i * 3], _palette[i * 3 + 1], _palette[i * 3 + 2]);
+}
+
+void BenchGraphicsManager::grabPalette(byte *colors, uint start, uint num) const {
+	assert(start + num <= 256);
+	memcpy(colors, _palette + start * 3, num * 3);
+}
+
+void BenchGraphicsManager::copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {
+	_screen.copyRectToSurface(buf, pitch, x, y, w, h);
+}
+
+void BenchGraphicsManager::fillScreen(uint32 col) {
+	_screen.fillRect(Common::Rect(_screen.w, _screen.h), col);
+}
+
+void BenchGraphicsManager::updateScreen() {
+	if (_listener)
+		_listener->beginUpdate();
+
+	const Graphics::Surface &src = _overlayVisible ? _overlay : _screen;
+	if (src.format.bytesPerPixel == 1) {
+		for (int y = 0; y < src.h; ++y) {
+			const byte *in = (const byte *)src.getBasePtr(0, y);
+			uint32 *out = (uint32 *)_output.getBasePtr(0, y);
+			for (int x = 0; x < src.w; ++x)
+				out[x] = _paletteMap[in[x]];
+		}
+	} else if (src.getPixels()) {
+		Graphics::crossBlit((byte *)_output.getPixels(), (const byte *)src.getPixels(),
+		                    _output.pitch, src.pitch, src.w, src.h, _output.format, src.format);
+	}
+
+	if (_listener)
+		_listener->endUpdate();
+}
+
+void BenchGraphicsManager::clearOverlay() {
+	_overlay.fillRect(Common::Rect(_overlay.w, _overlay.h), 0);
+}
+
+void BenchGraphicsManager::grabOverlay(void *buf, int pitch) const {
+	const byte *src = (const byte *)_overlay.getPixels();
+	byte *dst = (byte *)buf;
+	for (int y = 0; y < _overlay.h; ++y) {
+		memcpy(dst, src, _overlay.w * _overlay.format.bytesPerPixel);
+		src += _overlay.pitch;
+		dst += pitch;
+	}
+}
+
+void BenchGraphicsManager::copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {
+	_overlay.copyRectToSurface(buf, pitch, x, y, w, h);
+}
+
+bool BenchGraphicsManager::showMouse(bool visible) {
+	bool last = _mouseVisible;
+	_mouseVisible = visible;
+	return last;
+}
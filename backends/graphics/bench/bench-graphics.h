@@ -0,0 +1,108 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_BENCH_H
+#define BACKENDS_GRAPHICS_BENCH_H
+
+#include "backends/graphics/graphics.h"
+#include "graphics/surface.h"
+
+/**
+ * Graphics manager for the bench backend.
+ *
+ * Nothing is displayed, but unlike the null graphics manager the screen
+ * and overlay are real surfaces and every updateScreen() converts the
+ * visible one into a 32bpp output surface, which is roughly the work a
+ * software renderer does before handing a frame to the video driver.
+ */
+class BenchGraphicsManager : public GraphicsManager {
+public:
+	/**
+	 * Notified around every updateScreen(), which marks the end of a
+	 * frame for the bench backend.
+	 */
+	class FrameListener {
+	public:
+		virtual ~FrameListener() {}
+		virtual void beginUpdate() = 0;
+		virtual void endUpdate() = 0;
+	};
+
+	BenchGraphicsManager(FrameListener *listener);
+	virtual ~BenchGraphicsManager();
+
+	bool hasFeature(OSystem::Feature f) const override { return false; }
+	void setFeatureState(OSystem::Feature f, bool enable) override {}
+	bool getFeatureState(OSystem::Feature f) const override { return false; }
+
+	Graphics::PixelFormat getScreenFormat() const override { return _screen.format; }
+	Common::List<Graphics::PixelFormat> getSupportedFormats() const override;
+
+	void initSize(uint width, uint height, const Graphics::PixelFormat *format = NULL) override;
+	int getScreenChangeID() const override { return _screenChangeID; }
+
+	void beginGFXTransaction() override {}
+	OSystem::TransactionError endGFXTransaction() override { return OSystem::kTransactionSuccess; }
+
+	int16 getHeight() const override { return _screen.h; }
+	int16 getWidth() const override { return _screen.w; }
+	void setPalette(const byte *colors, uint start, uint num) override;
+	void grabPalette(byte *colors, uint start, uint num) const override;
+	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override;
+	Graphics::Surface *lockScreen() override { return &_screen; }
+	void unlockScreen() override {}
+	void fillScreen(uint32 col) override;
+	void updateScreen() override;
+	void setShakePos(int shakeXOffset, int shakeYOffset) override {}
+	void setFocusRectangle(const Common::Rect& rect) override {}
+	void clearFocusRectangle() override {}
+
+	void showOverlay() override { _overlayVisible = true; }
+	void hideOverlay() override { _overlayVisible = false; }
+	bool isOverlayVisible() const override { return _overlayVisible; }
+	Graphics::PixelFormat getOverlayFormat() const override { return _overlay.format; }
+	void clearOverlay() override;
+	void grabOverlay(void *buf, int pitch) const override;
+	void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) override;
+	int16 getOverlayHeight() const override { return _overlay.h; }
+	int16 getOverlayWidth() const override { return _overlay.w; }
+
+	bool showMouse(bool visible) override;
+	void warpMouse(int x, int y) override {}
+	void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale = false, const Graphics::PixelFormat *format = NULL) override {}
+	void setCursorPalette(const byte *colors, uint start, uint num) override {}
+
+private:
+	FrameListener *_listener;
+
+	Graphics::Surface _screen;
+	Graphics::Surface _overlay;
+	Graphics::Surface _output;
+	int _screenChangeID;
+	bool _overlayVisible;
+	bool _mouseVisible;
+
+	byte _palette[256 * 3];
+	uint32 _paletteMap[256];
+};
+
+#endif
@@ -26,6 +26,7 @@
 #include "common/system.h"
 #include "common/noncopyable.h"
 #include "common/keyboard.h"
+#include "common/rect.h"
 
 #include "graphics/mode.h"
 #include "graphics/palette.h"
@@ -81,6 +82,11 @@ public:
 	virtual void setPalette(const byte *colors, uint start, uint num) = 0;
 	virtual void grabPalette(byte *colors, uint start, uint num) const = 0;
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) = 0;
+	virtual void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint numRects) {
+		// The default of OSystem copies rectangle by rectangle, through the
+		// copyRectToScreen() of the backend owning this manager
+		g_system->OSystem::copyRectsToScreen(buf, pitch, rects, numRects);
+	}
 	virtual Graphics::Surface *lockScreen() = 0;
 	virtual void unlockScreen() = 0;
 	virtual void fillScreen(uint32 col) = 0;
@@ -157,6 +157,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_cursorFormat(Graphics::PixelFormat::createFormatCLUT8()),
 	_overlayscreen(0), _tmpscreen2(0),
 	_scalerProc(0), _screenChangeCount(0),
+	_bandScalerProc(0), _bandSrcPitch(0), _bandDstPitch(0),
 	_mouseData(nullptr), _mouseSurface(nullptr),
 	_mouseOrigSurface(nullptr), _cursorDontScale(false), _cursorPaletteDisabled(true),
 	_currentShakeXOffset(0), _currentShakeYOffset(0),
@@ -1282,8 +1283,8 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 					dst_y = real2Aspect(dst_y);
 
 				assert(scalerProc != NULL);
-				scalerProc((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
-					(byte *)_hwScreen->pixels + dst_x * 2 + dst_y * dstPitch, dstPitch, dst_w, dst_h);
+				addScalerBands((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch,
+					(byte *)_hwScreen->pixels + dst_x * 2 + dst_y * dstPitch, dst_w, dst_h, scale1, srcPitch, dstPitch);
 			}
 
 			r->x = dst_x;
@@ -1292,10 +1293,15 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 			r->h = dst_h * scale1;
 
 #ifdef USE_SCALERS
-			if (_videoMode.aspectRatioCorrection && orig_dst_y < height && !_overlayVisible)
+			if (_videoMode.aspectRatioCorrection && orig_dst_y < height && !_overlayVisible) {
+				// The stretching works in place, so the rect has to be
+				// scaled first. Rects may overlap, hence keep their order.
+				scaleBands(scalerProc, srcPitch, dstPitch);
 				r->h = stretch200To240((uint8 *) _hwScreen->pixels, dstPitch, r->w, r->h, r->x, r->y, orig_dst_y * scale1, _videoMode.filtering);
+			}
 #endif
 		}
+		scaleBands(scalerProc, srcPitch, dstPitch);
 		SDL_UnlockSurface(srcSurf);
 		SDL_UnlockSurface(_hwScreen);
 
@@ -1402,6 +1408,54 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	_cursorNeedsRedraw = false;
 }
 
+void SurfaceSdlGraphicsManager::addScalerBands(const byte *src, byte *dst, int width, int height, int scale, uint32 srcPitch, uint32 dstPitch) {
+	for (int y = 0; y < height;) {
+		// Scale2x and Scale3x need at least two rows
+		int bandHeight = MIN<int>(kScalerBandHeight, height - y);
+		if (height - y - bandHeight < 2)
+			bandHeight = height - y;
+
+		ScalerBand band;
+		band.src = src + y * srcPitch;
+		band.dst = dst + y * scale * dstPitch;
+		band.width = width;
+		band.height = bandHeight;
+		_scalerBands.push_back(band);
+
+		y += bandHeight;
+	}
+}
+
+void SurfaceSdlGraphicsManager::scaleBands(ScalerProc *scalerProc, uint32 srcPitch, uint32 dstPitch) {
+	if (_scalerBands.empty())
+		return;
+
+	// Overlapping rects make bands write the same pixels, but always with
+	// the same values since the output only depends on the source.
+	_bandScalerProc = scalerProc;
+	_bandSrcPitch = srcPitch;
+	_bandDstPitch = dstPitch;
+
+	uint pixels = 0;
+	for (uint i = 0; i < _scalerBands.size(); ++i)
+		pixels += _scalerBands[i].width * _scalerBands[i].height;
+
+	if (pixels >= kMinParallelScalerPixels && isScalerReentrant(scalerProc)) {
+		_scalerPool.run(scaleBand, this, _scalerBands.size());
+	} else {
+		for (uint i = 0; i < _scalerBands.size(); ++i)
+			scaleBand(this, i);
+	}
+
+	_scalerBands.clear();
+}
+
+void SurfaceSdlGraphicsManager::scaleBand(void *param, uint job) {
+	const SurfaceSdlGraphicsManager *manager = (const SurfaceSdlGraphicsManager *)param;
+	const ScalerBand &band = manager->_scalerBands[job];
+	manager->_bandScalerProc(band.src, manager->_bandSrcPitch, band.dst, manager->_bandDstPitch, band.width, band.height);
+}
+
 bool SurfaceSdlGraphicsManager::saveScreenshot(const Common::String &filename) const {
 	assert(_hwScreen != NULL);
 
@@ -1484,6 +1538,42 @@ void SurfaceSdlGraphicsManager::copyRectToScreen(const void *buf, int pitch, int
 
 	Common::StackLock lock(_graphicsMutex);	// Lock the mutex until this function ends
 
+	// Try to lock the screen surface
+	if (SDL_LockSurface(_screen) == -1)
+		error("SDL_LockSurface failed: %s", SDL_GetError());
+
+	copyRectToLockedScreen((const byte *)buf, pitch, x, y, w, h);
+
+	// Unlock the screen surface
+	SDL_UnlockSurface(_screen);
+}
+
+void SurfaceSdlGraphicsManager::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint numRects) {
+	assert(_transactionMode == kTransactionNone);
+	assert(buf);
+
+	if (_screen == NULL) {
+		warning("SurfaceSdlGraphicsManager::copyRectsToScreen: _screen == NULL");
+		return;
+	}
+
+	Common::StackLock lock(_graphicsMutex);	// Lock the mutex until this function ends
+
+	// Lock the screen surface once for the whole batch
+	if (SDL_LockSurface(_screen) == -1)
+		error("SDL_LockSurface failed: %s", SDL_GetError());
+
+	for (uint i = 0; i < numRects; ++i) {
+		const Common::Rect &r = rects[i];
+		const byte *src = (const byte *)buf + r.top * pitch + r.left * _screenFormat.bytesPerPixel;
+		copyRectToLockedScreen(src, pitch, r.left, r.top, r.width(), r.height());
+	}
+
+	// Unlock the screen surface
+	SDL_UnlockSurface(_screen);
+}
+
+void SurfaceSdlGraphicsManager::copyRectToLockedScreen(const byte *src, int pitch, int x, int y, int w, int h) {
 	assert(x >= 0 && x < _videoMode.screenWidth);
 	assert(y >= 0 && y < _videoMode.screenHeight);
 	assert(h > 0 && y + h <= _videoMode.screenHeight);
@@ -1491,24 +1581,16 @@ void SurfaceSdlGraphicsManager::copyRectToScreen(const void *buf, int pitch, int
 
 	addDirtyRect(x, y, w, h);
 
-	// Try to lock the screen surface
-	if (SDL_LockSurface(_screen) == -1)
-		error("SDL_LockSurface failed: %s", SDL_GetError());
-
 	byte *dst = (byte *)_screen->pixels + y * _screen->pitch + x * _screenFormat.bytesPerPixel;
 	if (_videoMode.screenWidth == w && pitch == _screen->pitch) {
-		memcpy(dst, buf, h*pitch);
+		memcpy(dst, src, h*pitch);
 	} else {
-		const byte *src = (const byte *)buf;
 		do {
 			memcpy(dst, src, w * _screenFormat.bytesPerPixel);
 			src += pitch;
 			dst += _screen->pitch;
 		} while (--h);
 	}
-
-	// Unlock the screen surface
-	SDL_UnlockSurface(_screen);
 }
 
 Graphics::Surface *SurfaceSdlGraphicsManager::lockScreen() {
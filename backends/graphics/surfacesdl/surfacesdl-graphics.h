@@ -27,8 +27,10 @@
 #include "backends/graphics/sdl/sdl-graphics.h"
 #include "graphics/pixelformat.h"
 #include "graphics/scaler.h"
+#include "common/array.h"
 #include "common/events.h"
 #include "common/mutex.h"
+#include "common/workerpool.h"
 
 #include "backends/events/sdl/sdl-events.h"
 
@@ -116,6 +118,7 @@ protected:
 	Graphics::PixelFormat convertSDLPixelFormat(SDL_PixelFormat *in) const;
 public:
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override;
+	virtual void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint numRects) override;
 	virtual Graphics::Surface *lockScreen() override;
 	virtual void unlockScreen() override;
 	virtual void fillScreen(uint32 col) override;
@@ -342,6 +345,36 @@ protected:
 
 	// Dirty rect management
 	SDL_Rect _dirtyRectList[NUM_DIRTY_RECT];
+
+	/**
+	 * A horizontal band of a dirty rect. Bands only write their own rows of
+	 * the hardware screen and only read the temporary screen, so they are
+	 * scaled in parallel unless the scaler is not reentrant.
+	 */
+	struct ScalerBand {
+		const byte *src;
+		byte *dst;
+		int width;
+		int height;
+	};
+
+	enum {
+		/** Source rows per band */
+		kScalerBandHeight = 16,
+		/** Batches with fewer source pixels are not worth waking up the workers */
+		kMinParallelScalerPixels = 320 * 48
+	};
+
+	Common::WorkerPool _scalerPool;
+	Common::Array<ScalerBand> _scalerBands;
+	ScalerProc *_bandScalerProc;
+	uint32 _bandSrcPitch, _bandDstPitch;
+
+	/** Queue the bands of a rect for scaleBands() */
+	void addScalerBands(const byte *src, byte *dst, int width, int height, int scale, uint32 srcPitch, uint32 dstPitch);
+	/** Scale the queued bands and wait for them */
+	void scaleBands(ScalerProc *scalerProc, uint32 srcPitch, uint32 dstPitch);
+	static void scaleBand(void *param, uint job);
 	int _numDirtyRects;
 
 	struct MousePos {
@@ -407,6 +440,9 @@ protected:
 
 	virtual void addDirtyRect(int x, int y, int w, int h, bool realCoordinates = false);
 
+	/** Copy a rectangle to _screen, which the caller has locked. */
+	void copyRectToLockedScreen(const byte *src, int pitch, int x, int y, int w, int h);
+
 	virtual void drawMouse();
 	virtual void undrawMouse();
 	virtual void blitCursor();
@@ -0,0 +1,65 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "backends/mixer/bench/bench-mixer.h"
+
+BenchMixerManager::BenchMixerManager() : MixerManager(), _samplesMixed(0) {
+	_samplesBuf = new uint8[kSamples * 4];
+}
+
+BenchMixerManager::~BenchMixerManager() {
+	delete[] _samplesBuf;
+}
+
+void BenchMixerManager::init() {
+	_mixer = new Audio::MixerImpl(kOutputRate);
+	assert(_mixer);
+	_mixer->setReady(true);
+}
+
+void BenchMixerManager::suspendAudio() {
+	_audioSuspended = true;
+}
+
+int BenchMixerManager::resumeAudio() {
+	if (!_audioSuspended) {
+		return -2;
+	}
+	_audioSuspended = false;
+	return 0;
+}
+
+void BenchMixerManager::update(uint32 millis) {
+	const uint64 due = (uint64)millis * kOutputRate / 1000;
+
+	// Time spent suspended is skipped rather than caught up with
+	if (_audioSuspended || due < _samplesMixed) {
+		_samplesMixed = due;
+		return;
+	}
+
+	assert(_mixer);
+	while (_samplesMixed + kSamples <= due) {
+		_mixer->mixCallback(_samplesBuf, kSamples * 4);
+		_samplesMixed += kSamples;
+	}
+}
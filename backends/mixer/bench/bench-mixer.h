@@ -0,0 +1,60 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_MIXER_BENCH_H
+#define BACKENDS_MIXER_BENCH_H
+
+#include "backends/mixer/mixer.h"
+
+/**
+ * Audio mixer for the bench backend.
+ *
+ * Nothing is output, but the mixer is driven in lockstep with the
+ * backend's virtual clock, so the mixing work done for a run does not
+ * depend on how fast the host is.
+ */
+class BenchMixerManager : public MixerManager {
+public:
+	BenchMixerManager();
+	virtual ~BenchMixerManager();
+
+	virtual void init();
+
+	/**
+	 * Mix all samples which are due at @p millis of virtual time.
+	 */
+	void update(uint32 millis);
+
+	virtual void suspendAudio();
+	virtual int resumeAudio();
+
+private:
+	enum {
+		kOutputRate = 44100,
+		kSamples = 1024
+	};
+
+	uint64 _samplesMixed;
+	uint8 *_samplesBuf;
+};
+
+#endif
@@ -29,6 +29,7 @@
 #include "backends/mutex/mutex.h"
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/timer.h"
 #include "graphics/pixelformat.h"
 #include "graphics/pixelbuffer.h"
@@ -161,6 +162,10 @@ void ModularGraphicsBackend::copyRectToScreen(const void *buf, int pitch, int x,
 	_graphicsManager->copyRectToScreen(buf, pitch, x, y, w, h);
 }
 
+void ModularGraphicsBackend::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint numRects) {
+	_graphicsManager->copyRectsToScreen(buf, pitch, rects, numRects);
+}
+
 Graphics::Surface *ModularGraphicsBackend::lockScreen() {
 	return _graphicsManager->lockScreen();
 }
@@ -174,6 +179,8 @@ void ModularGraphicsBackend::fillScreen(uint32 col) {
 }
 
 void ModularGraphicsBackend::updateScreen() {
+	PROFILE_ZONE("OSystem::updateScreen");
+
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.preDrawOverlayGui();
 #endif
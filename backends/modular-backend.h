@@ -92,6 +92,7 @@ public:
 	virtual int16 getWidth() override final;
 	virtual PaletteManager *getPaletteManager() override final;
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override final;
+	virtual void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint numRects) override final;
 	virtual Graphics::Surface *lockScreen() override final;
 	virtual void unlockScreen() override final;
 	virtual void fillScreen(uint32 col) override final;
@@ -239,6 +239,12 @@ MODULE_OBJS += \
 	events/androidsdl/androidsdl-events.o
 endif
 
+ifeq ($(BACKEND),bench)
+MODULE_OBJS += \
+	graphics/bench/bench-graphics.o \
+	mixer/bench/bench-mixer.o
+endif
+
 ifdef AMIGAOS
 MODULE_OBJS += \
 	fs/amigaos4/amigaos4-fs.o \
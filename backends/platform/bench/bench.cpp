@@ -0,0 +1,445 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <time.h>
+#ifdef POSIX
+#include <signal.h>
+#endif
+
+// We use some stdio.h functionality here thus we need to allow some
+// symbols. Alternatively, we could simply allow everything by defining
+// FORBIDDEN_SYMBOL_ALLOW_ALL
+#define FORBIDDEN_SYMBOL_EXCEPTION_FILE
+#define FORBIDDEN_SYMBOL_EXCEPTION_stdout
+#define FORBIDDEN_SYMBOL_EXCEPTION_stderr
+#define FORBIDDEN_SYMBOL_EXCEPTION_fputs
+#define FORBIDDEN_SYMBOL_EXCEPTION_exit
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+
+#include "backends/modular-backend.h"
+#include "base/main.h"
+
+#if defined(USE_BENCH_DRIVER)
+#include "backends/saves/default/default-saves.h"
+#include "backends/timer/default/default-timer.h"
+#include "backends/events/default/default-events.h"
+#include "backends/mixer/bench/bench-mixer.h"
+#include "backends/mutex/null/null-mutex.h"
+#include "backends/graphics/bench/bench-graphics.h"
+#include "common/array.h"
+#include "common/config-manager.h"
+#include "common/file.h"
+#include "common/fs.h"
+#include "common/scummsys.h"
+#include "gui/debugger.h"
+#include "gui/EventRecorder.h"
+
+/*
+ * Include header files needed for the getFilesystemFactory() method.
+ */
+#if defined(__amigaos4__)
+	#include "backends/fs/amigaos4/amigaos4-fs-factory.h"
+#elif defined(__MORPHOS__)
+	#include "backends/fs/morphos/morphos-fs-factory.h"
+#elif defined(POSIX)
+	#include "backends/fs/posix/posix-fs-factory.h"
+#elif defined(RISCOS)
+	#include "backends/fs/riscos/riscos-fs-factory.h"
+#elif defined(WIN32)
+	#include "backends/fs/windows/windows-fs-factory.h"
+#endif
+
+/**
+ * Headless backend for reproducible performance measurements.
+ *
+ * Time is virtual: delayMillis() advances the clock instead of sleeping,
+ * so a game runs as fast as the host allows, and timers and the mixer
+ * are driven from that clock. Combined with event recorder playback
+ * this replays a session deterministically, frame for frame.
+ *
+ * Every updateScreen() ends a frame. For each frame the CPU time spent
+ * in the engine, in the graphics update and in the audio and timer
+ * callbacks is recorded, and written as CSV or JSON on exit.
+ */
+class OSystem_Bench : public ModularMutexBackend, public ModularMixerBackend, public ModularGraphicsBackend, Common::EventSource, BenchGraphicsManager::FrameListener {
+public:
+	OSystem_Bench();
+	virtual ~OSystem_Bench();
+
+	virtual void initBackend();
+
+	virtual bool hasFeature(Feature f);
+
+	virtual bool pollEvent(Common::Event &event);
+
+	virtual uint32 getMillis(bool skipRecord = false);
+	virtual void delayMillis(uint msecs);
+	virtual void getTimeAndDate(TimeDate &t) const;
+
+	virtual MixerManager *getMixerManager();
+	virtual Common::TimerManager *getTimerManager();
+	virtual Common::SaveFileManager *getSavefileManager();
+
+	virtual void quit();
+	virtual void fatalError();
+
+	virtual void logMessage(LogMessageType::Type type, const char *message);
+
+	virtual void beginUpdate();
+	virtual void endUpdate();
+
+	/**
+	 * Write the collected frame timings, once.
+	 */
+	void writeReport();
+
+private:
+	struct Frame {
+		uint32 millis;
+		uint32 engineMicros;
+		uint32 graphicsMicros;
+		uint32 audioMicros;
+	};
+
+	static uint64 getCpuMicros();
+
+	bool isRecorderActive() const;
+	void updateSubsystems();
+
+	uint32 _virtualMillis;
+
+	uint64 _frameStart;
+	uint64 _updateStart;
+	uint32 _frameAudioMicros;
+	Common::Array<Frame> _frames;
+	int _maxFrames;
+	Common::String _reportPath;
+	bool _reportWritten;
+};
+
+OSystem_Bench::OSystem_Bench()
+	: _virtualMillis(0), _frameStart(0), _updateStart(0), _frameAudioMicros(0),
+	  _maxFrames(0), _reportWritten(false) {
+	#if defined(__amigaos4__)
+		_fsFactory = new AmigaOSFilesystemFactory();
+	#elif defined(__MORPHOS__)
+		_fsFactory = new MorphOSFilesystemFactory();
+	#elif defined(POSIX)
+		_fsFactory = new POSIXFilesystemFactory();
+	#elif defined(RISCOS)
+		_fsFactory = new RISCOSFilesystemFactory();
+	#elif defined(WIN32)
+		_fsFactory = new WindowsFilesystemFactory();
+	#else
+		#error Unknown and unsupported FS backend
+	#endif
+}
+
+OSystem_Bench::~OSystem_Bench() {
+	// The mixer has to go while the mutex manager is still usable
+	delete _mixerManager;
+	_mixerManager = 0;
+}
+
+#ifdef POSIX
+static volatile bool intReceived = false;
+
+static sighandler_t last_handler;
+
+static void intHandler(int dummy) {
+	signal(SIGINT, last_handler);
+	intReceived = true;
+}
+#endif
+
+void OSystem_Bench::initBackend() {
+#ifdef POSIX
+	last_handler = signal(SIGINT, intHandler);
+#endif
+
+	_mutexManager = new NullMutexManager();
+	_eventManager = new DefaultEventManager(this);
+	_savefileManager = new DefaultSaveFileManager();
+	_graphicsManager = new BenchGraphicsManager(this);
+	_mixerManager = new BenchMixerManager();
+	// Setup and start mixer
+	_mixerManager->init();
+
+#ifdef ENABLE_EVENTRECORDER
+	g_eventRec.registerMixerManager(_mixerManager);
+	g_eventRec.registerTimerManager(new DefaultTimerManager());
+#else
+	_timerManager = new DefaultTimerManager();
+#endif
+
+	// The command line has been parsed already, but the settings are
+	// gone by the time scummvm_main() returns
+	_maxFrames = ConfMan.getInt("bench_frames");
+	_reportPath = ConfMan.get("bench_report");
+	_frameStart = getCpuMicros();
+
+	BaseBackend::initBackend();
+}
+
+bool OSystem_Bench::hasFeature(Feature f) {
+	if (hasCpuFeature(f))
+		return true;
+	return ModularGraphicsBackend::hasFeature(f);
+}
+
+uint64 OSystem_Bench::getCpuMicros() {
+#if defined(POSIX) && defined(CLOCK_PROCESS_CPUTIME_ID)
+	timespec ts;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+	return (uint64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+	return (uint64)clock() * 1000000 / CLOCKS_PER_SEC;
+#endif
+}
+
+bool OSystem_Bench::isRecorderActive() const {
+#ifdef ENABLE_EVENTRECORDER
+	return g_eventRec.getRecordMode() != GUI::EventRecorder::kPassthrough;
+#else
+	return false;
+#endif
+}
+
+void OSystem_Bench::updateSubsystems() {
+	// While recording or playing back, the recorder drives timers and
+	// mixer from the recorded clock itself
+	if (isRecorderActive())
+		return;
+
+	const uint64 start = getCpuMicros();
+	((DefaultTimerManager *)getTimerManager())->checkTimers();
+	((BenchMixerManager *)_mixerManager)->update(_virtualMillis);
+	_frameAudioMicros += getCpuMicros() - start;
+}
+
+bool OSystem_Bench::pollEvent(Common::Event &event) {
+	updateSubsystems();
+
+#ifdef POSIX
+	if (intReceived) {
+		intReceived = false;
+
+#ifdef USE_TEXT_CONSOLE_FOR_DEBUGGER
+		GUI::Debugger *debugger = g_engine ? g_engine->getOrCreateDebugger() : nullptr;
+		if (debugger && !debugger->isActive()) {
+			last_handler = signal(SIGINT, intHandler);
+			event.type = Common::EVENT_DEBUGGER;
+			return true;
+		}
+#endif
+
+		event.type = Common::EVENT_QUIT;
+		return true;
+	}
+#endif
+
+	if (_maxFrames > 0 && _frames.size() >= (uint)_maxFrames) {
+		// Only ask once, the event sources are drained until they run dry
+		_maxFrames = 0;
+		event.type = Common::EVENT_QUIT;
+		return true;
+	}
+
+	// Let loops which poll until some time has passed make progress
+	++_virtualMillis;
+	return false;
+}
+
+uint32 OSystem_Bench::getMillis(bool skipRecord) {
+	uint32 millis = _virtualMillis;
+
+#ifdef ENABLE_EVENTRECORDER
+	// During playback the recorder runs the timers and the mixer in here
+	if (isRecorderActive()) {
+		const uint64 start = getCpuMicros();
+		g_eventRec.processMillis(millis, skipRecord);
+		_frameAudioMicros += getCpuMicros() - start;
+	}
+#endif
+
+	return millis;
+}
+
+void OSystem_Bench::delayMillis(uint msecs) {
+	_virtualMillis += msecs;
+	updateSubsystems();
+}
+
+void OSystem_Bench::getTimeAndDate(TimeDate &td) const {
+	time_t curTime = time(0);
+	struct tm t = *localtime(&curTime);
+	td.tm_sec = t.tm_sec;
+	td.tm_min = t.tm_min;
+	td.tm_hour = t.tm_hour;
+	td.tm_mday = t.tm_mday;
+	td.tm_mon = t.tm_mon;
+	td.tm_year = t.tm_year;
+	td.tm_wday = t.tm_wday;
+}
+
+MixerManager *OSystem_Bench::getMixerManager() {
+	assert(_mixerManager);
+
+#ifdef ENABLE_EVENTRECORDER
+	return g_eventRec.getMixerManager();
+#else
+	return _mixerManager;
+#endif
+}
+
+Common::TimerManager *OSystem_Bench::getTimerManager() {
+#ifdef ENABLE_EVENTRECORDER
+	return g_eventRec.getTimerManager();
+#else
+	return _timerManager;
+#endif
+}
+
+Common::SaveFileManager *OSystem_Bench::getSavefileManager() {
+#ifdef ENABLE_EVENTRECORDER
+	return g_eventRec.getSaveManager(_savefileManager);
+#else
+	return _savefileManager;
+#endif
+}
+
+void OSystem_Bench::beginUpdate() {
+	_updateStart = getCpuMicros();
+}
+
+void OSystem_Bench::endUpdate() {
+	const uint64 end = getCpuMicros();
+	const uint64 engineMicros = _updateStart - _frameStart;
+
+	Frame frame;
+	frame.millis = _virtualMillis;
+	frame.graphicsMicros = end - _updateStart;
+	frame.audioMicros = _frameAudioMicros;
+	frame.engineMicros = engineMicros > _frameAudioMicros ? engineMicros - _frameAudioMicros : 0;
+	_frames.push_back(frame);
+
+	_frameAudioMicros = 0;
+	_frameStart = end;
+}
+
+void OSystem_Bench::writeReport() {
+	if (_reportWritten)
+		return;
+	_reportWritten = true;
+
+	uint64 engineMicros = 0, graphicsMicros = 0, audioMicros = 0;
+	for (uint i = 0; i < _frames.size(); ++i) {
+		engineMicros += _frames[i].engineMicros;
+		graphicsMicros += _frames[i].graphicsMicros;
+		audioMicros += _frames[i].audioMicros;
+	}
+
+	const uint count = MAX<uint>(_frames.size(), 1);
+	logMessage(LogMessageType::kInfo, Common::String::format(
+		"bench: %u frames in %u ms, per frame: engine %u us, graphics %u us, audio %u us\n",
+		_frames.size(), _virtualMillis, (uint)(engineMicros / count), (uint)(graphicsMicros / count), (uint)(audioMicros / count)).c_str());
+
+	if (_reportPath.empty())
+		return;
+
+	Common::DumpFile out;
+	if (!out.open(Common::FSNode(_reportPath))) {
+		logMessage(LogMessageType::kWarning, Common::String::format("bench: Could not write report to '%s'\n", _reportPath.c_str()).c_str());
+		return;
+	}
+
+	if (_reportPath.hasSuffixIgnoreCase(".csv")) {
+		out.writeString("frame,time_ms,engine_us,graphics_us,audio_us\n");
+		for (uint i = 0; i < _frames.size(); ++i) {
+			const Frame &frame = _frames[i];
+			out.writeString(Common::String::format("%u,%u,%u,%u,%u\n", i, frame.millis,
+				frame.engineMicros, frame.graphicsMicros, frame.audioMicros));
+		}
+	} else {
+		out.writeString("{\n");
+		out.writeString(Common::String::format("\t\"frames\": %u,\n\t\"time_ms\": %u,\n", _frames.size(), _virtualMillis));
+		out.writeString(Common::String::format("\t\"engine_us\": %u,\n\t\"graphics_us\": %u,\n\t\"audio_us\": %u,\n",
+			(uint)engineMicros, (uint)graphicsMicros, (uint)audioMicros));
+		out.writeString("\t\"frame_times\": [");
+		for (uint i = 0; i < _frames.size(); ++i) {
+			const Frame &frame = _frames[i];
+			out.writeString(Common::String::format("%s\n\t\t{\"time_ms\": %u, \"engine_us\": %u, \"graphics_us\": %u, \"audio_us\": %u}",
+				i ? "," : "", frame.millis, frame.engineMicros, frame.graphicsMicros, frame.audioMicros));
+		}
+		out.writeString("\n\t]\n}\n");
+	}
+
+	out.finalize();
+	out.close();
+}
+
+void OSystem_Bench::quit() {
+	writeReport();
+	exit(0);
+}
+
+void OSystem_Bench::fatalError() {
+	// Playback ends with an error() once the recording is exhausted, the
+	// timings are still wanted then
+	writeReport();
+	exit(1);
+}
+
+void OSystem_Bench::logMessage(LogMessageType::Type type, const char *message) {
+	FILE *output = 0;
+
+	if (type == LogMessageType::kInfo || type == LogMessageType::kDebug)
+		output = stdout;
+	else
+		output = stderr;
+
+	fputs(message, output);
+	fflush(output);
+}
+
+OSystem *OSystem_Bench_create() {
+	return new OSystem_Bench();
+}
+
+int main(int argc, char *argv[]) {
+	OSystem_Bench *system = new OSystem_Bench();
+	g_system = system;
+
+	// Invoke the actual ScummVM main entry point:
+	int res = scummvm_main(argc, argv);
+	system->writeReport();
+	g_system->destroy();
+	return res;
+}
+
+#else /* USE_BENCH_DRIVER */
+
+OSystem *OSystem_Bench_create() {
+	return NULL;
+}
+
+#endif
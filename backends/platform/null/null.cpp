@@ -73,6 +73,8 @@ public:
 
 	virtual void initBackend();
 
+	virtual bool hasFeature(Feature f);
+
 	virtual bool pollEvent(Common::Event &event);
 
 	virtual uint32 getMillis(bool skipRecord = false);
@@ -138,6 +140,12 @@ void OSystem_NULL::initBackend() {
 	BaseBackend::initBackend();
 }
 
+bool OSystem_NULL::hasFeature(Feature f) {
+	if (hasCpuFeature(f))
+		return true;
+	return ModularGraphicsBackend::hasFeature(f);
+}
+
 bool OSystem_NULL::pollEvent(Common::Event &event) {
 	((DefaultTimerManager *)getTimerManager())->checkTimers();
 	((NullMixerManager *)_mixerManager)->update(1);
@@ -187,6 +187,15 @@ bool OSystem_SDL::hasFeature(Feature f) {
 	if (f == kFeatureJoystickDeadzone || f == kFeatureKbdMouseSpeed) {
 		return _eventSource->isJoystickConnected();
 	}
+#ifdef SCUMMVM_SSE2
+	if (f == kFeatureCpuSSE2) return SDL_HasSSE2();
+#endif
+#if defined(SCUMMVM_AVX2) && SDL_VERSION_ATLEAST(2, 0, 2)
+	if (f == kFeatureCpuAVX2) return SDL_HasAVX2();
+#endif
+#if defined(SCUMMVM_NEON) && SDL_VERSION_ATLEAST(2, 0, 6)
+	if (f == kFeatureCpuNEON) return SDL_HasNEON();
+#endif
 	return ModularGraphicsBackend::hasFeature(f);
 }
 
@@ -657,6 +666,48 @@ void OSystem_SDL::getTimeAndDate(TimeDate &td) const {
 	td.tm_wday = t.tm_wday;
 }
 
+OSystem::ThreadRef OSystem_SDL::createThread(ThreadProc proc, void *param) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	return (ThreadRef)SDL_CreateThread(proc, "ScummVM worker", param);
+#else
+	return (ThreadRef)SDL_CreateThread(proc, param);
+#endif
+}
+
+int OSystem_SDL::waitThread(ThreadRef thread) {
+	int status = 0;
+	SDL_WaitThread((SDL_Thread *)thread, &status);
+	return status;
+}
+
+uint OSystem_SDL::getCpuCount() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	return MAX(SDL_GetCPUCount(), 1);
+#else
+	return 1;
+#endif
+}
+
+OSystem::SemaphoreRef OSystem_SDL::createSemaphore(uint value) {
+	return (SemaphoreRef)SDL_CreateSemaphore(value);
+}
+
+void OSystem_SDL::waitSemaphore(SemaphoreRef sem) {
+	SDL_SemWait((SDL_sem *)sem);
+}
+
+bool OSystem_SDL::waitSemaphoreTimeout(SemaphoreRef sem, uint msecs) {
+	return SDL_SemWaitTimeout((SDL_sem *)sem, msecs) == 0;
+}
+
+void OSystem_SDL::postSemaphore(SemaphoreRef sem) {
+	SDL_SemPost((SDL_sem *)sem);
+}
+
+void OSystem_SDL::deleteSemaphore(SemaphoreRef sem) {
+	SDL_DestroySemaphore((SDL_sem *)sem);
+}
+
 MixerManager *OSystem_SDL::getMixerManager() {
 	assert(_mixerManager);
 
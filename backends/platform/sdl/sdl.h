@@ -83,6 +83,14 @@ public:
 	virtual uint32 getMillis(bool skipRecord = false) override;
 	virtual void delayMillis(uint msecs) override;
 	virtual void getTimeAndDate(TimeDate &td) const override;
+	virtual ThreadRef createThread(ThreadProc proc, void *param) override;
+	virtual int waitThread(ThreadRef thread) override;
+	virtual uint getCpuCount() override;
+	virtual SemaphoreRef createSemaphore(uint value) override;
+	virtual void waitSemaphore(SemaphoreRef sem) override;
+	virtual bool waitSemaphoreTimeout(SemaphoreRef sem, uint msecs) override;
+	virtual void postSemaphore(SemaphoreRef sem) override;
+	virtual void deleteSemaphore(SemaphoreRef sem) override;
 	virtual MixerManager *getMixerManager() override;
 	virtual Common::TimerManager *getTimerManager() override;
 	virtual Common::SaveFileManager *getSavefileManager() override;
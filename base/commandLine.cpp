@@ -132,6 +132,8 @@ static const char HELP_STRING[] =
 	"                           pce, segacd, wii, windows)\n"
 	"  --savepath=PATH          Path to where saved games are stored\n"
 	"  --extrapath=PATH         Extra path to additional game data\n"
+	"  --read-ahead=KIB         Load game files KIB ahead of reading on a background\n"
+	"                           thread (default: 0, disabled)\n"
 	"  --soundfont=FILE         Select the SoundFont for MIDI playback (only\n"
 	"                           supported by some MIDI drivers)\n"
 	"  --multi-midi             Enable combination AdLib and native MIDI\n"
@@ -163,6 +165,11 @@ static const char HELP_STRING[] =
 	"  --record-file-name=FILE  Specify record file name\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
+#endif
+#ifdef USE_BENCH_DRIVER
+	"  --bench-report=FILE      Write the frame timings of the bench backend to FILE,\n"
+	"                           as CSV if it ends in .csv and as JSON otherwise\n"
+	"  --bench-frames=NUM       Quit after NUM frames (default: 0, no limit)\n"
 #endif
 	"\n"
 #if defined(ENABLE_SKY) || defined(ENABLE_QUEEN)
@@ -302,11 +309,17 @@ void registerDefaults() {
 	ConfMan.registerDefault("joystick_num", 0);
 	ConfMan.registerDefault("confirm_exit", false);
 	ConfMan.registerDefault("disable_sdl_parachute", false);
+	ConfMan.registerDefault("read_ahead", 0);
 
 	ConfMan.registerDefault("disable_display", false);
 	ConfMan.registerDefault("record_mode", "none");
 	ConfMan.registerDefault("record_file_name", "record.bin");
 
+#ifdef USE_BENCH_DRIVER
+	ConfMan.registerDefault("bench_report", "");
+	ConfMan.registerDefault("bench_frames", 0);
+#endif
+
 	ConfMan.registerDefault("gui_saveload_chooser", "grid");
 	ConfMan.registerDefault("gui_saveload_last_pos", "0");
 
@@ -609,6 +622,14 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			END_OPTION
 #endif
 
+#ifdef USE_BENCH_DRIVER
+			DO_LONG_OPTION("bench-report")
+			END_OPTION
+
+			DO_LONG_OPTION_INT("bench-frames")
+			END_OPTION
+#endif
+
 			DO_LONG_OPTION("opl-driver")
 			END_OPTION
 
@@ -736,6 +757,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 				}
 			END_OPTION
 
+			DO_LONG_OPTION_INT("read-ahead")
+			END_OPTION
+
 			DO_LONG_OPTION_INT("talkspeed")
 			END_OPTION
 
@@ -47,6 +47,8 @@
 #ifdef ENABLE_EVENTRECORDER
 #include "common/recorderfile.h"
 #endif
+#include "common/readahead.h"
+#include "common/str-pool.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/tokenizer.h"
@@ -472,6 +474,9 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	// the command line params) was read.
 	system.initBackend();
 
+	// Game files on slow or network drives are loaded ahead on a thread
+	Common::setDefaultReadAheadSize(MAX(ConfMan.getInt("read_ahead"), 0) * 1024);
+
 	// If we received an invalid graphics mode parameter via command line
 	// we check this here. We can't do it until after the backend is inited,
 	// or there won't be a graphics manager to ask for the supported modes.
@@ -692,6 +697,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	GUI::EventRecorder::destroy();
 #endif
 	Common::SearchManager::destroy();
+	Common::shutdownReadAhead();
+	Common::StringPool::destroy();
 #ifdef USE_TRANSLATION
 	Common::TranslationManager::destroy();
 #endif
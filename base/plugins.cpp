@@ -616,6 +616,7 @@ void PluginManager::addToPluginsInMemList(Plugin *plugin) {
 
 // Engine plugins
 
+#include "engines/detectioncache.h"
 #include "engines/metaengine.h"
 
 namespace Common {
@@ -698,6 +699,10 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist) const
 		}
 	}
 
+	// Keep the checksums computed by the AdvancedDetector for the next run
+	DetectionCache::instance().flush();
+	DetectionCache::instance().releaseWorkerPool();
+
 	return DetectionResults(candidates);
 }
 
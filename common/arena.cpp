@@ -0,0 +1,144 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "common/arena.h"
+
+namespace Common {
+
+Arena::Arena(size_t blockSize)
+	: _blockSize(blockSize), _pool(blockSize), _current(0), _offset(0) {
+	assert(blockSize >= 256);
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+Arena::~Arena() {
+	releaseLarge(0);
+	for (uint i = 0; i < _blocks.size(); ++i)
+		_pool.freeChunk(_blocks[i]);
+}
+
+void *Arena::allocate(size_t size, size_t align) {
+	assert(align && (align & (align - 1)) == 0);
+
+	++_stats.allocations;
+	if (size > _blockSize / 4)
+		return allocateLarge(size, align);
+
+	for (;;) {
+		if (_current < _blocks.size()) {
+			byte *base = _blocks[_current];
+			size_t start = (((size_t)base + _offset + align - 1) & ~(align - 1)) - (size_t)base;
+			if (start + size <= _blockSize) {
+				_stats.bytesUsed += start + size - _offset;
+				_stats.peakBytesUsed = MAX(_stats.peakBytesUsed, _stats.bytesUsed);
+				_offset = start + size;
+				return base + start;
+			}
+
+			// The rest of the block is wasted, account for it so that
+			// bytesUsed drops back exactly on rewind.
+			_stats.bytesUsed += _blockSize - _offset;
+			++_current;
+			_offset = 0;
+			if (_current < _blocks.size())
+				continue;
+		}
+
+		_blocks.push_back((byte *)_pool.allocChunk());
+		_stats.bytesReserved += _blockSize;
+		_stats.blocks = _blocks.size();
+		_current = _blocks.size() - 1;
+		_offset = 0;
+	}
+}
+
+void *Arena::allocateLarge(size_t size, size_t align) {
+	size_t total = size + align - 1;
+	void *ptr = ::malloc(total);
+	assert(ptr);
+
+	_large.push_back(ptr);
+	_largeSizes.push_back(total);
+	++_stats.largeAllocations;
+	_stats.bytesReserved += total;
+	_stats.bytesUsed += total;
+	_stats.peakBytesUsed = MAX(_stats.peakBytesUsed, _stats.bytesUsed);
+
+	return (void *)(((size_t)ptr + align - 1) & ~(align - 1));
+}
+
+void Arena::releaseLarge(uint count) {
+	while (_large.size() > count) {
+		::free(_large.back());
+		_stats.bytesReserved -= _largeSizes.back();
+		_large.pop_back();
+		_largeSizes.pop_back();
+	}
+}
+
+char *Arena::copyString(const char *str) {
+	size_t len = strlen(str) + 1;
+	char *copy = (char *)allocate(len, 1);
+	memcpy(copy, str, len);
+	return copy;
+}
+
+Arena::Marker Arena::mark() const {
+	Marker marker;
+	marker.block = _current;
+	marker.offset = _offset;
+	marker.large = _large.size();
+	marker.bytesUsed = _stats.bytesUsed;
+	return marker;
+}
+
+void Arena::rewind(const Marker &marker) {
+	assert(marker.block <= _current && marker.large <= _large.size());
+	assert(marker.block < _current || marker.offset <= _offset);
+
+	releaseLarge(marker.large);
+	_current = marker.block;
+	_offset = marker.offset;
+	_stats.bytesUsed = marker.bytesUsed;
+	++_stats.resets;
+}
+
+void Arena::reset() {
+	releaseLarge(0);
+	_current = 0;
+	_offset = 0;
+	_stats.bytesUsed = 0;
+	++_stats.resets;
+}
+
+void Arena::freeUnusedBlocks() {
+	// The current block is kept when it holds live allocations
+	uint keep = (_offset || _current) ? _current + 1 : 0;
+	while (_blocks.size() > keep) {
+		_pool.freeChunk(_blocks.back());
+		_blocks.pop_back();
+		_stats.bytesReserved -= _blockSize;
+	}
+	_stats.blocks = _blocks.size();
+	_pool.freeUnusedPages();
+}
+
+} // End of namespace Common
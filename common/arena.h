@@ -0,0 +1,248 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef COMMON_ARENA_H
+#define COMMON_ARENA_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/memorypool.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_arena Arena allocator
+ * @ingroup common_memory
+ *
+ * @brief Bump allocator for short lived, per-frame or per-room data.
+ * @{
+ */
+
+/**
+ * An arena hands out memory by bumping a pointer through large blocks
+ * and frees everything at once, either completely with reset() or back
+ * to an earlier point with rewind() or an Arena::Scope.
+ *
+ * The blocks come from a MemoryPool, so a reset arena refills itself
+ * without touching malloc. Requests larger than a quarter of the block
+ * size are served by malloc directly and released on reset/rewind.
+ *
+ * Destructors are never run for memory taken from an arena, so it is
+ * meant for plain data: draw lists, temporary buffers, script values.
+ */
+class Arena {
+public:
+	enum {
+		kDefaultBlockSize = 16 * 1024,
+		kDefaultAlignment = 8
+	};
+
+	/** Allocation statistics, for tuning block sizes and spotting leaks. */
+	struct Stats {
+		size_t bytesUsed;       /*!< Bytes currently handed out, including padding. */
+		size_t peakBytesUsed;   /*!< Highest value of bytesUsed since construction. */
+		size_t bytesReserved;   /*!< Bytes held in blocks and large allocations. */
+		uint32 allocations;     /*!< Number of allocate() calls since construction. */
+		uint32 largeAllocations;/*!< Number of those which bypassed the blocks. */
+		uint32 blocks;          /*!< Number of blocks currently held. */
+		uint32 resets;          /*!< Number of reset() and rewind() calls. */
+	};
+
+	/** Position in the arena, as returned by mark(). */
+	struct Marker {
+		uint block;
+		size_t offset;
+		uint large;
+		size_t bytesUsed;
+	};
+
+	/**
+	 * Rewinds the arena to the point of its construction when it goes
+	 * out of scope.
+	 */
+	class Scope {
+	public:
+		explicit Scope(Arena &arena) : _arena(arena), _marker(arena.mark()) {}
+		~Scope() { _arena.rewind(_marker); }
+
+	private:
+		Scope(const Scope &);
+		Scope &operator=(const Scope &);
+
+		Arena &_arena;
+		Marker _marker;
+	};
+
+	explicit Arena(size_t blockSize = kDefaultBlockSize);
+	~Arena();
+
+	/**
+	 * Allocate @p size bytes aligned to @p align, which must be a power
+	 * of two. Never returns nullptr.
+	 */
+	void *allocate(size_t size, size_t align = kDefaultAlignment);
+
+	/** Allocate uninitialized storage for @p count objects of type T. */
+	template<class T>
+	T *allocateArray(size_t count) {
+		return (T *)allocate(sizeof(T) * count);
+	}
+
+	/** Copy a C string into the arena. */
+	char *copyString(const char *str);
+
+	/** Current position, to be passed to rewind(). */
+	Marker mark() const;
+
+	/**
+	 * Release everything allocated after @p marker was taken. The blocks
+	 * stay with the arena for reuse.
+	 */
+	void rewind(const Marker &marker);
+
+	/** Release all allocations. The blocks stay with the arena for reuse. */
+	void reset();
+
+	/**
+	 * Return blocks not in use to the pool and the pool's unused pages
+	 * to the system.
+	 */
+	void freeUnusedBlocks();
+
+	/** Size of the blocks small allocations are taken from. */
+	size_t getBlockSize() const { return _blockSize; }
+
+	const Stats &getStats() const { return _stats; }
+
+private:
+	Arena(const Arena &);
+	Arena &operator=(const Arena &);
+
+	void *allocateLarge(size_t size, size_t align);
+	void releaseLarge(uint count);
+
+	const size_t _blockSize;
+	MemoryPool _pool;
+	Array<byte *> _blocks;
+	uint _current;
+	size_t _offset;
+	Array<void *> _large;
+	Array<size_t> _largeSizes;
+	Stats _stats;
+};
+
+/**
+ * Growable array whose storage lives in an Arena. Growing copies the
+ * elements into a fresh, larger slice of the arena, the old slice is
+ * only reclaimed with the arena. Elements are copied bytewise and never
+ * destroyed, so T has to be a plain data type.
+ */
+template<class T>
+class ArenaArray {
+public:
+	typedef T *iterator;
+	typedef const T *const_iterator;
+	typedef T value_type;
+	typedef uint size_type;
+
+	explicit ArenaArray(Arena &arena, size_type capacity = 0)
+		: _arena(&arena), _storage(nullptr), _size(0), _capacity(0) {
+		if (capacity)
+			reserve(capacity);
+	}
+
+	void reserve(size_type capacity) {
+		if (capacity <= _capacity)
+			return;
+		T *storage = _arena->allocateArray<T>(capacity);
+		if (_size)
+			memcpy((void *)storage, (const void *)_storage, _size * sizeof(T));
+		_storage = storage;
+		_capacity = capacity;
+	}
+
+	void resize(size_type size) {
+		reserve(size);
+		_size = size;
+	}
+
+	void push_back(const T &value) {
+		if (_size == _capacity)
+			reserve(_capacity ? _capacity * 2 : 8);
+		_storage[_size++] = value;
+	}
+
+	void pop_back() {
+		assert(_size > 0);
+		--_size;
+	}
+
+	/** Forget the elements but keep the storage. */
+	void clear() { _size = 0; }
+
+	T &operator[](size_type idx) {
+		assert(idx < _size);
+		return _storage[idx];
+	}
+
+	const T &operator[](size_type idx) const {
+		assert(idx < _size);
+		return _storage[idx];
+	}
+
+	T &back() {
+		assert(_size > 0);
+		return _storage[_size - 1];
+	}
+
+	const T &back() const {
+		assert(_size > 0);
+		return _storage[_size - 1];
+	}
+
+	size_type size() const { return _size; }
+	size_type capacity() const { return _capacity; }
+	bool empty() const { return _size == 0; }
+
+	iterator begin() { return _storage; }
+	iterator end() { return _storage + _size; }
+	const_iterator begin() const { return _storage; }
+	const_iterator end() const { return _storage + _size; }
+
+private:
+	Arena *_arena;
+	T *_storage;
+	size_type _size;
+	size_type _capacity;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+inline void *operator new(size_t nbytes, Common::Arena &arena) {
+	return arena.allocate(nbytes);
+}
+
+inline void operator delete(void *, Common::Arena &) {
+}
+
+#endif
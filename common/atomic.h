@@ -0,0 +1,127 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_ATOMIC_H
+#define COMMON_ATOMIC_H
+
+#include "common/scummsys.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * Storage class specifier for variables with one instance per thread.
+ * Left undefined on compilers without support for it.
+ */
+#if defined(_MSC_VER)
+#define SCUMMVM_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define SCUMMVM_THREAD_LOCAL __thread
+#endif
+
+namespace Common {
+
+/**
+ * @defgroup common_atomic Atomic operations
+ * @ingroup common
+ *
+ * @brief Minimal set of atomic operations on 32-bit integers.
+ *
+ * These are meant for the few places where two threads (e.g. an engine
+ * thread and the audio callback) have to exchange data without one of
+ * them ever waiting on a mutex. Loads have acquire semantics, stores have
+ * release semantics and read-modify-write operations are full barriers.
+ *
+ * On compilers without atomic builtins the operations degrade to plain
+ * volatile accesses, which is only correct on single core targets.
+ * @{
+ */
+
+/**
+ * Atomically read the value stored at @p ptr.
+ */
+inline int32 atomicLoad(const volatile int32 *ptr) {
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+	return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+	int32 val = *ptr;
+	_ReadWriteBarrier();
+	return val;
+#else
+	return *ptr;
+#endif
+}
+
+/**
+ * Atomically store @p val at @p ptr.
+ */
+inline void atomicStore(volatile int32 *ptr, int32 val) {
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+	__atomic_store_n(ptr, val, __ATOMIC_RELEASE);
+#elif defined(_MSC_VER)
+	_ReadWriteBarrier();
+	*ptr = val;
+#else
+	*ptr = val;
+#endif
+}
+
+/**
+ * Atomically add @p val to the value stored at @p ptr.
+ *
+ * @return The new value.
+ */
+inline int32 atomicAdd(volatile int32 *ptr, int32 val) {
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+	return __atomic_add_fetch(ptr, val, __ATOMIC_SEQ_CST);
+#elif defined(_MSC_VER)
+	return _InterlockedExchangeAdd((volatile long *)ptr, val) + val;
+#else
+	return *ptr += val;
+#endif
+}
+
+/**
+ * Atomically replace the value at @p ptr with @p newVal if it is
+ * currently equal to @p expected.
+ *
+ * @return true if the value was replaced.
+ */
+inline bool atomicCompareExchange(volatile int32 *ptr, int32 expected, int32 newVal) {
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+	return __atomic_compare_exchange_n(ptr, &expected, newVal, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#elif defined(_MSC_VER)
+	return _InterlockedCompareExchange((volatile long *)ptr, newVal, expected) == expected;
+#else
+	if (*ptr != expected)
+		return false;
+	*ptr = newVal;
+	return true;
+#endif
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
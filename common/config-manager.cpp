@@ -403,7 +403,7 @@ ConfigManager::Domain *ConfigManager::getDomain(const String &domName) {
 #pragma mark -
 
 
-bool ConfigManager::hasKey(const String &key) const {
+bool ConfigManager::hasKey(const StringView &key) const {
 	// Search the domains in the following order:
 	// 1) the transient domain,
 	// 2) the active game domain (if any),
@@ -422,7 +422,7 @@ bool ConfigManager::hasKey(const String &key) const {
 	return false;
 }
 
-bool ConfigManager::hasKey(const String &key, const String &domName) const {
+bool ConfigManager::hasKey(const StringView &key, const String &domName) const {
 	// FIXME: For now we continue to allow empty domName to indicate
 	// "use 'default' domain". This is mainly needed for the SCUMM ConfigDialog
 	// and should be removed ASAP.
@@ -450,18 +450,20 @@ void ConfigManager::removeKey(const String &key, const String &domName) {
 #pragma mark -
 
 
-const String &ConfigManager::get(const String &key) const {
+const String &ConfigManager::get(const StringView &key) const {
+	// Keys are mostly literals, looking them up as views saves a String
+	// for every call
 	if (_transientDomain.contains(key))
-		return _transientDomain[key];
+		return _transientDomain.getVal(key);
 	else if (_activeDomain && _activeDomain->contains(key))
-		return (*_activeDomain)[key];
+		return _activeDomain->getVal(key);
 	else if (_appDomain.contains(key))
-		return _appDomain[key];
+		return _appDomain.getVal(key);
 
 	return _defaultsDomain.getVal(key);
 }
 
-const String &ConfigManager::get(const String &key, const String &domName) const {
+const String &ConfigManager::get(const StringView &key, const String &domName) const {
 	// FIXME: For now we continue to allow empty domName to indicate
 	// "use 'default' domain". This is mainly needed for the SCUMM ConfigDialog
 	// and should be removed ASAP.
@@ -472,15 +474,15 @@ const String &ConfigManager::get(const String &key, const String &domName) const
 
 	if (!domain)
 		error("ConfigManager::get(%s,%s) called on non-existent domain",
-		      key.c_str(), domName.c_str());
+		      String(key).c_str(), domName.c_str());
 
 	if (domain->contains(key))
-		return (*domain)[key];
+		return domain->getVal(key);
 
 	return _defaultsDomain.getVal(key);
 }
 
-int ConfigManager::getInt(const String &key, const String &domName) const {
+int ConfigManager::getInt(const StringView &key, const String &domName) const {
 	String value(get(key, domName));
 	char *errpos;
 
@@ -496,19 +498,19 @@ int ConfigManager::getInt(const String &key, const String &domName) const {
 	int ivalue = (int)strtol(value.c_str(), &errpos, 0);
 	if (value.c_str() == errpos)
 		error("ConfigManager::getInt(%s,%s): '%s' is not a valid integer",
-		      key.c_str(), domName.c_str(), errpos);
+		      String(key).c_str(), domName.c_str(), errpos);
 
 	return ivalue;
 }
 
-bool ConfigManager::getBool(const String &key, const String &domName) const {
+bool ConfigManager::getBool(const StringView &key, const String &domName) const {
 	String value(get(key, domName));
 	bool val;
 	if (parseBool(value, val))
 		return val;
 
 	error("ConfigManager::getBool(%s,%s): '%s' is not a valid bool",
-	      key.c_str(), domName.c_str(), value.c_str());
+	      String(key).c_str(), domName.c_str(), value.c_str());
 }
 
 
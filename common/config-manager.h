@@ -69,7 +69,7 @@ public:
 
 		bool           empty() const { return _entries.empty(); } /*!< Return true if the configuration is empty, i.e. has no [key, value] pairs, and false otherwise. */
 
-		bool           contains(const String &key) const { return _entries.contains(key); } /*!< Check whether the domain contains a @p key. */
+		bool           contains(const StringView &key) const { return _entries.containsAs(key); } /*!< Check whether the domain contains a @p key. */
         /** Return the configuration value for the given key.
 		 *  If no entry exists for the given key in the configuration, it is created.
 		 */
@@ -83,13 +83,13 @@ public:
 		void           setVal(const String &key, const String &value) { _entries.setVal(key, value); } /*!< Assign a @p value to a @p key. */
 
 		String        &getVal(const String &key) { return _entries.getVal(key); } /*!< Retrieve the value of a @p key. */
-		const String  &getVal(const String &key) const { return _entries.getVal(key); } /*!< @overload */
+		const String  &getVal(const StringView &key) const { return _entries.getValAs(key); } /*!< @overload */
          /**
           * Retrieve the value of @p key if it exists and leave the referenced variable unchanged if the key does not exist.
           * @return True if the key exists, false otherwise.
           * You can use this method if you frequently attempt to access keys that do not exist.
           */
-		bool          tryGetVal(const String &key, String &out) const { return _entries.tryGetVal(key, out); }
+		bool          tryGetVal(const StringView &key, String &out) const { return _entries.tryGetValAs(key, out); }
 
 		void           clear() { _entries.clear(); } /*!< Clear all configuration entries in the domain. */
 
@@ -139,8 +139,8 @@ public:
 	 * @{
 	 */
 
-	bool                     hasKey(const String &key) const; /*!< Check if a given @p key exists. */
-	const String            &get(const String &key) const;    /*!< Get the value of a @p key. */
+	bool                     hasKey(const StringView &key) const; /*!< Check if a given @p key exists. */
+	const String            &get(const StringView &key) const;    /*!< Get the value of a @p key. */
 	void                     set(const String &key, const String &value); /*!< Assign a @p value to a @p key. */
     /** @} */
 
@@ -161,8 +161,8 @@ public:
 	 * @{
 	 */
 
-	bool                     hasKey(const String &key, const String &domName) const; /*!< Check if a given @p key exists in the @p domName domain. */
-	const String            &get(const String &key, const String &domName) const; /*!< Get the value of a @p key from the @p domName domain. */
+	bool                     hasKey(const StringView &key, const String &domName) const; /*!< Check if a given @p key exists in the @p domName domain. */
+	const String            &get(const StringView &key, const String &domName) const; /*!< Get the value of a @p key from the @p domName domain. */
 	void                     set(const String &key, const String &value, const String &domName); /*!< Assign a @p value to a @p key in the @p domName domain. */
 
 	void                     removeKey(const String &key, const String &domName); /*!< Remove a @p key to a @p key from the @p domName domain. */
@@ -174,8 +174,8 @@ public:
 	 * @{
 	 */
 
-	int                      getInt(const String &key, const String &domName = String()) const; /*!< Get integer value. */
-	bool                     getBool(const String &key, const String &domName = String()) const; /*!< Get Boolean value. */
+	int                      getInt(const StringView &key, const String &domName = String()) const; /*!< Get integer value. */
+	bool                     getBool(const StringView &key, const String &domName = String()) const; /*!< Get Boolean value. */
 	void                     setInt(const String &key, int value, const String &domName = String()); /*!< Set integer value. */
 	void                     setBool(const String &key, bool value, const String &domName = String()); /*!< Set Boolean value. */
 
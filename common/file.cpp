@@ -24,6 +24,7 @@
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/profiler.h"
 #include "common/textconsole.h"
 #include "common/system.h"
 #include "backends/fs/fs-factory.h"
@@ -43,6 +44,7 @@ bool File::open(const String &filename) {
 }
 
 bool File::open(const String &filename, Archive &archive) {
+	PROFILE_ZONE("File::open");
 	assert(!filename.empty());
 	assert(!_handle);
 
@@ -138,7 +140,13 @@ bool File::seek(int32 offs, int whence) {
 	return _handle->seek(offs, whence);
 }
 
+void File::prefetch(int32 offset, uint32 size) {
+	assert(_handle);
+	_handle->prefetch(offset, size);
+}
+
 uint32 File::read(void *ptr, uint32 len) {
+	PROFILE_ZONE("File::read");
 	assert(_handle);
 	return _handle->read(ptr, len);
 }
@@ -134,6 +134,7 @@ public:
 	int32 size() const override; /*!< Implement abstract SeekableReadStream method. */
 	bool seek(int32 offs, int whence = SEEK_SET) override;	/*!< Implement abstract SeekableReadStream method. */
 	uint32 read(void *dataPtr, uint32 dataSize) override;	/*!< Implement abstract SeekableReadStream method. */
+	void prefetch(int32 offset, uint32 size) override;	/*!< Forwarded to the underlying stream. */
 };
 
 
@@ -0,0 +1,661 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// The flat hash map in this file follows the design of the SwissTable
+// family of hash tables: a separate array of one-byte control words is
+// probed a group at a time, and only slots whose control byte matches the
+// low bits of the hash are compared against the key.
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+#include "common/func.h"
+#include "common/math.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLATHASHMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Common {
+
+/**
+ * @defgroup common_flathashmap Flat hash table (FlatHashMap)
+ * @ingroup common
+ *
+ * @brief API for operations on an open addressing hash table.
+ *
+ * @{
+ */
+
+/**
+ * FlatHashMap<Key,Val> is a drop-in alternative to HashMap<Key,Val> that
+ * stores keys and values inline in a single slot array instead of
+ * allocating a node per entry. Lookups therefore do not chase pointers,
+ * which makes it the better choice for hot lookups of small keys and
+ * values (integers, short strings, pointers).
+ *
+ * Each slot has a control byte which is either empty, deleted, or holds
+ * seven bits of the key's hash. Lookups compare the control bytes of a
+ * whole group of slots at once (using SSE2 where the compiler targets it)
+ * and only compare keys for slots whose hash bits match.
+ *
+ * The public interface matches HashMap, with two differences to keep in
+ * mind: inserting into the map may move existing entries, so references
+ * to values and iterators are invalidated by any insertion, and iteration
+ * order differs from HashMap.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+private:
+
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	struct Node {
+		Val _value;
+		const Key _key;
+		explicit Node(const Key &key) : _value(), _key(key) {}
+	};
+
+	enum {
+		FLATHASHMAP_GROUP_WIDTH = 16,
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// The quotient of the next two constants controls how much the
+		// slot array may fill up (counting deleted slots) before it is
+		// rehashed. Group probing keeps lookups short even at high load.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 7,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 8
+	};
+
+	/** Control byte values; full slots store a value from 0 to 127. */
+	enum {
+		kCtrlEmpty = -128,
+		kCtrlDeleted = -2
+	};
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	/**
+	 * One control byte per slot, followed by a copy of the first
+	 * GROUP_WIDTH - 1 control bytes so that a group can be loaded
+	 * starting at any slot without wrapping around.
+	 */
+	int8 *_ctrl;
+	Node *_slots;		///< Slot storage, only constructed where the control byte is full.
+	size_type _mask;	///< Capacity of the map minus one; capacity is a power of two.
+	size_type _size;
+	size_type _deleted;	///< Number of deleted slots.
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	/**
+	 * Spread the bits of the user supplied hash. Many hash functions
+	 * (e.g. the one for integers) are the identity, but both the group
+	 * index and the control byte need well distributed bits.
+	 */
+	static uint32 mixHash(uint hash) {
+		const uint32 h = (uint32)hash * 0x9E3779B1U;
+		return h ^ (h >> 16);
+	}
+
+	static int8 hashTag(uint32 hash) {
+		return (int8)(hash & 0x7F);
+	}
+
+	size_type hashStart(uint32 hash) const {
+		return (hash >> 7) & _mask;
+	}
+
+	/**
+	 * A group of FLATHASHMAP_GROUP_WIDTH consecutive control bytes, whose
+	 * match functions return a bit mask with one bit per slot.
+	 */
+	struct Group {
+#ifdef FLATHASHMAP_SSE2
+		__m128i _ctrl;
+
+		explicit Group(const int8 *ctrl) : _ctrl(_mm_loadu_si128((const __m128i *)ctrl)) {}
+
+		/** Match the slots whose control byte is @p value. */
+		uint32 match(int8 value) const {
+			return (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), _ctrl));
+		}
+
+		/** Match the slots which are empty or deleted. */
+		uint32 matchFree() const {
+			return (uint32)_mm_movemask_epi8(_ctrl);
+		}
+#else
+		const int8 *_ctrl;
+
+		explicit Group(const int8 *ctrl) : _ctrl(ctrl) {}
+
+		/** Match the slots whose control byte is @p value. */
+		uint32 match(int8 value) const {
+			uint32 mask = 0;
+			for (int i = 0; i < FLATHASHMAP_GROUP_WIDTH; ++i) {
+				if (_ctrl[i] == value)
+					mask |= 1 << i;
+			}
+			return mask;
+		}
+
+		/** Match the slots which are empty or deleted. */
+		uint32 matchFree() const {
+			uint32 mask = 0;
+			for (int i = 0; i < FLATHASHMAP_GROUP_WIDTH; ++i) {
+				if (_ctrl[i] < 0)
+					mask |= 1 << i;
+			}
+			return mask;
+		}
+#endif
+	};
+
+	/** Return the index of the lowest set bit in @p mask, which must not be 0. */
+	static size_type lowestBit(uint32 mask) {
+#if GCC_ATLEAST(3, 4)
+		return (size_type)__builtin_ctz(mask);
+#else
+		return (size_type)intLog2(mask & (~mask + 1));
+#endif
+	}
+
+	void setCtrl(size_type idx, int8 value) {
+		_ctrl[idx] = value;
+		if (idx < FLATHASHMAP_GROUP_WIDTH - 1)
+			_ctrl[idx + _mask + 1] = value;
+	}
+
+	bool isFull(size_type idx) const {
+		return _ctrl[idx] >= 0;
+	}
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key, uint32 hash) const;
+	size_type lookup(const Key &key) const { return lookup(key, mixHash(_hash(key))); }
+	size_type findFreeSlot(uint32 hash) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void rehash(size_type newCapacity);
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(_hashmap->isFull(_idx));
+			return &_hashmap->_slots[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			do {
+				_idx++;
+			} while (_idx <= _hashmap->_mask && !_hashmap->isFull(_idx));
+			if (_idx > _hashmap->_mask)
+				_idx = (size_type)-1;
+
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		clear();
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getVal(const Key &key, const Val &defaultVal) const;
+	bool tryGetVal(const Key &key, Val &out) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	/**
+	 * Make room for at least @p count entries, so that inserting them
+	 * does not rehash the map.
+	 */
+	void reserve(size_type count);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isFull(ctr))
+				return iterator(ctr, this);
+		}
+		return end();
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isFull(ctr))
+				return const_iterator(ctr, this);
+		}
+		return end();
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	iterator	find(const Key &key) {
+		size_type ctr = lookup(key);
+		if (ctr <= _mask)
+			return iterator(ctr, this);
+		return end();
+	}
+
+	const_iterator	find(const Key &key) const {
+		size_type ctr = lookup(key);
+		if (ctr <= _mask)
+			return const_iterator(ctr, this);
+		return end();
+	}
+
+	/** Return true if hashmap is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	_size = 0;
+	_deleted = 0;
+}
+
+/**
+ * Copy constructor, creates a full copy of the given hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	clear();
+	freeStorage();
+}
+
+/**
+ * Internal method for allocating an empty slot array of the given capacity.
+ *
+ * @note The previous storage is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	assert(capacity >= FLATHASHMAP_MIN_CAPACITY && (capacity & (capacity - 1)) == 0);
+	_mask = capacity - 1;
+	_ctrl = (int8 *)malloc(capacity + FLATHASHMAP_GROUP_WIDTH - 1);
+	_slots = (Node *)malloc(capacity * sizeof(Node));
+	assert(_ctrl != nullptr && _slots != nullptr);
+	memset(_ctrl, (uint8)kCtrlEmpty, capacity + FLATHASHMAP_GROUP_WIDTH - 1);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	free(_ctrl);
+	free(_slots);
+	_ctrl = nullptr;
+	_slots = nullptr;
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note The previous storage is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// The slot layout only depends on the hashes, so the control bytes
+	// can be copied verbatim and every entry keeps its index.
+	memcpy(_ctrl, map._ctrl, _mask + FLATHASHMAP_GROUP_WIDTH);
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isFull(ctr))
+			new ((void *)&_slots[ctr]) Node(map._slots[ctr]);
+	}
+	_size = map._size;
+	_deleted = map._deleted;
+}
+
+/**
+ * Clear all values in the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isFull(ctr))
+			_slots[ctr].~Node();
+	}
+
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	} else {
+		memset(_ctrl, (uint8)kCtrlEmpty, _mask + FLATHASHMAP_GROUP_WIDTH);
+	}
+
+	_size = 0;
+	_deleted = 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+	assert(newCapacity > _size);
+
+	int8 *oldCtrl = _ctrl;
+	Node *oldSlots = _slots;
+	const size_type oldMask = _mask;
+
+	allocStorage(newCapacity);
+
+	// Move all entries over. Since we know that no key exists twice in
+	// the old table, we only need to look for a free slot and don't have
+	// to call _equal().
+	for (size_type ctr = 0; ctr <= oldMask; ++ctr) {
+		if (oldCtrl[ctr] < 0)
+			continue;
+
+		const uint32 hash = mixHash(_hash(oldSlots[ctr]._key));
+		const size_type idx = findFreeSlot(hash);
+		setCtrl(idx, hashTag(hash));
+		new ((void *)&_slots[idx]) Node(oldSlots[ctr]);
+		oldSlots[ctr].~Node();
+	}
+
+	_deleted = 0;
+
+	free(oldCtrl);
+	free(oldSlots);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::reserve(size_type count) {
+	size_type capacity = _mask + 1;
+	while (count * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+		capacity *= 2;
+	if (capacity > _mask + 1)
+		rehash(capacity);
+}
+
+/**
+ * Internal method returning the slot index of @p key, or a value greater
+ * than _mask if the key is not present.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key, uint32 hash) const {
+	const int8 tag = hashTag(hash);
+	size_type pos = hashStart(hash);
+
+	// Groups are visited in triangular steps, which reaches every group
+	// since the capacity is a power of two. There is always at least one
+	// empty slot, so the loop terminates.
+	for (size_type stride = FLATHASHMAP_GROUP_WIDTH; ; stride += FLATHASHMAP_GROUP_WIDTH) {
+		const Group group(_ctrl + pos);
+		for (uint32 match = group.match(tag); match; match &= match - 1) {
+			const size_type idx = (pos + lowestBit(match)) & _mask;
+			if (_equal(_slots[idx]._key, key))
+				return idx;
+		}
+		if (group.match(kCtrlEmpty))
+			return _mask + 1;
+		pos = (pos + stride) & _mask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::findFreeSlot(uint32 hash) const {
+	size_type pos = hashStart(hash);
+	for (size_type stride = FLATHASHMAP_GROUP_WIDTH; ; stride += FLATHASHMAP_GROUP_WIDTH) {
+		const uint32 match = Group(_ctrl + pos).matchFree();
+		if (match)
+			return (pos + lowestBit(match)) & _mask;
+		pos = (pos + stride) & _mask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	const uint32 hash = mixHash(_hash(key));
+	size_type ctr = lookup(key, hash);
+	if (ctr <= _mask)
+		return ctr;
+
+	// Keep the load factor below a certain threshold. Deleted slots are
+	// also counted; if they make up most of the load, rehash in place
+	// instead of growing.
+	size_type capacity = _mask + 1;
+	if ((_size + _deleted + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+		if ((_size + 1) * 2 * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+			capacity *= 2;
+		rehash(capacity);
+	}
+
+	ctr = findFreeSlot(hash);
+	if (_ctrl[ctr] == kCtrlDeleted)
+		_deleted--;
+	setCtrl(ctr, hashTag(hash));
+	new ((void *)&_slots[ctr]) Node(key);
+	_size++;
+
+	return ctr;
+}
+
+/**
+ * Check whether the hashmap contains the given key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key) <= _mask;
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getVal(key);
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	return _slots[ctr]._value;
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	return getVal(key, _defaultVal);
+}
+
+/**
+ * Get a value from the hashmap. If the key is not present, then return @p defaultVal.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask)
+		return _slots[ctr]._value;
+	else
+		return defaultVal;
+}
+
+/**
+ * Get a value from the hashmap into @p out. Return false if the key is not present.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::tryGetVal(const Key &key, Val &out) const {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask) {
+		out = _slots[ctr]._value;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * Assign an element specified by @p key to a value @p val.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	_slots[ctr]._value = val;
+}
+
+/**
+ * Erase an element referred to by an iterator.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	const size_type ctr = entry._idx;
+	assert(ctr <= _mask);
+	assert(isFull(ctr));
+
+	// If we remove a key, we mark its slot as deleted so that probing
+	// continues past it.
+	_slots[ctr].~Node();
+	setCtrl(ctr, kCtrlDeleted);
+	_size--;
+	_deleted++;
+}
+
+/**
+ * Erase an element specified by a key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr > _mask)
+		return;
+
+	_slots[ctr].~Node();
+	setCtrl(ctr, kCtrlDeleted);
+	_size--;
+	_deleted++;
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/readahead.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "backends/fs/abstract-fs.h"
@@ -125,6 +126,10 @@ bool FSNode::isWritable() const {
 	return _realNode && _realNode->isWritable();
 }
 
+uint32 FSNode::getModificationTime() const {
+	return _realNode ? _realNode->getModificationTime() : 0;
+}
+
 SeekableReadStream *FSNode::createReadStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -137,7 +142,7 @@ SeekableReadStream *FSNode::createReadStream() const {
 		return nullptr;
 	}
 
-	return _realNode->createReadStream();
+	return wrapDefaultReadAheadStream(_realNode->createReadStream());
 }
 
 WriteStream *FSNode::createWriteStream() const {
@@ -213,8 +218,9 @@ FSNode *FSDirectory::lookupCache(NodeCache &cache, const String &name) const {
 	if (!name.empty()) {
 		ensureCached();
 
-		if (cache.contains(name))
-			return &cache[name];
+		NodeCache::iterator it = cache.find(name);
+		if (it != cache.end())
+			return &it->_value;
 	}
 
 	return nullptr;
@@ -222,6 +222,16 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Return the time of the last modification of the file, in seconds.
+	 *
+	 * The time base depends on the backend, so the value is only useful
+	 * for detecting whether a file changed.
+	 *
+	 * @return The modification time, or 0 if it is unknown.
+	 */
+	uint32 getModificationTime() const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -25,30 +25,40 @@
 
 #include "common/hashmap.h"
 #include "common/str.h"
+#include "common/str-view.h"
 
 namespace Common {
 
 uint hashit(const char *str);
 uint hashit_lower(const char *str); // Generate a hash based on the lowercase version of the string
 inline uint hashit_lower(const String &str) { return hashit_lower(str.c_str()); }
+uint hashit_lower(const char *str, uint len); // Same as hashit_lower, for strings which are not null terminated
+inline uint hashit_lower(const StringView &str) { return hashit_lower(str.data(), str.size()); }
+
+// The functors for String keys also accept StringView, which allows looking
+// up a view with HashMap::findAs() and friends without creating a String.
 
 // FIXME: The following functors obviously are not consistently named
 
 struct CaseSensitiveString_EqualTo {
 	bool operator()(const String& x, const String& y) const { return x.equals(y); }
+	bool operator()(const String& x, const StringView& y) const { return StringView(x).equals(y); }
 };
 
 struct CaseSensitiveString_Hash {
 	uint operator()(const String& x) const { return x.hash(); }
+	uint operator()(const StringView& x) const { return x.hash(); }
 };
 
 
 struct IgnoreCase_EqualTo {
 	bool operator()(const String& x, const String& y) const { return x.equalsIgnoreCase(y); }
+	bool operator()(const String& x, const StringView& y) const { return StringView(x).equalsIgnoreCase(y); }
 };
 
 struct IgnoreCase_Hash {
 	uint operator()(const String& x) const { return hashit_lower(x.c_str()); }
+	uint operator()(const StringView& x) const { return hashit_lower(x); }
 };
 
 // Specalization of the Hash functor for String objects.
@@ -62,6 +72,16 @@ struct Hash<String> {
 	uint operator()(const String& s) const {
 		return s.hash();
 	}
+	uint operator()(const StringView& s) const {
+		return s.hash();
+	}
+};
+
+template<>
+struct Hash<StringView> {
+	uint operator()(const StringView& s) const {
+		return s.hash();
+	}
 };
 
 template<>
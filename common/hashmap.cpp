@@ -52,6 +52,13 @@ uint hashit_lower(const char *p) {
 	return hash ^ size;
 }
 
+uint hashit_lower(const char *p, uint len) {
+	uint hash = tolower(len ? *p : 0) << 7;
+	for (uint i = 0; i < len; ++i)
+		hash = (1000003 * hash) ^ tolower((byte)p[i]);
+	return hash ^ len;
+}
+
 #ifdef DEBUG_HASH_COLLISIONS
 static double
 	g_collisions = 0,
@@ -153,7 +153,7 @@ private:
 	}
 
 	void assign(const HM_t &map);
-	size_type lookup(const Key &key) const;
+	template<class K> size_type lookup(const K &key) const;
 	size_type lookupAndCreateIfMissing(const Key &key);
 	void expandStorage(size_type newCapacity);
 
@@ -295,6 +295,53 @@ public:
 		return end();
 	}
 
+	/**
+	 * @name Heterogeneous lookup
+	 *
+	 * Same as contains(), find(), getVal() and tryGetVal(), but for a key
+	 * of another type than Key, for example a StringView in a map with
+	 * String keys. This saves creating a temporary Key for every lookup.
+	 * HashFunc and EqualFunc must accept the type, and an equal key must
+	 * have the same hash either way.
+	 * @{
+	 */
+	template<class K>
+	bool containsAs(const K &key) const {
+		return _storage[lookup(key)] != nullptr;
+	}
+
+	template<class K>
+	iterator findAs(const K &key) {
+		size_type ctr = lookup(key);
+		if (_storage[ctr])
+			return iterator(ctr, this);
+		return end();
+	}
+
+	template<class K>
+	const_iterator findAs(const K &key) const {
+		size_type ctr = lookup(key);
+		if (_storage[ctr])
+			return const_iterator(ctr, this);
+		return end();
+	}
+
+	template<class K>
+	const Val &getValAs(const K &key) const {
+		size_type ctr = lookup(key);
+		return _storage[ctr] ? _storage[ctr]->_value : _defaultVal;
+	}
+
+	template<class K>
+	bool tryGetValAs(const K &key, Val &out) const {
+		size_type ctr = lookup(key);
+		if (!_storage[ctr])
+			return false;
+		out = _storage[ctr]->_value;
+		return true;
+	}
+	/** @} */
+
 	// TODO: insert() method?
     /** Return true if hashmap is empty. */
 	bool empty() const {
@@ -463,7 +510,8 @@ void HashMap<Key, Val, HashFunc, EqualFunc>::expandStorage(size_type newCapacity
 }
 
 template<class Key, class Val, class HashFunc, class EqualFunc>
-typename HashMap<Key, Val, HashFunc, EqualFunc>::size_type HashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+template<class K>
+typename HashMap<Key, Val, HashFunc, EqualFunc>::size_type HashMap<Key, Val, HashFunc, EqualFunc>::lookup(const K &key) const {
 	const size_type hash = _hash(key);
 	size_type ctr = hash & _mask;
 	for (size_type perturb = hash; ; perturb >>= HASHMAP_PERTURB_SHIFT) {
@@ -3,6 +3,7 @@ MODULE := common
 MODULE_OBJS := \
 	achievements.o \
 	archive.o \
+	arena.o \
 	base-str.o \
 	config-manager.o \
 	coroutines.o \
@@ -27,13 +28,18 @@ MODULE_OBJS := \
 	mutex.o \
 	osd_message_queue.o \
 	platform.o \
+	profiler.o \
 	quicktime.o \
 	random.o \
 	rational.o \
+	readahead.o \
 	rendermode.o \
+	simd.o \
 	sinewindows.o \
 	str.o \
 	str-enc.o \
+	str-pool.o \
+	str-view.o \
 	stream.o \
 	streamdebug.o \
 	stuffit.o \
@@ -49,6 +55,7 @@ MODULE_OBJS := \
 	winexe.o \
 	winexe_ne.o \
 	winexe_pe.o \
+	workerpool.o \
 	xmlparser.o \
 	zlib.o
 
@@ -47,6 +47,34 @@ void Mutex::unlock() {
 #pragma mark -
 
 
+Semaphore::Semaphore(uint value) {
+	assert(g_system);
+	_sem = g_system->createSemaphore(value);
+}
+
+Semaphore::~Semaphore() {
+	if (_sem)
+		g_system->deleteSemaphore(_sem);
+}
+
+void Semaphore::wait() {
+	if (_sem)
+		g_system->waitSemaphore(_sem);
+}
+
+bool Semaphore::wait(uint msecs) {
+	return _sem && g_system->waitSemaphoreTimeout(_sem, msecs);
+}
+
+void Semaphore::post() {
+	if (_sem)
+		g_system->postSemaphore(_sem);
+}
+
+
+#pragma mark -
+
+
 StackLock::StackLock(OSystem::MutexRef mutex, const char *mutexName)
 	: _mutex(mutex), _mutexName(mutexName) {
 	lock();
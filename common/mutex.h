@@ -70,6 +70,25 @@ public:
 	void unlock();
 };
 
+/**
+ * Wrapper class around the OSystem semaphore functions.
+ *
+ * Only use it together with threads created through OSystem::createThread():
+ * on backends without thread support, wait() and post() do nothing.
+ */
+class Semaphore {
+	OSystem::SemaphoreRef _sem;
+
+public:
+	explicit Semaphore(uint value = 0);
+	~Semaphore();
+
+	void wait();
+	/** Wait at most @p msecs milliseconds. Returns false on timeout. */
+	bool wait(uint msecs);
+	void post();
+};
+
 /** @} */
 
 } // End of namespace Common
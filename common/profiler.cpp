@@ -0,0 +1,203 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+
+#if defined(WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(POSIX)
+#include <time.h>
+#endif
+
+#include "common/profiler.h"
+#include "common/atomic.h"
+#include "common/str.h"
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/util.h"
+
+#ifdef SCUMMVM_THREAD_LOCAL
+#define PROFILER_THREAD_LOCAL SCUMMVM_THREAD_LOCAL
+#else
+// All threads share one buffer, which is only safe with a single thread
+// recording at a time
+#define PROFILER_THREAD_LOCAL
+#endif
+
+namespace Common {
+
+namespace {
+
+struct ProfileEvent {
+	const char *name;
+	uint64 start;
+	uint64 end;
+};
+
+struct ProfileBuffer {
+	ProfileEvent events[Profiler::kEventsPerThread];
+	/** Number of events ever written, the ring index is taken modulo the size. */
+	volatile int32 count;
+};
+
+enum {
+	kSlotFree = 0,
+	kSlotOwned = 1,
+	kSlotReleased = 2
+};
+
+ProfileBuffer *g_buffers[Profiler::kMaxThreads];
+volatile int32 g_slotStates[Profiler::kMaxThreads];
+
+PROFILER_THREAD_LOCAL int g_threadSlot = -1;
+
+int claimSlot() {
+	// Prefer the buffers of threads which are gone
+	for (uint i = 0; i < Profiler::kMaxThreads; ++i) {
+		if (atomicCompareExchange(&g_slotStates[i], kSlotReleased, kSlotOwned))
+			return i;
+	}
+
+	for (uint i = 0; i < Profiler::kMaxThreads; ++i) {
+		if (atomicCompareExchange(&g_slotStates[i], kSlotFree, kSlotOwned)) {
+			ProfileBuffer *buffer = new ProfileBuffer;
+			buffer->count = 0;
+			g_buffers[i] = buffer;
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+uint getFirstEvent(uint32 count) {
+	return count > Profiler::kEventsPerThread ? count - Profiler::kEventsPerThread : 0;
+}
+
+} // End of anonymous namespace
+
+volatile bool Profiler::_enabled = false;
+
+void Profiler::setEnabled(bool enable) {
+	_enabled = enable;
+}
+
+void Profiler::reset() {
+	for (uint i = 0; i < kMaxThreads; ++i) {
+		if (g_buffers[i])
+			atomicStore(&g_buffers[i]->count, 0);
+	}
+}
+
+uint64 Profiler::getNanos() {
+#if defined(WIN32)
+	static LARGE_INTEGER frequency;
+	if (!frequency.QuadPart)
+		QueryPerformanceFrequency(&frequency);
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return (uint64)((double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart);
+#elif defined(POSIX) && defined(CLOCK_MONOTONIC)
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#else
+	return g_system ? (uint64)g_system->getMillis(true) * 1000000 : 0;
+#endif
+}
+
+void Profiler::addZone(const char *name, uint64 start, uint64 end) {
+	if (g_threadSlot < 0) {
+		g_threadSlot = claimSlot();
+		if (g_threadSlot < 0)
+			return;
+	}
+
+	ProfileBuffer *buffer = g_buffers[g_threadSlot];
+	const uint32 count = buffer->count;
+	ProfileEvent &event = buffer->events[count % kEventsPerThread];
+	event.name = name;
+	event.start = start;
+	event.end = end;
+	atomicStore(&buffer->count, count + 1);
+}
+
+void Profiler::releaseThread() {
+	if (g_threadSlot < 0)
+		return;
+
+	atomicStore(&g_slotStates[g_threadSlot], kSlotReleased);
+	g_threadSlot = -1;
+}
+
+uint Profiler::getZoneCount() {
+	uint zones = 0;
+	for (uint i = 0; i < kMaxThreads; ++i) {
+		if (g_buffers[i])
+			zones += MIN<uint32>(atomicLoad(&g_buffers[i]->count), kEventsPerThread);
+	}
+	return zones;
+}
+
+void Profiler::writeTrace(WriteStream &stream) {
+	uint32 counts[kMaxThreads];
+	uint64 base = 0;
+	bool first = true;
+
+	// Time stamps are written relative to the oldest zone
+	for (uint i = 0; i < kMaxThreads; ++i) {
+		counts[i] = g_buffers[i] ? atomicLoad(&g_buffers[i]->count) : 0;
+		for (uint32 j = getFirstEvent(counts[i]); j < counts[i]; ++j) {
+			const uint64 start = g_buffers[i]->events[j % kEventsPerThread].start;
+			if (first || start < base)
+				base = start;
+			first = false;
+		}
+	}
+
+	stream.writeString("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+	first = true;
+	for (uint i = 0; i < kMaxThreads; ++i) {
+		if (!counts[i])
+			continue;
+
+		stream.writeString(String::format("%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}",
+			first ? "" : ",", i, i));
+		first = false;
+
+		for (uint32 j = getFirstEvent(counts[i]); j < counts[i]; ++j) {
+			const ProfileEvent &event = g_buffers[i]->events[j % kEventsPerThread];
+			const uint64 start = event.start - base;
+			const uint64 duration = event.end - event.start;
+
+			// The format wants microseconds, fractions keep the precision
+			stream.writeString(String::format(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%u.%03u,\"dur\":%u.%03u}",
+				event.name, i, (uint)(start / 1000), (uint)(start % 1000), (uint)(duration / 1000), (uint)(duration % 1000)));
+		}
+	}
+
+	stream.writeString("\n]}\n");
+}
+
+} // End of namespace Common
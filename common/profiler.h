@@ -0,0 +1,121 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+namespace Common {
+
+class WriteStream;
+
+/**
+ * @defgroup common_profiler Profiler
+ * @ingroup common
+ *
+ * @brief Scoped instrumentation zones for hot paths.
+ *
+ * A zone is opened with PROFILE_ZONE("name") and closed at the end of the
+ * enclosing scope. While the profiler is enabled, every closed zone is
+ * appended to a ring buffer owned by the calling thread; when it is
+ * disabled, opening a zone costs a single flag check. The collected
+ * zones can be written as a Chrome trace, which chrome://tracing and
+ * Perfetto display as a timeline.
+ *
+ * Zone names must be string literals, or otherwise outlive the profiler.
+ * @{
+ */
+
+class Profiler {
+public:
+	/** Number of zones kept per thread, older ones are overwritten. */
+	static const uint kEventsPerThread = 1 << 15;
+	/** Number of threads which can record zones at the same time. */
+	static const uint kMaxThreads = 32;
+
+	static bool isEnabled() { return _enabled; }
+	static void setEnabled(bool enable);
+
+	/** Discard all recorded zones. */
+	static void reset();
+
+	/** Monotonic time stamp in nanoseconds. */
+	static uint64 getNanos();
+
+	/** Record a zone for the calling thread. */
+	static void addZone(const char *name, uint64 start, uint64 end);
+
+	/**
+	 * Give up the ring buffer of the calling thread, keeping the zones
+	 * recorded so far. Short lived threads have to call this before they
+	 * exit, the next thread then continues in the same buffer.
+	 */
+	static void releaseThread();
+
+	/** Number of zones currently held in all ring buffers. */
+	static uint getZoneCount();
+
+	/**
+	 * Write all recorded zones in the Chrome trace event format.
+	 *
+	 * Threads may keep recording meanwhile, zones being written while the
+	 * trace is taken can come out garbled.
+	 */
+	static void writeTrace(WriteStream &stream);
+
+private:
+	static volatile bool _enabled;
+};
+
+/**
+ * Times the enclosing scope, see PROFILE_ZONE.
+ */
+class ProfileZone {
+public:
+	explicit ProfileZone(const char *name) : _name(name), _active(Profiler::isEnabled()), _start(0) {
+		if (_active)
+			_start = Profiler::getNanos();
+	}
+
+	~ProfileZone() {
+		if (_active)
+			Profiler::addZone(_name, _start, Profiler::getNanos());
+	}
+
+private:
+	const char *_name;
+	bool _active;
+	uint64 _start;
+};
+
+#define PROFILE_ZONE_CONCAT2(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT2(a, b)
+
+/** Open a profiling zone which lasts until the end of the current scope. */
+#define PROFILE_ZONE(name) Common::ProfileZone PROFILE_ZONE_CONCAT(profileZone, __LINE__)(name)
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,469 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "common/readahead.h"
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/profiler.h"
+#include "common/system.h"
+#include "common/util.h"
+
+namespace Common {
+
+namespace {
+
+enum {
+	kChunkSize = 32 * 1024
+};
+
+uint32 g_defaultReadAheadSize = 0;
+
+class ReadAheadStream;
+
+/**
+ * Chunks waiting to be loaded. The thread draining the queue exits once
+ * it is empty and the next request starts a new one, so an idle queue
+ * costs nothing.
+ */
+class ReadAheadQueue {
+public:
+	ReadAheadQueue() : _thread(nullptr), _running(false), _noThreads(false), _active(nullptr), _cancelWaiting(false) {}
+	~ReadAheadQueue();
+
+	/**
+	 * Queue loading @p chunk of @p stream.
+	 *
+	 * @return false if the backend cannot start the I/O thread.
+	 */
+	bool push(ReadAheadStream *stream, uint32 chunk);
+
+	/** Drop the requests of @p stream and wait for the one in progress. */
+	void cancel(ReadAheadStream *stream);
+
+private:
+	struct Request {
+		ReadAheadStream *stream;
+		uint32 chunk;
+	};
+
+	static int threadProc(void *param);
+
+	Mutex _mutex;
+	OSystem::ThreadRef _thread;
+	bool _running;
+	bool _noThreads;
+	ReadAheadStream *_active;
+	Array<Request> _requests;
+
+	/** Posted by the thread once the request cancel() waits for is done. */
+	Semaphore _cancelDone;
+	bool _cancelWaiting;
+};
+
+ReadAheadQueue *g_readAheadQueue = nullptr;
+
+/** Locks a mutex which is only created when threads may be involved. */
+class OptionalLock {
+public:
+	explicit OptionalLock(OSystem::MutexRef mutex) : _mutex(mutex) {
+		if (_mutex)
+			g_system->lockMutex(_mutex);
+	}
+
+	~OptionalLock() {
+		if (_mutex)
+			g_system->unlockMutex(_mutex);
+	}
+
+private:
+	OSystem::MutexRef _mutex;
+};
+
+/**
+ * Reads the parent stream in chunks held in a small LRU cache of slots.
+ *
+ * Loading a chunk takes the parent mutex first and the slot mutex only
+ * to claim or publish a slot, so reads served from the cache never wait
+ * for the disk. A slot is marked pending while it is loaded, which only
+ * happens with the parent mutex held: locking that mutex waits for it.
+ */
+class ReadAheadStream : public SeekableReadStream {
+public:
+	ReadAheadStream(SeekableReadStream *parentStream, uint32 readAheadSize, DisposeAfterUse::Flag disposeParentStream);
+	~ReadAheadStream() override;
+
+	bool eos() const override { return _eos; }
+	bool err() const override { return _err; }
+	void clearErr() override { _eos = false; _err = false; }
+
+	int32 pos() const override { return _pos; }
+	int32 size() const override { return _size; }
+	bool seek(int32 offset, int whence = SEEK_SET) override;
+	uint32 read(void *dataPtr, uint32 dataSize) override;
+	void prefetch(int32 offset, uint32 size) override;
+
+	/**
+	 * Load @p chunk unless it is already cached.
+	 *
+	 * @return false if reading the parent stream failed.
+	 */
+	bool loadChunk(uint32 chunk);
+
+private:
+	struct Slot {
+		byte *data;
+		int32 chunk;
+		uint32 size;
+		uint32 lastUse;
+		bool pending;
+	};
+
+	Slot *findSlot(uint32 chunk);
+	void request(uint32 chunk);
+
+	SeekableReadStream *_parentStream;
+	DisposeAfterUse::Flag _disposeParentStream;
+	OSystem::MutexRef _parentMutex;
+	OSystem::MutexRef _slotMutex;
+	bool _async;
+
+	Array<Slot> _slots;
+	uint32 _useCount;
+	uint32 _aheadChunks;
+	uint32 _numChunks;
+	uint32 _lastChunk;
+	uint32 _requestedEnd;
+
+	int32 _pos;
+	int32 _size;
+	bool _eos;
+	bool _err;
+};
+
+ReadAheadQueue::~ReadAheadQueue() {
+	{
+		StackLock lock(_mutex);
+		_requests.clear();
+	}
+
+	if (_thread)
+		g_system->waitThread(_thread);
+}
+
+bool ReadAheadQueue::push(ReadAheadStream *stream, uint32 chunk) {
+	StackLock lock(_mutex);
+	if (_noThreads)
+		return false;
+
+	for (uint i = 0; i < _requests.size(); ++i) {
+		if (_requests[i].stream == stream && _requests[i].chunk == chunk)
+			return true;
+	}
+
+	Request request = { stream, chunk };
+	_requests.push_back(request);
+
+	if (!_running) {
+		// The previous thread gave up the queue and is about to exit
+		if (_thread)
+			g_system->waitThread(_thread);
+
+		_thread = g_system->createThread(threadProc, this);
+		if (!_thread) {
+			_noThreads = true;
+			_requests.clear();
+			return false;
+		}
+		_running = true;
+	}
+
+	return true;
+}
+
+void ReadAheadQueue::cancel(ReadAheadStream *stream) {
+	{
+		StackLock lock(_mutex);
+		for (uint i = _requests.size(); i-- > 0;) {
+			if (_requests[i].stream == stream)
+				_requests.remove_at(i);
+		}
+
+		if (_active != stream)
+			return;
+
+		// Only the stream being loaded waits, so there is one waiter at most
+		_cancelWaiting = true;
+	}
+
+	_cancelDone.wait();
+}
+
+int ReadAheadQueue::threadProc(void *param) {
+	ReadAheadQueue *queue = (ReadAheadQueue *)param;
+
+	for (;;) {
+		Request request;
+		{
+			StackLock lock(queue->_mutex);
+			queue->_active = nullptr;
+			if (queue->_cancelWaiting) {
+				queue->_cancelWaiting = false;
+				queue->_cancelDone.post();
+			}
+
+			if (queue->_requests.empty()) {
+				queue->_running = false;
+				break;
+			}
+
+			request = queue->_requests.front();
+			queue->_requests.remove_at(0);
+			queue->_active = request.stream;
+		}
+
+		request.stream->loadChunk(request.chunk);
+	}
+
+	Profiler::releaseThread();
+	return 0;
+}
+
+ReadAheadStream::ReadAheadStream(SeekableReadStream *parentStream, uint32 readAheadSize, DisposeAfterUse::Flag disposeParentStream)
+	: _parentStream(parentStream), _disposeParentStream(disposeParentStream),
+	  _parentMutex(nullptr), _slotMutex(nullptr), _async(g_system != nullptr),
+	  _useCount(0), _lastChunk(0), _requestedEnd(0), _pos(0), _eos(false), _err(false) {
+
+	_size = MAX<int32>(_parentStream->size(), 0);
+	_numChunks = (_size + kChunkSize - 1) / kChunkSize;
+	_aheadChunks = (readAheadSize + kChunkSize - 1) / kChunkSize;
+
+	// The chunk being read and the one before stay cached next to the
+	// chunks loaded ahead.
+	_slots.resize(MIN<uint32>(_aheadChunks + 2, MAX<uint32>(_numChunks, 1)));
+	for (uint i = 0; i < _slots.size(); ++i) {
+		Slot &slot = _slots[i];
+		slot.data = (byte *)malloc(kChunkSize);
+		assert(slot.data);
+		slot.chunk = -1;
+		slot.size = 0;
+		slot.lastUse = 0;
+		slot.pending = false;
+	}
+
+	if (_async) {
+		_parentMutex = g_system->createMutex();
+		_slotMutex = g_system->createMutex();
+	}
+}
+
+ReadAheadStream::~ReadAheadStream() {
+	if (g_readAheadQueue)
+		g_readAheadQueue->cancel(this);
+
+	for (uint i = 0; i < _slots.size(); ++i)
+		free(_slots[i].data);
+
+	if (_async) {
+		g_system->deleteMutex(_parentMutex);
+		g_system->deleteMutex(_slotMutex);
+	}
+
+	if (_disposeParentStream)
+		delete _parentStream;
+}
+
+ReadAheadStream::Slot *ReadAheadStream::findSlot(uint32 chunk) {
+	for (uint i = 0; i < _slots.size(); ++i) {
+		if (_slots[i].chunk == (int32)chunk)
+			return &_slots[i];
+	}
+	return nullptr;
+}
+
+bool ReadAheadStream::loadChunk(uint32 chunk) {
+	if (chunk >= _numChunks)
+		return false;
+
+	OptionalLock parentLock(_parentMutex);
+
+	Slot *slot = nullptr;
+	{
+		OptionalLock lock(_slotMutex);
+		if (findSlot(chunk))
+			return true;
+
+		// No slot is pending here, loads are serialized by the parent mutex
+		for (uint i = 0; i < _slots.size(); ++i) {
+			if (!slot || _slots[i].lastUse < slot->lastUse)
+				slot = &_slots[i];
+		}
+		slot->chunk = chunk;
+		slot->pending = true;
+	}
+
+	PROFILE_ZONE("ReadAheadStream::loadChunk");
+	const uint32 start = chunk * kChunkSize;
+	const uint32 len = MIN<uint32>(kChunkSize, _size - start);
+	bool ok = _parentStream->seek(start, SEEK_SET) && _parentStream->read(slot->data, len) == len;
+
+	OptionalLock lock(_slotMutex);
+	slot->pending = false;
+	slot->size = len;
+	slot->lastUse = ++_useCount;
+	if (!ok) {
+		slot->chunk = -1;
+		slot->lastUse = 0;
+		_parentStream->clearErr();
+	}
+	return ok;
+}
+
+void ReadAheadStream::request(uint32 chunk) {
+	if (!_async || chunk >= _numChunks)
+		return;
+
+	// The queue is created by setDefaultReadAheadSize() at startup
+	if (!g_readAheadQueue || !g_readAheadQueue->push(this, chunk))
+		_async = false;
+}
+
+uint32 ReadAheadStream::read(void *dataPtr, uint32 dataSize) {
+	byte *dst = (byte *)dataPtr;
+	uint32 total = 0;
+
+	while (total < dataSize) {
+		if (_pos >= _size) {
+			_eos = true;
+			break;
+		}
+
+		const uint32 chunk = _pos / kChunkSize;
+		const uint32 offset = _pos % kChunkSize;
+		uint32 len = 0;
+		bool pending = false;
+		{
+			OptionalLock lock(_slotMutex);
+			Slot *slot = findSlot(chunk);
+			if (slot && !slot->pending) {
+				len = MIN(dataSize - total, slot->size - offset);
+				memcpy(dst + total, slot->data + offset, len);
+				slot->lastUse = ++_useCount;
+			} else {
+				pending = (slot != nullptr);
+			}
+		}
+
+		if (len) {
+			total += len;
+			_pos += len;
+		} else if (pending) {
+			// Wait for the I/O thread to finish the chunk
+			OptionalLock wait(_parentMutex);
+		} else if (!loadChunk(chunk)) {
+			_err = true;
+			break;
+		}
+	}
+
+	if (total && _aheadChunks) {
+		// Only read ahead of sequential access
+		const uint32 chunk = (_pos - 1) / kChunkSize;
+		if (chunk != _lastChunk && chunk != _lastChunk + 1)
+			_requestedEnd = 0;
+		_lastChunk = chunk;
+
+		const uint32 end = chunk + 1 + _aheadChunks;
+		for (uint32 i = MAX(chunk + 1, _requestedEnd); i < end; ++i)
+			request(i);
+		_requestedEnd = end;
+	}
+
+	return total;
+}
+
+void ReadAheadStream::prefetch(int32 offset, uint32 size) {
+	if (offset < 0 || offset >= _size || !size)
+		return;
+
+	const uint32 first = offset / kChunkSize;
+	uint32 last = (MIN<uint32>(size, _size - offset) + offset - 1) / kChunkSize;
+
+	// Leave a slot for the chunk being read
+	const uint32 maxChunks = MAX<uint32>(_slots.size(), 2) - 1;
+	last = MIN(last, first + maxChunks - 1);
+	for (uint32 chunk = first; chunk <= last; ++chunk)
+		request(chunk);
+}
+
+bool ReadAheadStream::seek(int32 offset, int whence) {
+	switch (whence) {
+	case SEEK_END:
+		offset += _size;
+		break;
+	case SEEK_CUR:
+		offset += _pos;
+		break;
+	case SEEK_SET:
+	default:
+		break;
+	}
+
+	if (offset < 0 || offset > _size)
+		return false;
+
+	_pos = offset;
+	_eos = false;
+	return true;
+}
+
+} // End of anonymous namespace
+
+SeekableReadStream *wrapReadAheadStream(SeekableReadStream *parentStream, uint32 readAheadSize, DisposeAfterUse::Flag disposeParentStream) {
+	if (parentStream)
+		return new ReadAheadStream(parentStream, readAheadSize, disposeParentStream);
+	return nullptr;
+}
+
+void setDefaultReadAheadSize(uint32 size) {
+	g_defaultReadAheadSize = size;
+
+	// Created here rather than on first use, where several threads could
+	// race to create it
+	if (!g_readAheadQueue && g_system)
+		g_readAheadQueue = new ReadAheadQueue();
+}
+
+uint32 getDefaultReadAheadSize() {
+	return g_defaultReadAheadSize;
+}
+
+SeekableReadStream *wrapDefaultReadAheadStream(SeekableReadStream *stream) {
+	if (!stream || !g_defaultReadAheadSize || stream->size() < (int32)(2 * g_defaultReadAheadSize))
+		return stream;
+	return new ReadAheadStream(stream, g_defaultReadAheadSize, DisposeAfterUse::YES);
+}
+
+void shutdownReadAhead() {
+	delete g_readAheadQueue;
+	g_readAheadQueue = nullptr;
+}
+
+} // End of namespace Common
@@ -0,0 +1,91 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef COMMON_READAHEAD_H
+#define COMMON_READAHEAD_H
+
+#include "common/stream.h"
+#include "common/types.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_readahead Read-ahead stream
+ * @ingroup common
+ *
+ * @brief API for prefetching file data on a background thread.
+ *
+ * @{
+ */
+
+/**
+ * Take an arbitrary SeekableReadStream and wrap it in a custom stream that
+ * keeps the next @p readAheadSize bytes behind the read position loaded.
+ *
+ * The data is read in chunks of 32 KiB by a shared I/O thread, so that a
+ * sequential reader rarely waits for the disk. Explicit hints passed to
+ * SeekableReadStream::prefetch() are queued on the same thread. On
+ * backends without thread support, or before setDefaultReadAheadSize()
+ * was called, the stream still reads whole chunks but only loads them
+ * when they are needed.
+ *
+ * The wrapped stream must not be used directly while the wrapper exists.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ *
+ * @param parentStream        The SeekableReadStream to wrap in a custom stream.
+ * @param readAheadSize       Number of bytes to keep loaded ahead of the read position.
+ * @param disposeParentStream Flag indicating whether to dispose of the wrapped stream.
+ */
+SeekableReadStream *wrapReadAheadStream(SeekableReadStream *parentStream, uint32 readAheadSize, DisposeAfterUse::Flag disposeParentStream);
+
+/**
+ * Set the read-ahead size FSNode::createReadStream() applies to files
+ * big enough to benefit from it. 0, the default, disables it.
+ *
+ * The first call also sets up the queue of the I/O thread, so it has to
+ * happen at startup, once the backend is initialized and before streams
+ * are used on several threads.
+ */
+void setDefaultReadAheadSize(uint32 size);
+
+/** Return the size set with setDefaultReadAheadSize(). */
+uint32 getDefaultReadAheadSize();
+
+/**
+ * Wrap @p stream according to the default read-ahead size, taking
+ * ownership of it. Streams smaller than twice that size are returned
+ * unchanged.
+ */
+SeekableReadStream *wrapDefaultReadAheadStream(SeekableReadStream *stream);
+
+/**
+ * Wait for the I/O thread to finish and free its resources. All
+ * read-ahead streams must be deleted before.
+ */
+void shutdownReadAhead();
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,69 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/simd.h"
+
+namespace Common {
+
+namespace {
+
+enum {
+	kSimdSSE2 = 1 << 0,
+	kSimdAVX2 = 1 << 1,
+	kSimdNEON = 1 << 2
+};
+
+uint32 g_simdFeatures = 0;
+
+uint32 simdFlag(OSystem::Feature f) {
+	switch (f) {
+	case OSystem::kFeatureCpuSSE2:
+		return kSimdSSE2;
+	case OSystem::kFeatureCpuAVX2:
+		return kSimdAVX2;
+	case OSystem::kFeatureCpuNEON:
+		return kSimdNEON;
+	default:
+		return 0;
+	}
+}
+
+} // End of anonymous namespace
+
+void initSimdFeatures() {
+	static const OSystem::Feature features[] = {
+		OSystem::kFeatureCpuSSE2, OSystem::kFeatureCpuAVX2, OSystem::kFeatureCpuNEON
+	};
+
+	uint32 flags = 0;
+	for (uint i = 0; i < ARRAYSIZE(features); ++i) {
+		if (g_system->hasFeature(features[i]))
+			flags |= simdFlag(features[i]);
+	}
+	g_simdFeatures = flags;
+}
+
+bool hasSimdFeature(OSystem::Feature f) {
+	return (g_simdFeatures & simdFlag(f)) != 0;
+}
+
+} // End of namespace Common
@@ -0,0 +1,74 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_SIMD_H
+#define COMMON_SIMD_H
+
+#include "common/scummsys.h"
+#include "common/system.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_simd SIMD dispatch
+ * @ingroup common
+ *
+ * @brief API for choosing between scalar and vectorized code at runtime.
+ * @{
+ */
+
+/**
+ * Query the backend for the kFeatureCpu* features once. Called by
+ * OSystem::initBackend(), before any thread may use the SIMD code, so
+ * the result never changes while it is read.
+ */
+void initSimdFeatures();
+
+/**
+ * Return whether the CPU supports the kFeatureCpu* feature @p f, as
+ * detected by initSimdFeatures(). Always false before that, so code
+ * running without a backend, like the unit tests, uses the scalar paths.
+ */
+bool hasSimdFeature(OSystem::Feature f);
+
+/**
+ * Pick the table of functions to use from the variants of some code.
+ * Pass nullptr for the variants which are not built, or which do not
+ * apply to the current configuration. The best variant the CPU supports
+ * wins, @p generic if there is none.
+ */
+template<class Procs>
+const Procs &selectSimdProcs(const Procs &generic, const Procs *neon, const Procs *sse2, const Procs *avx2) {
+	if (avx2 && hasSimdFeature(OSystem::kFeatureCpuAVX2))
+		return *avx2;
+	if (sse2 && hasSimdFeature(OSystem::kFeatureCpuSSE2))
+		return *sse2;
+	if (neon && hasSimdFeature(OSystem::kFeatureCpuNEON))
+		return *neon;
+	return generic;
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,80 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/str-pool.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(StringPool);
+
+StringPool::StringPool() : _blockPos(nullptr), _blockLeft(0) {
+}
+
+StringPool::~StringPool() {
+	clear();
+}
+
+const char *StringPool::intern(const StringView &str) {
+	InternMap::const_iterator it = _strings.find(str);
+	if (it != _strings.end())
+		return it->_value;
+
+	const uint32 size = str.size() + 1;
+	char *copy;
+	if (size > kBlockSize / 4) {
+		// Long strings get a block of their own, instead of wasting the
+		// rest of the current one
+		copy = new char[size];
+		_blocks.push_back(copy);
+	} else {
+		if (size > _blockLeft) {
+			_blockPos = new char[kBlockSize];
+			_blockLeft = kBlockSize;
+			_blocks.push_back(_blockPos);
+		}
+		copy = _blockPos;
+		_blockPos += size;
+		_blockLeft -= size;
+	}
+
+	memcpy(copy, str.data(), str.size());
+	copy[str.size()] = 0;
+
+	// The key refers to the copy, which lives as long as the entry
+	_strings[StringView(copy, str.size())] = copy;
+	return copy;
+}
+
+const char *StringPool::find(const StringView &str) const {
+	return _strings.getVal(str, nullptr);
+}
+
+void StringPool::clear() {
+	_strings.clear();
+	for (uint i = 0; i < _blocks.size(); ++i)
+		delete[] _blocks[i];
+	_blocks.clear();
+	_blockPos = nullptr;
+	_blockLeft = 0;
+}
+
+} // End of namespace Common
@@ -0,0 +1,90 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_STR_POOL_H
+#define COMMON_STR_POOL_H
+
+#include "common/array.h"
+#include "common/hash-str.h"
+#include "common/singleton.h"
+#include "common/str-view.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_str_pool String pool
+ * @ingroup common
+ *
+ * @brief Interning of strings such as identifiers.
+ *
+ * @{
+ */
+
+/**
+ * Keeps one copy of every string added to it. Interned strings are equal
+ * exactly if their pointers are, so they can be compared and hashed by
+ * pointer. They stay valid until the pool is cleared or destroyed.
+ *
+ * StringPool::instance() is a global pool, which lives until ScummVM
+ * exits; engines can use a pool of their own to release the strings along
+ * with the engine. Pools are not thread safe.
+ */
+class StringPool : public Singleton<StringPool> {
+public:
+	StringPool();
+	~StringPool();
+
+	/** Return the pooled, null terminated copy of @p str, adding it if needed. */
+	const char *intern(const StringView &str);
+
+	/** Return the pooled copy of @p str, or nullptr if it has not been interned. */
+	const char *find(const StringView &str) const;
+
+	/** Number of distinct strings in the pool. */
+	uint size() const { return _strings.size(); }
+
+	/** Release all strings, invalidating every pointer handed out. */
+	void clear();
+
+private:
+	enum {
+		kBlockSize = 4096
+	};
+
+	typedef HashMap<StringView, const char *> InternMap;
+
+	InternMap _strings;
+	Array<char *> _blocks;
+	char *_blockPos;
+	uint32 _blockLeft;
+};
+
+/** Intern @p str in the global string pool. */
+inline const char *intern(const StringView &str) {
+	return StringPool::instance().intern(str);
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,78 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/str-view.h"
+
+namespace Common {
+
+StringView StringView::trim() const {
+	uint32 begin = 0, end = _size;
+	while (begin < end && isSpace(_str[begin]))
+		++begin;
+	while (end > begin && isSpace(_str[end - 1]))
+		--end;
+	return StringView(_str + begin, end - begin);
+}
+
+int StringView::compareTo(const StringView &x) const {
+	int result = memcmp(_str, x._str, MIN(_size, x._size));
+	if (result)
+		return result;
+	return _size < x._size ? -1 : (_size > x._size ? 1 : 0);
+}
+
+int StringView::compareToIgnoreCase(const StringView &x) const {
+	const uint32 size = MIN(_size, x._size);
+	for (uint32 i = 0; i < size; ++i) {
+		const int l = tolower((byte)_str[i]);
+		const int r = tolower((byte)x._str[i]);
+		if (l != r)
+			return l - r;
+	}
+	return _size < x._size ? -1 : (_size > x._size ? 1 : 0);
+}
+
+uint32 StringView::find(char c, uint32 pos) const {
+	if (pos >= _size)
+		return npos;
+	const char *found = (const char *)memchr(_str + pos, c, _size - pos);
+	return found ? found - _str : npos;
+}
+
+uint32 StringView::find(const StringView &x, uint32 pos) const {
+	if (x._size > _size)
+		return npos;
+	for (uint32 i = pos; i + x._size <= _size; ++i) {
+		if (!memcmp(_str + i, x._str, x._size))
+			return i;
+	}
+	return npos;
+}
+
+uint StringView::hash() const {
+	uint hashResult = (_size ? (byte)_str[0] : 0) << 7;
+	for (uint32 i = 0; i < _size; i++)
+		hashResult = (1000003 * hashResult) ^ (byte)_str[i];
+	return hashResult ^ _size;
+}
+
+} // End of namespace Common
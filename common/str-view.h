@@ -0,0 +1,133 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_STR_VIEW_H
+#define COMMON_STR_VIEW_H
+
+#include "common/scummsys.h"
+#include "common/str.h"
+#include "common/util.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_str_view String views
+ * @ingroup common
+ *
+ * @brief Non-owning references to character sequences.
+ *
+ * @{
+ */
+
+/**
+ * A read-only view of a character sequence, which it neither owns nor
+ * copies. Taking a substring of a view, or looking up a view in a String
+ * keyed HashMap (see HashMap::findAs()), does not allocate.
+ *
+ * A view is only valid as long as the characters it refers to; a view of
+ * a String is invalidated by any change to that String. Views are not
+ * null terminated, so use size() rather than strlen() on data(), and
+ * construct a String from them where a C string is needed.
+ */
+class StringView {
+public:
+	typedef char value_type;
+	typedef const char *const_iterator;
+
+	static const uint32 npos = 0xFFFFFFFF;
+
+	StringView() : _str(""), _size(0) {}
+	StringView(const char *str) : _str(str), _size(strlen(str)) {}
+	StringView(const char *str, uint32 len) : _str(str), _size(len) {}
+	StringView(const char *beginP, const char *endP) : _str(beginP), _size(endP - beginP) {}
+	StringView(const String &str) : _str(str.c_str()), _size(str.size()) {}
+
+	const char *data() const { return _str; }
+	uint32 size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	char operator[](uint32 idx) const {
+		assert(idx < _size);
+		return _str[idx];
+	}
+
+	char firstChar() const { return _size ? _str[0] : 0; }
+	char lastChar() const { return _size ? _str[_size - 1] : 0; }
+
+	const_iterator begin() const { return _str; }
+	const_iterator end() const { return _str + _size; }
+
+	/** Return the view of @p len characters starting at @p pos, clipped to this view. */
+	StringView substr(uint32 pos = 0, uint32 len = npos) const {
+		if (pos >= _size)
+			return StringView(_str + _size, (uint32)0);
+		return StringView(_str + pos, MIN(len, _size - pos));
+	}
+
+	/** Return the view without leading and trailing whitespace. */
+	StringView trim() const;
+
+	bool equals(const StringView &x) const {
+		return _size == x._size && !memcmp(_str, x._str, _size);
+	}
+	bool equalsIgnoreCase(const StringView &x) const {
+		return _size == x._size && !compareToIgnoreCase(x);
+	}
+	int compareTo(const StringView &x) const;
+	int compareToIgnoreCase(const StringView &x) const;
+
+	bool hasPrefix(const StringView &x) const {
+		return x._size <= _size && !memcmp(_str, x._str, x._size);
+	}
+	bool hasSuffix(const StringView &x) const {
+		return x._size <= _size && !memcmp(_str + _size - x._size, x._str, x._size);
+	}
+	bool hasPrefixIgnoreCase(const StringView &x) const {
+		return x._size <= _size && substr(0, x._size).equalsIgnoreCase(x);
+	}
+	bool hasSuffixIgnoreCase(const StringView &x) const {
+		return x._size <= _size && substr(_size - x._size).equalsIgnoreCase(x);
+	}
+
+	/** Return the position of the first @p c at or after @p pos, or npos. */
+	uint32 find(char c, uint32 pos = 0) const;
+	/** Return the position of the first @p x at or after @p pos, or npos. */
+	uint32 find(const StringView &x, uint32 pos = 0) const;
+	bool contains(char c) const { return find(c) != npos; }
+	bool contains(const StringView &x) const { return find(x) != npos; }
+
+	/** Same as String::hash() of a String with the same contents. */
+	uint hash() const;
+
+private:
+	const char *_str;
+	uint32 _size;
+};
+
+inline bool operator==(const StringView &x, const StringView &y) { return x.equals(y); }
+inline bool operator!=(const StringView &x, const StringView &y) { return !x.equals(y); }
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
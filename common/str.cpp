@@ -24,6 +24,7 @@
 #include "common/list.h"
 #include "common/memorypool.h"
 #include "common/str.h"
+#include "common/str-view.h"
 #include "common/util.h"
 #include "common/mutex.h"
 
@@ -76,6 +77,24 @@ String &String::operator+=(char c) {
 	return *this;
 }
 
+String::String(const StringView &view) : BaseString<char>(view.data(), view.size()) {
+}
+
+String &String::operator+=(const StringView &view) {
+	if (pointerInOwnBuffer(view.data())) {
+		assignAppend(String(view));
+		return *this;
+	}
+
+	if (!view.empty()) {
+		ensureCapacity(_size + view.size(), true);
+		memcpy(_str + _size, view.data(), view.size());
+		_size += view.size();
+		_str[_size] = 0;
+	}
+	return *this;
+}
+
 bool String::hasPrefix(const String &x) const {
 	return hasPrefix(x.c_str());
 }
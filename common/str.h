@@ -42,6 +42,7 @@ namespace Common {
  */
 
 class U32String;
+class StringView;
 
 /**
  * Simple string class for ScummVM. Provides automatic storage managment,
@@ -87,12 +88,16 @@ public:
 	/** Construct a new string from the given u32 string. */
 	String(const U32String &str);
 
+	/** Construct a new string with a copy of the characters of @p view. */
+	explicit String(const StringView &view);
+
 	String &operator=(const char *str);
 	String &operator=(const String &str);
 	String &operator=(char c);
 	String &operator+=(const char *str);
 	String &operator+=(const String &str);
 	String &operator+=(char c);
+	String &operator+=(const StringView &view);
 
 	bool equalsIgnoreCase(const String &x) const;
 	int compareToIgnoreCase(const String &x) const; // stricmp clone
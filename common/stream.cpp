@@ -225,6 +225,12 @@ SeekableSubReadStream::SeekableSubReadStream(SeekableReadStream *parentStream, u
 	_eos = false;
 }
 
+void SeekableSubReadStream::prefetch(int32 offset, uint32 size) {
+	if (offset < 0 || (uint32)offset >= _end - _begin)
+		return;
+	_parentStream->prefetch(_begin + offset, MIN(size, _end - _begin - offset));
+}
+
 bool SeekableSubReadStream::seek(int32 offset, int whence) {
 	assert(_pos >= _begin);
 	assert(_pos <= _end);
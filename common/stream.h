@@ -619,6 +619,13 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Hint that the @p size bytes at @p offset will be read soon. Streams
+	 * backed by slow storage may start loading them in the background,
+	 * all others ignore the hint.
+	 */
+	virtual void prefetch(int32 offset, uint32 size) {}
+
 	/**
 	 * Reads at most one less than the number of characters specified
 	 * by bufSize from the and stores them in the string buf. Reading
@@ -25,7 +25,9 @@
 #include "common/system.h"
 #include "common/events.h"
 #include "common/fs.h"
+#include "common/rect.h"
 #include "common/savefile.h"
+#include "common/simd.h"
 #include "common/str.h"
 #include "common/taskbar.h"
 #include "common/updates.h"
@@ -118,6 +120,8 @@ void OSystem::initBackend() {
 // 	if (!_fsFactory)
 // 		error("Backend failed to instantiate fs factory");
 
+	Common::initSimdFeatures();
+
 	_backendInitialized = true;
 }
 
@@ -190,6 +194,15 @@ bool OSystem::setStretchMode(const char *name) {
 	return false;
 }
 
+void OSystem::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint numRects) {
+	const int bytesPerPixel = getScreenFormat().bytesPerPixel;
+	for (uint i = 0; i < numRects; ++i) {
+		const Common::Rect &r = rects[i];
+		copyRectToScreen((const byte *)buf + r.top * pitch + r.left * bytesPerPixel, pitch,
+		                 r.left, r.top, r.width(), r.height());
+	}
+}
+
 void OSystem::fatalError() {
 	quit();
 	exit(1);
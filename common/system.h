@@ -463,7 +463,25 @@ public:
 		/**
 		* For platforms that should not have a Quit button
 		*/
-		kFeatureNoQuit
+		kFeatureNoQuit,
+
+		/**
+		* The CPU supports SSE2 instructions. Code built with
+		* SCUMMVM_SSE2 may only use them if this feature is present.
+		*/
+		kFeatureCpuSSE2,
+
+		/**
+		* The CPU supports AVX2 instructions. Code built with
+		* SCUMMVM_AVX2 may only use them if this feature is present.
+		*/
+		kFeatureCpuAVX2,
+
+		/**
+		* The CPU supports NEON instructions. Code built with
+		* SCUMMVM_NEON may only use them if this feature is present.
+		*/
+		kFeatureCpuNEON
 
 	};
 
@@ -945,6 +963,25 @@ public:
 	 */
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) = 0;
 
+	/**
+	 * Blit several areas of a bitmap to the virtual screen in one go.
+	 * This is equivalent to calling copyRectToScreen() for every rectangle,
+	 * but allows backends to lock and upload their screen surface once per
+	 * batch instead of once per rectangle.
+	 *
+	 * @param buf		the buffer containing the graphics data source, laid
+	 *					out like the whole screen
+	 * @param pitch		the pitch of the buffer (number of bytes in a scanline)
+	 * @param rects		the areas to copy, both in the buffer and on screen
+	 * @param numRects	the number of rectangles
+	 *
+	 * @note The same restrictions as for copyRectToScreen() apply to every
+	 *       rectangle.
+	 *
+	 * @see copyRectToScreen
+	 */
+	virtual void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint numRects);
+
 	/**
 	 * Lock the active screen framebuffer and return a Graphics::Surface
 	 * representing it. The caller can then perform arbitrary graphics
@@ -1308,6 +1345,88 @@ public:
 
 
 
+	/**
+	 * @name Threads
+	 *
+	 * Backends may allow ScummVM code to spread independent work over
+	 * several CPU cores. Thread support is optional: code using it must
+	 * always be prepared to do the work on the calling thread when
+	 * createThread() fails. Common::WorkerPool takes care of that.
+	 */
+	//@{
+
+	typedef struct OpaqueThread *ThreadRef;
+	typedef int (*ThreadProc)(void *param);
+
+	/**
+	 * Start a new thread executing @p proc.
+	 *
+	 * @param proc	the function to run on the new thread.
+	 * @param param	the parameter passed to @p proc.
+	 * @return the new thread, or 0 if threads are not supported or an error occurred.
+	 */
+	virtual ThreadRef createThread(ThreadProc proc, void *param) { return 0; }
+
+	/**
+	 * Wait until the given thread finished and release it.
+	 *
+	 * @param thread	the thread to wait for.
+	 * @return the value returned by the thread procedure.
+	 */
+	virtual int waitThread(ThreadRef thread) { return 0; }
+
+	/**
+	 * Return the number of CPU cores which may be used by threads created
+	 * through createThread().
+	 */
+	virtual uint getCpuCount() { return 1; }
+
+	typedef struct OpaqueSemaphore *SemaphoreRef;
+
+	/**
+	 * Create a new counting semaphore. Backends implementing createThread()
+	 * must implement the semaphore methods as well.
+	 *
+	 * @param value	the initial value of the semaphore.
+	 * @return the newly created semaphore, or 0 if threads are not supported or an error occurred.
+	 */
+	virtual SemaphoreRef createSemaphore(uint value) { return 0; }
+
+	/**
+	 * Wait until the value of the given semaphore is greater than zero,
+	 * then decrement it.
+	 *
+	 * @param sem	the semaphore to wait for.
+	 */
+	virtual void waitSemaphore(SemaphoreRef sem) {}
+
+	/**
+	 * Like waitSemaphore(), but give up after the given time.
+	 *
+	 * @param sem	the semaphore to wait for.
+	 * @param msecs	the maximum time to wait, in milliseconds.
+	 * @return true if the semaphore was decremented, false on timeout.
+	 */
+	virtual bool waitSemaphoreTimeout(SemaphoreRef sem, uint msecs) { return false; }
+
+	/**
+	 * Increment the value of the given semaphore, waking up one waiting thread.
+	 *
+	 * @param sem	the semaphore to post.
+	 */
+	virtual void postSemaphore(SemaphoreRef sem) {}
+
+	/**
+	 * Delete the given semaphore. No thread may be waiting for it anymore.
+	 *
+	 * @param sem	the semaphore to delete.
+	 */
+	virtual void deleteSemaphore(SemaphoreRef sem) {}
+
+	//@}
+
+
+
 	/** @name Sound */
 	//@{
 
@@ -43,6 +43,10 @@ bool StringTokenizer::empty() const {
 }
 
 String StringTokenizer::nextToken() {
+	return String(nextTokenView());
+}
+
+StringView StringTokenizer::nextTokenView() {
 	// Seek to next token's start (i.e. jump over the delimiters before next token)
 	for (_tokenBegin = _tokenEnd; _tokenBegin < _str.size() && _delimiters.contains(_str[_tokenBegin]); _tokenBegin++)
 		;
@@ -50,7 +54,7 @@ String StringTokenizer::nextToken() {
 	for (_tokenEnd = _tokenBegin; _tokenEnd < _str.size() && !_delimiters.contains(_str[_tokenEnd]); _tokenEnd++)
 		;
 	// Return the found token
-	return String(_str.c_str() + _tokenBegin, _tokenEnd - _tokenBegin);
+	return StringView(_str.c_str() + _tokenBegin, _tokenEnd - _tokenBegin);
 }
 
 U32StringTokenizer::U32StringTokenizer(const U32String &str, const String &delimiters) : _str(str), _delimiters(delimiters) {
@@ -25,6 +25,7 @@
 
 #include "common/scummsys.h"
 #include "common/str.h"
+#include "common/str-view.h"
 #include "common/ustr.h"
 
 namespace Common {
@@ -56,6 +57,7 @@ public:
 	void reset();       ///< Resets the tokenizer to its initial state
 	bool empty() const; ///< Returns true if there are no more tokens left in the string, false otherwise
 	String nextToken(); ///< Returns the next token from the string (Or an empty string if there are no more tokens)
+	StringView nextTokenView(); ///< Same as nextToken(), but returns a view into the tokenizer's copy of the string, valid as long as the tokenizer
 
 private:
 	const String _str;        ///< The string to be tokenized
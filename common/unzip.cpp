@@ -106,6 +106,9 @@ typedef struct {
 #include "common/fs.h"
 #include "common/unzip.h"
 #include "common/memstream.h"
+#include "common/endian.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -339,6 +342,90 @@ const char unz_copyright[] =
    " unzip 0.15 Copyright 1998 Gilles Vollant ";
 #endif
 
+namespace Common {
+
+/**
+ * The archive stream of a ZipArchive, shared by the archive and all its
+ * member streams, which may be read from different threads. Reads go
+ * through readAt(), which serializes them and skips the seek when the
+ * stream is already at the right position.
+ */
+class ZipSharedStream {
+public:
+	/** Holds the lock while the unzip code uses the stream directly. */
+	class Lock {
+	public:
+		explicit Lock(ZipSharedStream &stream) : _stream(stream) { _stream.lock(); }
+		~Lock() { _stream.unlock(); }
+
+	private:
+		ZipSharedStream &_stream;
+	};
+
+	explicit ZipSharedStream(SeekableReadStream *stream);
+	~ZipSharedStream();
+
+	uint32 readAt(uint32 offset, void *dataPtr, uint32 dataSize);
+	void prefetch(uint32 offset, uint32 size);
+
+private:
+	void lock();
+	void unlock();
+
+	SeekableReadStream *_stream;
+	/** Not needed without a backend, e.g. in the unit tests, as there are no threads then. */
+	Mutex *_mutex;
+	/** Position of _stream, or -1 after direct use. */
+	int32 _pos;
+};
+
+ZipSharedStream::ZipSharedStream(SeekableReadStream *stream)
+	: _stream(stream), _mutex(g_system ? new Mutex() : nullptr), _pos(-1) {
+}
+
+ZipSharedStream::~ZipSharedStream() {
+	delete _stream;
+	delete _mutex;
+}
+
+void ZipSharedStream::lock() {
+	if (_mutex)
+		_mutex->lock();
+}
+
+void ZipSharedStream::unlock() {
+	// The unzip code moved the stream behind our back
+	_pos = -1;
+	if (_mutex)
+		_mutex->unlock();
+}
+
+uint32 ZipSharedStream::readAt(uint32 offset, void *dataPtr, uint32 dataSize) {
+	if (_mutex)
+		_mutex->lock();
+
+	uint32 len = 0;
+	if (_pos == (int32)offset || _stream->seek(offset, SEEK_SET))
+		len = _stream->read(dataPtr, dataSize);
+	_pos = (len == dataSize) ? (int32)(offset + len) : -1;
+
+	if (_mutex)
+		_mutex->unlock();
+	return len;
+}
+
+void ZipSharedStream::prefetch(uint32 offset, uint32 size) {
+	if (_mutex)
+		_mutex->lock();
+
+	_stream->prefetch(offset, size);
+
+	if (_mutex)
+		_mutex->unlock();
+}
+
+} // End of namespace Common
+
 /* unz_file_info_interntal contain internal info about a file in zipfile*/
 typedef struct {
     uLong offset_curfile;/* relative offset of local header 4 bytes */
@@ -398,6 +485,8 @@ typedef struct {
 	file_in_zip_read_info_s* pfile_in_zip_read;		/* structure about the current
 													file if we are decompressing it */
 	ZipHash _hash;
+	bool _hashBuilt;				/* _hash holds the whole central directory */
+	Common::SharedPtr<Common::ZipSharedStream> _streamRef;	/* owns _stream, shared with member streams */
 } unz_s;
 
 /* ===========================================================================
@@ -544,6 +633,7 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 	int err=UNZ_OK;
 
 	us->_stream = stream;
+	us->_streamRef = Common::SharedPtr<Common::ZipSharedStream>(new Common::ZipSharedStream(stream));
 
 	central_pos = unzlocal_SearchCentralDir(*us->_stream);
 	if (central_pos==0)
@@ -595,7 +685,7 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 		err=UNZ_BADZIPFILE;
 
 	if (err != UNZ_OK) {
-		delete us->_stream;
+		// Releasing _streamRef deletes the stream
 		delete us;
 		return nullptr;
 	}
@@ -604,28 +694,14 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 		                    (us->offset_central_dir+us->size_central_dir);
 	us->central_pos = central_pos;
 	us->pfile_in_zip_read = nullptr;
+	us->num_file = 0;
+	us->pos_in_central_dir = us->offset_central_dir;
+	us->current_file_ok = 0;
 
-	err = unzGoToFirstFile((unzFile)us);
-
-	while (err == UNZ_OK) {
-		// Get the file details
-		char szCurrentFileName[UNZ_MAXFILENAMEINZIP+1];
-		unzGetCurrentFileInfo(us, nullptr, szCurrentFileName, sizeof(szCurrentFileName) - 1,
-							nullptr, 0, nullptr, 0);
-
-		// Save details into the hash
-		cached_file_in_zip fe;
-		fe.num_file = us->num_file;
-		fe.pos_in_central_dir = us->pos_in_central_dir;
-		fe.current_file_ok = us->current_file_ok;
-		fe.cur_file_info = us->cur_file_info;
-		fe.cur_file_info_internal = us->cur_file_info_internal;
-
-		us->_hash[Common::String(szCurrentFileName)] = fe;
+	// The central directory is only read once a member is looked up,
+	// see unzlocal_BuildHash().
+	us->_hashBuilt = false;
 
-		// Move to the next file
-		err = unzGoToNextFile((unzFile)us);
-	}
 	return (unzFile)us;
 }
 
@@ -644,7 +720,7 @@ int unzClose(unzFile file) {
 	if (s->pfile_in_zip_read != nullptr)
 		unzCloseCurrentFile(file);
 
-	delete s->_stream;
+	// The stream is deleted together with the last member stream using it
 	delete s;
 	return UNZ_OK;
 }
@@ -906,6 +982,73 @@ int unzGoToNextFile(unzFile file) {
 	return err;
 }
 
+/*
+  Read the whole central directory with a single read and index it by name.
+  The entries are parsed from memory instead of seeking to every record, and
+  this is deferred until the first lookup so that merely opening an archive
+  stays cheap.
+*/
+static void unzlocal_BuildHash(unz_s *s) {
+	if (s->_hashBuilt)
+		return;
+	s->_hashBuilt = true;
+
+	if (s->size_central_dir == 0)
+		return;
+
+	byte *buf = (byte *)malloc(s->size_central_dir);
+	if (buf == nullptr)
+		return;
+
+	s->_stream->seek(s->offset_central_dir + s->byte_before_the_zipfile, SEEK_SET);
+	uLong size = s->_stream->read(buf, s->size_central_dir);
+
+	uLong pos = 0;
+	for (uLong i = 0; i < s->gi.number_entry; i++) {
+		if (size - pos < SIZECENTRALDIRITEM)
+			break;
+
+		const byte *entry = buf + pos;
+		if (READ_LE_UINT32(entry) != 0x02014b50)
+			break;
+
+		cached_file_in_zip fe;
+		unz_file_info &info = fe.cur_file_info;
+		info.version = READ_LE_UINT16(entry + 4);
+		info.version_needed = READ_LE_UINT16(entry + 6);
+		info.flag = READ_LE_UINT16(entry + 8);
+		info.compression_method = READ_LE_UINT16(entry + 10);
+		info.dosDate = READ_LE_UINT32(entry + 12);
+		unzlocal_DosDateToTmuDate(info.dosDate, &info.tmu_date);
+		info.crc = READ_LE_UINT32(entry + 16);
+		info.compressed_size = READ_LE_UINT32(entry + 20);
+		info.uncompressed_size = READ_LE_UINT32(entry + 24);
+		info.size_filename = READ_LE_UINT16(entry + 28);
+		info.size_file_extra = READ_LE_UINT16(entry + 30);
+		info.size_file_comment = READ_LE_UINT16(entry + 32);
+		info.disk_num_start = READ_LE_UINT16(entry + 34);
+		info.internal_fa = READ_LE_UINT16(entry + 36);
+		info.external_fa = READ_LE_UINT32(entry + 38);
+		fe.cur_file_info_internal.offset_curfile = READ_LE_UINT32(entry + 42);
+
+		uLong recordSize = SIZECENTRALDIRITEM + info.size_filename +
+			info.size_file_extra + info.size_file_comment;
+		if (size - pos < recordSize)
+			break;
+
+		fe.num_file = i;
+		fe.pos_in_central_dir = s->offset_central_dir + pos;
+		fe.current_file_ok = 1;
+
+		uLong nameSize = MIN<uLong>(info.size_filename, UNZ_MAXFILENAMEINZIP - 1);
+		s->_hash[Common::String((const char *)entry + SIZECENTRALDIRITEM, nameSize)] = fe;
+
+		pos += recordSize;
+	}
+
+	free(buf);
+}
+
 /*
   Try locate the file szFileName in the zipfile.
   For the iCaseSensitivity signification, see unzipStringFileNameCompare
@@ -924,11 +1067,10 @@ int unzLocateFile(unzFile file, const char *szFileName, int iCaseSensitivity) {
 		return UNZ_PARAMERROR;
 
 	s=(unz_s*)file;
-	if (!s->current_file_ok)
-		return UNZ_END_OF_LIST_OF_FILE;
+	unzlocal_BuildHash(s);
 
 	// Check to see if the entry exists
-	ZipHash::iterator i = s->_hash.find(Common::String(szFileName));
+	ZipHash::iterator i = s->_hash.findAs(Common::StringView(szFileName));
 	if (i == s->_hash.end())
 		return UNZ_END_OF_LIST_OF_FILE;
 
@@ -1419,8 +1561,336 @@ int unzGetGlobalComment(unzFile file, char *szComment, uLong uSizeBuf) {
 
 namespace Common {
 
+/**
+ * Base class of the member streams handed out by ZipArchive. Member data is
+ * read on demand from the archive stream, which is shared with the archive so
+ * that a member stream stays valid after its archive has been deleted. Several
+ * members can be open and read at a time, even from different threads.
+ *
+ * The CRC is checked as soon as the member has been read up to its end.
+ */
+class ZipMemberStream : public SeekableReadStream {
+public:
+	ZipMemberStream(const SharedPtr<ZipSharedStream> &parent, uint32 dataOffset, const unz_file_info &info, const String &name);
+
+	bool eos() const { return _eos; }
+	bool err() const { return _err; }
+	void clearErr() { _eos = false; }
+
+	int32 pos() const { return _pos; }
+	int32 size() const { return _size; }
+	bool seek(int32 offset, int whence = SEEK_SET);
+
+protected:
+	/** Move to the given position, which is known to be inside the member. */
+	virtual bool seekTo(uint32 target) = 0;
+
+	/** Feed the @p len bytes just produced at _pos into the running CRC. */
+	void updateCrc(const byte *data, uint32 len);
+
+	SharedPtr<ZipSharedStream> _parent;
+	uint32 _dataOffset;
+	uint32 _size;
+	uint32 _pos;
+	bool _eos;
+	bool _err;
+
+private:
+	String _name;
+	uint32 _crcExpected;
+	uint32 _crc;
+	uint32 _crcPos;
+};
+
+ZipMemberStream::ZipMemberStream(const SharedPtr<ZipSharedStream> &parent, uint32 dataOffset, const unz_file_info &info, const String &name)
+	: _parent(parent), _dataOffset(dataOffset), _size(info.uncompressed_size), _pos(0), _eos(false), _err(false),
+	  _name(name), _crcExpected(info.crc), _crc(0), _crcPos(0) {
+}
+
+bool ZipMemberStream::seek(int32 offset, int whence) {
+	switch (whence) {
+	case SEEK_END:
+		offset = _size + offset;
+		break;
+	case SEEK_CUR:
+		offset = _pos + offset;
+		break;
+	case SEEK_SET:
+	default:
+		break;
+	}
+
+	if (offset < 0 || (uint32)offset > _size)
+		return false;
+
+	if (!seekTo(offset))
+		return false;
+
+	_eos = false;
+	return true;
+}
+
+void ZipMemberStream::updateCrc(const byte *data, uint32 len) {
+#ifdef USE_ZLIB
+	// Only data following the part already checked counts, which is what
+	// reading the member front to back produces. Re-reads after seeking
+	// backwards are skipped.
+	if (_pos > _crcPos || _pos + len <= _crcPos)
+		return;
+
+	uint32 skip = _crcPos - _pos;
+	_crc = ::crc32(_crc, data + skip, len - skip);
+	_crcPos += len - skip;
+
+	if (_crcPos == _size && _crc != _crcExpected) {
+		warning("ZipArchive: CRC mismatch in '%s'", _name.c_str());
+		_err = true;
+	}
+#endif
+}
+
+/**
+ * Stream for a member stored without compression. This is a window on the
+ * archive stream, nothing is copied up front.
+ */
+class ZipStoredStream : public ZipMemberStream {
+public:
+	ZipStoredStream(const SharedPtr<ZipSharedStream> &parent, uint32 dataOffset, const unz_file_info &info, const String &name)
+		: ZipMemberStream(parent, dataOffset, info, name) {
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize);
+
+	void prefetch(int32 offset, uint32 size) {
+		if (offset >= 0 && (uint32)offset < _size)
+			_parent->prefetch(_dataOffset + offset, MIN(size, _size - offset));
+	}
+
+protected:
+	bool seekTo(uint32 target) {
+		_pos = target;
+		return true;
+	}
+};
+
+uint32 ZipStoredStream::read(void *dataPtr, uint32 dataSize) {
+	if (dataSize > _size - _pos) {
+		dataSize = _size - _pos;
+		_eos = true;
+	}
+	if (dataSize == 0)
+		return 0;
+
+	uint32 len = _parent->readAt(_dataOffset + _pos, dataPtr, dataSize);
+	if (len != dataSize)
+		_err = true;
+
+	updateCrc((const byte *)dataPtr, len);
+	_pos += len;
+	return len;
+}
+
+#ifdef USE_ZLIB
+
+/**
+ * Stream for a deflated member, inflated on demand as it is read.
+ *
+ * Seeking forward decodes and drops the data in between. To keep seeking
+ * backwards cheap in large members, the decoder state is saved every
+ * kCheckpointSpan bytes of output at a deflate block boundary: the input
+ * position, the bits of the partially consumed input byte and the last
+ * 32 KB of output. A backward seek restarts from the closest checkpoint
+ * instead of from the start of the member.
+ */
+class ZipInflateStream : public ZipMemberStream {
+public:
+	ZipInflateStream(const SharedPtr<ZipSharedStream> &parent, uint32 dataOffset, const unz_file_info &info, const String &name);
+	~ZipInflateStream();
+
+	uint32 read(void *dataPtr, uint32 dataSize);
+
+protected:
+	bool seekTo(uint32 target);
+
+private:
+	enum {
+		kBufSize = 16384,
+		kWindowSize = 32768,
+		kCheckpointSpan = 1024 * 1024
+	};
+
+	struct Checkpoint {
+		uint32 outPos;
+		uint32 inPos;
+		int bits;
+		uint32 windowSize;
+		byte *window;
+	};
+
+	/** Inflate up to @p len bytes into @p dst and advance _pos. */
+	uint32 inflateTo(byte *dst, uint32 len);
+
+	void addCheckpoint(uint32 outPos);
+	void restart(const Checkpoint *checkpoint);
+
+	z_stream _stream;
+	bool _initialized;
+	bool _finished;
+	uint32 _compressedSize;
+	uint32 _inPos;
+	Array<Checkpoint> _checkpoints;
+	byte _buf[kBufSize];
+};
+
+ZipInflateStream::ZipInflateStream(const SharedPtr<ZipSharedStream> &parent, uint32 dataOffset, const unz_file_info &info, const String &name)
+	: ZipMemberStream(parent, dataOffset, info, name), _stream(), _finished(false),
+	  _compressedSize(info.compressed_size), _inPos(0) {
+	// Negative windowBits: raw deflate data without zlib header
+	_initialized = (inflateInit2(&_stream, -MAX_WBITS) == Z_OK);
+	if (!_initialized)
+		_err = true;
+}
+
+ZipInflateStream::~ZipInflateStream() {
+	if (_initialized)
+		inflateEnd(&_stream);
+
+	for (uint i = 0; i < _checkpoints.size(); ++i)
+		free(_checkpoints[i].window);
+}
+
+uint32 ZipInflateStream::read(void *dataPtr, uint32 dataSize) {
+	if (dataSize > _size - _pos) {
+		dataSize = _size - _pos;
+		_eos = true;
+	}
+
+	uint32 len = inflateTo((byte *)dataPtr, dataSize);
+	if (len < dataSize)
+		_eos = true;
+	return len;
+}
+
+uint32 ZipInflateStream::inflateTo(byte *dst, uint32 len) {
+	if (len == 0 || _err)
+		return 0;
+
+	_stream.next_out = dst;
+	_stream.avail_out = len;
+
+	while (_stream.avail_out > 0 && !_finished) {
+		if (_stream.avail_in == 0 && _inPos < _compressedSize) {
+			uint32 chunk = MIN<uint32>(kBufSize, _compressedSize - _inPos);
+			if (_parent->readAt(_dataOffset + _inPos, _buf, chunk) != chunk) {
+				_err = true;
+				break;
+			}
+			_inPos += chunk;
+			_stream.next_in = _buf;
+			_stream.avail_in = chunk;
+		}
+
+		// Z_BLOCK returns at every block boundary, which is where
+		// checkpoints can be taken. Running out of input before the end
+		// of the deflate data fails with Z_BUF_ERROR.
+		int zlibErr = inflate(&_stream, Z_BLOCK);
+		if (zlibErr == Z_STREAM_END) {
+			_finished = true;
+		} else if (zlibErr != Z_OK) {
+			_err = true;
+			break;
+		} else if ((_stream.data_type & 128) && !(_stream.data_type & 64)) {
+			addCheckpoint(_pos + len - _stream.avail_out);
+		}
+	}
+
+	uint32 produced = len - _stream.avail_out;
+	updateCrc(dst, produced);
+	_pos += produced;
+	return produced;
+}
+
+void ZipInflateStream::addCheckpoint(uint32 outPos) {
+#if ZLIB_VERNUM >= 0x1280
+	uint32 lastPos = _checkpoints.empty() ? 0 : _checkpoints.back().outPos;
+	if (outPos < lastPos + kCheckpointSpan)
+		return;
+
+	Checkpoint checkpoint;
+	checkpoint.outPos = outPos;
+	checkpoint.inPos = _inPos - _stream.avail_in;
+	checkpoint.bits = _stream.data_type & 7;
+	checkpoint.window = (byte *)malloc(kWindowSize);
+	if (!checkpoint.window)
+		return;
+
+	uInt windowSize = kWindowSize;
+	if (inflateGetDictionary(&_stream, checkpoint.window, &windowSize) != Z_OK) {
+		free(checkpoint.window);
+		return;
+	}
+	checkpoint.windowSize = windowSize;
+
+	_checkpoints.push_back(checkpoint);
+#endif
+}
+
+void ZipInflateStream::restart(const Checkpoint *checkpoint) {
+	inflateReset(&_stream);
+	_stream.avail_in = 0;
+	_finished = false;
+	_inPos = 0;
+	_pos = 0;
+
+#if ZLIB_VERNUM >= 0x1280
+	if (!checkpoint)
+		return;
+
+	_inPos = checkpoint->inPos;
+	if (checkpoint->bits) {
+		// The checkpoint lies inside the last byte consumed, hand its
+		// remaining bits to the decoder
+		byte partial = 0;
+		_parent->readAt(_dataOffset + _inPos - 1, &partial, 1);
+		inflatePrime(&_stream, checkpoint->bits, partial >> (8 - checkpoint->bits));
+	}
+	inflateSetDictionary(&_stream, checkpoint->window, checkpoint->windowSize);
+	_pos = checkpoint->outPos;
+#endif
+}
+
+bool ZipInflateStream::seekTo(uint32 target) {
+	if (_err)
+		return false;
+
+	const Checkpoint *checkpoint = nullptr;
+	for (uint i = _checkpoints.size(); i-- > 0; ) {
+		if (_checkpoints[i].outPos <= target) {
+			checkpoint = &_checkpoints[i];
+			break;
+		}
+	}
+
+	// Decode forward from the current position unless the target lies
+	// behind it or a checkpoint gets us closer
+	if (target < _pos || (checkpoint && checkpoint->outPos > _pos))
+		restart(checkpoint);
+
+	byte scratch[4096];
+	while (_pos < target) {
+		if (inflateTo(scratch, MIN<uint32>(sizeof(scratch), target - _pos)) == 0)
+			return false;
+	}
+
+	return !_err;
+}
+
+#endif
 
 class ZipArchive : public Archive {
+	/** Deflated members up to this size are inflated into memory right away. */
+	static const uint32 kMaxBufferedMemberSize = 64 * 1024;
+
 	unzFile _zipFile;
 
 public:
@@ -1462,13 +1932,16 @@ ZipArchive::~ZipArchive() {
 }
 
 bool ZipArchive::hasFile(const String &name) const {
+	ZipSharedStream::Lock lock(*((unz_s *)_zipFile)->_streamRef);
 	return (unzLocateFile(_zipFile, name.c_str(), 2) == UNZ_OK);
 }
 
 int ZipArchive::listMembers(ArchiveMemberList &list) const {
 	int members = 0;
 
-	const unz_s *const archive = (const unz_s *)_zipFile;
+	unz_s *const archive = (unz_s *)_zipFile;
+	ZipSharedStream::Lock lock(*archive->_streamRef);
+	unzlocal_BuildHash(archive);
 	for (ZipHash::const_iterator i = archive->_hash.begin(), end = archive->_hash.end();
 	     i != end; ++i) {
 		list.push_back(ArchiveMemberList::value_type(new GenericArchiveMember(i->_key, this)));
@@ -1486,35 +1959,47 @@ const ArchiveMemberPtr ZipArchive::getMember(const String &name) const {
 }
 
 SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) const {
+	unz_s *s = (unz_s *)_zipFile;
+	ZipSharedStream::Lock lock(*s->_streamRef);
+
 	if (unzLocateFile(_zipFile, name.c_str(), 2) != UNZ_OK)
 		return nullptr;
 
-	unz_file_info fileInfo;
-	if (unzOpenCurrentFile(_zipFile) != UNZ_OK)
+	uInt iSizeVar;
+	uLong offset_local_extrafield;
+	uInt size_local_extrafield;
+	if (unzlocal_CheckCurrentFileCoherencyHeader(s, &iSizeVar, &offset_local_extrafield, &size_local_extrafield) != UNZ_OK)
 		return nullptr;
 
-	if (unzGetCurrentFileInfo(_zipFile, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK)
-		return nullptr;
+	const unz_file_info &fileInfo = s->cur_file_info;
+	uint32 dataOffset = s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar + s->byte_before_the_zipfile;
 
-	byte *buffer = (byte *)malloc(fileInfo.uncompressed_size);
+	if (fileInfo.compression_method == 0)
+		return new ZipStoredStream(s->_streamRef, dataOffset, fileInfo, name);
+
+#ifdef USE_ZLIB
+	ZipInflateStream *stream = new ZipInflateStream(s->_streamRef, dataOffset, fileInfo, name);
+	if (fileInfo.uncompressed_size > kMaxBufferedMemberSize)
+		return stream;
+
+	// Small members are cheaper to hold inflated than the decoder state
+	byte *buffer = (byte *)malloc(MAX<uLong>(fileInfo.uncompressed_size, 1));
 	assert(buffer);
 
-	if (unzReadCurrentFile(_zipFile, buffer, fileInfo.uncompressed_size) != (int)fileInfo.uncompressed_size) {
-		free(buffer);
-		return nullptr;
-	}
+	uint32 size = stream->read(buffer, fileInfo.uncompressed_size);
+	bool valid = (size == fileInfo.uncompressed_size) && !stream->err();
+	delete stream;
 
-	if (unzCloseCurrentFile(_zipFile) != UNZ_OK) {
+	if (!valid) {
 		free(buffer);
 		return nullptr;
 	}
 
-	return new MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
-
-	// FIXME: instead of reading all into a memory stream, we could
-	// instead create a new ZipStream class. But then we have to be
-	// careful to handle the case where the client code opens multiple
-	// files in the archive and tries to use them independently.
+	return new MemoryReadStream(buffer, size, DisposeAfterUse::YES);
+#else
+	// Cannot decompress the file without zlib.
+	return nullptr;
+#endif
 }
 
 Archive *makeZipArchive(const String &name) {
@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/workerpool.h"
+#include "common/atomic.h"
+#include "common/mutex.h"
+#include "common/profiler.h"
+#include "common/util.h"
+
+namespace Common {
+
+WorkerPool::WorkerPool(uint maxThreads)
+	: _start(nullptr), _done(nullptr), _quit(0), _proc(nullptr), _param(nullptr), _numJobs(0), _nextJob(0) {
+	_numThreads = g_system ? g_system->getCpuCount() : 1;
+	if (maxThreads)
+		_numThreads = MIN(_numThreads, maxThreads);
+	_numThreads = MAX<uint>(_numThreads, 1);
+}
+
+WorkerPool::~WorkerPool() {
+	atomicStore(&_quit, 1);
+	for (uint i = 0; i < _workers.size(); ++i)
+		_start->post();
+	for (uint i = 0; i < _workers.size(); ++i)
+		g_system->waitThread(_workers[i]);
+
+	delete _start;
+	delete _done;
+}
+
+int WorkerPool::workerThread(void *param) {
+	WorkerPool *pool = (WorkerPool *)param;
+
+	for (;;) {
+		pool->_start->wait();
+		if (atomicLoad(&pool->_quit))
+			break;
+
+		pool->runJobs();
+		pool->_done->post();
+	}
+
+	Profiler::releaseThread();
+	return 0;
+}
+
+void WorkerPool::startWorkers() {
+	_start = new Semaphore();
+	_done = new Semaphore();
+
+	for (uint i = 1; i < _numThreads; ++i) {
+		OSystem::ThreadRef thread = g_system->createThread(workerThread, this);
+		if (!thread)
+			break;
+		_workers.push_back(thread);
+	}
+
+	// Never wait for workers which could not be started
+	_numThreads = _workers.size() + 1;
+}
+
+void WorkerPool::runJobs() {
+	for (;;) {
+		const int32 job = atomicAdd(&_nextJob, 1) - 1;
+		if (job >= _numJobs)
+			break;
+
+		_proc(_param, job);
+	}
+}
+
+void WorkerPool::run(JobProc proc, void *param, uint numJobs) {
+	_proc = proc;
+	_param = param;
+	_numJobs = numJobs;
+	atomicStore(&_nextJob, 0);
+
+	if (numJobs > 1 && _numThreads > 1 && !_start)
+		startWorkers();
+
+	// Only wake up as many workers as there are jobs left for them
+	const uint numWorkers = MIN<uint>(_workers.size(), numJobs ? numJobs - 1 : 0);
+	for (uint i = 0; i < numWorkers; ++i)
+		_start->post();
+
+	runJobs();
+
+	for (uint i = 0; i < numWorkers; ++i)
+		_done->wait();
+}
+
+} // End of namespace Common
@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_WORKERPOOL_H
+#define COMMON_WORKERPOOL_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/system.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_workerpool Worker pool
+ * @ingroup common
+ *
+ * @brief API for running independent jobs on several CPU cores.
+ * @{
+ */
+
+class Semaphore;
+
+/**
+ * Runs batches of independent jobs on the threads provided by the backend.
+ *
+ * The calling thread takes part in the work and run() only returns once all
+ * jobs of the batch are done, so results can be used right away without any
+ * further synchronization. On backends without thread support, or with only
+ * one CPU core, the jobs simply run one after another on the calling thread.
+ *
+ * The worker threads are started by the first batch which needs them and
+ * then sleep between batches until the pool is destroyed. A pool must only
+ * be used from one thread at a time.
+ *
+ * Jobs must not share any state which is not protected otherwise. In
+ * particular, Common::String and Common::SharedPtr instances must not be
+ * copied across jobs, since their reference counts are not atomic.
+ */
+class WorkerPool {
+public:
+	typedef void (*JobProc)(void *param, uint job);
+
+	/**
+	 * @param maxThreads Maximum number of threads to use, including the
+	 *                   calling one. 0 means one thread per CPU core.
+	 */
+	explicit WorkerPool(uint maxThreads = 0);
+	~WorkerPool();
+
+	/**
+	 * Run proc(param, job) for every job in [0, numJobs) and wait for all
+	 * of them to finish.
+	 */
+	void run(JobProc proc, void *param, uint numJobs);
+
+	/**
+	 * Return the number of threads a batch with enough jobs would use.
+	 */
+	uint getThreadCount() const { return _numThreads; }
+
+private:
+	static int workerThread(void *param);
+	void startWorkers();
+	void runJobs();
+
+	uint _numThreads;
+	Array<OSystem::ThreadRef> _workers;
+	Semaphore *_start;
+	Semaphore *_done;
+	volatile int32 _quit;
+
+	JobProc _proc;
+	void *_param;
+	int32 _numJobs;
+	volatile int32 _nextJob;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
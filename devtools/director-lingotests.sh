@@ -0,0 +1,39 @@
+#!/bin/bash
+
+usage() {
+			cat << EOF
+Usage: $0 <scummvm binary> <output directory> [<reference directory>]
+
+Runs every script in engines/director/lingo/tests through the directortest
+target and stores the output of each one in <output directory>/<script>.txt.
+
+When the output directory of an earlier run is given as reference, the
+outputs are compared with it. The exit code is 1 when any of them differs.
+
+Miscellaneous:
+  -h, --help   display this help and exit
+EOF
+}
+
+if [ "$1" = "-h" ] || [ "$1" = "--help" ] || [ $# -lt 2 ]; then
+	usage
+	exit 0
+fi
+
+scummvm=`realpath "$1"`
+outdir=$2
+refdir=$3
+testdir=`dirname \`realpath $0\``/../engines/director/lingo/tests
+
+mkdir -p "$outdir"
+
+for script in "$testdir"/*.lingo; do
+	name=`basename "$script"`
+	timeout 60 "$scummvm" -p "$testdir" --start-movie="$name" directortest > "$outdir/$name.txt" 2>&1
+	echo "$name: exit code $?"
+done
+
+if [ -n "$refdir" ]; then
+	diff -r "$refdir" "$outdir" || exit 1
+	echo "All outputs match $refdir"
+fi
@@ -29,10 +29,12 @@
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
+#include "common/workerpool.h"
 #include "gui/EventRecorder.h"
 #include "gui/gui-manager.h"
 #include "gui/message.h"
 #include "engines/advancedDetector.h"
+#include "engines/detectioncache.h"
 #include "engines/obsolete.h"
 
 /**
@@ -469,16 +471,103 @@ bool AdvancedMetaEngineDetection::getFileProperties(const FileMap &allFiles, con
 	if (!allFiles.contains(fname))
 		return false;
 
+	const Common::FSNode &node = allFiles[fname];
 	Common::File testFile;
 
-	if (!testFile.open(allFiles[fname]))
+	if (!testFile.open(node))
 		return false;
 
 	fileProps.size = (int32)testFile.size();
-	fileProps.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
+
+	const uint32 mtime = node.getModificationTime();
+	if (!DetectionCache::instance().lookup(node.getPath(), fileProps.size, mtime, _md5Bytes, fileProps.md5)) {
+		fileProps.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
+		DetectionCache::instance().store(node.getPath(), fileProps.size, mtime, _md5Bytes, fileProps.md5);
+	}
 	return true;
 }
 
+namespace {
+
+struct MD5Job {
+	Common::File *file;
+	uint32 md5Bytes;
+	uint8 digest[16];
+	bool valid;
+};
+
+void computeMD5Job(void *param, uint job) {
+	MD5Job &md5Job = ((MD5Job *)param)[job];
+	md5Job.valid = Common::computeStreamMD5(*md5Job.file, md5Job.digest, md5Job.md5Bytes);
+}
+
+} // End of anonymous namespace
+
+void AdvancedMetaEngineDetection::getFilesProperties(const FileMap &allFiles, const Common::StringArray &fnames, FilePropertiesMap &filesProps) const {
+	// Bounds the number of files open at the same time
+	const uint kBatchSize = 64;
+
+	DetectionCache &cache = DetectionCache::instance();
+	Common::WorkerPool &workerPool = cache.getWorkerPool();
+
+	for (uint start = 0; start < fnames.size(); start += kBatchSize) {
+		const uint end = MIN<uint>(start + kBatchSize, fnames.size());
+
+		// Open the files and look them up in the cache on this thread, so
+		// the jobs only ever touch their own file.
+		Common::Array<MD5Job> jobs;
+		Common::Array<uint> jobFiles;
+		Common::Array<uint32> jobTimes;
+		for (uint i = start; i < end; ++i) {
+			const Common::FSNode &node = allFiles[fnames[i]];
+			Common::File *file = new Common::File();
+
+			if (!file->open(node)) {
+				delete file;
+				continue;
+			}
+
+			FileProperties &fileProps = filesProps[fnames[i]];
+			fileProps.size = (int32)file->size();
+
+			const uint32 mtime = node.getModificationTime();
+			if (cache.lookup(node.getPath(), fileProps.size, mtime, _md5Bytes, fileProps.md5)) {
+				debug(3, "> '%s': '%s' (cached)", fnames[i].c_str(), fileProps.md5.c_str());
+				delete file;
+				continue;
+			}
+
+			MD5Job job;
+			job.file = file;
+			job.md5Bytes = _md5Bytes;
+			job.valid = false;
+			jobs.push_back(job);
+			jobFiles.push_back(i);
+			jobTimes.push_back(mtime);
+		}
+
+		if (jobs.empty())
+			continue;
+
+		workerPool.run(computeMD5Job, jobs.begin(), jobs.size());
+
+		for (uint j = 0; j < jobs.size(); ++j) {
+			const Common::String &fname = fnames[jobFiles[j]];
+			FileProperties &fileProps = filesProps[fname];
+
+			if (jobs[j].valid) {
+				for (int k = 0; k < 16; k++)
+					fileProps.md5 += Common::String::format("%02x", (int)jobs[j].digest[k]);
+
+				cache.store(allFiles[fname].getPath(), fileProps.size, jobTimes[j], _md5Bytes, fileProps.md5);
+			}
+			debug(3, "> '%s': '%s'", fname.c_str(), fileProps.md5.c_str());
+
+			delete jobs[j].file;
+		}
+	}
+}
+
 bool AdvancedMetaEngine::getFilePropertiesExtern(uint md5Bytes, const FileMap &allFiles, const ADGameDescription &game, const Common::String fname, FileProperties &fileProps) const {
 	// FIXME/TODO: We don't handle the case that a file is listed as a regular
 	// file and as one with resource fork.
@@ -523,6 +612,7 @@ ADDetectedGames AdvancedMetaEngineDetection::detectGame(const Common::FSNode &pa
 
 	// Check which files are included in some ADGameDescription *and* whether
 	// they are present. Compute MD5s and file sizes for the available files.
+	Common::StringArray plainFiles;
 	for (descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize) {
 		g = (const ADGameDescription *)descPtr;
 
@@ -533,7 +623,10 @@ ADDetectedGames AdvancedMetaEngineDetection::detectGame(const Common::FSNode &pa
 				continue;
 
 			FileProperties tmp;
-			if (getFileProperties(allFiles, *g, fname, tmp)) {
+			if (!(g->flags & ADGF_MACRESFORK) && allFiles.contains(fname)) {
+				// Plain files are hashed together below
+				plainFiles.push_back(fname);
+			} else if (getFileProperties(allFiles, *g, fname, tmp)) {
 				debug(3, "> '%s': '%s'", fname.c_str(), tmp.md5.c_str());
 			}
 
@@ -543,6 +636,8 @@ ADDetectedGames AdvancedMetaEngineDetection::detectGame(const Common::FSNode &pa
 		}
 	}
 
+	getFilesProperties(allFiles, plainFiles, filesProps);
+
 	int maxFilesMatched = 0;
 	bool gotAnyMatchesWithAllFiles = false;
 
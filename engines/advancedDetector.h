@@ -27,6 +27,7 @@
 #include "engines/engine.h"
 
 #include "common/hash-str.h"
+#include "common/str-array.h"
 
 #include "common/gui_options.h" // FIXME: Temporary hack?
 
@@ -326,6 +327,13 @@ protected:
 	/** Get the properties (size and MD5) of this file. */
 	bool getFileProperties(const FileMap &allFiles, const ADGameDescription &game, const Common::String fname, FileProperties &fileProps) const;
 
+	/**
+	 * Get the properties (size and MD5) of several plain files at once.
+	 * Checksums not found in the DetectionCache are computed in parallel.
+	 * Files which can not be opened are left untouched in @p filesProps.
+	 */
+	void getFilesProperties(const FileMap &allFiles, const Common::StringArray &fnames, FilePropertiesMap &filesProps) const;
+
 	/** Convert an AD game description into the shared game description format */
 	virtual DetectedGame toDetectedGame(const ADDetectedGame &adGame) const;
 
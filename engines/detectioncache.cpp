@@ -0,0 +1,210 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/detectioncache.h"
+
+#include "common/algorithm.h"
+#include "common/debug.h"
+#include "common/savefile.h"
+#include "common/str-array.h"
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/workerpool.h"
+
+namespace Common {
+DECLARE_SINGLETON(DetectionCache);
+}
+
+static const char *const kCacheFileName = "detection.cache";
+
+enum {
+	kCacheVersion = 2,
+
+	// Keep the cache from growing without bounds when lots of different
+	// directories get scanned over time.
+	kMaxEntries = 65536,
+
+	// Number of least recently used entries dropped when the cache is full
+	kEvictEntries = kMaxEntries / 4
+};
+
+static Common::String readString(Common::ReadStream &in) {
+	const uint16 len = in.readUint16BE();
+	Common::String str;
+	for (uint16 i = 0; i < len && !in.eos(); ++i)
+		str += (char)in.readByte();
+	return str;
+}
+
+static void writeString(Common::WriteStream &out, const Common::String &str) {
+	out.writeUint16BE(str.size());
+	out.writeString(str);
+}
+
+DetectionCache::DetectionCache() : _loaded(false), _dirty(false), _useCounter(0), _workerPool(nullptr) {
+}
+
+DetectionCache::~DetectionCache() {
+	releaseWorkerPool();
+}
+
+Common::String DetectionCache::makeKey(const Common::String &path, uint md5Bytes) {
+	return Common::String::format("%u:%s", md5Bytes, path.c_str());
+}
+
+bool DetectionCache::lookup(const Common::String &path, int32 size, uint32 mtime, uint md5Bytes, Common::String &md5) {
+	if (mtime == 0)
+		return false;
+
+	load();
+
+	EntryMap::iterator it = _entries.find(makeKey(path, md5Bytes));
+	if (it == _entries.end() || it->_value.size != size || it->_value.mtime != mtime)
+		return false;
+
+	it->_value.lastUse = ++_useCounter;
+	_dirty = true;
+	md5 = it->_value.md5;
+	return true;
+}
+
+void DetectionCache::store(const Common::String &path, int32 size, uint32 mtime, uint md5Bytes, const Common::String &md5) {
+	if (mtime == 0 || md5.empty())
+		return;
+
+	load();
+
+	const Common::String key = makeKey(path, md5Bytes);
+	if (_entries.size() >= kMaxEntries && !_entries.contains(key))
+		evict();
+
+	Entry &entry = _entries[key];
+	entry.size = size;
+	entry.mtime = mtime;
+	entry.md5 = md5;
+	entry.lastUse = ++_useCounter;
+	_dirty = true;
+}
+
+void DetectionCache::evict() {
+	Common::Array<uint32> uses;
+	uses.reserve(_entries.size());
+	for (EntryMap::const_iterator it = _entries.begin(); it != _entries.end(); ++it)
+		uses.push_back(it->_value.lastUse);
+
+	Common::sort(uses.begin(), uses.end());
+	const uint32 threshold = uses[MIN<uint>(kEvictEntries, uses.size() - 1)];
+
+	Common::StringArray keys;
+	for (EntryMap::const_iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->_value.lastUse < threshold)
+			keys.push_back(it->_key);
+	}
+
+	for (uint i = 0; i < keys.size(); ++i)
+		_entries.erase(keys[i]);
+
+	debug(2, "DetectionCache: Dropped %u least recently used entries", keys.size());
+}
+
+Common::WorkerPool &DetectionCache::getWorkerPool() {
+	if (!_workerPool)
+		_workerPool = new Common::WorkerPool();
+	return *_workerPool;
+}
+
+void DetectionCache::releaseWorkerPool() {
+	delete _workerPool;
+	_workerPool = nullptr;
+}
+
+void DetectionCache::load() {
+	if (_loaded)
+		return;
+	_loaded = true;
+
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	if (!saveFileMan)
+		return;
+
+	Common::InSaveFile *in = saveFileMan->openForLoading(kCacheFileName);
+	if (!in)
+		return;
+
+	if (in->readUint32BE() != MKTAG('D', 'C', 'C', 'H') || in->readUint32BE() != kCacheVersion) {
+		debug(2, "DetectionCache: Ignoring cache with unknown format");
+		delete in;
+		return;
+	}
+
+	const uint32 count = in->readUint32BE();
+	for (uint32 i = 0; i < count && !in->eos() && !in->err(); ++i) {
+		Common::String key = readString(*in);
+		Entry entry;
+		entry.size = in->readSint32BE();
+		entry.mtime = in->readUint32BE();
+		entry.md5 = readString(*in);
+		entry.lastUse = in->readUint32BE();
+
+		if (in->eos() || in->err())
+			break;
+
+		_entries[key] = entry;
+		_useCounter = MAX(_useCounter, entry.lastUse);
+	}
+
+	debug(2, "DetectionCache: Loaded %u entries", _entries.size());
+	delete in;
+}
+
+void DetectionCache::flush() {
+	if (!_dirty)
+		return;
+
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	if (!saveFileMan)
+		return;
+
+	Common::OutSaveFile *out = saveFileMan->openForSaving(kCacheFileName, false);
+	if (!out) {
+		warning("DetectionCache: Could not write '%s'", kCacheFileName);
+		return;
+	}
+
+	out->writeUint32BE(MKTAG('D', 'C', 'C', 'H'));
+	out->writeUint32BE(kCacheVersion);
+	out->writeUint32BE(_entries.size());
+	for (EntryMap::const_iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		writeString(*out, it->_key);
+		out->writeSint32BE(it->_value.size);
+		out->writeUint32BE(it->_value.mtime);
+		writeString(*out, it->_value.md5);
+		out->writeUint32BE(it->_value.lastUse);
+	}
+
+	out->finalize();
+	if (out->err())
+		warning("DetectionCache: Error while writing '%s'", kCacheFileName);
+	delete out;
+
+	_dirty = false;
+}
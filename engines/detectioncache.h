@@ -0,0 +1,107 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef ENGINES_DETECTIONCACHE_H
+#define ENGINES_DETECTIONCACHE_H
+
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+namespace Common {
+class WorkerPool;
+}
+
+/**
+ * Persistent cache for the MD5 checksums computed by the AdvancedDetector.
+ *
+ * Entries are keyed by the path of the file, its size, its modification
+ * time and the number of bytes hashed, so any change to the file makes the
+ * old entry useless. Files whose modification time can not be determined
+ * by the filesystem backend are never cached, and neither are checksums
+ * which could not be computed. Once the cache is full, the least recently
+ * used entries are dropped.
+ *
+ * The cache is loaded on first use and written back by flush(), which
+ * EngineManager::detectGames() calls once all engines ran their detection.
+ */
+class DetectionCache : public Common::Singleton<DetectionCache> {
+public:
+	DetectionCache();
+	~DetectionCache();
+
+	/**
+	 * Look up the MD5 of the first @p md5Bytes bytes of a file.
+	 *
+	 * @return true if a valid entry was found, in which case @p md5 is set.
+	 */
+	bool lookup(const Common::String &path, int32 size, uint32 mtime, uint md5Bytes, Common::String &md5);
+
+	/**
+	 * Record the MD5 of the first @p md5Bytes bytes of a file. An empty
+	 * @p md5, as returned when reading the file failed, is not recorded.
+	 */
+	void store(const Common::String &path, int32 size, uint32 mtime, uint md5Bytes, const Common::String &md5);
+
+	/**
+	 * Write the cache back to disk if any entries were added or used.
+	 */
+	void flush();
+
+	/**
+	 * Return the worker pool hashing the files which are not cached. It is
+	 * shared by all engines, so its threads are only started once per
+	 * detection run.
+	 */
+	Common::WorkerPool &getWorkerPool();
+
+	/**
+	 * Stop the threads of the worker pool once the detection is over.
+	 */
+	void releaseWorkerPool();
+
+private:
+	struct Entry {
+		int32 size;
+		uint32 mtime;
+		Common::String md5;
+		// Value of _useCounter when the entry was last stored or found
+		uint32 lastUse;
+
+		Entry() : size(-1), mtime(0), lastUse(0) {}
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	EntryMap _entries;
+	bool _loaded;
+	bool _dirty;
+	uint32 _useCounter;
+	Common::WorkerPool *_workerPool;
+
+	static Common::String makeKey(const Common::String &path, uint md5Bytes);
+	void load();
+	void evict();
+};
+
+#endif
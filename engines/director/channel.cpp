@@ -28,9 +28,12 @@
 #include "director/channel.h"
 #include "director/sprite.h"
 #include "director/castmember.h"
+#include "director/window.h"
 
 #include "graphics/macgui/mactext.h"
 
+#include "image/image_decoder.h"
+
 namespace Director {
 
 Channel::Channel(Sprite *sp, int priority) {
@@ -40,6 +43,9 @@ Channel::Channel(Sprite *sp, int priority) {
 	_delta = Common::Point(0, 0);
 	_constraint = 0;
 	_mask = nullptr;
+	_maskCastId = 0;
+	_stretchedSurface = nullptr;
+	_widgetCastId = 0;
 
 	_priority = priority;
 	_width = _sprite->_width;
@@ -61,6 +67,8 @@ Channel::~Channel() {
 		delete _widget;
 	if (_mask)
 		delete _mask;
+	if (_stretchedSurface)
+		delete _stretchedSurface;
 }
 
 DirectorPlotData Channel::getPlotData() {
@@ -110,16 +118,23 @@ const Graphics::Surface *Channel::getMask(bool forceMatte) {
 			return nullptr;
 		}
 	} else if (_sprite->_ink == kInkTypeMask) {
-		CastMember *member = g_director->getCurrentMovie()->getCastMember(_sprite->_castId + 1);
+		uint16 maskCastId = _sprite->_castId + 1;
+		CastMember *member = g_director->getCurrentMovie()->getCastMember(maskCastId);
 
 		if (member && member->_initialRect == _sprite->_cast->_initialRect) {
 			Common::Rect bbox(getBbox());
-			Graphics::MacWidget *widget = member->createWidget(bbox, this);
-			if (_mask)
-				delete _mask;
-			_mask = new Graphics::ManagedSurface();
-			_mask->copyFrom(*widget->getSurface());
-			delete widget;
+
+			// The mask is only recreated when its cast member or size changes
+			if (!_mask || _maskCastId != maskCastId || member->isModified() ||
+					_mask->w != bbox.width() || _mask->h != bbox.height()) {
+				Graphics::MacWidget *widget = member->createWidget(bbox, this);
+				if (_mask)
+					delete _mask;
+				_mask = new Graphics::ManagedSurface();
+				_mask->copyFrom(*widget->getSurface());
+				_maskCastId = maskCastId;
+				delete widget;
+			}
 			return &_mask->rawSurface();
 		} else {
 			warning("Channel::getMask(): Requested cast mask, but no matching mask was found");
@@ -130,6 +145,58 @@ const Graphics::Surface *Channel::getMask(bool forceMatte) {
 	return nullptr;
 }
 
+Graphics::ManagedSurface *Channel::getStretchedSurface() {
+	if (!_sprite->_cast || _sprite->_cast->_type != kCastBitmap)
+		return nullptr;
+
+	// Scale from the cast member image, the widget surface has the size of
+	// the stretched bounding box
+	BitmapCastMember *bitmap = (BitmapCastMember *)_sprite->_cast;
+	if (!bitmap->_img)
+		return nullptr;
+	const Graphics::Surface *srf = bitmap->_img->getSurface();
+
+	Common::Rect srcRect = getBbox(true);
+	Common::Rect destRect = getBbox();
+
+	if (srcRect.isEmpty() || destRect.isEmpty() || !srf->w || !srf->h)
+		return nullptr;
+
+	// Images which are converted while blitting are left to the generic path
+	if (srf->format.bytesPerPixel != g_director->_pixelformat.bytesPerPixel)
+		return nullptr;
+
+	if (_stretchedSurface && _stretchedSurface->w == destRect.width() && _stretchedSurface->h == destRect.height())
+		return _stretchedSurface;
+
+	if (_stretchedSurface)
+		delete _stretchedSurface;
+	_stretchedSurface = new Graphics::ManagedSurface(destRect.width(), destRect.height(), srf->format);
+
+	int scaleX = SCALE_THRESHOLD * srcRect.width() / destRect.width();
+	int scaleY = SCALE_THRESHOLD * srcRect.height() / destRect.height();
+
+	for (int y = 0, scaleYCtr = 0; y < destRect.height(); y++, scaleYCtr += scaleY) {
+		int srcY = MIN<int>(scaleYCtr / SCALE_THRESHOLD, srf->h - 1);
+
+		if (srf->format.bytesPerPixel == 1) {
+			byte *dst = (byte *)_stretchedSurface->getBasePtr(0, y);
+			const byte *src = (const byte *)srf->getBasePtr(0, srcY);
+
+			for (int x = 0, scaleXCtr = 0; x < destRect.width(); x++, scaleXCtr += scaleX)
+				*dst++ = src[MIN<int>(scaleXCtr / SCALE_THRESHOLD, srf->w - 1)];
+		} else {
+			uint32 *dst = (uint32 *)_stretchedSurface->getBasePtr(0, y);
+			const uint32 *src = (const uint32 *)srf->getBasePtr(0, srcY);
+
+			for (int x = 0, scaleXCtr = 0; x < destRect.width(); x++, scaleXCtr += scaleX)
+				*dst++ = src[MIN<int>(scaleXCtr / SCALE_THRESHOLD, srf->w - 1)];
+		}
+	}
+
+	return _stretchedSurface;
+}
+
 bool Channel::isDirty(Sprite *nextSprite) {
 	// When a sprite is puppeted setTheSprite ensures that the dirty flag here is
 	// set. Otherwise, we need to rerender when the position, bounding box, or
@@ -366,17 +433,38 @@ void Channel::setBbox(int l, int t, int r, int b) {
 }
 
 void Channel::replaceWidget() {
+	if (_widget && _sprite && _sprite->_cast) {
+		Common::Rect bbox(getBbox());
+
+		// Bitmaps don't change with their position, so an unmodified cast
+		// member of the same size can keep its widget
+		if (_sprite->_cast->_type == kCastBitmap && _sprite->_castId == _widgetCastId &&
+				!_sprite->_cast->isModified() && _widget->getDimensions().width() == bbox.width() &&
+				_widget->getDimensions().height() == bbox.height()) {
+			_widget->setDimensions(bbox);
+			return;
+		}
+	}
+
 	if (_widget) {
 		delete _widget;
 		_widget = nullptr;
 	}
 
+	if (_stretchedSurface) {
+		delete _stretchedSurface;
+		_stretchedSurface = nullptr;
+	}
+
+	_widgetCastId = 0;
+
 	if (_sprite && _sprite->_cast) {
 		Common::Rect bbox(getBbox());
 		_sprite->_cast->_modified = false;
 
 		_widget = _sprite->_cast->createWidget(bbox, this);
 		if (_widget) {
+			_widgetCastId = _sprite->_castId;
 			_widget->_priority = _priority;
 			_widget->draw();
 
@@ -398,6 +486,11 @@ bool Channel::updateWidget() {
 			_sprite->_cast->updateFromWidget(_widget);
 		}
 		_widget->draw();
+
+		if (_stretchedSurface) {
+			delete _stretchedSurface;
+			_stretchedSurface = nullptr;
+		}
 		return true;
 	}
 
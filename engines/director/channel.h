@@ -35,6 +35,7 @@ namespace Director {
 
 class Sprite;
 class Cursor;
+class CastMember;
 
 class Channel {
 public:
@@ -43,6 +44,7 @@ public:
 
 	DirectorPlotData getPlotData();
 	const Graphics::Surface *getMask(bool forceMatte = false);
+	Graphics::ManagedSurface *getStretchedSurface();
 	Common::Rect getBbox(bool unstretched = false);
 
 	bool isStretched();
@@ -78,6 +80,13 @@ public:
 	Common::Point _currentPoint;
 	Common::Point _delta;
 	Graphics::ManagedSurface *_mask;
+	// Cast member the mask was created from
+	uint16 _maskCastId;
+	// Scaled copy of a stretched bitmap sprite
+	Graphics::ManagedSurface *_stretchedSurface;
+	// Cast member the widget was created from, to only move bitmap widgets
+	// when just the position changes
+	uint16 _widgetCastId;
 
 	int _priority;
 	int _width;
@@ -182,7 +182,7 @@ void Lingo::cleanupFuncs() {
 		delete it->_value;
 }
 
-void Lingo::push(Datum d) {
+void Lingo::push(const Datum &d) {
 	_stack.push_back(d);
 }
 
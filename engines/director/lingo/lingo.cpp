@@ -585,30 +585,37 @@ void Lingo::execute(uint pc) {
 			break;
 		}
 	
-		Common::String instr = decodeInstruction(_currentArchive, _currentScript, _pc);
+		// Decoding the instruction is expensive, only do it when tracing
+		const bool trace = debugChannelSet(1, kDebugLingoExec);
 		uint current = _pc;
 
-		if (debugChannelSet(5, kDebugLingoExec))
-			printStack("Stack before: ", current);
+		if (trace) {
+			if (debugChannelSet(5, kDebugLingoExec))
+				printStack("Stack before: ", current);
 
-		if (debugChannelSet(9, kDebugLingoExec)) {
-			debug("Vars before");
-			printAllVars();
-			if (_currentMe.type == OBJECT)
-				debug("me: %s", _currentMe.asString(true).c_str());
-		}
+			if (debugChannelSet(9, kDebugLingoExec)) {
+				debug("Vars before");
+				printAllVars();
+				if (_currentMe.type == OBJECT)
+					debug("me: %s", _currentMe.asString(true).c_str());
+			}
 
-		debugC(1, kDebugLingoExec, "[%3d]: %s", current, instr.c_str());
+			Common::String instr = decodeInstruction(_currentArchive, _currentScript, _pc);
+			debugC(1, kDebugLingoExec, "[%3d]: %s", current, instr.c_str());
+		}
 
 		_pc++;
-		(*((*_currentScript)[_pc - 1]))();
+		if (trace || !executeCompiled(current))
+			(*((*_currentScript)[_pc - 1]))();
 
-		if (debugChannelSet(5, kDebugLingoExec))
-			printStack("Stack after: ", current);
+		if (trace) {
+			if (debugChannelSet(5, kDebugLingoExec))
+				printStack("Stack after: ", current);
 
-		if (debugChannelSet(9, kDebugLingoExec)) {
-			debug("Vars after");
-			printAllVars();
+			if (debugChannelSet(9, kDebugLingoExec)) {
+				debug("Vars after");
+				printAllVars();
+			}
 		}
 
 		if (!_abort && _pc >= (*_currentScript).size()) {
@@ -630,6 +637,137 @@ void Lingo::execute(uint pc) {
 	_abort = false;
 }
 
+static const struct CompiledOpDescr {
+	inst func;
+	CompiledOp op;
+} compiledOps[] = {
+	{ LC::c_add,	kCompiledAdd },
+	{ LC::c_sub,	kCompiledSub },
+	{ LC::c_mul,	kCompiledMul },
+	{ LC::c_eq,		kCompiledEq },
+	{ LC::c_neq,	kCompiledNeq },
+	{ LC::c_gt,		kCompiledGt },
+	{ LC::c_lt,		kCompiledLt },
+	{ LC::c_ge,		kCompiledGe },
+	{ LC::c_le,		kCompiledLe },
+	{ 0, kCompiledCall }
+};
+
+void Lingo::compileScript(ScriptData *sd) {
+	const uint size = sd->size();
+	sd->compiled.resize(size);
+
+	// Every slot is classified on its own, operands included. This is safe
+	// as execution only ever lands on the start of an instruction.
+	for (uint pc = 0; pc < size; pc++) {
+		CompiledInst &ci = sd->compiled[pc];
+		const inst func = (*sd)[pc];
+		ci.op = kCompiledCall;
+		ci.arg = 0;
+
+		for (const CompiledOpDescr *descr = compiledOps; descr->func; descr++) {
+			if (descr->func == func) {
+				ci.op = descr->op;
+				break;
+			}
+		}
+
+		if (pc + 1 >= size)
+			continue;
+
+		const int operand = (int)READ_UINT32(&(*sd)[pc + 1]);
+		if (func == LC::c_intpush) {
+			ci.op = kCompiledIntPush;
+			ci.arg = operand;
+		} else if (func == LC::c_jump || func == LC::c_jumpifz) {
+			if (pc + operand >= size)
+				continue;
+			ci.op = (func == LC::c_jump) ? kCompiledJump : kCompiledJumpIfZ;
+			ci.arg = pc + operand;
+		}
+	}
+}
+
+bool Lingo::executeCompiled(uint pc) {
+	ScriptData *sd = _currentScript;
+	if (sd->compiled.size() != sd->size())
+		compileScript(sd);
+
+	const CompiledInst &ci = sd->compiled[pc];
+	switch (ci.op) {
+	case kCompiledCall:
+		return false;
+	case kCompiledIntPush:
+		_stack.push_back(Datum(ci.arg));
+		_pc = pc + 2;
+		return true;
+	case kCompiledJump:
+		_pc = ci.arg;
+		return true;
+	case kCompiledJumpIfZ:
+		if (_stack.empty() || _stack.back().type != INT)
+			return false;
+		_pc = _stack.back().u.i ? pc + 2 : ci.arg;
+		_stack.pop_back();
+		return true;
+	default:
+		break;
+	}
+
+	// Arithmetic and comparisons of two numbers of the same type are done in
+	// place. Anything else, lists and type conversions, goes through LC.
+	const uint size = _stack.size();
+	if (size < 2)
+		return false;
+
+	Datum &d1 = _stack[size - 2];
+	const Datum &d2 = _stack[size - 1];
+	if (d1.type != d2.type)
+		return false;
+
+	if (d1.type == INT) {
+		const int i1 = d1.u.i;
+		const int i2 = d2.u.i;
+		switch (ci.op) {
+		case kCompiledAdd:	d1.u.i = i1 + i2; break;
+		case kCompiledSub:	d1.u.i = i1 - i2; break;
+		case kCompiledMul:	d1.u.i = i1 * i2; break;
+		case kCompiledEq:	d1.u.i = (i1 == i2); break;
+		case kCompiledNeq:	d1.u.i = (i1 != i2); break;
+		case kCompiledGt:	d1.u.i = (i1 > i2); break;
+		case kCompiledLt:	d1.u.i = (i1 < i2); break;
+		case kCompiledGe:	d1.u.i = (i1 >= i2); break;
+		case kCompiledLe:	d1.u.i = (i1 <= i2); break;
+		default:
+			return false;
+		}
+	} else if (d1.type == FLOAT) {
+		const double f1 = d1.u.f;
+		const double f2 = d2.u.f;
+		// Ordered like Datum::compareTo(), which puts NaN above everything
+		const int cmp = (f1 < f2) ? -1 : ((f1 == f2) ? 0 : 1);
+		switch (ci.op) {
+		case kCompiledAdd:	d1.u.f = f1 + f2; break;
+		case kCompiledSub:	d1.u.f = f1 - f2; break;
+		case kCompiledMul:	d1.u.f = f1 * f2; break;
+		case kCompiledEq:	d1.u.i = (f1 == f2); d1.type = INT; break;
+		case kCompiledNeq:	d1.u.i = (f1 != f2); d1.type = INT; break;
+		case kCompiledGt:	d1.u.i = (cmp > 0); d1.type = INT; break;
+		case kCompiledLt:	d1.u.i = (cmp < 0); d1.type = INT; break;
+		case kCompiledGe:	d1.u.i = (cmp >= 0); d1.type = INT; break;
+		case kCompiledLe:	d1.u.i = (cmp <= 0); d1.type = INT; break;
+		default:
+			return false;
+		}
+	} else {
+		return false;
+	}
+
+	_stack.pop_back();
+	_pc = pc + 1;
+	return true;
+}
+
 void Lingo::executeScript(ScriptType type, uint16 id) {
 	Movie *movie = _vm->getCurrentMovie();
 	if (!movie) {
@@ -750,24 +888,31 @@ int Lingo::getAlignedType(const Datum &d1, const Datum &d2, bool numsOnly) {
 Datum::Datum() {
 	u.s = nullptr;
 	type = VOID;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 }
 
 Datum::Datum(const Datum &d) {
 	type = d.type;
 	u = d.u;
+	// The first copy of an unshared value starts sharing it
+	if (!d.refCount && !d.isScalar()) {
+		d.refCount = new int;
+		*d.refCount = 1;
+	}
 	refCount = d.refCount;
-	*refCount += 1;
+	if (refCount)
+		*refCount += 1;
 }
 
 Datum& Datum::operator=(const Datum &d) {
-	if (this != &d && refCount != d.refCount) {
+	if (this != &d && (!refCount || refCount != d.refCount)) {
+		Datum copy(d);
 		reset();
-		type = d.type;
-		u = d.u;
-		refCount = d.refCount;
-		*refCount += 1;
+		type = copy.type;
+		u = copy.u;
+		refCount = copy.refCount;
+		copy.refCount = nullptr;
+		copy.type = VOID;
 	}
 	return *this;
 }
@@ -775,22 +920,19 @@ Datum& Datum::operator=(const Datum &d) {
 Datum::Datum(int val) {
 	u.i = val;
 	type = INT;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 }
 
 Datum::Datum(double val) {
 	u.f = val;
 	type = FLOAT;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 }
 
 Datum::Datum(const Common::String &val) {
 	u.s = new Common::String(val);
 	type = STRING;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 }
 
 Datum::Datum(AbstractObject *val) {
@@ -801,21 +943,18 @@ Datum::Datum(AbstractObject *val) {
 		*refCount += 1;
 	} else {
 		type = VOID;
-		refCount = new int;
-		*refCount = 1;
+		refCount = nullptr;
 	}
 }
 
 void Datum::reset() {
-	if (!refCount)
-		return;
-
-	*refCount -= 1;
+	if (refCount)
+		*refCount -= 1;
 	// Coverity thinks that we always free memory, as it assumes
 	// (correctly) that there are cases when refCount == 0
 	// Thus, DO NOT COMPILE, trick it and shut tons of false positives
 #ifndef __COVERITY__
-	if (*refCount <= 0) {
+	if (!refCount || *refCount <= 0) {
 		switch (type) {
 		case VAR:
 		case STRING:
@@ -848,6 +987,12 @@ void Datum::reset() {
 			delete refCount;
 	}
 #endif
+	refCount = nullptr;
+	type = VOID;
+}
+
+bool Datum::isScalar() const {
+	return type == INT || type == FLOAT || type == VOID || type == ARGC || type == ARGCNORET;
 }
 
 Datum Datum::eval() {
@@ -66,7 +66,38 @@ typedef void (*inst)(void);
 #define	STOP (inst)0
 #define ENTITY_INDEX(t,id) ((t) * 100000 + (id))
 
-typedef Common::Array<inst> ScriptData;
+enum CompiledOp {
+	kCompiledCall,		// Not compiled, call the instruction
+	kCompiledIntPush,
+	kCompiledAdd,
+	kCompiledSub,
+	kCompiledMul,
+	kCompiledEq,
+	kCompiledNeq,
+	kCompiledGt,
+	kCompiledLt,
+	kCompiledGe,
+	kCompiledLe,
+	kCompiledJump,
+	kCompiledJumpIfZ
+};
+
+struct CompiledInst {
+	byte op;	// CompiledOp
+	int arg;	// Value for kCompiledIntPush, target pc for the jumps
+};
+
+struct ScriptData : public Common::Array<inst> {
+	ScriptData() {}
+	ScriptData(const inst *code, size_type n) : Common::Array<inst>(code, n) {}
+
+	/**
+	 * Typed form of the instructions, indexed by pc. It is built on the first
+	 * execution, see Lingo::compileScript(). Entries which are not at the
+	 * start of an instruction are never looked at.
+	 */
+	Common::Array<CompiledInst> compiled;
+};
 
 struct FuncDesc {
 	Common::String name;
@@ -121,7 +152,9 @@ struct Datum {	/* interpreter stack type */
 		ChunkReference *cref; /* CHUNKREF */
 	} u;
 
-	int *refCount;
+	// Shared by all copies of the value. Plain numbers never get one, other
+	// values only get one once they are copied.
+	mutable int *refCount;
 
 	Datum();
 	Datum(const Datum &d);
@@ -137,6 +170,7 @@ struct Datum {	/* interpreter stack type */
 	}
 
 	Datum eval();
+	bool isScalar() const;
 	double asFloat() const;
 	int asInt() const;
 	Common::String asString(bool printonly = false) const;
@@ -292,6 +326,8 @@ public:
 
 public:
 	void execute(uint pc);
+	void compileScript(ScriptData *sd);
+	bool executeCompiled(uint pc);
 	void pushContext(const Symbol funcSym, bool allowRetVal, Datum defaultRetVal);
 	void popContext();
 	void cleanLocalVars();
@@ -448,7 +484,7 @@ private:
 	void parseMenu(const char *code);
 
 public:
-	void push(Datum d);
+	void push(const Datum &d);
 	Datum pop(bool eval = true);
 	Datum peek(uint offset, bool eval = true);
 
@@ -167,8 +167,15 @@ void Window::inkBlitFrom(Channel *channel, Common::Rect destRect, Graphics::Mana
 		inkBlitShape(&pd, srcRect);
 	} else if (pd.srf) {
 		if (channel->isStretched()) {
-			srcRect = channel->getBbox(true);
-			inkBlitStretchSurface(&pd, srcRect, channel->getMask());
+			// Bitmaps are scaled once and then blitted like unstretched sprites
+			Graphics::ManagedSurface *stretched = channel->getStretchedSurface();
+			if (stretched) {
+				pd.srf = stretched;
+				inkBlitSurface(&pd, srcRect, channel->getMask());
+			} else {
+				srcRect = channel->getBbox(true);
+				inkBlitStretchSurface(&pd, srcRect, channel->getMask());
+			}
 		} else {
 			inkBlitSurface(&pd, srcRect, channel->getMask());
 		}
@@ -104,12 +104,12 @@ void QObjectCase::draw() {
 
 		QSystem *sys = g_vm->getQSystem();
 
-		const Common::List<Common::Rect> &dirty = g_vm->videoSystem()->rects();
+		const Common::Array<Common::Rect> &dirty = g_vm->videoSystem()->rects();
 		const Common::Array<Common::Rect> &mskRects = flc->getMskRects();
 
-		for (Common::List<Common::Rect>::const_iterator it = dirty.begin(); it != dirty.end(); ++it) {
+		for (uint j = 0; j < dirty.size(); ++j) {
 			for (uint i = 0; i < mskRects.size(); ++i) {
-				Common::Rect destRect = mskRects[i].findIntersectingRect(*it);
+				Common::Rect destRect = mskRects[i].findIntersectingRect(dirty[j]);
 				Common::Rect srcRect = destRect;
 				srcRect.translate(-_x + sys->_xOffset, -_y);
 				g_vm->videoSystem()->transBlitFrom(*s, srcRect, destRect, flc->getTransColor(s->format));
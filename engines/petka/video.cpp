@@ -58,11 +58,10 @@ void VideoSystem::update() {
 	interface->draw();
 	_allowAddingRects = true;
 
-	for (Common::Rect &r : _dirtyRects) {
-		const byte *srcP = (const byte *)getBasePtr(r.left, r.top);
-		g_system->copyRectToScreen(srcP, pitch, r.left, r.top, r.width(), r.height());
-	}
+	if (!_dirtyRects.empty())
+		g_system->copyRectsToScreen(getPixels(), pitch, &_dirtyRects[0], _dirtyRects.size());
 
+	_dirtyRegion.clear();
 	_dirtyRects.clear();
 
 	_time = time;
@@ -104,7 +103,7 @@ void VideoSystem::addDirtyMskRects(FlicDecoder &flc) {
 	addDirtyMskRects(Common::Point(0, 0), flc);
 }
 
-const Common::List<Common::Rect> &VideoSystem::rects() const {
+const Common::Array<Common::Rect> &VideoSystem::rects() const {
 	return _dirtyRects;
 }
 
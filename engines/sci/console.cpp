@@ -23,6 +23,7 @@
 // Console module
 
 #include "common/md5.h"
+#include "common/profiler.h"
 #include "sci/sci.h"
 #include "sci/console.h"
 #include "sci/debug.h"
@@ -115,6 +116,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_id",		WRAP_METHOD(Console, cmdResourceId));
 	registerCmd("resource_info",		WRAP_METHOD(Console, cmdResourceInfo));
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
@@ -163,6 +165,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	registerCmd("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	registerCmd("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	registerCmd("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	registerCmd("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	registerCmd("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -225,6 +228,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("script_decode",	WRAP_METHOD(Console, cmdScriptDecode));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -247,6 +251,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vo",					WRAP_METHOD(Console, cmdViewObject));				// alias
 	registerCmd("active_object",		WRAP_METHOD(Console, cmdViewActiveObject));
 	registerCmd("acc_object",			WRAP_METHOD(Console, cmdViewAccumulatorObject));
+	registerCmd("avoidpath_bench",	WRAP_METHOD(Console, cmdAvoidPathBench));
 
 	_debugState.seeking = kDebugSeekNothing;
 	_debugState.seekLevel = 0;
@@ -345,6 +350,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_id - Identifies a resource number by splitting it up in resource type and resource number\n");
 	debugPrintf(" resource_info - Shows info about a resource\n");
 	debugPrintf(" resource_types - Shows the valid resource types\n");
+	debugPrintf(" resource_cache - Shows resource cache statistics, or changes the cache budget and pinned resources\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
@@ -388,6 +394,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	debugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	debugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	debugPrintf(" gc_stats - Shows the pause times of the garbage collector\n");
 	debugPrintf("\n");
 	debugPrintf("Music/SFX:\n");
 	debugPrintf(" songlib - Shows the song library\n");
@@ -433,6 +440,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" script_decode - Checks the cached instructions of all loaded scripts and times decoding them\n");
 	debugPrintf(" script_objects / scro - Shows all objects inside a specified script\n");
 	debugPrintf(" script_strings / scrs - Shows all strings inside a specified script\n");
 	debugPrintf(" script_said - Shows all said - strings inside a specified script\n");
@@ -446,6 +454,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" view_object / vo - Examines the object at the given address\n");
 	debugPrintf(" active_object - Shows information on the currently active object or class\n");
 	debugPrintf(" acc_object - Shows information on the object or class at the address indexed by the accumulator\n");
+	debugPrintf(" avoidpath_bench - Records pathfinding requests and replays them with and without the visibility graph cache\n");
 	debugPrintf("\n");
 	return true;
 }
@@ -1028,7 +1037,7 @@ bool Console::cmdAllocList(int argc, const char **argv) {
 						debugPrintf("%s: ", getResourceTypeName((ResourceType)i));
 					}
 					hasAlloc = true;
-					debugPrintf("%u (%u locks)", resource->getNumber(), resource->getNumLockers());
+					debugPrintf("%u (%u locks%s)", resource->getNumber(), resource->getNumLockers(), resource->isPinned() ? ", pinned" : "");
 				}
 			}
 			if (hasAlloc) {
@@ -1107,6 +1116,41 @@ bool Console::cmdResourceTypes(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc == 3 && !strcmp(argv[1], "budget")) {
+		resMan->setCacheBudget(atoi(argv[2]) * 1024);
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		resMan->resetCacheStats();
+	} else if (argc == 4 && (!strcmp(argv[1], "pin") || !strcmp(argv[1], "unpin"))) {
+		ResourceType res = parseResourceType(argv[2]);
+		if (res == kResourceTypeInvalid) {
+			debugPrintf("Resource type '%s' is not valid\n", argv[2]);
+			return true;
+		}
+
+		const ResourceId id(res, atoi(argv[3]));
+		if (argv[1][0] == 'u')
+			resMan->unpinResource(id);
+		else if (!resMan->pinResource(id))
+			debugPrintf("Resource %s not found\n", id.toString().c_str());
+	} else if (argc != 1) {
+		debugPrintf("Shows resource cache statistics, or changes the cache\n");
+		debugPrintf("Usage: %s [budget <KiB> | reset | pin <resource type> <resource number> | unpin <resource type> <resource number>]\n", argv[0]);
+		return true;
+	}
+
+	const ResourceCacheStats &stats = resMan->getCacheStats();
+	const uint32 lookups = stats.hits + stats.misses;
+
+	debugPrintf("Cache: %d of %d KiB used, %d KiB locked\n", resMan->getCacheMemoryUsed() / 1024, resMan->getCacheBudget() / 1024, resMan->getLockedMemory() / 1024);
+	debugPrintf("Lookups: %u, hits: %u (%u%%), misses: %u\n", lookups, stats.hits, lookups ? stats.hits * 100 / lookups : 0, stats.misses);
+	debugPrintf("Prefetch hints: %u, evicted: %u (%u KiB)\n", stats.prefetches, stats.evictions, stats.evictedBytes / 1024);
+
+	return true;
+}
+
 bool Console::cmdHexgrep(int argc, const char **argv) {
 	if (argc < 4) {
 		debugPrintf("Searches some resources for a particular sequence of bytes, represented as decimal or hexadecimal numbers.\n");
@@ -2733,6 +2777,22 @@ bool Console::cmdGCInvoke(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCStats(int argc, const char **argv) {
+	const EngineState *s = _engine->_gamestate;
+	const GCStats &stats = s->gcStats;
+
+	debugPrintf("Collections: %u, incremental steps: %u%s\n", stats.collections, stats.slices,
+		s->gcMark->active ? ", marking in progress" : "");
+	debugPrintf("Last collection: %u reachable, %u rescanned, %u unreachable, %u still queued\n",
+		stats.lastReachable, stats.lastRescanned, stats.lastGarbage, s->gcGarbage.size());
+	debugPrintf("Objects freed: %u\n", stats.totalFreed);
+	debugPrintf("Collection or final step: last %u us, max %u us\n", stats.lastCollectionTime, stats.maxCollectionTime);
+	debugPrintf("Marking part of it: last %u us, max %u us\n", stats.lastMarkTime, stats.maxMarkTime);
+	debugPrintf("Incremental step: max %u us\n", stats.maxSliceTime);
+	debugPrintf("Total time: %u ms\n", (uint32)(stats.totalTime / 1000));
+	return true;
+}
+
 bool Console::cmdGCObjects(int argc, const char **argv) {
 	AddrSet *use_map = findAllActiveReferences(_engine->_gamestate);
 
@@ -3263,11 +3323,118 @@ bool Console::cmdViewAccumulatorObject(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdAvoidPathBench(int argc, const char **argv) {
+	uint iterations = 10;
+
+	if (argc > 3 || (argc == 3 && strcmp(argv[1], "record"))) {
+		debugPrintf("Replays the recorded kAvoidPath requests with and without the visibility graph cache.\n");
+		debugPrintf("Usage: %s [<iterations>]\n", argv[0]);
+		debugPrintf("       %s record on|off\n", argv[0]);
+		debugPrintf("Requests are only recorded between 'record on' and 'record off'.\n");
+		return true;
+	}
+
+	if (argc == 3) {
+		const bool record = !scumm_stricmp(argv[2], "on");
+		setAvoidPathRecording(_engine->_gamestate, record);
+		debugPrintf("kAvoidPath recording %s\n", record ? "started" : "stopped");
+		return true;
+	}
+
+	if (argc == 2)
+		iterations = MAX<int>(1, atoi(argv[1]));
+
+	debugPrintf("%s", benchmarkAvoidPath(_engine->_gamestate, iterations).c_str());
+	return true;
+}
+
 bool Console::cmdScriptSteps(int argc, const char **argv) {
 	debugPrintf("Number of executed SCI operations: %d\n", _engine->_gamestate->scriptStepCounter);
 	return true;
 }
 
+bool Console::cmdScriptDecode(int argc, const char **argv) {
+	uint iterations = 100;
+
+	if (argc > 2) {
+		debugPrintf("Compares the cached instructions of all loaded scripts with a fresh decode.\n");
+		debugPrintf("Then times decoding them anew against looking them up in the cache.\n");
+		debugPrintf("Usage: %s [<iterations>]\n", argv[0]);
+		debugPrintf("Run it again after a room change to check scripts which were reloaded.\n");
+		return true;
+	}
+
+	if (argc == 2)
+		iterations = MAX<int>(1, atoi(argv[1]));
+
+	const Common::Array<SegmentObj *> &heap = _engine->_gamestate->_segMan->getSegments();
+	uint scripts = 0, instructions = 0, fused = 0, mismatches = 0;
+	uint64 freshTime = 0, cachedTime = 0;
+	uint32 freshBytes = 0, cachedBytes = 0;
+
+	for (uint seg = 1; seg < heap.size(); ++seg) {
+		if (!heap[seg] || heap[seg]->getType() != SEG_TYPE_SCRIPT)
+			continue;
+
+		Script *scr = (Script *)heap[seg];
+		const Common::Array<DecodedInstruction> &cache = scr->getInstructionCache();
+		if (cache.empty())
+			continue;
+
+		Common::Array<uint32> offsets;
+		for (uint i = 0; i < cache.size(); ++i) {
+			const DecodedInstruction &cached = cache[i];
+			if (cached.offset == kNoInstruction)
+				continue;
+
+			DecodedInstruction fresh;
+			scr->decodeInstruction(fresh, cached.offset);
+			if (fresh.extOpcode != cached.extOpcode || fresh.size != cached.size ||
+				memcmp(fresh.opparams, cached.opparams, sizeof(fresh.opparams)) ||
+				fresh.branchOpcode != cached.branchOpcode || fresh.branchParam != cached.branchParam ||
+				fresh.branchSize != cached.branchSize) {
+				debugPrintf("Mismatch in script %d at %04x\n", scr->getScriptNumber(), cached.offset);
+				++mismatches;
+			}
+
+			if (cached.branchOpcode)
+				++fused;
+			offsets.push_back(cached.offset);
+		}
+
+		++scripts;
+		instructions += offsets.size();
+
+		uint64 start = Common::Profiler::getNanos();
+		for (uint i = 0; i < iterations; ++i) {
+			for (uint j = 0; j < offsets.size(); ++j) {
+				DecodedInstruction fresh;
+				scr->decodeInstruction(fresh, offsets[j]);
+				freshBytes += fresh.size;
+			}
+		}
+		freshTime += Common::Profiler::getNanos() - start;
+
+		start = Common::Profiler::getNanos();
+		for (uint i = 0; i < iterations; ++i) {
+			for (uint j = 0; j < offsets.size(); ++j)
+				cachedBytes += scr->getInstruction(offsets[j]).size;
+		}
+		cachedTime += Common::Profiler::getNanos() - start;
+	}
+
+	debugPrintf("%u cached instructions in %u scripts, %u of them fused with a branch\n", instructions, scripts, fused);
+	debugPrintf("%u mismatches against a fresh decode\n", mismatches);
+
+	// Both loops went over the same instructions, unless something is wrong
+	const uint32 decoded = instructions * iterations;
+	if (decoded && freshBytes == cachedBytes) {
+		debugPrintf("Fresh decode: %u ns per instruction\n", (uint32)(freshTime / decoded));
+		debugPrintf("Cached: %u ns per instruction\n", (uint32)(cachedTime / decoded));
+	}
+	return true;
+}
+
 bool Console::cmdScriptObjects(int argc, const char **argv) {
 	int curScriptNr = -1;
 
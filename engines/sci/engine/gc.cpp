@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/profiler.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -99,10 +100,17 @@ static void processWorkList(SegManager *segMan, WorklistManager &wm, const Commo
 	}
 }
 
-AddrSet *findAllActiveReferences(EngineState *s) {
-	assert(!s->_executionStack.empty());
+void GCMarkState::clear() {
+	active = false;
+	wm._worklist.clear();
+	wm._map.clear();
+	scanned.clear();
+	refsStart.clear();
+	refs.clear();
+}
 
-	WorklistManager wm;
+static void pushRoots(EngineState *s, WorklistManager &wm) {
+	assert(!s->_executionStack.empty());
 
 	// Initialize registers
 	wm.push(s->r_acc);
@@ -170,8 +178,13 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	}
 
 	debugC(kDebugLevelGC, "[GC] -- Finished explicitly loaded scripts, done with root set");
+}
 
-	processWorkList(s->_segMan, wm, heap);
+AddrSet *findAllActiveReferences(EngineState *s) {
+	WorklistManager wm;
+
+	pushRoots(s, wm);
+	processWorkList(s->_segMan, wm, s->_segMan->getSegments());
 
 	if (g_sci->_gfxPorts)
 		g_sci->_gfxPorts->processEngineHunkList(wm);
@@ -179,11 +192,118 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
-void run_gc(EngineState *s) {
+static void freeGarbage(SegManager *segMan, reg_t addr) {
+	// The segment is gone if it belonged to a script freed before
+	SegmentObj *mobj = segMan->getSegmentObj(addr.getSegment());
+	if (mobj && mobj->isValidOffset(addr.getOffset())) {
+		mobj->freeAtAddress(segMan, addr);
+		debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+	}
+}
+
+static uint32 elapsedMicros(uint64 start) {
+	return (uint32)((Common::Profiler::getNanos() - start) / 1000);
+}
+
+static void freeAllGarbage(EngineState *s) {
+	// Whatever the previous run left behind is still unreachable
+	for (uint i = 0; i < s->gcGarbage.size(); ++i)
+		freeGarbage(s->_segMan, s->gcGarbage[i]);
+	s->gcStats.totalFreed += s->gcGarbage.size();
+	s->gcGarbage.clear();
+}
+
+/**
+ * Scans the next few objects of an incremental collection.
+ * @return false if there was nothing left to scan
+ */
+static bool markSlice(SegManager *segMan, GCMarkState &mark) {
+	WorklistManager &wm = mark.wm;
+	if (wm._worklist.empty())
+		return false;
+
+	const Common::Array<SegmentObj *> &heap = segMan->getSegments();
+	const SegmentId stackSegment = segMan->findSegmentByType(SEG_TYPE_STACK);
+
+	for (uint i = 0; i < kGCSliceSize && !wm._worklist.empty(); ++i) {
+		const reg_t reg = wm._worklist.back();
+		wm._worklist.pop_back();
+
+		// The stack is a root, scanned again when marking finishes
+		if (reg.getSegment() == stackSegment)
+			continue;
+
+		// Scripts may have freed the object since it was found. Forget
+		// about it, as a new object there would have to be scanned again.
+		SegmentObj *mobj = reg.getSegment() < heap.size() ? heap[reg.getSegment()] : nullptr;
+		if (!mobj || !mobj->isValidOffset(reg.getOffset())) {
+			wm._map.erase(reg);
+			continue;
+		}
+
+		const Common::Array<reg_t> refs = mobj->listAllOutgoingReferences(reg);
+		mark.scanned.push_back(reg);
+		mark.refsStart.push_back(mark.refs.size());
+		for (uint j = 0; j < refs.size(); ++j)
+			mark.refs.push_back(refs[j]);
+
+		wm.pushArray(refs);
+	}
+
+	return true;
+}
+
+/**
+ * Finishes the marking of an incremental collection in one go.
+ * @return the addresses found reachable, normalised like with
+ *         findAllActiveReferences()
+ */
+static AddrSet *finishMarking(EngineState *s) {
 	SegManager *segMan = s->_segMan;
+	GCMarkState &mark = *s->gcMark;
+	WorklistManager &wm = mark.wm;
+	const Common::Array<SegmentObj *> &heap = segMan->getSegments();
+
+	// Scripts ran between the steps. Any reference they stored is either
+	// in a root or in an object which was scanned already, so scan both
+	// again where they changed.
+	pushRoots(s, wm);
+
+	s->gcStats.lastRescanned = 0;
+	for (uint i = 0; i < mark.scanned.size(); ++i) {
+		const reg_t reg = mark.scanned[i];
+
+		// Freed since, so nothing refers to it anymore
+		SegmentObj *mobj = reg.getSegment() < heap.size() ? heap[reg.getSegment()] : nullptr;
+		if (!mobj || !mobj->isValidOffset(reg.getOffset()))
+			continue;
+
+		const Common::Array<reg_t> refs = mobj->listAllOutgoingReferences(reg);
+		const uint begin = mark.refsStart[i];
+		const uint end = i + 1 < mark.refsStart.size() ? mark.refsStart[i + 1] : mark.refs.size();
+
+		bool changed = refs.size() != end - begin;
+		for (uint j = 0; !changed && j < refs.size(); ++j)
+			changed = refs[j] != mark.refs[begin + j];
+
+		if (changed) {
+			++s->gcStats.lastRescanned;
+			wm.pushArray(refs);
+		}
+	}
+
+	processWorkList(segMan, wm, heap);
+
+	if (g_sci->_gfxPorts)
+		g_sci->_gfxPorts->processEngineHunkList(wm);
+
+	return normalizeAddresses(segMan, wm._map);
+}
+
+static void sweep(EngineState *s, const AddrSet *activeRefs, bool incremental) {
+	SegManager *segMan = s->_segMan;
+	GCStats &stats = s->gcStats;
 
-	// Some debug stuff
-	debugC(kDebugLevelGC, "[GC] Running...");
 #ifdef GC_DEBUG_CODE
 	const char *segnames[SEG_TYPE_MAX + 1];
 	int segcount[SEG_TYPE_MAX + 1];
@@ -191,8 +311,8 @@ void run_gc(EngineState *s) {
 	memset(segcount, 0, sizeof(segcount));
 #endif
 
-	// Compute the set of all segments references currently in use.
-	AddrSet *activeRefs = findAllActiveReferences(s);
+	stats.lastReachable = activeRefs->size();
+	stats.lastGarbage = 0;
 
 	// Iterate over all segments, and check for each whether it
 	// contains stuff that can be collected.
@@ -201,8 +321,8 @@ void run_gc(EngineState *s) {
 		SegmentObj *mobj = heap[seg];
 
 		if (mobj != NULL) {
-#ifdef GC_DEBUG_CODE
 			const SegmentType type = mobj->getType();
+#ifdef GC_DEBUG_CODE
 			segnames[type] = segmentTypeNames[type];
 #endif
 
@@ -212,9 +332,17 @@ void run_gc(EngineState *s) {
 			for (Common::Array<reg_t>::const_iterator it = tmp.begin(); it != tmp.end(); ++it) {
 				const reg_t addr = *it;
 				if (!activeRefs->contains(addr)) {
-					// Not found -> we can free it
-					mobj->freeAtAddress(segMan, addr);
-					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+					// Not found -> we can free it. Scripts marked as deleted
+					// may get loaded again before the next slice, so they are
+					// never deferred.
+					++stats.lastGarbage;
+					if (incremental && type != SEG_TYPE_SCRIPT) {
+						s->gcGarbage.push_back(addr);
+					} else {
+						mobj->freeAtAddress(segMan, addr);
+						++stats.totalFreed;
+						debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+					}
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
 #endif
@@ -224,8 +352,6 @@ void run_gc(EngineState *s) {
 		}
 	}
 
-	delete activeRefs;
-
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -235,4 +361,88 @@ void run_gc(EngineState *s) {
 #endif
 }
 
+static void finishCollection(GCStats &stats, uint64 start, uint64 markStart, uint64 markEnd) {
+	const uint32 time = elapsedMicros(start);
+	++stats.collections;
+	stats.lastCollectionTime = time;
+	stats.maxCollectionTime = MAX(stats.maxCollectionTime, time);
+	stats.lastMarkTime = (uint32)((markEnd - markStart) / 1000);
+	stats.maxMarkTime = MAX(stats.maxMarkTime, stats.lastMarkTime);
+}
+
+void run_gc(EngineState *s, bool incremental) {
+	GCStats &stats = s->gcStats;
+
+	if (incremental && s->gcMark->active)
+		return;
+
+	const uint64 start = Common::Profiler::getNanos();
+
+	// Some debug stuff
+	debugC(kDebugLevelGC, "[GC] Running...");
+
+	freeAllGarbage(s);
+	s->gcMark->clear();
+
+	if (incremental) {
+		// Scanning the objects is left to run_gc_slice()
+		pushRoots(s, s->gcMark->wm);
+		s->gcMark->active = true;
+
+		const uint32 time = elapsedMicros(start);
+		++stats.slices;
+		stats.maxSliceTime = MAX(stats.maxSliceTime, time);
+		stats.totalTime += time;
+		return;
+	}
+
+	// Compute the set of all segments references currently in use.
+	const uint64 markStart = Common::Profiler::getNanos();
+	AddrSet *activeRefs = findAllActiveReferences(s);
+	const uint64 markEnd = Common::Profiler::getNanos();
+
+	stats.lastRescanned = 0;
+	sweep(s, activeRefs, false);
+	delete activeRefs;
+
+	finishCollection(stats, start, markStart, markEnd);
+	stats.totalTime += stats.lastCollectionTime;
+}
+
+void run_gc_slice(EngineState *s) {
+	GCStats &stats = s->gcStats;
+	GCMarkState &mark = *s->gcMark;
+
+	if (!mark.active && s->gcGarbage.empty())
+		return;
+
+	const uint64 start = Common::Profiler::getNanos();
+
+	if (mark.active) {
+		if (!markSlice(s->_segMan, mark)) {
+			// Everything found so far was scanned, so finish in one go
+			AddrSet *activeRefs = finishMarking(s);
+			const uint64 markEnd = Common::Profiler::getNanos();
+
+			mark.clear();
+			sweep(s, activeRefs, true);
+			delete activeRefs;
+
+			finishCollection(stats, start, start, markEnd);
+		}
+	} else {
+		const uint count = MIN<uint>(kGCSliceSize, s->gcGarbage.size());
+		for (uint i = 0; i < count; ++i) {
+			freeGarbage(s->_segMan, s->gcGarbage.back());
+			s->gcGarbage.pop_back();
+		}
+		stats.totalFreed += count;
+	}
+
+	const uint32 time = elapsedMicros(start);
+	++stats.slices;
+	stats.maxSliceTime = MAX(stats.maxSliceTime, time);
+	stats.totalTime += time;
+}
+
 } // End of namespace Sci
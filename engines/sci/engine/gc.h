@@ -49,11 +49,40 @@ typedef Common::HashMap<reg_t, bool, reg_t_Hash> AddrSet;
  */
 AddrSet *findAllActiveReferences(EngineState *s);
 
+enum {
+	kGCSliceSize = 64 ///< Number of objects run_gc_slice() scans or frees at most
+};
+
 /**
  * Runs garbage collection on the current system state
+ *
+ * An incremental collection only finds the roots right away. Scanning the
+ * objects reachable from them is spread over the following run_gc_slice()
+ * calls, and so is freeing the unreachable ones afterwards.
+ *
+ * The VM has no write barrier, so scripts running between two steps may
+ * store references into objects already scanned. The final marking step
+ * therefore scans the roots again, along with every object whose outgoing
+ * references changed since it was scanned. That step still visits all
+ * objects found so far, but only has to follow what changed. The gc_stats
+ * console command shows how long it takes.
+ *
+ * @param s The state in which we should gc
+ * @param incremental If set, start an incremental collection unless one is
+ *        running already. Otherwise collect everything right away, which
+ *        replaces an incremental collection in progress.
+ */
+void run_gc(EngineState *s, bool incremental = false);
+
+/**
+ * Runs the next step of an incremental collection: scans the next few
+ * reachable objects, finishes marking and sweeps, or frees the next few
+ * unreachable objects. Objects once unreachable stay unreachable, since
+ * scripts cannot refer to them anymore, so the unreachable objects may be
+ * freed at any later time. Does nothing if no collection is in progress.
  * @param s The state in which we should gc
  */
-void run_gc(EngineState *s);
+void run_gc_slice(EngineState *s);
 
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
@@ -63,6 +92,24 @@ struct WorklistManager {
 	void pushArray(const Common::Array<reg_t> &tmp);
 };
 
+/**
+ * The marking progress of an incremental collection, see run_gc()
+ */
+struct GCMarkState {
+	bool active; ///< Whether marking is in progress
+	WorklistManager wm; ///< The objects found so far and the ones left to scan
+
+	// The outgoing references of each object scanned so far, as they were
+	// when it was scanned. Those of scanned[i] start at refs[refsStart[i]].
+	Common::Array<reg_t> scanned;
+	Common::Array<uint32> refsStart;
+	Common::Array<reg_t> refs;
+
+	GCMarkState() : active(false) {}
+
+	void clear();
+};
+
 
 } // End of namespace Sci
 
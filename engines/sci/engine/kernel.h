@@ -34,6 +34,7 @@
 
 namespace Sci {
 
+class AvoidPathCache;	// from kpathing.cpp
 struct Node;	// from segment.h
 struct List;	// from segment.h
 struct SelectorCache;	// from selector.h
@@ -333,6 +334,11 @@ reg_t kSort(EngineState *s, int argc, reg_t *argv);
 reg_t kStrEnd(EngineState *s, int argc, reg_t *argv);
 reg_t kMemory(EngineState *s, int argc, reg_t *argv);
 reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv);
+void freeAvoidPathCache(AvoidPathCache *cache);
+/** Starts or stops recording kAvoidPath queries for benchmarkAvoidPath() */
+void setAvoidPathRecording(EngineState *s, bool record);
+/** Replays the recorded kAvoidPath queries with and without the visibility graph cache */
+Common::String benchmarkAvoidPath(EngineState *s, uint iterations);
 reg_t kParse(EngineState *s, int argc, reg_t *argv);
 reg_t kSaid(EngineState *s, int argc, reg_t *argv);
 reg_t kStrCpy(EngineState *s, int argc, reg_t *argv);
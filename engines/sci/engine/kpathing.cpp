@@ -117,10 +117,14 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Position in the vertex index
+	int idx;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		idx = -1;
 	}
 };
 
@@ -242,6 +246,56 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+/**
+ * Visibility graph of a polygon set, kept across kAvoidPath calls as long as
+ * the polygons stay the same. The start and end points usually end up as
+ * single-vertex polygons. These have no edges, so they do not change which
+ * polygon vertices see each other, and only their own visibility has to be
+ * computed for every call.
+ */
+struct VisibilityGraph {
+	// Vertex count and points of every polygon
+	Common::Array<int16> key;
+	// Visible polygon vertices of each polygon vertex, in the order
+	// visible_vertices() returns them
+	Common::Array<Common::Array<uint16> > visible;
+	Common::Array<bool> known;
+	uint32 lastUse;
+
+	VisibilityGraph() : lastUse(0) {}
+};
+
+/** The input of a kAvoidPath call, kept for the avoidpath_bench console command. */
+struct AvoidPathQuery {
+	// Type, vertex count and points of every polygon
+	Common::Array<int16> polygons;
+	Common::Point start, end;
+	int width, height, opt;
+};
+
+class AvoidPathCache {
+public:
+	enum {
+		kMaxGraphs = 4,
+		kMaxQueries = 256
+	};
+
+	AvoidPathCache() : useCount(0), recording(false), nextQuery(0) {}
+
+	VisibilityGraph graphs[kMaxGraphs];
+	uint32 useCount;
+
+	// Queries are only recorded while the console asks for it, to keep
+	// the copies off regular kAvoidPath calls
+	bool recording;
+	Common::Array<AvoidPathQuery> queries;
+	uint nextQuery;
+};
+
+void freeAvoidPathCache(AvoidPathCache *cache) {
+	delete cache;
+}
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
@@ -263,6 +317,13 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Cached visibility graph of the polygons, if it applies to this call
+	VisibilityGraph *graph;
+
+	// Position of the first polygon vertex in vertex_index, the vertices
+	// before are the single-vertex start and end points
+	int baseOffset;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = NULL;
 		vertex_end = NULL;
@@ -270,6 +331,8 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		graph = NULL;
+		baseOffset = 0;
 	}
 
 	~PathfindingState() {
@@ -699,6 +762,39 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Checks whether a vertex is visible from another vertex.
+ * @param s				the pathfinding state
+ * @param vertex_cur	the vertex to look from
+ * @param vertex		the vertex to look at
+ * @return true if no polygon blocks the line between the two vertices
+ */
+static bool visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	// Check for intersecting edges
+	for (int j = 0; j < s->vertices; j++) {
+		Vertex *edge = s->vertex_index[j];
+		if (VERTEX_HAS_EDGES(edge)) {
+			if (between(vertex_cur->v, vertex->v, edge->v)) {
+				// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+				if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
+					return false;
+
+				// This edge won't properly intersect, so we continue
+				continue;
+			}
+
+			if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -707,35 +803,37 @@ static int inside(const Common::Point &p, Vertex *vertex) {
  */
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	VertexList *visVerts = new VertexList();
+	VisibilityGraph *graph = s->graph;
+	const int base = vertex_cur->idx - s->baseOffset;
+
+	if (graph && base >= 0 && graph->known[base]) {
+		// Polygon vertices come first, as the list is built back to front
+		const Common::Array<uint16> &cached = graph->visible[base];
+		for (uint i = 0; i < cached.size(); i++)
+			visVerts->push_back(s->vertex_index[s->baseOffset + cached[i]]);
+
+		for (int i = s->baseOffset - 1; i >= 0; i--) {
+			if (visible(s, vertex_cur, s->vertex_index[i]))
+				visVerts->push_back(s->vertex_index[i]);
+		}
+
+		return visVerts;
+	}
 
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
+		if (visible(s, vertex_cur, vertex))
+			visVerts->push_front(vertex);
+	}
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
-			continue;
-
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
-
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
-			}
+	if (graph && base >= 0) {
+		Common::Array<uint16> &cached = graph->visible[base];
+		cached.clear();
+		for (VertexList::iterator it = visVerts->begin(); it != visVerts->end(); ++it) {
+			if ((*it)->idx >= s->baseOffset)
+				cached.push_back((*it)->idx - s->baseOffset);
 		}
-
-		if (j == s->vertices)
-			visVerts->push_front(vertex);
+		graph->known[base] = true;
 	}
 
 	return visVerts;
@@ -1232,40 +1330,68 @@ static void change_polygons_opt_0(PathfindingState *s) {
 }
 
 /**
- * Converts the SCI input data for pathfinding
- * Parameters: (EngineState *) s: The game state
- *             (reg_t) poly_list: Polygon list
- *             (Common::Point) start: The start point
- *             (Common::Point) end: The end point
- *             (int) opt: Optimization level (0, 1 or 2)
- * Returns   : (PathfindingState *) On success a newly allocated pathfinding state,
- *                            NULL otherwise
+ * Looks up the visibility graph of the polygon set in the cache. If there is
+ * none yet, the least recently used graph is replaced by an empty one
+ * Parameters: (AvoidPathCache *) cache: The cache
+ *             (PathfindingState *) s: The pathfinding state
+ *             (int) vertices: Number of vertices in the polygon set
+ * Returns   : (VisibilityGraph *) The visibility graph
  */
-static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Common::Point start, Common::Point end, int width, int height, int opt) {
-	SegManager *segMan = s->_segMan;
-	Polygon *polygon;
-	int count = 0;
-	PathfindingState *pf_s = new PathfindingState(width, height);
+static VisibilityGraph *lookup_graph(AvoidPathCache *cache, PathfindingState *s, int vertices) {
+	Common::Array<int16> key;
+	key.reserve(s->polygons.size() + vertices * 2);
 
-	// Convert all polygons
-	if (poly_list.getSegment()) {
-		List *list = s->_segMan->lookupList(poly_list);
-		Node *node = s->_segMan->lookupNode(list->first);
+	for (PolygonList::iterator it = s->polygons.begin(); it != s->polygons.end(); ++it) {
+		Vertex *vertex;
+		uint size = key.size();
 
-		while (node) {
-			// The node value might be null, in which case there's no polygon to parse.
-			// Happens in LB2 floppy - refer to bug #3041232
-			polygon = !node->value.isNull() ? convert_polygon(s, node->value) : NULL;
+		key.push_back(0);
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			key[size]++;
+			key.push_back(vertex->v.x);
+			key.push_back(vertex->v.y);
+		}
+	}
 
-			if (polygon) {
-				pf_s->polygons.push_back(polygon);
-				count += readSelectorValue(segMan, node->value, SELECTOR(size));
-			}
+	cache->useCount++;
 
-			node = s->_segMan->lookupNode(node->succ);
+	VisibilityGraph *graph = &cache->graphs[0];
+	for (int i = 0; i < AvoidPathCache::kMaxGraphs; i++) {
+		if (cache->graphs[i].key == key) {
+			graph = &cache->graphs[i];
+			graph->lastUse = cache->useCount;
+			return graph;
 		}
+
+		if (cache->graphs[i].lastUse < graph->lastUse)
+			graph = &cache->graphs[i];
 	}
 
+	graph->key = key;
+	graph->visible.clear();
+	graph->visible.resize(vertices);
+	graph->known.clear();
+	graph->known.resize(vertices);
+	graph->lastUse = cache->useCount;
+
+	return graph;
+}
+
+/**
+ * Prepares a converted polygon set for pathfinding: applies the optimization
+ * level, fixes up the start and end points and merges them into the set
+ * Parameters: (EngineState *) s: The game state
+ *             (PathfindingState *) pf_s: The pathfinding state
+ *             (Common::Point) start: The start point
+ *             (Common::Point) end: The end point
+ *             (int) opt: Optimization level (0, 1 or 2)
+ *             (AvoidPathCache *) cache: Visibility graph cache, or NULL
+ * Returns   : (bool) true on success, false otherwise
+ */
+static bool prepare_polygon_set(EngineState *s, PathfindingState *pf_s, Common::Point start, Common::Point end, int opt, AvoidPathCache *cache) {
+	Polygon *polygon;
+	int count = 0;
+
 	if (opt == 0)
 		change_polygons_opt_0(pf_s);
 
@@ -1273,8 +1399,7 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 
 	if (!new_start) {
 		warning("AvoidPath: Couldn't fixup start position for pathfinding");
-		delete pf_s;
-		return NULL;
+		return false;
 	}
 
 	Common::Point *new_end = fixup_end_point(pf_s, end);
@@ -1282,8 +1407,7 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	if (!new_end) {
 		warning("AvoidPath: Couldn't fixup end position for pathfinding");
 		delete new_start;
-		delete pf_s;
-		return NULL;
+		return false;
 	}
 
 	if (opt == 0) {
@@ -1305,8 +1429,7 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 				warning("AvoidPath: error finding nearest intersection");
 				delete new_start;
 				delete new_end;
-				delete pf_s;
-				return NULL;
+				return false;
 			}
 
 			if (err == PF_OK)
@@ -1322,6 +1445,18 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it) {
+		Vertex *vertex;
+
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			count++;
+		}
+	}
+
+	VisibilityGraph *graph = cache ? lookup_graph(cache, pf_s, count) : NULL;
+	const int baseCount = count;
+	const int basePolygons = pf_s->polygons.size();
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
@@ -1339,12 +1474,104 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		Vertex *vertex;
 
 		CLIST_FOREACH(vertex, &polygon->vertices) {
+			vertex->idx = count;
 			pf_s->vertex_index[count++] = vertex;
 		}
 	}
 
 	pf_s->vertices = count;
 
+	// The merged points are only added in front of the polygon set as
+	// single-vertex polygons. If one of them split up an edge instead, the
+	// cached graph doesn't match.
+	const int added = pf_s->polygons.size() - basePolygons;
+
+	if (graph && count == baseCount + added) {
+		pf_s->graph = graph;
+		pf_s->baseOffset = added;
+	}
+
+	return true;
+}
+
+/**
+ * Records a kAvoidPath query for the avoidpath_bench console command
+ * Parameters: (AvoidPathCache *) cache: The cache
+ *             (PathfindingState *) pf_s: The pathfinding state, holding the converted polygons
+ *             (Common::Point) start: The start point
+ *             (Common::Point) end: The end point
+ *             (int) opt: Optimization level (0, 1 or 2)
+ */
+static void record_query(AvoidPathCache *cache, PathfindingState *pf_s, Common::Point start, Common::Point end, int opt) {
+	if (cache->queries.size() < AvoidPathCache::kMaxQueries)
+		cache->queries.push_back(AvoidPathQuery());
+
+	AvoidPathQuery &query = cache->queries[cache->nextQuery];
+	cache->nextQuery = (cache->nextQuery + 1) % AvoidPathCache::kMaxQueries;
+
+	query.polygons.clear();
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it) {
+		Vertex *vertex;
+		uint size = query.polygons.size();
+
+		query.polygons.push_back((*it)->type);
+		query.polygons.push_back(0);
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			query.polygons[size + 1]++;
+			query.polygons.push_back(vertex->v.x);
+			query.polygons.push_back(vertex->v.y);
+		}
+	}
+
+	query.start = start;
+	query.end = end;
+	query.width = pf_s->_width;
+	query.height = pf_s->_height;
+	query.opt = opt;
+}
+
+/**
+ * Converts the SCI input data for pathfinding
+ * Parameters: (EngineState *) s: The game state
+ *             (reg_t) poly_list: Polygon list
+ *             (Common::Point) start: The start point
+ *             (Common::Point) end: The end point
+ *             (int) opt: Optimization level (0, 1 or 2)
+ * Returns   : (PathfindingState *) On success a newly allocated pathfinding state,
+ *                            NULL otherwise
+ */
+static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Common::Point start, Common::Point end, int width, int height, int opt) {
+	Polygon *polygon;
+	PathfindingState *pf_s = new PathfindingState(width, height);
+
+	// Convert all polygons
+	if (poly_list.getSegment()) {
+		List *list = s->_segMan->lookupList(poly_list);
+		Node *node = s->_segMan->lookupNode(list->first);
+
+		while (node) {
+			// The node value might be null, in which case there's no polygon to parse.
+			// Happens in LB2 floppy - refer to bug #3041232
+			polygon = !node->value.isNull() ? convert_polygon(s, node->value) : NULL;
+
+			if (polygon)
+				pf_s->polygons.push_back(polygon);
+
+			node = s->_segMan->lookupNode(node->succ);
+		}
+	}
+
+	if (!s->_avoidPathCache)
+		s->_avoidPathCache = new AvoidPathCache();
+
+	if (s->_avoidPathCache->recording)
+		record_query(s->_avoidPathCache, pf_s, start, end, opt);
+
+	if (!prepare_polygon_set(s, pf_s, start, end, opt, s->_avoidPathCache)) {
+		delete pf_s;
+		return NULL;
+	}
+
 	return pf_s;
 }
 
@@ -1640,6 +1867,98 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 	}
 }
 
+/**
+ * Rebuilds the converted polygon set of a recorded kAvoidPath query
+ * Parameters: (const AvoidPathQuery &) query: The query
+ * Returns   : (PathfindingState *) A newly allocated pathfinding state
+ */
+static PathfindingState *replay_query(const AvoidPathQuery &query) {
+	PathfindingState *pf_s = new PathfindingState(query.width, query.height);
+	uint i = 0;
+
+	while (i < query.polygons.size()) {
+		Polygon *polygon = new Polygon(query.polygons[i]);
+		int size = query.polygons[i + 1];
+
+		for (i += 2; size > 0; size--, i += 2)
+			polygon->vertices.insertAtEnd(new Vertex(Common::Point(query.polygons[i], query.polygons[i + 1])));
+
+		pf_s->polygons.push_back(polygon);
+	}
+
+	return pf_s;
+}
+
+static uint32 path_checksum(PathfindingState *p) {
+	uint32 checksum = 0;
+
+	if (p->_prependPoint)
+		checksum = checksum * 31 + p->_prependPoint->x * 1024 + p->_prependPoint->y;
+
+	for (Vertex *vertex = p->vertex_end; vertex; vertex = vertex->path_prev)
+		checksum = checksum * 31 + vertex->v.x * 1024 + vertex->v.y;
+
+	if (p->_appendPoint)
+		checksum = checksum * 31 + p->_appendPoint->x * 1024 + p->_appendPoint->y;
+
+	return checksum;
+}
+
+void setAvoidPathRecording(EngineState *s, bool record) {
+	if (!s->_avoidPathCache)
+		s->_avoidPathCache = new AvoidPathCache();
+
+	AvoidPathCache *cache = s->_avoidPathCache;
+	if (record && !cache->recording) {
+		// Start a new recording
+		cache->queries.clear();
+		cache->nextQuery = 0;
+	}
+	cache->recording = record;
+}
+
+Common::String benchmarkAvoidPath(EngineState *s, uint iterations) {
+	AvoidPathCache *cache = s->_avoidPathCache;
+
+	if (!cache || cache->queries.empty())
+		return "No kAvoidPath queries recorded yet, start with 'avoidpath_bench record on'\n";
+
+	uint32 checksum[2];
+	uint32 time[2];
+
+	for (int pass = 0; pass < 2; pass++) {
+		// Start with empty graphs, so that building them is measured as well
+		for (int i = 0; i < AvoidPathCache::kMaxGraphs; i++)
+			cache->graphs[i] = VisibilityGraph();
+
+		const uint32 startTime = g_system->getMillis();
+		checksum[pass] = 0;
+
+		for (uint iteration = 0; iteration < iterations; iteration++) {
+			for (uint i = 0; i < cache->queries.size(); i++) {
+				const AvoidPathQuery &query = cache->queries[i];
+				PathfindingState *p = replay_query(query);
+
+				if (prepare_polygon_set(s, p, query.start, query.end, query.opt, pass ? cache : NULL)) {
+					AStar(p);
+					checksum[pass] = checksum[pass] * 31 + path_checksum(p);
+				}
+
+				delete p;
+			}
+		}
+
+		time[pass] = g_system->getMillis() - startTime;
+	}
+
+	return Common::String::format("%u queries, %u iterations\n"
+			"  Uncached: %u ms\n"
+			"  Cached:   %u ms\n"
+			"  Paths %s\n",
+			cache->queries.size(), iterations, time[0], time[1],
+			checksum[0] == checksum[1] ? "match" : "DIFFER");
+}
+
 static bool PointInRect(const Common::Point &point, int16 rectX1, int16 rectY1, int16 rectX2, int16 rectY2) {
 	int16 top = MIN<int16>(rectY1, rectY2);
 	int16 left = MIN<int16>(rectX1, rectX2);
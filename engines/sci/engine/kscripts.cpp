@@ -46,6 +46,11 @@ reg_t kLoad(EngineState *s, int argc, reg_t *argv) {
 	if (restype == kResourceTypeMemory)
 		return s->_segMan->allocateHunkEntry("kLoad()", resnr);
 
+	// Room scripts announce the views and pics they are about to use
+	// through kLoad, so start reading them in the background
+	if (restype == kResourceTypeView || restype == kResourceTypePic || restype == kResourceTypePalette)
+		g_sci->getResMan()->prefetchResource(ResourceId(restype, resnr));
+
 	return make_reg(0, ((restype << 11) | resnr)); // Return the resource identifier as handle
 }
 
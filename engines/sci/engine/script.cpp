@@ -73,6 +73,8 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
+
+	_instructionCache.clear();
 }
 
 enum {
@@ -935,6 +937,47 @@ bool Script::isValidOffset(uint32 offset) const {
 	return offset < _buf->size();
 }
 
+DecodedInstruction &Script::allocInstructionCache(uint32 offset) {
+	// One entry per 4 bytes of script, which keeps collisions in loops
+	// rare, up to 80KB per script
+	uint32 size = 64;
+	while (size < 4096 && size * 4 < _buf->size())
+		size *= 2;
+
+	DecodedInstruction empty;
+	memset(&empty, 0, sizeof(empty));
+	empty.offset = kNoInstruction;
+	_instructionCache.resize(size);
+	for (uint32 i = 0; i < size; ++i)
+		_instructionCache[i] = empty;
+
+	return _instructionCache[offset & (size - 1)];
+}
+
+void Script::decodeInstruction(DecodedInstruction &inst, uint32 offset) const {
+	inst.size = readPMachineInstruction(getBuf(offset), inst.extOpcode, inst.opparams);
+	inst.offset = offset;
+	inst.branchOpcode = 0;
+	inst.branchParam = 0;
+	inst.branchSize = 0;
+
+	// Conditions of if and while statements compile to a comparison and a
+	// conditional branch
+	const byte opcode = inst.extOpcode >> 1;
+	const uint32 next = offset + inst.size;
+	if (opcode < op_eq_ || opcode > op_ule_ || next >= _buf->size())
+		return;
+
+	byte extOpcode;
+	int16 opparams[4];
+	const uint16 size = readPMachineInstruction(getBuf(next), extOpcode, opparams);
+	if ((extOpcode >> 1) == op_bt || (extOpcode >> 1) == op_bnt) {
+		inst.branchOpcode = extOpcode >> 1;
+		inst.branchParam = opparams[0];
+		inst.branchSize = size;
+	}
+}
+
 SegmentRef Script::dereference(reg_t pointer) {
 	if (pointer.getOffset() > _buf->size()) {
 		error("Script::dereference(): Attempt to dereference invalid pointer %04x:%04x into script %d segment (script size=%u)",
@@ -57,7 +57,8 @@ enum ScriptOffsetEntryTypes {
 };
 
 enum {
-	kNoRelocation = 0xFFFFFFFF
+	kNoRelocation = 0xFFFFFFFF,
+	kNoInstruction = 0xFFFFFFFF
 };
 
 struct offsetLookupArrayEntry {
@@ -69,6 +70,23 @@ struct offsetLookupArrayEntry {
 
 typedef Common::Array<offsetLookupArrayEntry> offsetLookupArrayType;
 
+/**
+ * An instruction as decoded by readPMachineInstruction(), cached by
+ * Script::getInstruction().
+ *
+ * A comparison directly followed by a conditional branch also holds that
+ * branch, so run_vm() can run both as one superinstruction.
+ */
+struct DecodedInstruction {
+	uint32 offset;      // offset of the instruction, kNoInstruction for free entries
+	int16 opparams[4];  // decoded operands
+	byte extOpcode;     // opcode, including the operand size bit
+	byte branchOpcode;  // op_bt or op_bnt following a comparison, 0 otherwise
+	uint16 size;        // size of the instruction in bytes
+	int16 branchParam;  // relative target of that branch
+	uint16 branchSize;  // size of that branch in bytes
+};
+
 class Script : public SegmentObj {
 private:
 	int _nr; /**< Script number */
@@ -102,6 +120,13 @@ private:
 	uint16 _offsetLookupStringCount;
 	uint16 _offsetLookupSaidCount;
 
+	/**
+	 * Direct mapped cache of decoded instructions, indexed by the low bits
+	 * of their offset. Allocated on first execution, as most scripts only
+	 * ever provide objects and classes.
+	 */
+	Common::Array<DecodedInstruction> _instructionCache;
+
 public:
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
@@ -120,6 +145,29 @@ public:
 	const byte *getBuf(uint offset = 0) const { return _buf->getUnsafeDataAt(offset); }
 	SciSpan<const byte> getSpan(uint offset) const { return _buf->subspan(offset); }
 
+	/**
+	 * Returns the instruction at the given offset, decoding it only if it
+	 * is not cached yet. Script code is never written to after the script
+	 * has been loaded and patched, so entries stay valid until the script
+	 * is freed.
+	 */
+	const DecodedInstruction &getInstruction(uint32 offset) {
+		DecodedInstruction &inst = _instructionCache.empty() ? allocInstructionCache(offset) : _instructionCache[offset & (_instructionCache.size() - 1)];
+		if (inst.offset != offset)
+			decodeInstruction(inst, offset);
+		return inst;
+	}
+
+	/**
+	 * Decodes the instruction at the given offset without the cache.
+	 */
+	void decodeInstruction(DecodedInstruction &inst, uint32 offset) const;
+
+	/**
+	 * Returns the instructions cached so far.
+	 */
+	const Common::Array<DecodedInstruction> &getInstructionCache() const { return _instructionCache; }
+
 	int getScriptNumber() const { return _nr; }
 	SegmentId getLocalsSegment() const { return _localsSegment; }
 	reg_t *getLocalsBegin() { return _localsBlock ? _localsBlock->_locals.begin() : NULL; }
@@ -295,6 +343,12 @@ public:
 	uint32 getRelocationOffset(const uint32 offset) const;
 
 private:
+	/**
+	 * Allocates the instruction cache, sized after the script, and returns
+	 * the entry for the given offset.
+	 */
+	DecodedInstruction &allocInstructionCache(uint32 offset);
+
 	/**
 	 * Returns a Span containing the relocation table for a SCI0-SCI2.1 script.
 	 * (The SCI0-SCI2.1 relocation table is simply a list of all of the
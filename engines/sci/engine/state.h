@@ -43,12 +43,14 @@ class WriteStream;
 
 namespace Sci {
 
+class AvoidPathCache;
 class FileHandle;
 class DirSeeker;
 class EventManager;
 class MessageState;
 class SoundCommandParser;
 class VirtualIndexFile;
+struct GCMarkState;
 
 enum AbortGameState {
 	kAbortNone = 0,
@@ -98,6 +100,25 @@ struct SciCallOrigin {
 	}
 };
 
+/**
+ * Pause statistics of the garbage collector, shown by the gc_stats console
+ * command. Times are in microseconds.
+ */
+struct GCStats {
+	uint32 collections; //< Number of collections finished
+	uint32 slices; //< Number of incremental marking and sweep steps run
+	uint32 lastReachable; //< Addresses found reachable by the last collection
+	uint32 lastGarbage; //< Objects found unreachable by the last collection
+	uint32 lastRescanned; //< Objects scanned again by the last incremental collection
+	uint32 totalFreed; //< Objects freed since the game was started
+	uint32 lastCollectionTime; //< Duration of the last full collection or final incremental step
+	uint32 maxCollectionTime; //< Longest of those
+	uint32 lastMarkTime; //< Part of it spent finding reachable objects
+	uint32 maxMarkTime; //< Longest of those
+	uint32 maxSliceTime; //< Longest incremental step
+	uint64 totalTime; //< Time spent in the garbage collector
+};
+
 struct EngineState : public Common::Serializable {
 public:
 	EngineState(SegManager *segMan);
@@ -194,6 +215,11 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	GCMarkState *gcMark; /**< Progress of an incremental collection, see run_gc() */
+	Common::Array<reg_t> gcGarbage; /**< Unreachable objects not freed yet, see run_gc_slice() */
+	GCStats gcStats;
+
+	AvoidPathCache *_avoidPathCache; /**< Visibility graphs and recorded queries of kAvoidPath */
 
 	MessageState *_msgState;
 
@@ -664,9 +664,20 @@ void run_vm(EngineState *s) {
 
 		// Get opcode
 		byte extOpcode;
-		if (!vmHooks.isActive(s))
-			s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
-		else {
+		const DecodedInstruction *fusedBranch = nullptr;
+		if (!vmHooks.isActive(s)) {
+			const DecodedInstruction &inst = scr->getInstruction(s->xs->addr.pc.getOffset());
+			extOpcode = inst.extOpcode;
+			memcpy(opparams, inst.opparams, sizeof(opparams));
+			s->xs->addr.pc.incOffset(inst.size);
+
+			// Run the branch following a comparison right after it. This
+			// skips the checks between the two, so only do it when neither
+			// the debugger nor a VM hook could stop at the branch.
+			if (inst.branchOpcode && !g_sci->_debugState.debugging && !vmHooks.hasHooks() &&
+				!(g_sci->_debugState._activeBreakpointTypes & BREAK_ADDRESS))
+				fusedBranch = &inst;
+		} else {
 			int offset = readPMachineInstruction(vmHooks.data(), extOpcode, opparams);
 			vmHooks.advance(offset);
 		}
@@ -906,10 +917,13 @@ void run_vm(EngineState *s) {
 		}
 
 		case op_callk: { // 0x21 (33)
-			// Run the garbage collector, if needed
+			// Run the garbage collector, if needed. Finding and freeing the
+			// unreachable objects is spread over the following kernel calls.
 			if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				run_gc(s, true);
+			} else {
+				run_gc_slice(s);
 			}
 
 			// Call kernel function
@@ -1443,6 +1457,26 @@ void run_vm(EngineState *s) {
 
 		} // switch (opcode)
 
+		if (fusedBranch) {
+			// A comparison changes neither the execution stack nor the
+			// program counter, so the branch can follow it directly
+			s->xs->addr.pc.incOffset(fusedBranch->branchSize);
+			const bool isTrue = s->r_acc.getOffset() || s->r_acc.getSegment();
+			if (isTrue == (fusedBranch->branchOpcode == op_bt)) {
+				s->xs->addr.pc.incOffset(fusedBranch->branchParam);
+
+				if (s->xs->addr.pc.getOffset() >= local_script->getScriptSize())
+					error("[VM] %s: request to jump past the end of script %d (offset %d, script is %d bytes)",
+						fusedBranch->branchOpcode == op_bt ? "op_bt" : "op_bnt",
+						local_script->getScriptNumber(), s->xs->addr.pc.getOffset(), local_script->getScriptSize());
+			}
+
+#ifdef ABORT_ON_INFINITE_LOOP
+			prevOpcode = fusedBranch->branchOpcode;
+#endif
+			++s->scriptStepCounter;
+		}
+
 		if (s->_executionStackPosChanged) // Force initialization
 			s->xs = xs_new;
 
@@ -83,6 +83,9 @@ public:
 
 	bool isActive(Sci::EngineState *s);
 
+	/** Whether the game has any hooks at all */
+	bool hasHooks() const { return !_hooksMap.empty(); }
+
 	void advance(int offset);
 
 private:
@@ -22,9 +22,11 @@
 
 // Resource library
 
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/profiler.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
@@ -211,6 +213,9 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_fileOffset = 0;
 	_status = kResStatusNoMalloc;
 	_lockers = 0;
+	_pinned = false;
+	_lruPrev = nullptr;
+	_lruNext = nullptr;
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
@@ -423,6 +428,7 @@ void ResourceManager::disposeVolumeFileStream(Common::SeekableReadStream *fileSt
 }
 
 void ResourceManager::loadResource(Resource *res) {
+	PROFILE_ZONE("Sci::ResourceManager::loadResource");
 	res->_source->loadResource(this, res);
 	if (_patcher) {
 		_patcher->applyPatch(*res);
@@ -990,7 +996,9 @@ void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
 	_memoryLRU = 0;
-	_LRU.clear();
+	_lruHead = nullptr;
+	_lruTail = nullptr;
+	_cacheStats = ResourceCacheStats();
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 #ifdef ENABLE_SCI32
@@ -1064,6 +1072,11 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	// The cache budget can be overridden (in KiB), e.g. to stop SCI32
+	// games with many large scrolling pictures from thrashing the cache
+	if (!_detectionMode && ConfMan.hasKey("resource_cache_size"))
+		setCacheBudget(ConfMan.getInt("resource_cache_size") * 1024);
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1110,7 +1123,17 @@ void ResourceManager::removeFromLRU(Resource *res) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
+
+	if (res->_lruPrev)
+		res->_lruPrev->_lruNext = res->_lruNext;
+	else
+		_lruHead = res->_lruNext;
+	if (res->_lruNext)
+		res->_lruNext->_lruPrev = res->_lruPrev;
+	else
+		_lruTail = res->_lruPrev;
+	res->_lruPrev = res->_lruNext = nullptr;
+
 	_memoryLRU -= res->size();
 	res->_status = kResStatusAllocated;
 }
@@ -1120,7 +1143,19 @@ void ResourceManager::addToLRU(Resource *res) {
 		warning("resMan: trying to enqueue resource with state %d", res->_status);
 		return;
 	}
-	_LRU.push_front(res);
+
+	// Pinned resources stay allocated, but out of reach of the LRU
+	if (res->_pinned)
+		return;
+
+	res->_lruPrev = nullptr;
+	res->_lruNext = _lruHead;
+	if (_lruHead)
+		_lruHead->_lruPrev = res;
+	else
+		_lruTail = res;
+	_lruHead = res;
+
 	_memoryLRU += res->size();
 #if SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
@@ -1133,15 +1168,11 @@ void ResourceManager::addToLRU(Resource *res) {
 void ResourceManager::printLRU() {
 	int mem = 0;
 	int entries = 0;
-	Common::List<Resource *>::iterator it = _LRU.begin();
-	Resource *res;
 
-	while (it != _LRU.end()) {
-		res = *it;
+	for (Resource *res = _lruHead; res; res = res->_lruNext) {
 		debug("\t%s: %u bytes", res->_id.toString().c_str(), res->size());
 		mem += res->size();
 		++entries;
-		++it;
 	}
 
 	debug("Total: %d entries, %d bytes (mgr says %d)", entries, mem, _memoryLRU);
@@ -1149,9 +1180,11 @@ void ResourceManager::printLRU() {
 
 void ResourceManager::freeOldResources() {
 	while (_maxMemoryLRU < _memoryLRU) {
-		assert(!_LRU.empty());
-		Resource *goner = _LRU.back();
+		assert(_lruTail);
+		Resource *goner = _lruTail;
 		removeFromLRU(goner);
+		_cacheStats.evictions++;
+		_cacheStats.evictedBytes += goner->size();
 		goner->unalloc();
 #ifdef SCI_VERBOSE_RESMAN
 		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
@@ -1159,6 +1192,53 @@ void ResourceManager::freeOldResources() {
 	}
 }
 
+void ResourceManager::setCacheBudget(int bytes) {
+	_maxMemoryLRU = MAX(bytes, 0);
+	freeOldResources();
+}
+
+void ResourceManager::prefetchResource(ResourceId id) {
+	Resource *res = testResource(id);
+	if (!res || res->_status != kResStatusNoMalloc)
+		return;
+
+	// Only the volume files kept open in _volumeFiles are hinted, other
+	// sources would have to create a stream just for this
+	if (res->_source->getSourceType() != kSourceVolume || res->_source->_resourceFile)
+		return;
+
+	Common::SeekableReadStream *fileStream = getVolumeFile(res->_source);
+	if (!fileStream)
+		return;
+
+	// Streams without read-ahead ignore the hint, so this never blocks
+	fileStream->prefetch(res->_fileOffset, PREFETCH_SIZE);
+	_cacheStats.prefetches++;
+}
+
+bool ResourceManager::pinResource(ResourceId id) {
+	Resource *res = findResource(id, false);
+	if (!res)
+		return false;
+
+	if (res->_status == kResStatusEnqueued)
+		removeFromLRU(res);
+	res->_pinned = true;
+	return true;
+}
+
+void ResourceManager::unpinResource(ResourceId id) {
+	Resource *res = testResource(id);
+	if (!res || !res->_pinned)
+		return;
+
+	res->_pinned = false;
+	if (res->_status == kResStatusAllocated) {
+		addToLRU(res);
+		freeOldResources();
+	}
+}
+
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
 	Common::List<ResourceId> resources;
 
@@ -1195,9 +1275,14 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (retval->_status == kResStatusNoMalloc) {
+		_cacheStats.misses++;
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+	} else {
+		_cacheStats.hits++;
+	}
+
+	if (retval->_status == kResStatusEnqueued)
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
@@ -76,7 +76,8 @@ enum ResourceErrorCodes {
 };
 
 enum {
-	MAX_OPENED_VOLUMES = 5 ///< Max number of simultaneously opened volumes
+	MAX_OPENED_VOLUMES = 5, ///< Max number of simultaneously opened volumes
+	PREFETCH_SIZE = 64 * 1024 ///< Bytes of volume data hinted by prefetchResource
 };
 
 enum ResourceType {
@@ -241,6 +242,17 @@ struct ResourceIdHash : public Common::UnaryFunction<ResourceId, uint> {
 	uint operator()(ResourceId val) const { return val.hash(); }
 };
 
+/** Counters describing how well the resource cache is doing */
+struct ResourceCacheStats {
+	uint32 hits;		///< Lookups of resources which were already in memory
+	uint32 misses;		///< Lookups which had to load the resource
+	uint32 prefetches;	///< Resources hinted to the read-ahead thread by prefetchResource
+	uint32 evictions;	///< Resources freed to stay within the cache budget
+	uint32 evictedBytes;	///< Total size of the evicted resources
+
+	ResourceCacheStats() : hits(0), misses(0), prefetches(0), evictions(0), evictedBytes(0) {}
+};
+
 /** Class for storing resources in memory */
 class Resource : public SciSpan<const byte> {
 	friend class ResourceManager;
@@ -292,12 +304,16 @@ public:
 	uint32 getAudioCompressionType() const;
 
 	uint16 getNumLockers() const { return _lockers; }
+	bool isPinned() const { return _pinned; }
 
 protected:
 	ResourceId _id;	// TODO: _id could almost be made const, only readResourceInfo() modifies it...
 	int32 _fileOffset; /**< Offset in file */
 	ResourceStatus _status;
 	uint16 _lockers; /**< Number of places where this resource was locked */
+	bool _pinned; /**< Pinned resources stay in memory when unlocked */
+	Resource *_lruPrev; /**< Next more recently used resource in the LRU list */
+	Resource *_lruNext; /**< Next less recently used resource in the LRU list */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
@@ -369,6 +385,41 @@ public:
 	 */
 	void unlockResource(Resource *res);
 
+	/**
+	 * Hints that a resource will be used soon, e.g. when a room script
+	 * announces the views and pics it is about to use. The volume data is
+	 * queued on the read-ahead I/O thread, the resource itself is still
+	 * decompressed on first use. Does nothing if the resource does not
+	 * exist, is already loaded or does not come from a volume file.
+	 * @param id	The resource to prefetch
+	 */
+	void prefetchResource(ResourceId id);
+
+	/**
+	 * Pins a resource, so that it stays in memory even while it is not
+	 * locked. Pinned resources do not count against the cache budget.
+	 * @param id	The resource to pin
+	 * @return true if the resource exists and could be loaded
+	 */
+	bool pinResource(ResourceId id);
+
+	/**
+	 * Unpins a previously pinned resource, handing it back to the LRU cache.
+	 * @param id	The resource to unpin
+	 */
+	void unpinResource(ResourceId id);
+
+	/**
+	 * Sets the number of bytes unlocked resources may take up before the
+	 * least recently used ones are freed.
+	 */
+	void setCacheBudget(int bytes);
+	int getCacheBudget() const { return _maxMemoryLRU; }
+	int getCacheMemoryUsed() const { return _memoryLRU; }
+	int getLockedMemory() const { return _memoryLocked; }
+	const ResourceCacheStats &getCacheStats() const { return _cacheStats; }
+	void resetCacheStats() { _cacheStats = ResourceCacheStats(); }
+
 	/**
 	 * Tests whether a resource exists.
 	 *
@@ -489,7 +540,9 @@ protected:
 	SourcesList _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
-	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	Resource *_lruHead;	///< Most recently used resource under LRU control
+	Resource *_lruTail;	///< Least recently used resource, the next one to be freed
+	ResourceCacheStats _cacheStats;
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -0,0 +1,254 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/dirty_region.h"
+
+namespace Graphics {
+
+static inline uint32 rectArea(const Common::Rect &r) {
+	return (uint32)r.width() * r.height();
+}
+
+uint DirtyRegion::nextBand(const Common::Array<Common::Rect> &rects, uint band) const {
+	uint i = band + 1;
+	while (i < rects.size() && rects[i].top == rects[band].top)
+		++i;
+	return i;
+}
+
+void DirtyRegion::appendBand(Common::Array<Common::Rect> &dst, uint &dstBand, int16 top, int16 bottom,
+                             const Common::Rect *first, const Common::Rect *last, const Common::Rect *extra) const {
+	const uint start = dst.size();
+
+	// Both inputs are sorted by left edge, merge them and join the spans
+	// that overlap or touch
+	while (first != last || extra) {
+		int16 left, right;
+		if (extra && (first == last || extra->left < first->left)) {
+			left = extra->left;
+			right = extra->right;
+			extra = nullptr;
+		} else {
+			left = first->left;
+			right = first->right;
+			++first;
+		}
+
+		if (dst.size() > start && left <= dst.back().right)
+			dst.back().right = MAX(dst.back().right, right);
+		else
+			dst.push_back(Common::Rect(left, top, right, bottom));
+	}
+
+	if (dst.size() == start)
+		return;
+
+	// Extend the previous band instead if it ends here with the same spans
+	const uint count = dst.size() - start;
+	if (dstBand < start && dst[dstBand].bottom == top && start - dstBand == count) {
+		bool same = true;
+		for (uint i = 0; i < count && same; ++i)
+			same = dst[dstBand + i].left == dst[start + i].left && dst[dstBand + i].right == dst[start + i].right;
+
+		if (same) {
+			for (uint i = 0; i < count; ++i)
+				dst[dstBand + i].bottom = bottom;
+			dst.resize(start);
+			return;
+		}
+	}
+
+	dstBand = start;
+}
+
+void DirtyRegion::add(const Common::Rect &r) {
+	if (r.isEmpty())
+		return;
+
+	if (_rects.empty()) {
+		_rects.push_back(r);
+		return;
+	}
+
+	// Sprites redrawn in place often hit an area that is already dirty
+	for (uint i = 0; i < _rects.size() && _rects[i].top <= r.top; ++i) {
+		if (_rects[i].contains(r))
+			return;
+	}
+
+	// Walk the region top to bottom, splitting it at the edges of both the
+	// existing bands and the new rectangle
+	// The bands are built in a scratch array which keeps its storage
+	// between calls, then copied back
+	_scratch.resize(0);
+	_scratch.reserve(_rects.size() + 4);
+	uint resultBand = 0;
+
+	const uint size = _rects.size();
+	const int16 end = MAX(r.bottom, _rects[size - 1].bottom);
+	int16 y = MIN(r.top, _rects[0].top);
+	uint band = 0;
+
+	while (y < end) {
+		while (band < size && _rects[band].bottom <= y)
+			band = nextBand(_rects, band);
+
+		int16 next = end;
+		const bool inBand = band < size && _rects[band].top <= y;
+		if (band < size)
+			next = MIN(next, inBand ? _rects[band].bottom : _rects[band].top);
+
+		const bool inRect = r.top <= y && y < r.bottom;
+		if (inRect)
+			next = MIN(next, r.bottom);
+		else if (y < r.top)
+			next = MIN(next, r.top);
+
+		if (inBand || inRect) {
+			const Common::Rect *first = nullptr, *last = nullptr;
+			if (inBand) {
+				first = &_rects[band];
+				last = first + (nextBand(_rects, band) - band);
+			}
+			appendBand(_scratch, resultBand, y, next, first, last, inRect ? &r : nullptr);
+		}
+
+		y = next;
+	}
+
+	_rects.assign(_scratch.begin(), _scratch.end());
+}
+
+void DirtyRegion::add(const DirtyRegion &region) {
+	for (uint i = 0; i < region._rects.size(); ++i)
+		add(region._rects[i]);
+}
+
+void DirtyRegion::clip(const Common::Rect &bounds) {
+	uint dst = 0;
+	for (uint i = 0; i < _rects.size(); ++i) {
+		Common::Rect r = _rects[i];
+		r.clip(bounds);
+		if (!r.isEmpty())
+			_rects[dst++] = r;
+	}
+	_rects.resize(dst);
+}
+
+void DirtyRegion::translate(int16 dx, int16 dy) {
+	for (uint i = 0; i < _rects.size(); ++i)
+		_rects[i].translate(dx, dy);
+}
+
+bool DirtyRegion::intersects(const Common::Rect &r) const {
+	for (uint i = 0; i < _rects.size() && _rects[i].top < r.bottom; ++i) {
+		if (_rects[i].intersects(r))
+			return true;
+	}
+	return false;
+}
+
+bool DirtyRegion::contains(int16 x, int16 y) const {
+	for (uint i = 0; i < _rects.size() && _rects[i].top <= y; ++i) {
+		if (_rects[i].contains(x, y))
+			return true;
+	}
+	return false;
+}
+
+Common::Rect DirtyRegion::getBounds() const {
+	if (_rects.empty())
+		return Common::Rect();
+
+	Common::Rect bounds = _rects[0];
+	for (uint i = 1; i < _rects.size(); ++i)
+		bounds.extend(_rects[i]);
+	return bounds;
+}
+
+uint32 DirtyRegion::getArea() const {
+	uint32 area = 0;
+	for (uint i = 0; i < _rects.size(); ++i)
+		area += rectArea(_rects[i]);
+	return area;
+}
+
+void DirtyRegion::getUpdateRects(Common::Array<Common::Rect> &rects, uint rectCost) const {
+	rects = _rects;
+
+	Common::Array<bool> absorbed;
+	bool merged = true;
+	while (merged) {
+		merged = false;
+
+		for (uint i = 0; i < rects.size(); ++i) {
+			for (uint j = i + 1; j < rects.size(); ++j) {
+				Common::Rect box = rects[i];
+				box.extend(rects[j]);
+
+				// Cheap test on the pair alone first
+				uint32 cost = rectArea(rects[i]) + rectArea(rects[j]) + rectCost;
+				if (rectArea(box) > cost)
+					continue;
+
+				// The box replaces every rectangle it touches, which
+				// keeps the result disjoint. Those are charged as well.
+				absorbed.clear();
+				absorbed.resize(rects.size());
+				absorbed[i] = absorbed[j] = true;
+				bool grown = true;
+				while (grown) {
+					grown = false;
+					for (uint k = 0; k < rects.size(); ++k) {
+						if (!absorbed[k] && box.intersects(rects[k])) {
+							absorbed[k] = true;
+							box.extend(rects[k]);
+							cost += rectArea(rects[k]) + rectCost;
+							grown = true;
+						}
+					}
+				}
+
+				if (rectArea(box) > cost)
+					continue;
+
+				uint dst = 0, boxIndex = 0;
+				for (uint k = 0; k < rects.size(); ++k) {
+					if (k == i) {
+						boxIndex = dst;
+						rects[dst++] = box;
+					} else if (!absorbed[k]) {
+						rects[dst++] = rects[k];
+					}
+				}
+				rects.resize(dst);
+
+				// Keep merging into the new box
+				merged = true;
+				i = boxIndex;
+				j = i;
+			}
+		}
+	}
+}
+
+} // End of namespace Graphics
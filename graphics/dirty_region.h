@@ -0,0 +1,118 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_DIRTY_REGION_H
+#define GRAPHICS_DIRTY_REGION_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+/**
+ * @defgroup graphics_dirty_region Dirty region
+ * @ingroup graphics
+ *
+ * @brief Set of screen areas that need to be redrawn or uploaded.
+ *
+ * @{
+ */
+
+/**
+ * A set of pixels, stored as disjoint rectangles in y-x banded order:
+ * the rectangles are sorted by top edge, rectangles in the same band share
+ * their top and bottom edges and are sorted by left edge. Adding a rectangle
+ * splits the bands it crosses and unions the horizontal spans within them,
+ * so overlapping dirty rectangles never cover a pixel twice. Vertically
+ * adjacent bands with identical spans are coalesced.
+ */
+class DirtyRegion {
+public:
+	/**
+	 * Default cost of a single rectangle update, expressed in pixels. It
+	 * is the amount of unchanged pixels that is worth copying to save a
+	 * call to the backend.
+	 */
+	static const uint kDefaultRectCost = 2048;
+
+	/** Add the rectangle to the region. */
+	void add(const Common::Rect &r);
+
+	/** Add all of another region. */
+	void add(const DirtyRegion &region);
+
+	/** Remove everything outside of the given bounds. */
+	void clip(const Common::Rect &bounds);
+
+	/** Translate the whole region. */
+	void translate(int16 dx, int16 dy);
+
+	/** Empty the region, keeping the storage for the next rectangles. */
+	void clear() { _rects.resize(0); }
+
+	bool isEmpty() const { return _rects.empty(); }
+
+	/** Check whether any part of the rectangle lies within the region. */
+	bool intersects(const Common::Rect &r) const;
+
+	/** Check whether the point lies within the region. */
+	bool contains(int16 x, int16 y) const;
+
+	/** Bounding box of the region. */
+	Common::Rect getBounds() const;
+
+	/** Number of pixels covered by the region. */
+	uint32 getArea() const;
+
+	/** The banded rectangles making up the region. */
+	const Common::Array<Common::Rect> &getRects() const { return _rects; }
+
+	/**
+	 * Compute the rectangles to update for the region. Each rectangle is
+	 * charged its area plus @p rectCost; rectangles are merged into their
+	 * bounding box whenever that lowers the total cost. The result stays
+	 * disjoint and covers the whole region.
+	 */
+	void getUpdateRects(Common::Array<Common::Rect> &rects, uint rectCost = kDefaultRectCost) const;
+
+private:
+	/** Index of the first rectangle after the band starting at @p band. */
+	uint nextBand(const Common::Array<Common::Rect> &rects, uint band) const;
+
+	/**
+	 * Append the band [top, bottom) holding the union of the spans in
+	 * [first, last) and @p extra to @p dst, merging it with the previous
+	 * band when the spans match.
+	 */
+	void appendBand(Common::Array<Common::Rect> &dst, uint &dstBand, int16 top, int16 bottom,
+	                const Common::Rect *first, const Common::Rect *last, const Common::Rect *extra) const;
+
+	Common::Array<Common::Rect> _rects;
+	// Storage reused by add() to build the new bands
+	Common::Array<Common::Rect> _scratch;
+};
+
+/** @} */
+
+} // End of namespace Graphics
+
+#endif
@@ -3,6 +3,7 @@ MODULE := graphics
 MODULE_OBJS := \
 	conversion.o \
 	cursorman.o \
+	dirty_region.o \
 	font.o \
 	fontman.o \
 	fonts/bdf.o \
@@ -54,6 +55,28 @@ MODULE_OBJS := \
 	opengl/control_shaders.o \
 	opengl/compat_shaders.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	transparent_surface_sse2.o \
+	yuv_to_rgb_sse2.o
+$(MODULE)/transparent_surface_sse2.o: CXXFLAGS += -msse2
+$(MODULE)/yuv_to_rgb_sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	transparent_surface_avx2.o \
+	yuv_to_rgb_avx2.o
+$(MODULE)/transparent_surface_avx2.o: CXXFLAGS += -mavx2
+$(MODULE)/yuv_to_rgb_avx2.o: CXXFLAGS += -mavx2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	transparent_surface_neon.o \
+	yuv_to_rgb_neon.o
+endif
+
 ifdef USE_TINYGL
 MODULE_OBJS += \
 	tinygl/api.o \
@@ -89,6 +112,23 @@ MODULE_OBJS += \
 	scaler/scale3x.o \
 	scaler/scalebit.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	scaler/simd_sse2.o
+$(MODULE)/scaler/simd_sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	scaler/simd_avx2.o
+$(MODULE)/scaler/simd_avx2.o: CXXFLAGS += -mavx2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	scaler/simd_neon.o
+endif
+
 ifdef USE_ARM_SCALER_ASM
 MODULE_OBJS += \
 	scaler/downscalerARM.o \
@@ -20,9 +20,12 @@
  *
  */
 
+#include "graphics/scaler.h"
 #include "graphics/scaler/intern.h"
 #include "graphics/scaler/scalebit.h"
+#include "graphics/scaler/simd_intern.h"
 #include "common/util.h"
+#include "common/simd.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -159,6 +162,14 @@ void DestroyScalers() {
 #endif
 }
 
+bool isScalerReentrant(ScalerProc *scaler) {
+#if defined(USE_SCALERS) && defined(USE_HQ_SCALERS) && defined(USE_NASM)
+	if (scaler == HQ2x || scaler == HQ3x)
+		return false;
+#endif
+	return true;
+}
+
 
 /**
  * Trivial 'scaler' - in fact it doesn't do any scaling but just copies the
@@ -259,7 +270,11 @@ void Normal3x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPit
  */
 void AdvMame2x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch,
 							 int width, int height) {
-	scale(2, dstPtr, dstPitch, srcPtr - srcPitch, srcPitch, 2, width, height);
+	int done = 0;
+	if (getScalerProcs().advMame2x)
+		done = getScalerProcs().advMame2x(srcPtr, srcPitch, dstPtr, dstPitch, width, height, gBitFormat == 565);
+	if (done < width)
+		scale(2, dstPtr + done * 4, dstPitch, srcPtr - srcPitch + done * 2, srcPitch, 2, width - done, height);
 }
 
 /**
@@ -268,7 +283,11 @@ void AdvMame2x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPi
  */
 void AdvMame3x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch,
 							 int width, int height) {
-	scale(3, dstPtr, dstPitch, srcPtr - srcPitch, srcPitch, 2, width, height);
+	int done = 0;
+	if (getScalerProcs().advMame3x)
+		done = getScalerProcs().advMame3x(srcPtr, srcPitch, dstPtr, dstPitch, width, height, gBitFormat == 565);
+	if (done < width)
+		scale(3, dstPtr + done * 6, dstPitch, srcPtr - srcPitch + done * 2, srcPitch, 2, width - done, height);
 }
 
 template<typename ColorMask>
@@ -340,4 +359,65 @@ void DotMatrix(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPi
 	}
 }
 
+void hqxPattern(uint8 *patterns, const uint16 *src, uint32 nextline, const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, int width) {
+	const uint16 *row0 = src - nextline - 1;
+	const uint16 *row1 = src - 1;
+	const uint16 *row2 = src + nextline - 1;
+
+	for (int i = 0; i < width; ++i) {
+		const int w5 = row1[i + 1];
+		const int yuv5 = yuv1[i + 1];
+
+		int pattern = 0;
+		if (w5 != row0[i] && diffYUV(yuv5, yuv0[i])) pattern |= 0x0001;
+		if (w5 != row0[i + 1] && diffYUV(yuv5, yuv0[i + 1])) pattern |= 0x0002;
+		if (w5 != row0[i + 2] && diffYUV(yuv5, yuv0[i + 2])) pattern |= 0x0004;
+		if (w5 != row1[i] && diffYUV(yuv5, yuv1[i])) pattern |= 0x0008;
+		if (w5 != row1[i + 2] && diffYUV(yuv5, yuv1[i + 2])) pattern |= 0x0010;
+		if (w5 != row2[i] && diffYUV(yuv5, yuv2[i])) pattern |= 0x0020;
+		if (w5 != row2[i + 1] && diffYUV(yuv5, yuv2[i + 1])) pattern |= 0x0040;
+		if (w5 != row2[i + 2] && diffYUV(yuv5, yuv2[i + 2])) pattern |= 0x0080;
+		patterns[i] = pattern;
+	}
+}
+
+#ifdef USE_HQ_SCALERS
+void computeHQxPatterns(uint8 *patterns, const uint16 *src, uint32 nextline, int width) {
+	assert(width <= kHQxPatternChunk);
+
+	// Looking the pixels up once per row instead of nine times per pixel
+	uint32 yuv[3][kHQxPatternChunk + 2];
+	const uint16 *rows[3] = { src - nextline - 1, src - 1, src + nextline - 1 };
+	for (int r = 0; r < 3; ++r) {
+		for (int i = 0; i < width + 2; ++i)
+			yuv[r][i] = RGBtoYUV[rows[r][i]];
+	}
+
+	getScalerProcs().hqxPattern(patterns, src, nextline, yuv[0], yuv[1], yuv[2], width);
+}
+#endif
+
+const ScalerProcs &getScalerProcs() {
+	static const ScalerProcs generic = { 0, 0, 0, 0, 0, hqxPattern };
+	const ScalerProcs *neon = nullptr, *sse2 = nullptr, *avx2 = nullptr;
+
+	// The vectorized routines store the pixels in little endian order
+#ifdef SCUMM_LITTLE_ENDIAN
+#ifdef SCUMMVM_NEON
+	static const ScalerProcs neonProcs = { advMame2xNEON, advMame3xNEON, _2xSaINEON, super2xSaINEON, superEagleNEON, hqxPatternNEON };
+	neon = &neonProcs;
+#endif
+#ifdef SCUMMVM_SSE2
+	static const ScalerProcs sse2Procs = { advMame2xSSE2, advMame3xSSE2, _2xSaISSE2, super2xSaISSE2, superEagleSSE2, hqxPatternSSE2 };
+	sse2 = &sse2Procs;
+#endif
+#ifdef SCUMMVM_AVX2
+	static const ScalerProcs avx2Procs = { advMame2xAVX2, advMame3xAVX2, _2xSaIAVX2, super2xSaIAVX2, superEagleAVX2, hqxPatternAVX2 };
+	avx2 = &avx2Procs;
+#endif
+#endif
+
+	return Common::selectSimdProcs(generic, neon, sse2, avx2);
+}
+
 #endif // #ifdef USE_SCALERS
@@ -61,6 +61,13 @@ DECLARE_SCALER(HQ3x);
 
 #endif // #ifdef USE_SCALERS
 
+/**
+ * Check whether several calls of a scaler may run at the same time, e.g. on
+ * different bands of one picture. The assembly versions of HQ2x and HQ3x
+ * keep their state in global variables, so they may not.
+ */
+extern bool isScalerReentrant(ScalerProc *scaler);
+
 // creates a 160x100 thumbnail for 320x200 games
 // and 160x120 thumbnail for 320x240 and 640x480 games
 // only 565 mode
@@ -21,6 +21,7 @@
  */
 
 #include "graphics/scaler/intern.h"
+#include "graphics/scaler/simd_intern.h"
 
 
 
@@ -152,6 +153,13 @@ void Super2xSaITemplate(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uin
 
 void Super2xSaI(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	extern int gBitFormat;
+	int done = 0;
+	if (getScalerProcs().super2xSaI)
+		done = getScalerProcs().super2xSaI(srcPtr, srcPitch, dstPtr, dstPitch, width, height, gBitFormat == 565);
+	srcPtr += done * 2;
+	dstPtr += done * 4;
+	width -= done;
+
 	if (gBitFormat == 565)
 		Super2xSaITemplate<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
 	else
@@ -264,6 +272,13 @@ void SuperEagleTemplate(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uin
 
 void SuperEagle(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	extern int gBitFormat;
+	int done = 0;
+	if (getScalerProcs().superEagle)
+		done = getScalerProcs().superEagle(srcPtr, srcPitch, dstPtr, dstPitch, width, height, gBitFormat == 565);
+	srcPtr += done * 2;
+	dstPtr += done * 4;
+	width -= done;
+
 	if (gBitFormat == 565)
 		SuperEagleTemplate<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
 	else
@@ -405,6 +420,13 @@ void _2xSaITemplate(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32
 
 void _2xSaI(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	extern int gBitFormat;
+	int done = 0;
+	if (getScalerProcs()._2xSaI)
+		done = getScalerProcs()._2xSaI(srcPtr, srcPitch, dstPtr, dstPitch, width, height, gBitFormat == 565);
+	srcPtr += done * 2;
+	dstPtr += done * 4;
+	width -= done;
+
 	if (gBitFormat == 565)
 		_2xSaITemplate<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
 	else
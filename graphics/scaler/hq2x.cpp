@@ -21,6 +21,8 @@
  */
 
 #include "graphics/scaler/intern.h"
+#include "graphics/scaler/simd_intern.h"
+#include "common/util.h"
 
 #ifdef USE_NASM
 // Assembly version of HQ2x
@@ -131,24 +133,27 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		w5 = *(p);
 		w8 = *(p + nextlineSrc);
 
+		// The patterns are computed ahead, a chunk of pixels at a time
+		uint8 patterns[kHQxPatternChunk];
+		const uint8 *nextPattern = patterns;
+		const uint8 *patternsEnd = patterns;
+
 		int tmpWidth = width;
 		while (tmpWidth--) {
+			if (nextPattern == patternsEnd) {
+				const int count = MIN<int>(tmpWidth + 1, kHQxPatternChunk);
+				computeHQxPatterns(patterns, p, nextlineSrc, count);
+				nextPattern = patterns;
+				patternsEnd = patterns + count;
+			}
+
 			p++;
 
 			w3 = *(p - nextlineSrc);
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = *nextPattern++;
 
 			switch (pattern) {
 			case 0:
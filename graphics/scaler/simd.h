@@ -0,0 +1,490 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_SCALER_SIMD_H
+#define GRAPHICS_SCALER_SIMD_H
+
+#include "graphics/colormasks.h"
+#include "graphics/scaler/simd_intern.h"
+
+/*
+ * Vectorized versions of the AdvMame and 2xSaI family scalers, shared by
+ * the SSE2, AVX2 and NEON implementations.
+ *
+ * The instruction set is abstracted by an Ops class, which provides a Vec
+ * type holding Ops::kLanes 16-bit pixels. The C scalers branch on pixel
+ * comparisons; here every candidate result is computed and the right one
+ * is picked with the comparison masks. The interpolations work on every
+ * channel separately and round down like the interpolate16_* helpers, so
+ * the output is identical to that of the C code.
+ */
+
+template<class Ops, class ColorMask>
+struct ScalerSIMD {
+	typedef typename Ops::Vec Vec;
+
+	static inline Vec ne(Vec a, Vec b) { return Ops::bitXor(Ops::eq(a, b), Ops::set1(-1)); }
+	static inline Vec select(Vec mask, Vec a, Vec b) { return Ops::bitOr(Ops::bitAnd(mask, a), Ops::andNot(mask, b)); }
+
+	static inline Vec red(Vec p) { return Ops::bitAnd(Ops::srl(p, ColorMask::kRedShift), Ops::set1(ColorMask::kRedMask >> ColorMask::kRedShift)); }
+	static inline Vec green(Vec p) { return Ops::bitAnd(Ops::srl(p, ColorMask::kGreenShift), Ops::set1(ColorMask::kGreenMask >> ColorMask::kGreenShift)); }
+	static inline Vec blue(Vec p) { return Ops::bitAnd(Ops::srl(p, ColorMask::kBlueShift), Ops::set1(ColorMask::kBlueMask >> ColorMask::kBlueShift)); }
+	static inline Vec join(Vec r, Vec g, Vec b) {
+		return Ops::bitOr(Ops::bitOr(Ops::sll(r, ColorMask::kRedShift), Ops::sll(g, ColorMask::kGreenShift)), Ops::sll(b, ColorMask::kBlueShift));
+	}
+
+	/** Like interpolate16_1_1: (a & b) plus half of (a ^ b), per channel. */
+	static inline Vec interpolate_1_1(Vec a, Vec b) {
+		const Vec half = Ops::srl(Ops::bitAnd(Ops::bitXor(a, b), Ops::set1(ColorMask::kHighBitsMask & 0xFFFF)), 1);
+		return Ops::add(Ops::bitAnd(a, b), half);
+	}
+
+	/** Like interpolate16_3_1 */
+	static inline Vec interpolate_3_1(Vec a, Vec b) {
+		const Vec three = Ops::set1(3);
+		const Vec r = Ops::srl(Ops::add(Ops::mullo(red(a), three), red(b)), 2);
+		const Vec g = Ops::srl(Ops::add(Ops::mullo(green(a), three), green(b)), 2);
+		const Vec bl = Ops::srl(Ops::add(Ops::mullo(blue(a), three), blue(b)), 2);
+		return join(r, g, bl);
+	}
+
+	/** Like interpolate16_6_1_1 */
+	static inline Vec interpolate_6_1_1(Vec a, Vec b, Vec c) {
+		const Vec six = Ops::set1(6);
+		const Vec r = Ops::srl(Ops::add(Ops::mullo(red(a), six), Ops::add(red(b), red(c))), 3);
+		const Vec g = Ops::srl(Ops::add(Ops::mullo(green(a), six), Ops::add(green(b), green(c))), 3);
+		const Vec bl = Ops::srl(Ops::add(Ops::mullo(blue(a), six), Ops::add(blue(b), blue(c))), 3);
+		return join(r, g, bl);
+	}
+
+	/** Like interpolate16_1_1_1_1 */
+	static inline Vec interpolate_1_1_1_1(Vec a, Vec b, Vec c, Vec d) {
+		const Vec r = Ops::srl(Ops::add(Ops::add(red(a), red(b)), Ops::add(red(c), red(d))), 2);
+		const Vec g = Ops::srl(Ops::add(Ops::add(green(a), green(b)), Ops::add(green(c), green(d))), 2);
+		const Vec bl = Ops::srl(Ops::add(Ops::add(blue(a), blue(b)), Ops::add(blue(c), blue(d))), 2);
+		return join(r, g, bl);
+	}
+
+	/** Like GetResult() in 2xsai.cpp, giving -1, 0 or 1 in every lane. */
+	static inline Vec getResult(Vec a, Vec b, Vec c, Vec d) {
+		const Vec ac = Ops::eq(a, c);
+		const Vec ad = Ops::eq(a, d);
+		const Vec y = Ops::bitAnd(Ops::andNot(ac, Ops::eq(b, c)), Ops::andNot(ad, Ops::eq(b, d)));
+		return Ops::sub(Ops::bitAnd(ac, ad), y);
+	}
+
+	static int advMame2x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+		const int columns = width - width % Ops::kLanes;
+		const int nextline = srcPitch / 2;
+
+		for (int y = 0; y < height; ++y) {
+			const uint16 *p = (const uint16 *)(srcPtr + y * srcPitch);
+			uint16 *q0 = (uint16 *)(dstPtr + 2 * y * dstPitch);
+			uint16 *q1 = (uint16 *)((uint8 *)q0 + dstPitch);
+
+			for (int x = 0; x < columns; x += Ops::kLanes) {
+				const Vec up = Ops::load(p + x - nextline);
+				const Vec left = Ops::load(p + x - 1);
+				const Vec center = Ops::load(p + x);
+				const Vec right = Ops::load(p + x + 1);
+				const Vec down = Ops::load(p + x + nextline);
+
+				const Vec edge = Ops::bitAnd(ne(up, down), ne(left, right));
+				const Vec upLeft = Ops::bitAnd(edge, Ops::eq(left, up));
+				const Vec upRight = Ops::bitAnd(edge, Ops::eq(right, up));
+				const Vec downLeft = Ops::bitAnd(edge, Ops::eq(left, down));
+				const Vec downRight = Ops::bitAnd(edge, Ops::eq(right, down));
+
+				Ops::storeInterleaved(q0 + 2 * x, select(upLeft, up, center), select(upRight, up, center));
+				Ops::storeInterleaved(q1 + 2 * x, select(downLeft, down, center), select(downRight, down, center));
+			}
+		}
+
+		return columns;
+	}
+
+	static inline void advMame3xBorder(uint16 *q, Vec edge, Vec up, Vec upLeft, Vec upRight, Vec left, Vec center, Vec right) {
+		const Vec leftUp = Ops::eq(left, up);
+		const Vec rightUp = Ops::eq(right, up);
+		const Vec middle = Ops::bitOr(Ops::andNot(Ops::eq(center, upRight), leftUp), Ops::andNot(Ops::eq(center, upLeft), rightUp));
+
+		Ops::storeInterleaved3(q,
+			select(Ops::bitAnd(edge, leftUp), left, center),
+			select(Ops::bitAnd(edge, middle), up, center),
+			select(Ops::bitAnd(edge, rightUp), right, center));
+	}
+
+	static int advMame3x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+		const int columns = width - width % Ops::kLanes;
+		const int nextline = srcPitch / 2;
+
+		for (int y = 0; y < height; ++y) {
+			const uint16 *p = (const uint16 *)(srcPtr + y * srcPitch);
+			uint16 *q0 = (uint16 *)(dstPtr + 3 * y * dstPitch);
+			uint16 *q1 = (uint16 *)((uint8 *)q0 + dstPitch);
+			uint16 *q2 = (uint16 *)((uint8 *)q1 + dstPitch);
+
+			for (int x = 0; x < columns; x += Ops::kLanes) {
+				const Vec upLeft = Ops::load(p + x - nextline - 1);
+				const Vec up = Ops::load(p + x - nextline);
+				const Vec upRight = Ops::load(p + x - nextline + 1);
+				const Vec left = Ops::load(p + x - 1);
+				const Vec center = Ops::load(p + x);
+				const Vec right = Ops::load(p + x + 1);
+				const Vec downLeft = Ops::load(p + x + nextline - 1);
+				const Vec down = Ops::load(p + x + nextline);
+				const Vec downRight = Ops::load(p + x + nextline + 1);
+
+				const Vec edge = Ops::bitAnd(ne(up, down), ne(left, right));
+
+				advMame3xBorder(q0 + 3 * x, edge, up, upLeft, upRight, left, center, right);
+
+				const Vec leftUp = Ops::eq(left, up);
+				const Vec leftDown = Ops::eq(left, down);
+				const Vec rightUp = Ops::eq(right, up);
+				const Vec rightDown = Ops::eq(right, down);
+				const Vec takeLeft = Ops::bitOr(Ops::andNot(Ops::eq(center, downLeft), leftUp), Ops::andNot(Ops::eq(center, upLeft), leftDown));
+				const Vec takeRight = Ops::bitOr(Ops::andNot(Ops::eq(center, downRight), rightUp), Ops::andNot(Ops::eq(center, upRight), rightDown));
+				Ops::storeInterleaved3(q1 + 3 * x,
+					select(Ops::bitAnd(edge, takeLeft), left, center),
+					center,
+					select(Ops::bitAnd(edge, takeRight), right, center));
+
+				advMame3xBorder(q2 + 3 * x, edge, down, downLeft, downRight, left, center, right);
+			}
+		}
+
+		return columns;
+	}
+
+	static int _2xSaI(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+		const int columns = width - width % Ops::kLanes;
+		const int nextline = srcPitch / 2;
+
+		for (int y = 0; y < height; ++y) {
+			const uint16 *bP = (const uint16 *)(srcPtr + y * srcPitch);
+			uint16 *q0 = (uint16 *)(dstPtr + 2 * y * dstPitch);
+			uint16 *q1 = (uint16 *)((uint8 *)q0 + dstPitch);
+
+			for (int x = 0; x < columns; x += Ops::kLanes) {
+				// I|E F|J
+				// G|A B|K
+				// H|C D|L
+				// M|N O|P
+				const uint16 *p = bP + x;
+				const Vec colorI = Ops::load(p - nextline - 1);
+				const Vec colorE = Ops::load(p - nextline);
+				const Vec colorF = Ops::load(p - nextline + 1);
+				const Vec colorJ = Ops::load(p - nextline + 2);
+				const Vec colorG = Ops::load(p - 1);
+				const Vec colorA = Ops::load(p);
+				const Vec colorB = Ops::load(p + 1);
+				const Vec colorK = Ops::load(p + 2);
+				const Vec colorH = Ops::load(p + nextline - 1);
+				const Vec colorC = Ops::load(p + nextline);
+				const Vec colorD = Ops::load(p + nextline + 1);
+				const Vec colorL = Ops::load(p + nextline + 2);
+				const Vec colorM = Ops::load(p + 2 * nextline - 1);
+				const Vec colorN = Ops::load(p + 2 * nextline);
+				const Vec colorO = Ops::load(p + 2 * nextline + 1);
+
+				const Vec ad = Ops::eq(colorA, colorD);
+				const Vec bc = Ops::eq(colorB, colorC);
+				const Vec onlyAD = Ops::andNot(bc, ad);
+				const Vec onlyBC = Ops::andNot(ad, bc);
+				const Vec both = Ops::bitAnd(ad, bc);
+
+				const Vec ab = interpolate_1_1(colorA, colorB);
+				const Vec ac = interpolate_1_1(colorA, colorC);
+				const Vec abcd = interpolate_1_1_1_1(colorA, colorB, colorC, colorD);
+
+				// Conditions shared by several of the cases
+				const Vec productA = Ops::bitAnd(Ops::bitAnd(Ops::eq(colorA, colorC), Ops::eq(colorA, colorF)),
+					Ops::andNot(Ops::eq(colorB, colorE), Ops::eq(colorB, colorJ)));
+				const Vec productB = Ops::bitAnd(Ops::bitAnd(Ops::eq(colorB, colorE), Ops::eq(colorB, colorD)),
+					Ops::andNot(Ops::eq(colorA, colorF), Ops::eq(colorA, colorI)));
+				const Vec product1A = Ops::bitAnd(Ops::bitAnd(Ops::eq(colorA, colorB), Ops::eq(colorA, colorH)),
+					Ops::andNot(Ops::eq(colorG, colorC), Ops::eq(colorC, colorM)));
+				const Vec product1C = Ops::bitAnd(Ops::bitAnd(Ops::eq(colorC, colorG), Ops::eq(colorC, colorD)),
+					Ops::andNot(Ops::eq(colorA, colorH), Ops::eq(colorA, colorI)));
+
+				// A == D, B != C
+				const Vec case1Product = Ops::bitOr(Ops::bitAnd(Ops::eq(colorA, colorE), Ops::eq(colorB, colorL)), productA);
+				const Vec case1Product1 = Ops::bitOr(Ops::bitAnd(Ops::eq(colorA, colorG), Ops::eq(colorC, colorO)), product1A);
+
+				// B == C, A != D
+				const Vec case2Product = Ops::bitOr(Ops::bitAnd(Ops::eq(colorB, colorF), Ops::eq(colorA, colorH)), productB);
+				const Vec case2Product1 = Ops::bitOr(Ops::bitAnd(Ops::eq(colorC, colorH), Ops::eq(colorA, colorF)), product1C);
+
+				// A == D, B == C. If A == B as well, all of the products
+				// below are A.
+				Vec r = getResult(colorA, colorB, colorG, colorE);
+				r = Ops::sub(r, getResult(colorB, colorA, colorK, colorF));
+				r = Ops::sub(r, getResult(colorB, colorA, colorH, colorN));
+				r = Ops::add(r, getResult(colorA, colorB, colorL, colorO));
+				const Vec zero = Ops::set1(0);
+				const Vec case3Product2 = select(Ops::cmpgt(r, zero), colorA, select(Ops::cmpgt(zero, r), colorB, abcd));
+
+				// None of them, the default case
+				const Vec case4Product = select(productA, colorA, select(productB, colorB, ab));
+				const Vec case4Product1 = select(product1A, colorA, select(product1C, colorC, ac));
+
+				const Vec product = select(onlyAD, select(case1Product, colorA, ab),
+					select(onlyBC, select(case2Product, colorB, ab),
+					select(both, ab, case4Product)));
+				const Vec product1 = select(onlyAD, select(case1Product1, colorA, ac),
+					select(onlyBC, select(case2Product1, colorC, ac),
+					select(both, ac, case4Product1)));
+				const Vec product2 = select(onlyAD, colorA,
+					select(onlyBC, colorB,
+					select(both, case3Product2, abcd)));
+
+				Ops::storeInterleaved(q0 + 2 * x, colorA, product);
+				Ops::storeInterleaved(q1 + 2 * x, product1, product2);
+			}
+		}
+
+		return columns;
+	}
+
+	static int super2xSaI(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+		const int columns = width - width % Ops::kLanes;
+		const int nextline = srcPitch / 2;
+
+		for (int y = 0; y < height; ++y) {
+			const uint16 *bP = (const uint16 *)(srcPtr + y * srcPitch);
+			uint16 *q0 = (uint16 *)(dstPtr + 2 * y * dstPitch);
+			uint16 *q1 = (uint16 *)((uint8 *)q0 + dstPitch);
+
+			for (int x = 0; x < columns; x += Ops::kLanes) {
+				//    B1 B2
+				//  4  5  6 S2
+				//  1  2  3 S1
+				//    A1 A2
+				const uint16 *p = bP + x;
+				const Vec colorB0 = Ops::load(p - nextline - 1);
+				const Vec colorB1 = Ops::load(p - nextline);
+				const Vec colorB2 = Ops::load(p - nextline + 1);
+				const Vec colorB3 = Ops::load(p - nextline + 2);
+				const Vec color4 = Ops::load(p - 1);
+				const Vec color5 = Ops::load(p);
+				const Vec color6 = Ops::load(p + 1);
+				const Vec colorS2 = Ops::load(p + 2);
+				const Vec color1 = Ops::load(p + nextline - 1);
+				const Vec color2 = Ops::load(p + nextline);
+				const Vec color3 = Ops::load(p + nextline + 1);
+				const Vec colorS1 = Ops::load(p + nextline + 2);
+				const Vec colorA0 = Ops::load(p + 2 * nextline - 1);
+				const Vec colorA1 = Ops::load(p + 2 * nextline);
+				const Vec colorA2 = Ops::load(p + 2 * nextline + 1);
+				const Vec colorA3 = Ops::load(p + 2 * nextline + 2);
+
+				const Vec eq26 = Ops::eq(color2, color6);
+				const Vec eq53 = Ops::eq(color5, color3);
+				const Vec i56 = interpolate_1_1(color5, color6);
+				const Vec i23 = interpolate_1_1(color2, color3);
+				const Vec i25 = interpolate_1_1(color2, color5);
+
+				Vec r = getResult(color6, color5, color1, colorA1);
+				r = Ops::add(r, getResult(color6, color5, color4, colorB1));
+				r = Ops::add(r, getResult(color6, color5, colorA2, colorS1));
+				r = Ops::add(r, getResult(color6, color5, colorB2, colorS2));
+				const Vec zero = Ops::set1(0);
+				const Vec both = select(Ops::cmpgt(r, zero), color6, select(Ops::cmpgt(zero, r), color5, i56));
+
+				const Vec eq63 = Ops::eq(color6, color3);
+				const Vec eq52 = Ops::eq(color5, color2);
+				const Vec product2bFrom3 = Ops::bitAnd(Ops::bitAnd(eq63, Ops::eq(color3, colorA1)),
+					Ops::andNot(Ops::bitOr(Ops::eq(color2, colorA2), Ops::eq(color3, colorA0)), Ops::set1(-1)));
+				const Vec product2bFrom2 = Ops::bitAnd(Ops::bitAnd(eq52, Ops::eq(color2, colorA2)),
+					Ops::andNot(Ops::bitOr(Ops::eq(colorA1, color3), Ops::eq(color2, colorA3)), Ops::set1(-1)));
+				const Vec product1bFrom6 = Ops::bitAnd(Ops::bitAnd(eq63, Ops::eq(color6, colorB1)),
+					Ops::andNot(Ops::bitOr(Ops::eq(color5, colorB2), Ops::eq(color6, colorB0)), Ops::set1(-1)));
+				const Vec product1bFrom5 = Ops::bitAnd(Ops::bitAnd(eq52, Ops::eq(color5, colorB2)),
+					Ops::andNot(Ops::bitOr(Ops::eq(colorB1, color6), Ops::eq(color5, colorB3)), Ops::set1(-1)));
+
+				const Vec otherProduct2b = select(product2bFrom3, interpolate_3_1(color3, color2),
+					select(product2bFrom2, interpolate_3_1(color2, color3), i23));
+				const Vec otherProduct1b = select(product1bFrom6, interpolate_3_1(color6, color5),
+					select(product1bFrom5, interpolate_3_1(color5, color6), i56));
+
+				const Vec only26 = Ops::andNot(eq53, eq26);
+				const Vec only53 = Ops::andNot(eq26, eq53);
+				const Vec eqBoth = Ops::bitAnd(eq26, eq53);
+				const Vec product1b = select(only26, color2, select(only53, color5, select(eqBoth, both, otherProduct1b)));
+				const Vec product2b = select(only26, color2, select(only53, color5, select(eqBoth, both, otherProduct2b)));
+
+				const Vec product2aMix = Ops::bitOr(
+					Ops::bitAnd(Ops::bitAnd(only53, Ops::eq(color4, color5)), ne(color5, colorA2)),
+					Ops::bitAnd(Ops::bitAnd(Ops::eq(color5, color1), Ops::eq(color6, color5)), Ops::bitAnd(ne(color4, color2), ne(color5, colorA0))));
+				const Vec product1aMix = Ops::bitOr(
+					Ops::bitAnd(Ops::bitAnd(only26, Ops::eq(color1, color2)), ne(color2, colorB2)),
+					Ops::bitAnd(Ops::bitAnd(Ops::eq(color4, color2), Ops::eq(color3, color2)), Ops::bitAnd(ne(color1, color5), ne(color2, colorB0))));
+
+				Ops::storeInterleaved(q0 + 2 * x, select(product1aMix, i25, color5), product1b);
+				Ops::storeInterleaved(q1 + 2 * x, select(product2aMix, i25, color2), product2b);
+			}
+		}
+
+		return columns;
+	}
+
+	static int superEagle(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+		const int columns = width - width % Ops::kLanes;
+		const int nextline = srcPitch / 2;
+
+		for (int y = 0; y < height; ++y) {
+			const uint16 *bP = (const uint16 *)(srcPtr + y * srcPitch);
+			uint16 *q0 = (uint16 *)(dstPtr + 2 * y * dstPitch);
+			uint16 *q1 = (uint16 *)((uint8 *)q0 + dstPitch);
+
+			for (int x = 0; x < columns; x += Ops::kLanes) {
+				const uint16 *p = bP + x;
+				const Vec colorB1 = Ops::load(p - nextline);
+				const Vec colorB2 = Ops::load(p - nextline + 1);
+				const Vec color4 = Ops::load(p - 1);
+				const Vec color5 = Ops::load(p);
+				const Vec color6 = Ops::load(p + 1);
+				const Vec colorS2 = Ops::load(p + 2);
+				const Vec color1 = Ops::load(p + nextline - 1);
+				const Vec color2 = Ops::load(p + nextline);
+				const Vec color3 = Ops::load(p + nextline + 1);
+				const Vec colorS1 = Ops::load(p + nextline + 2);
+				const Vec colorA1 = Ops::load(p + 2 * nextline);
+				const Vec colorA2 = Ops::load(p + 2 * nextline + 1);
+
+				const Vec eq53 = Ops::eq(color5, color3);
+				const Vec eq26 = Ops::eq(color2, color6);
+				const Vec i56 = interpolate_1_1(color5, color6);
+				const Vec i23 = interpolate_1_1(color2, color3);
+
+				// 5 != 3, 2 == 6
+				const Vec a1a = select(Ops::bitOr(Ops::eq(color1, color2), Ops::eq(color6, colorB2)), interpolate_3_1(color2, color5), i56);
+				const Vec a2b = select(Ops::bitOr(Ops::eq(color6, colorS2), Ops::eq(color2, colorA1)), interpolate_3_1(color2, color3), i23);
+
+				// 5 != 3, 2 != 6
+				const Vec b2b = interpolate_6_1_1(color3, color2, color6);
+				const Vec b1a = interpolate_6_1_1(color5, color2, color6);
+				const Vec b2a = interpolate_6_1_1(color2, color5, color3);
+				const Vec b1b = interpolate_6_1_1(color6, color5, color3);
+
+				// 5 == 3, 2 != 6
+				const Vec c1b = select(Ops::bitOr(Ops::eq(colorB1, color5), Ops::eq(color3, colorS1)), interpolate_3_1(color5, color6), i56);
+				const Vec c2a = select(Ops::bitOr(Ops::eq(color3, colorA2), Ops::eq(color4, color5)), interpolate_3_1(color5, color2), i23);
+
+				// 5 == 3, 2 == 6
+				Vec r = getResult(color6, color5, color1, colorA1);
+				r = Ops::add(r, getResult(color6, color5, color4, colorB1));
+				r = Ops::add(r, getResult(color6, color5, colorA2, colorS1));
+				r = Ops::add(r, getResult(color6, color5, colorB2, colorS2));
+				const Vec zero = Ops::set1(0);
+				const Vec positive = Ops::cmpgt(r, zero);
+				const Vec negative = Ops::cmpgt(zero, r);
+				const Vec d1a = select(positive, i56, color5);
+				const Vec d1b = select(positive, color2, select(negative, i56, color2));
+				const Vec d2a = d1b;
+				const Vec d2b = d1a;
+
+				const Vec product1a = select(eq53, select(eq26, d1a, color5), select(eq26, a1a, b1a));
+				const Vec product1b = select(eq53, select(eq26, d1b, c1b), select(eq26, color2, b1b));
+				const Vec product2a = select(eq53, select(eq26, d2a, c2a), select(eq26, color2, b2a));
+				const Vec product2b = select(eq53, select(eq26, d2b, color5), select(eq26, a2b, b2b));
+
+				Ops::storeInterleaved(q0 + 2 * x, product1a, product1b);
+				Ops::storeInterleaved(q1 + 2 * x, product2a, product2b);
+			}
+		}
+
+		return columns;
+	}
+};
+
+/**
+ * Instantiate the column procs for both 16 bit formats.
+ */
+template<class Ops>
+struct ScalerSIMDProcs {
+	typedef ScalerSIMD<Ops, Graphics::ColorMasks<565> > Scaler565;
+	typedef ScalerSIMD<Ops, Graphics::ColorMasks<555> > Scaler555;
+
+	static int advMame2x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+		// AdvMame does not interpolate, so the format does not matter
+		return Scaler565::advMame2x(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	}
+	static int advMame3x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+		return Scaler565::advMame3x(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	}
+	static int _2xSaI(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+		if (rgb565)
+			return Scaler565::_2xSaI(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+		return Scaler555::_2xSaI(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	}
+	static int super2xSaI(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+		if (rgb565)
+			return Scaler565::super2xSaI(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+		return Scaler555::super2xSaI(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	}
+	static int superEagle(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+		if (rgb565)
+			return Scaler565::superEagle(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+		return Scaler555::superEagle(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	}
+};
+
+/**
+ * Vectorized HQx pattern computation. Ops::Vec32 holds Ops::kLanes32
+ * pixels, one per 32-bit lane.
+ */
+template<class Ops>
+void hqxPatternSIMD(uint8 *patterns, const uint16 *src, uint32 nextline, const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, int width) {
+	typedef typename Ops::Vec32 Vec32;
+
+	const int columns = width - width % Ops::kLanes32;
+	const uint16 *row0 = src - nextline - 1;
+	const uint16 *row1 = src - 1;
+	const uint16 *row2 = src + nextline - 1;
+
+	for (int x = 0; x < columns; x += Ops::kLanes32) {
+		const Vec32 w5 = Ops::loadPixels(row1 + x + 1);
+		const Vec32 yuv5 = Ops::load32(yuv1 + x + 1);
+
+		// A neighbour counts if it is neither equal nor similar
+#define HQX_NEIGHBOUR(row, yuv, offset, bit) \
+		Ops::andNot32(Ops::bitOr32(Ops::eq32(w5, Ops::loadPixels(row + x + offset)), Ops::similar(yuv5, Ops::load32(yuv + x + offset))), Ops::set32(bit))
+
+		Vec32 pattern = Ops::bitOr32(HQX_NEIGHBOUR(row0, yuv0, 0, 0x01), HQX_NEIGHBOUR(row0, yuv0, 1, 0x02));
+		pattern = Ops::bitOr32(pattern, HQX_NEIGHBOUR(row0, yuv0, 2, 0x04));
+		pattern = Ops::bitOr32(pattern, HQX_NEIGHBOUR(row1, yuv1, 0, 0x08));
+		pattern = Ops::bitOr32(pattern, HQX_NEIGHBOUR(row1, yuv1, 2, 0x10));
+		pattern = Ops::bitOr32(pattern, HQX_NEIGHBOUR(row2, yuv2, 0, 0x20));
+		pattern = Ops::bitOr32(pattern, HQX_NEIGHBOUR(row2, yuv2, 1, 0x40));
+		pattern = Ops::bitOr32(pattern, HQX_NEIGHBOUR(row2, yuv2, 2, 0x80));
+
+#undef HQX_NEIGHBOUR
+
+		Ops::storePatterns(patterns + x, pattern);
+	}
+
+	hqxPattern(patterns + columns, src + columns, nextline, yuv0 + columns, yuv1 + columns, yuv2 + columns, width - columns);
+}
+
+#endif
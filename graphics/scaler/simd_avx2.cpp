@@ -0,0 +1,117 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/endian.h"
+#include "graphics/scaler/simd.h"
+
+#ifdef SCUMMVM_AVX2
+
+#include <immintrin.h>
+
+struct ScalerOpsAVX2 {
+	typedef __m256i Vec;
+	enum { kLanes = 16 };
+
+	static inline Vec load(const uint16 *p) { return _mm256_loadu_si256((const __m256i *)p); }
+	static inline Vec set1(int v) { return _mm256_set1_epi16((int16)v); }
+
+	static inline Vec eq(Vec a, Vec b) { return _mm256_cmpeq_epi16(a, b); }
+	static inline Vec cmpgt(Vec a, Vec b) { return _mm256_cmpgt_epi16(a, b); }
+	static inline Vec bitAnd(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+	static inline Vec bitOr(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+	static inline Vec bitXor(Vec a, Vec b) { return _mm256_xor_si256(a, b); }
+	static inline Vec andNot(Vec a, Vec b) { return _mm256_andnot_si256(a, b); }
+	static inline Vec add(Vec a, Vec b) { return _mm256_add_epi16(a, b); }
+	static inline Vec sub(Vec a, Vec b) { return _mm256_sub_epi16(a, b); }
+	static inline Vec mullo(Vec a, Vec b) { return _mm256_mullo_epi16(a, b); }
+	static inline Vec srl(Vec a, int n) { return _mm256_srl_epi16(a, _mm_cvtsi32_si128(n)); }
+	static inline Vec sll(Vec a, int n) { return _mm256_sll_epi16(a, _mm_cvtsi32_si128(n)); }
+
+	static inline void storeInterleaved(uint16 *dst, Vec a, Vec b) {
+		// The unpacks work within the 128-bit halves
+		const __m256i lo = _mm256_unpacklo_epi16(a, b);
+		const __m256i hi = _mm256_unpackhi_epi16(a, b);
+		_mm256_storeu_si256((__m256i *)dst, _mm256_permute2x128_si256(lo, hi, 0x20));
+		_mm256_storeu_si256((__m256i *)(dst + 16), _mm256_permute2x128_si256(lo, hi, 0x31));
+	}
+	static inline void storeInterleaved3(uint16 *dst, Vec a, Vec b, Vec c) {
+		uint16 tmp[3][kLanes];
+		_mm256_storeu_si256((__m256i *)tmp[0], a);
+		_mm256_storeu_si256((__m256i *)tmp[1], b);
+		_mm256_storeu_si256((__m256i *)tmp[2], c);
+		for (int i = 0; i < kLanes; ++i) {
+			dst[3 * i + 0] = tmp[0][i];
+			dst[3 * i + 1] = tmp[1][i];
+			dst[3 * i + 2] = tmp[2][i];
+		}
+	}
+
+	typedef __m256i Vec32;
+	enum { kLanes32 = 8 };
+
+	static inline Vec32 load32(const uint32 *p) { return _mm256_loadu_si256((const __m256i *)p); }
+	static inline Vec32 loadPixels(const uint16 *p) { return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)p)); }
+	static inline Vec32 set32(int v) { return _mm256_set1_epi32(v); }
+	static inline Vec32 eq32(Vec32 a, Vec32 b) { return _mm256_cmpeq_epi32(a, b); }
+	static inline Vec32 bitOr32(Vec32 a, Vec32 b) { return _mm256_or_si256(a, b); }
+	static inline Vec32 andNot32(Vec32 a, Vec32 b) { return _mm256_andnot_si256(a, b); }
+
+	/** Whether no channel differs by more than the diffYUV() thresholds */
+	static inline Vec32 similar(Vec32 a, Vec32 b) {
+		const __m256i diff = _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a));
+		const __m256i over = _mm256_subs_epu8(diff, _mm256_set1_epi32((int)0xFF300706));
+		return _mm256_cmpeq_epi32(over, _mm256_setzero_si256());
+	}
+
+	static inline void storePatterns(uint8 *dst, Vec32 v) {
+		// Packing works within the 128-bit halves, leaving four patterns in each
+		const __m256i bytes = _mm256_packus_epi16(_mm256_packs_epi32(v, v), _mm256_setzero_si256());
+		WRITE_UINT32(dst, _mm_cvtsi128_si32(_mm256_castsi256_si128(bytes)));
+		WRITE_UINT32(dst + 4, _mm_cvtsi128_si32(_mm256_extracti128_si256(bytes, 1)));
+	}
+};
+
+int advMame2xAVX2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsAVX2>::advMame2x(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+int advMame3xAVX2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsAVX2>::advMame3x(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+int _2xSaIAVX2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsAVX2>::_2xSaI(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+int super2xSaIAVX2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsAVX2>::super2xSaI(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+int superEagleAVX2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsAVX2>::superEagle(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+void hqxPatternAVX2(uint8 *patterns, const uint16 *src, uint32 nextline, const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, int width) {
+	hqxPatternSIMD<ScalerOpsAVX2>(patterns, src, nextline, yuv0, yuv1, yuv2, width);
+}
+
+#endif
@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_SCALER_SIMD_INTERN_H
+#define GRAPHICS_SCALER_SIMD_INTERN_H
+
+#include "common/scummsys.h"
+
+/**
+ * Vectorized part of a 16 bit scaler. It scales the leftmost columns of
+ * the rectangle, as many as fit its vector width, and returns their number.
+ * The caller scales the remaining columns with the C code, which gives
+ * the same result since every output pixel only depends on its
+ * neighbourhood.
+ *
+ * The parameters are those of a ScalerProc, plus whether the pixels are
+ * in 565 (instead of 555) format.
+ */
+typedef int (*ScalerColumnsProc)(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+
+/**
+ * Compute the HQx patterns of a run of pixels. Bit n of a pattern is set
+ * if the n-th neighbour of the pixel, counted in reading order, is neither
+ * equal nor similar in YUV to the pixel.
+ *
+ * @param patterns receives one pattern per pixel
+ * @param src      the first pixel
+ * @param nextline the distance in pixels between two source rows
+ * @param yuv0     RGBtoYUV of the row above, starting one pixel to the left
+ * @param yuv1     RGBtoYUV of the row itself, starting one pixel to the left
+ * @param yuv2     RGBtoYUV of the row below, starting one pixel to the left
+ * @param width    the number of pixels
+ */
+typedef void (*HQxPatternProc)(uint8 *patterns, const uint16 *src, uint32 nextline, const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, int width);
+
+/**
+ * The vectorized scaler routines. The column procs are nullptr if the CPU
+ * has no suitable vector unit.
+ */
+struct ScalerProcs {
+	ScalerColumnsProc advMame2x;
+	ScalerColumnsProc advMame3x;
+	ScalerColumnsProc _2xSaI;
+	ScalerColumnsProc super2xSaI;
+	ScalerColumnsProc superEagle;
+	HQxPatternProc hqxPattern;
+};
+
+enum {
+	/** Maximum number of pixels passed to computeHQxPatterns() at once */
+	kHQxPatternChunk = 256
+};
+
+void hqxPattern(uint8 *patterns, const uint16 *src, uint32 nextline, const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, int width);
+
+/**
+ * Compute the HQx patterns of up to kHQxPatternChunk pixels, using the
+ * fastest HQxPatternProc.
+ */
+void computeHQxPatterns(uint8 *patterns, const uint16 *src, uint32 nextline, int width);
+
+#ifdef SCUMMVM_SSE2
+int advMame2xSSE2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+int advMame3xSSE2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+int _2xSaISSE2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+int super2xSaISSE2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+int superEagleSSE2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+void hqxPatternSSE2(uint8 *patterns, const uint16 *src, uint32 nextline, const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, int width);
+#endif
+
+#ifdef SCUMMVM_AVX2
+int advMame2xAVX2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+int advMame3xAVX2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+int _2xSaIAVX2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+int super2xSaIAVX2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+int superEagleAVX2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+void hqxPatternAVX2(uint8 *patterns, const uint16 *src, uint32 nextline, const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, int width);
+#endif
+
+#ifdef SCUMMVM_NEON
+int advMame2xNEON(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+int advMame3xNEON(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+int _2xSaINEON(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+int super2xSaINEON(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+int superEagleNEON(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565);
+void hqxPatternNEON(uint8 *patterns, const uint16 *src, uint32 nextline, const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, int width);
+#endif
+
+/**
+ * Return the fastest scaler routines the CPU supports.
+ */
+const ScalerProcs &getScalerProcs();
+
+#endif
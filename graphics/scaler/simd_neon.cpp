@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/scaler/simd.h"
+
+#ifdef SCUMMVM_NEON
+
+#include <arm_neon.h>
+
+struct ScalerOpsNEON {
+	typedef uint16x8_t Vec;
+	enum { kLanes = 8 };
+
+	static inline Vec load(const uint16 *p) { return vld1q_u16(p); }
+	static inline Vec set1(int v) { return vdupq_n_u16((uint16)v); }
+
+	static inline Vec eq(Vec a, Vec b) { return vceqq_u16(a, b); }
+	static inline Vec cmpgt(Vec a, Vec b) { return vcgtq_s16(vreinterpretq_s16_u16(a), vreinterpretq_s16_u16(b)); }
+	static inline Vec bitAnd(Vec a, Vec b) { return vandq_u16(a, b); }
+	static inline Vec bitOr(Vec a, Vec b) { return vorrq_u16(a, b); }
+	static inline Vec bitXor(Vec a, Vec b) { return veorq_u16(a, b); }
+	static inline Vec andNot(Vec a, Vec b) { return vbicq_u16(b, a); }
+	static inline Vec add(Vec a, Vec b) { return vaddq_u16(a, b); }
+	static inline Vec sub(Vec a, Vec b) { return vsubq_u16(a, b); }
+	static inline Vec mullo(Vec a, Vec b) { return vmulq_u16(a, b); }
+	static inline Vec srl(Vec a, int n) { return vshlq_u16(a, vdupq_n_s16(-n)); }
+	static inline Vec sll(Vec a, int n) { return vshlq_u16(a, vdupq_n_s16(n)); }
+
+	static inline void storeInterleaved(uint16 *dst, Vec a, Vec b) {
+		uint16x8x2_t v;
+		v.val[0] = a;
+		v.val[1] = b;
+		vst2q_u16(dst, v);
+	}
+	static inline void storeInterleaved3(uint16 *dst, Vec a, Vec b, Vec c) {
+		uint16x8x3_t v;
+		v.val[0] = a;
+		v.val[1] = b;
+		v.val[2] = c;
+		vst3q_u16(dst, v);
+	}
+
+	typedef uint32x4_t Vec32;
+	enum { kLanes32 = 4 };
+
+	static inline Vec32 load32(const uint32 *p) { return vld1q_u32(p); }
+	static inline Vec32 loadPixels(const uint16 *p) { return vmovl_u16(vld1_u16(p)); }
+	static inline Vec32 set32(int v) { return vdupq_n_u32((uint32)v); }
+	static inline Vec32 eq32(Vec32 a, Vec32 b) { return vceqq_u32(a, b); }
+	static inline Vec32 bitOr32(Vec32 a, Vec32 b) { return vorrq_u32(a, b); }
+	static inline Vec32 andNot32(Vec32 a, Vec32 b) { return vbicq_u32(b, a); }
+
+	/** Whether no channel differs by more than the diffYUV() thresholds */
+	static inline Vec32 similar(Vec32 a, Vec32 b) {
+		const uint8x16_t diff = vabdq_u8(vreinterpretq_u8_u32(a), vreinterpretq_u8_u32(b));
+		const uint8x16_t over = vqsubq_u8(diff, vreinterpretq_u8_u32(vdupq_n_u32(0xFF300706)));
+		return vceqq_u32(vreinterpretq_u32_u8(over), vdupq_n_u32(0));
+	}
+
+	static inline void storePatterns(uint8 *dst, Vec32 v) {
+		const uint16x4_t half = vmovn_u32(v);
+		uint8 bytes[8];
+		vst1_u8(bytes, vmovn_u16(vcombine_u16(half, half)));
+		memcpy(dst, bytes, kLanes32);
+	}
+};
+
+int advMame2xNEON(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsNEON>::advMame2x(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+int advMame3xNEON(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsNEON>::advMame3x(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+int _2xSaINEON(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsNEON>::_2xSaI(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+int super2xSaINEON(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsNEON>::super2xSaI(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+int superEagleNEON(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsNEON>::superEagle(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+void hqxPatternNEON(uint8 *patterns, const uint16 *src, uint32 nextline, const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, int width) {
+	hqxPatternSIMD<ScalerOpsNEON>(patterns, src, nextline, yuv0, yuv1, yuv2, width);
+}
+
+#endif
@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/endian.h"
+#include "graphics/scaler/simd.h"
+
+#ifdef SCUMMVM_SSE2
+
+#include <emmintrin.h>
+
+struct ScalerOpsSSE2 {
+	typedef __m128i Vec;
+	enum { kLanes = 8 };
+
+	static inline Vec load(const uint16 *p) { return _mm_loadu_si128((const __m128i *)p); }
+	static inline Vec set1(int v) { return _mm_set1_epi16((int16)v); }
+
+	static inline Vec eq(Vec a, Vec b) { return _mm_cmpeq_epi16(a, b); }
+	static inline Vec cmpgt(Vec a, Vec b) { return _mm_cmpgt_epi16(a, b); }
+	static inline Vec bitAnd(Vec a, Vec b) { return _mm_and_si128(a, b); }
+	static inline Vec bitOr(Vec a, Vec b) { return _mm_or_si128(a, b); }
+	static inline Vec bitXor(Vec a, Vec b) { return _mm_xor_si128(a, b); }
+	static inline Vec andNot(Vec a, Vec b) { return _mm_andnot_si128(a, b); }
+	static inline Vec add(Vec a, Vec b) { return _mm_add_epi16(a, b); }
+	static inline Vec sub(Vec a, Vec b) { return _mm_sub_epi16(a, b); }
+	static inline Vec mullo(Vec a, Vec b) { return _mm_mullo_epi16(a, b); }
+	static inline Vec srl(Vec a, int n) { return _mm_srl_epi16(a, _mm_cvtsi32_si128(n)); }
+	static inline Vec sll(Vec a, int n) { return _mm_sll_epi16(a, _mm_cvtsi32_si128(n)); }
+
+	static inline void storeInterleaved(uint16 *dst, Vec a, Vec b) {
+		_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi16(a, b));
+		_mm_storeu_si128((__m128i *)(dst + 8), _mm_unpackhi_epi16(a, b));
+	}
+	static inline void storeInterleaved3(uint16 *dst, Vec a, Vec b, Vec c) {
+		// SSE2 has no byte shuffle, so interleave through memory
+		uint16 tmp[3][kLanes];
+		_mm_storeu_si128((__m128i *)tmp[0], a);
+		_mm_storeu_si128((__m128i *)tmp[1], b);
+		_mm_storeu_si128((__m128i *)tmp[2], c);
+		for (int i = 0; i < kLanes; ++i) {
+			dst[3 * i + 0] = tmp[0][i];
+			dst[3 * i + 1] = tmp[1][i];
+			dst[3 * i + 2] = tmp[2][i];
+		}
+	}
+
+	typedef __m128i Vec32;
+	enum { kLanes32 = 4 };
+
+	static inline Vec32 load32(const uint32 *p) { return _mm_loadu_si128((const __m128i *)p); }
+	static inline Vec32 loadPixels(const uint16 *p) { return _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)p), _mm_setzero_si128()); }
+	static inline Vec32 set32(int v) { return _mm_set1_epi32(v); }
+	static inline Vec32 eq32(Vec32 a, Vec32 b) { return _mm_cmpeq_epi32(a, b); }
+	static inline Vec32 bitOr32(Vec32 a, Vec32 b) { return _mm_or_si128(a, b); }
+	static inline Vec32 andNot32(Vec32 a, Vec32 b) { return _mm_andnot_si128(a, b); }
+
+	/** Whether no channel differs by more than the diffYUV() thresholds */
+	static inline Vec32 similar(Vec32 a, Vec32 b) {
+		const __m128i diff = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+		const __m128i over = _mm_subs_epu8(diff, _mm_set1_epi32((int)0xFF300706));
+		return _mm_cmpeq_epi32(over, _mm_setzero_si128());
+	}
+
+	static inline void storePatterns(uint8 *dst, Vec32 v) {
+		const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(v, v), _mm_setzero_si128());
+		WRITE_UINT32(dst, _mm_cvtsi128_si32(bytes));
+	}
+};
+
+int advMame2xSSE2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsSSE2>::advMame2x(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+int advMame3xSSE2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsSSE2>::advMame3x(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+int _2xSaISSE2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsSSE2>::_2xSaI(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+int super2xSaISSE2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsSSE2>::super2xSaI(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+int superEagleSSE2(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, bool rgb565) {
+	return ScalerSIMDProcs<ScalerOpsSSE2>::superEagle(srcPtr, srcPitch, dstPtr, dstPitch, width, height, rgb565);
+}
+
+void hqxPatternSSE2(uint8 *patterns, const uint16 *src, uint32 nextline, const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, int width) {
+	hqxPatternSIMD<ScalerOpsSSE2>(patterns, src, nextline, yuv0, yuv1, yuv2, width);
+}
+
+#endif
@@ -43,17 +43,13 @@ void Screen::update() {
 	// Merge the dirty rects
 	mergeDirtyRects();
 
-	// Loop through copying dirty areas to the physical screen
-	Common::List<Common::Rect>::iterator i;
-	for (i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
-		const Common::Rect &r = *i;
-		const byte *srcP = (const byte *)getBasePtr(r.left, r.top);
-		g_system->copyRectToScreen(srcP, pitch, r.left, r.top,
-			r.width(), r.height());
-	}
+	// Copy the dirty areas to the physical screen in a single batch
+	if (!_dirtyRects.empty())
+		g_system->copyRectsToScreen(getPixels(), pitch, &_dirtyRects[0], _dirtyRects.size());
 
 	// Signal the physical screen to update
 	updateScreen();
+	_dirtyRegion.clear();
 	_dirtyRects.clear();
 }
 
@@ -67,8 +63,7 @@ void Screen::addDirtyRect(const Common::Rect &r) {
 	bounds.clip(getBounds());
 	bounds.translate(getOffsetFromOwner().x, getOffsetFromOwner().y);
 
-	if (bounds.width() > 0 && bounds.height() > 0)
-		_dirtyRects.push_back(bounds);
+	_dirtyRegion.add(bounds);
 }
 
 void Screen::makeAllDirty() {
@@ -76,25 +71,7 @@ void Screen::makeAllDirty() {
 }
 
 void Screen::mergeDirtyRects() {
-	Common::List<Common::Rect>::iterator rOuter, rInner;
-
-	// Process the dirty rect list to find any rects to merge
-	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
-		rInner = rOuter;
-		while (++rInner != _dirtyRects.end()) {
-
-			if ((*rOuter).intersects(*rInner)) {
-				// These two rectangles overlap, so merge them
-				unionRectangle(*rOuter, *rOuter, *rInner);
-
-				// remove the inner rect from the list
-				_dirtyRects.erase(rInner);
-
-				// move back to beginning of list
-				rInner = rOuter;
-			}
-		}
-	}
+	_dirtyRegion.getUpdateRects(_dirtyRects);
 }
 
 bool Screen::unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2) {
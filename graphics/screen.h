@@ -23,8 +23,10 @@
 #ifndef GRAPHICS_SCREEN_H
 #define GRAPHICS_SCREEN_H
 
+#include "graphics/dirty_region.h"
 #include "graphics/managed_surface.h"
 #include "graphics/pixelformat.h"
+#include "common/array.h"
 #include "common/list.h"
 #include "common/rect.h"
 
@@ -42,12 +44,18 @@ namespace Graphics {
 class Screen : public ManagedSurface {
 protected:
 	/**
-	 * List of affected areas of the screen
+	 * Affected areas of the screen
 	 */
-	Common::List<Common::Rect> _dirtyRects;
+	DirtyRegion _dirtyRegion;
+
+	/**
+	 * Rectangles to copy to the physical screen, set up by mergeDirtyRects()
+	 */
+	Common::Array<Common::Rect> _dirtyRects;
 protected:
 	/**
-	 * Merges together overlapping dirty areas of the screen
+	 * Splits the dirty region into the rectangles to copy to the physical
+	 * screen, merging those that are cheaper to copy as one
 	 */
 	void mergeDirtyRects();
 
@@ -69,7 +77,7 @@ public:
 	/**
 	 * Returns true if there are any pending screen updates (dirty areas)
 	 */
-	bool isDirty() const { return !_dirtyRects.empty(); }
+	bool isDirty() const { return !_dirtyRegion.isEmpty(); }
 
 	/**
 	 * Marks the whole screen as dirty. This forces the next call to update
@@ -78,9 +86,12 @@ public:
 	void makeAllDirty();
 
 	/**
-	 * Clear the current dirty rects list
+	 * Clear the current dirty region
 	 */
-	virtual void clearDirtyRects() { _dirtyRects.clear(); }
+	virtual void clearDirtyRects() {
+		_dirtyRegion.clear();
+		_dirtyRects.clear();
+	}
 
 	/**
 	 * Updates the screen by copying any affected areas to the system
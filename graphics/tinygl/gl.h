@@ -847,6 +847,10 @@ void tglPolygonOffset(TGLfloat factor, TGLfloat units);
 
 void tglEnableDirtyRects(bool enable);
 
+// Rasterize the draw calls of a frame on several threads, splitting the
+// screen into tiles. The output is identical to single-threaded rendering.
+void tglEnableTiledRendering(bool enable);
+
 void tglDebug(int mode);
 
 namespace TinyGL {
@@ -235,6 +235,9 @@ void glInit(void *zbuffer1, int textureSize) {
 	c->_drawCallAllocator[1].initialize(kDrawCallMemory);
 	c->_enableDirtyRectangles = true;
 
+	c->_enableTiledRendering = true;
+	c->_workerPool = new Common::WorkerPool();
+
 	Graphics::Internal::tglBlitResetScissorRect();
 }
 
@@ -243,6 +246,8 @@ void glClose() {
 
 	tglDisposeDrawCallLists(c);
 	tglDisposeResources(c);
+	tglDisposeTileContexts(c);
+	delete c->_workerPool;
 
 	specbuf_cleanup(c);
 	for (int i = 0; i < 3; i++)
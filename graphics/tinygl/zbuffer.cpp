@@ -91,6 +91,7 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelBuffer &fra
 
 	this->_zbuf = (unsigned int *)gl_malloc(size);
 	memset(this->_zbuf, 0, size);
+	this->_zbufAllocated = true;
 
 	this->frame_buffer_allocated = 0;
 	this->pbuf = frame_buffer;
@@ -117,6 +118,7 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 
 	this->_zbuf = (unsigned int *)gl_malloc(size);
 	memset(this->_zbuf, 0, size);
+	this->_zbufAllocated = true;
 
 	byte *pixelBuffer = (byte *)gl_malloc(this->ysize * this->linesize);
 	this->pbuf.set(this->cmode, pixelBuffer);
@@ -136,7 +138,14 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 FrameBuffer::~FrameBuffer() {
 	if (frame_buffer_allocated)
 		pbuf.free();
-	gl_free(_zbuf);
+	if (_zbufAllocated)
+		gl_free(_zbuf);
+}
+
+void FrameBuffer::shareBuffers(const FrameBuffer &other) {
+	*this = other;
+	this->frame_buffer_allocated = 0;
+	this->_zbufAllocated = false;
 }
 
 Buffer *FrameBuffer::genOffscreenBuffer() {
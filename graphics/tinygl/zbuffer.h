@@ -104,6 +104,13 @@ struct FrameBuffer {
 	FrameBuffer(int xsize, int ysize, const Graphics::PixelFormat &format);
 	~FrameBuffer();
 
+	/**
+	 * Draw into the pixel and depth buffers of another frame buffer, with a
+	 * copy of its rendering state. The buffers remain owned by @p other.
+	 * This gives every tile of the tile rasterizer its own state.
+	 */
+	void shareBuffers(const FrameBuffer &other);
+
 	Buffer *genOffscreenBuffer();
 	void delOffscreenBuffer(Buffer *buffer);
 	void clear(int clear_z, int z, int clear_color, int r, int g, int b);
@@ -514,6 +521,7 @@ private:
 	void drawLine(const ZBufferPoint *p1, const ZBufferPoint *p2);
 
 	unsigned int *_zbuf;
+	bool _zbufAllocated;
 	bool _depthWrite;
 	Graphics::PixelBuffer pbuf;
 	bool _blendingEnabled;
@@ -113,6 +113,143 @@ void tglDisposeDrawCallLists(TinyGL::GLContext *c) {
 	c->_drawCallsQueue.clear();
 }
 
+typedef Common::List<Graphics::DrawCall *>::const_iterator DrawCallIterator;
+typedef Common::List<TinyGL::DirtyRectangle>::const_iterator DirtyRectangleIterator;
+
+// Height of the tiles of the tile rasterizer. Tiles span the whole width of
+// the screen, as the rasterizer works on scanlines and cheaply skips those
+// outside of the scissor rectangle.
+static const int kTileHeight = 32;
+
+struct TileBatch {
+	TinyGL::GLContext *c;
+	DrawCallIterator begin, end;
+	const Common::List<DirtyRectangle> *rectangles;
+};
+
+// Copy the state which the rasterizer reads from the context, but which is
+// not part of the state captured by the draw calls.
+static void tglSyncTileContext(TinyGL::GLContext *tile, const TinyGL::GLContext *c) {
+	tile->fb->shareBuffers(*c->fb);
+	tile->renderRect = c->renderRect;
+	tile->_textureSize = c->_textureSize;
+	tile->viewport = c->viewport;
+	tile->polygon_mode_back = c->polygon_mode_back;
+	tile->polygon_mode_front = c->polygon_mode_front;
+	tile->current_front_face = c->current_front_face;
+	tile->current_shade_model = c->current_shade_model;
+	tile->current_cull_face = c->current_cull_face;
+	tile->cull_face_enabled = c->cull_face_enabled;
+	tile->render_mode = c->render_mode;
+	tile->lighting_enabled = c->lighting_enabled;
+	tile->current_texture = c->current_texture;
+	tile->texture_2d_enabled = c->texture_2d_enabled;
+	tile->begin_type = c->begin_type;
+	tile->vertex_n = c->vertex_n;
+	tile->shadow_mode = c->shadow_mode;
+	tile->depth_test = c->depth_test;
+	tile->color_mask = c->color_mask;
+	tile->_scissorRect = c->_scissorRect;
+	tile->_enableDirtyRectangles = c->_enableDirtyRectangles;
+}
+
+static void tglPrepareTileContexts(TinyGL::GLContext *c) {
+	uint numTiles = (c->fb->ysize + kTileHeight - 1) / kTileHeight;
+	if (c->_tileContexts.size() != numTiles) {
+		tglDisposeTileContexts(c);
+		for (uint i = 0; i < numTiles; i++) {
+			// The frame buffer is set up to share the buffers of the
+			// main one by tglSyncTileContext() below
+			TinyGL::GLContext *tile = new TinyGL::GLContext();
+			tile->fb = new TinyGL::FrameBuffer(*c->fb);
+			tile->vertex_max = POLYGON_MAX_VERTEX;
+			tile->vertex = (TinyGL::GLVertex *)gl_malloc(POLYGON_MAX_VERTEX * sizeof(TinyGL::GLVertex));
+			c->_tileContexts.push_back(tile);
+		}
+	}
+
+	for (uint i = 0; i < numTiles; i++) {
+		tglSyncTileContext(c->_tileContexts[i], c);
+	}
+}
+
+void tglDisposeTileContexts(TinyGL::GLContext *c) {
+	for (uint i = 0; i < c->_tileContexts.size(); i++) {
+		TinyGL::GLContext *tile = c->_tileContexts[i];
+		delete tile->fb;
+		gl_free(tile->vertex);
+		delete tile;
+	}
+	c->_tileContexts.clear();
+}
+
+static void tglRasterizeTile(void *param, uint tileIndex) {
+	const TileBatch &batch = *(const TileBatch *)param;
+	TinyGL::GLContext *tile = batch.c->_tileContexts[tileIndex];
+	Common::Rect tileRect(0, tileIndex * kTileHeight, tile->fb->xsize, MIN<int>((tileIndex + 1) * kTileHeight, tile->fb->ysize));
+
+	// Every tile runs the draw calls in order, so each pixel sees the same
+	// sequence of operations as with single-threaded rendering.
+	for (DrawCallIterator it = batch.begin; it != batch.end; ++it) {
+		if (!batch.rectangles) {
+			(*it)->executeTile(tile, tileRect);
+			continue;
+		}
+
+		Common::Rect drawCallRegion = (*it)->getDirtyRegion();
+		for (DirtyRectangleIterator itRect = batch.rectangles->begin(); itRect != batch.rectangles->end(); ++itRect) {
+			if ((*itRect).rectangle.intersects(drawCallRegion)) {
+				Common::Rect clippingRectangle = (*itRect).rectangle.findIntersectingRect(tileRect);
+				if (!clippingRectangle.isEmpty())
+					(*it)->executeTile(tile, clippingRectangle);
+			}
+		}
+	}
+}
+
+static void tglExecuteDrawCall(const Graphics::DrawCall &drawCall, const Common::List<DirtyRectangle> *rectangles) {
+	if (!rectangles) {
+		drawCall.execute(true);
+		return;
+	}
+
+	Common::Rect drawCallRegion = drawCall.getDirtyRegion();
+	for (DirtyRectangleIterator itRect = rectangles->begin(); itRect != rectangles->end(); ++itRect) {
+		Common::Rect dirtyRegion = (*itRect).rectangle;
+		if (dirtyRegion.intersects(drawCallRegion)) {
+			drawCall.execute(dirtyRegion, true);
+		}
+	}
+}
+
+// Execute the draw calls of the frame, restricted to the given dirty
+// rectangles if there are any. Runs of tileable draw calls are rasterized
+// by the worker pool, one job per tile, while the others (i.e. blits) are
+// executed in between on the calling thread.
+static void tglExecuteDrawCalls(TinyGL::GLContext *c, const Common::List<DirtyRectangle> *rectangles) {
+	bool useTiles = c->_enableTiledRendering && c->render_mode == TGL_RENDER && c->_workerPool->getThreadCount() > 1;
+	if (useTiles)
+		tglPrepareTileContexts(c);
+
+	DrawCallIterator it = c->_drawCallsQueue.begin();
+	DrawCallIterator end = c->_drawCallsQueue.end();
+	while (it != end) {
+		if (useTiles && (*it)->isTileable()) {
+			TileBatch batch;
+			batch.c = c;
+			batch.begin = it;
+			batch.rectangles = rectangles;
+			while (it != end && (*it)->isTileable())
+				++it;
+			batch.end = it;
+			c->_workerPool->run(tglRasterizeTile, &batch, c->_tileContexts.size());
+		} else {
+			tglExecuteDrawCall(**it, rectangles);
+			++it;
+		}
+	}
+}
+
 static inline void _appendDirtyRectangle(const Graphics::DrawCall &call, Common::List<DirtyRectangle> &rectangles, int r, int g, int b) {
 	Common::Rect dirty_region = call.getDirtyRegion();
 	if (rectangles.empty() || dirty_region != rectangles.back().rectangle)
@@ -120,7 +257,6 @@ static inline void _appendDirtyRectangle(const Graphics::DrawCall &call, Common:
 }
 
 static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
-	typedef Common::List<Graphics::DrawCall *>::const_iterator DrawCallIterator;
 	typedef Common::List<TinyGL::DirtyRectangle>::iterator RectangleIterator;
 
 	Common::List<DirtyRectangle> rectangles;
@@ -195,15 +331,7 @@ static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
 
 	if (!rectangles.empty()) {
 		// Execute draw calls.
-		for (DrawCallIterator it = c->_drawCallsQueue.begin(); it != c->_drawCallsQueue.end(); ++it) {
-			Common::Rect drawCallRegion = (*it)->getDirtyRegion();
-			for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
-				Common::Rect dirtyRegion = (*itRect).rectangle;
-				if (dirtyRegion.intersects(drawCallRegion)) {
-					(*it)->execute(dirtyRegion, true);
-				}
-			}
-		}
+		tglExecuteDrawCalls(c, &rectangles);
 #if TGL_DIRTY_RECT_SHOW
 		// Draw debug rectangles.
 		// Note: white rectangles are rectangle that contained other rectangles
@@ -240,10 +368,10 @@ static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
 }
 
 static void tglPresentBufferSimple(TinyGL::GLContext *c) {
-	typedef Common::List<Graphics::DrawCall *>::const_iterator DrawCallIterator;
+
+	tglExecuteDrawCalls(c, nullptr);
 
 	for (DrawCallIterator it = c->_drawCallsQueue.begin(); it != c->_drawCallsQueue.end(); ++it) {
-		(*it)->execute(true);
 		delete *it;
 	}
 
@@ -294,7 +422,7 @@ RasterizationDrawCall::RasterizationDrawCall() : DrawCall(DrawCall_Rasterization
 	_drawTriangleFront = c->draw_triangle_front;
 	_drawTriangleBack = c->draw_triangle_back;
 	memcpy(_vertex, c->vertex, sizeof(TinyGL::GLVertex) * _vertexCount);
-	_state = captureState();
+	_state = captureState(c);
 	if (c->_enableDirtyRectangles) {
 		computeDirtyRegion();
 	}
@@ -334,18 +462,20 @@ void RasterizationDrawCall::computeDirtyRegion() {
 }
 
 void RasterizationDrawCall::execute(bool restoreState) const {
-	TinyGL::GLContext *c = TinyGL::gl_get_context();
+	execute(TinyGL::gl_get_context(), _vertex, restoreState);
+}
 
+void RasterizationDrawCall::execute(TinyGL::GLContext *c, TinyGL::GLVertex *vertex, bool restoreState) const {
 	RasterizationDrawCall::RasterizationState backupState;
 	if (restoreState) {
-		backupState = captureState();
+		backupState = captureState(c);
 	}
-	applyState(_state);
+	applyState(c, _state);
 
 	TinyGL::GLVertex *prevVertex = c->vertex;
 	int prevVertexCount = c->vertex_cnt;
 
-	c->vertex = _vertex;
+	c->vertex = vertex;
 	c->vertex_cnt = _vertexCount;
 	c->draw_triangle_front = (TinyGL::gl_draw_triangle_func)_drawTriangleFront;
 	c->draw_triangle_back = (TinyGL::gl_draw_triangle_func)_drawTriangleBack;
@@ -429,13 +559,12 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 	c->vertex_cnt = prevVertexCount;
 
 	if (restoreState) {
-		applyState(backupState);
+		applyState(c, backupState);
 	}
 }
 
-RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState() const {
+RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState(TinyGL::GLContext *c) const {
 	RasterizationState state;
-	TinyGL::GLContext *c = TinyGL::gl_get_context();
 	state.alphaTest = c->fb->isAlphaTestEnabled();
 	c->fb->getBlendingFactors(state.sfactor, state.dfactor);
 	state.enableBlending = c->fb->isBlendingEnabled();
@@ -467,8 +596,7 @@ RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState()
 	return state;
 }
 
-void RasterizationDrawCall::applyState(const RasterizationDrawCall::RasterizationState &state) const {
-	TinyGL::GLContext *c = TinyGL::gl_get_context();
+void RasterizationDrawCall::applyState(TinyGL::GLContext *c, const RasterizationDrawCall::RasterizationState &state) const {
 	c->fb->setBlendingFactors(state.sfactor, state.dfactor);
 	c->fb->enableBlending(state.enableBlending);
 	c->fb->enableAlphaTest(state.alphaTest);
@@ -502,6 +630,21 @@ void RasterizationDrawCall::execute(const Common::Rect &clippingRectangle, bool
 	c->fb->resetScissorRectangle();
 }
 
+void RasterizationDrawCall::executeTile(TinyGL::GLContext *c, const Common::Rect &clippingRectangle) const {
+	// The rasterizer modifies the vertices while drawing, so every tile
+	// draws from its own copy.
+	if (c->vertex_max < _vertexCount) {
+		TinyGL::gl_free(c->vertex);
+		c->vertex_max = _vertexCount;
+		c->vertex = (TinyGL::GLVertex *)TinyGL::gl_malloc(c->vertex_max * sizeof(TinyGL::GLVertex));
+	}
+	memcpy(c->vertex, _vertex, _vertexCount * sizeof(TinyGL::GLVertex));
+
+	c->fb->setScissorRectangle(clippingRectangle);
+	execute(c, c->vertex, true);
+	c->fb->resetScissorRectangle();
+}
+
 bool RasterizationDrawCall::operator==(const RasterizationDrawCall &other) const {
 	if (_vertexCount == other._vertexCount && 
 		_drawTriangleFront == other._drawTriangleFront && 
@@ -642,6 +785,10 @@ void ClearBufferDrawCall::execute(const Common::Rect &clippingRectangle, bool re
 	c->fb->clearRegion(clearRect.left, clearRect.top, clearRect.width(), clearRect.height(), _clearZBuffer, _zValue, _clearColorBuffer, _rValue, _gValue, _bValue);
 }
 
+void ClearBufferDrawCall::executeTile(TinyGL::GLContext *c, const Common::Rect &clippingRectangle) const {
+	c->fb->clearRegion(clippingRectangle.left, clippingRectangle.top, clippingRectangle.width(), clippingRectangle.height(), _clearZBuffer, _zValue, _clearColorBuffer, _rValue, _gValue, _bValue);
+}
+
 bool ClearBufferDrawCall::operator==(const ClearBufferDrawCall &other) const {
 	return	_clearZBuffer == other._clearZBuffer &&
 			_clearColorBuffer == other._clearColorBuffer &&
@@ -62,6 +62,11 @@ public:
 	}
 	virtual void execute(bool restoreState) const = 0;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const = 0;
+	// Draw calls which only touch pixels inside the clipping rectangle and do
+	// not depend on the global context can be rasterized in parallel, on the
+	// context of a tile of the tile rasterizer.
+	virtual bool isTileable() const { return false; }
+	virtual void executeTile(TinyGL::GLContext *c, const Common::Rect &clippingRectangle) const { }
 	DrawCallType getType() const { return _type; }
 	virtual const Common::Rect getDirtyRegion() const { return _dirtyRegion; }
 protected:
@@ -77,6 +82,8 @@ public:
 	bool operator==(const ClearBufferDrawCall &other) const;
 	virtual void execute(bool restoreState) const;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const;
+	virtual bool isTileable() const { return true; }
+	virtual void executeTile(TinyGL::GLContext *c, const Common::Rect &clippingRectangle) const;
 
 	void *operator new(size_t size) {
 		return ::Internal::allocateFrame(size);
@@ -96,6 +103,8 @@ public:
 	bool operator==(const RasterizationDrawCall &other) const;
 	virtual void execute(bool restoreState) const;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const;
+	virtual bool isTileable() const { return true; }
+	virtual void executeTile(TinyGL::GLContext *c, const Common::Rect &clippingRectangle) const;
 
 	void *operator new(size_t size) {
 		return ::Internal::allocateFrame(size);
@@ -104,6 +113,7 @@ public:
 	void operator delete(void *p) { }
 private:
 	void computeDirtyRegion();
+	void execute(TinyGL::GLContext *c, TinyGL::GLVertex *vertex, bool restoreState) const;
 	typedef void (*gl_draw_triangle_func_ptr)(TinyGL::GLContext *c, TinyGL::GLVertex *p0, TinyGL::GLVertex *p1, TinyGL::GLVertex *p2);
 	int _vertexCount;
 	TinyGL::GLVertex *_vertex;
@@ -139,8 +149,8 @@ private:
 
 	RasterizationState _state;
 
-	RasterizationState captureState() const;
-	void applyState(const RasterizationState &state) const;
+	RasterizationState captureState(TinyGL::GLContext *c) const;
+	void applyState(TinyGL::GLContext *c, const RasterizationState &state) const;
 };
 
 // Encapsulate a blit call: it might execute either a color buffer or z buffer blit.
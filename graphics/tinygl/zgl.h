@@ -34,6 +34,7 @@
 #include "common/array.h"
 #include "common/list.h"
 #include "common/scummsys.h"
+#include "common/workerpool.h"
 
 #include "graphics/tinygl/gl.h"
 #include "graphics/tinygl/zbuffer.h"
@@ -391,6 +392,11 @@ struct GLContext {
 	Common::List<Graphics::DrawCall *> _previousFrameDrawCallsQueue;
 	int _currentAllocatorIndex;
 	LinearAllocator _drawCallAllocator[2];
+
+	// Tile rasterizer
+	bool _enableTiledRendering;
+	Common::WorkerPool *_workerPool;
+	Common::Array<GLContext *> _tileContexts;
 };
 
 extern GLContext *gl_ctx;
@@ -433,6 +439,7 @@ void tglIssueDrawCall(Graphics::DrawCall *drawCall);
 // zdirtyrect.cpp
 void tglDisposeResources(GLContext *c);
 void tglDisposeDrawCallLists(TinyGL::GLContext *c);
+void tglDisposeTileContexts(GLContext *c);
 
 GLContext *gl_get_context();
 
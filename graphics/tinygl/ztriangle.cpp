@@ -160,6 +160,11 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		p2 = tp;
 	}
 
+	// Nothing to draw if the triangle is entirely above or below the
+	// scissor rectangle, as happens for most tiles of the tile rasterizer
+	if (kEnableScissor && (p2->y < _clipRectangle.top || p0->y >= _clipRectangle.bottom))
+		return;
+
 	// we compute dXdx and dXdy for all interpolated values
 
 	fdx1 = (float)(p1->x - p0->x);
@@ -371,7 +376,8 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		// we draw all the scan line of the part
 		while (nb_lines > 0) {
 			int x = x1;
-			{
+			// Lines outside of the scissor rectangle only advance the edges
+			if (!kEnableScissor || (y >= _clipRectangle.top && y < _clipRectangle.bottom)) {
 				if (kDrawLogic == DRAW_DEPTH_ONLY ||
 						(kDrawLogic == DRAW_FLAT && !(kInterpST || kInterpSTZ))) {
 					int pp;
@@ -32,10 +32,12 @@
 #include "common/util.h"
 #include "common/rect.h"
 #include "common/math.h"
+#include "common/simd.h"
 #include "common/textconsole.h"
 #include "graphics/conversion.h"
 #include "graphics/primitives.h"
 #include "graphics/transparent_surface.h"
+#include "graphics/transparent_surface_intern.h"
 #include "graphics/transform_tools.h"
 
 namespace Graphics {
@@ -58,13 +60,6 @@ static const int kGIndex = 1;
 static const int kRIndex = 0;
 #endif
 
-void doBlitOpaqueFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep);
-void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep);
-void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
-void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
-void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
-void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
-
 TransparentSurface::TransparentSurface() : Surface(), _alphaMode(ALPHA_FULL) {}
 
 TransparentSurface::TransparentSurface(const Surface &surf, bool copyData) : Surface(), _alphaMode(ALPHA_FULL) {
@@ -305,19 +300,19 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
 
 				out[kAIndex] = 255;
 				if (cb != 255) {
-					out[kBIndex] = MAX(out[kBIndex] - ((in[kBIndex] * cb  * (out[kBIndex]) * in[kAIndex]) >> 24), 0);
+					out[kBIndex] = MAX(out[kBIndex] - (int)((in[kBIndex] * cb * (uint32)out[kBIndex] * in[kAIndex]) >> 24), 0);
 				} else {
 					out[kBIndex] = MAX(out[kBIndex] - (in[kBIndex] * (out[kBIndex]) * in[kAIndex] >> 16), 0);
 				}
 
 				if (cg != 255) {
-					out[kGIndex] = MAX(out[kGIndex] - ((in[kGIndex] * cg  * (out[kGIndex]) * in[kAIndex]) >> 24), 0);
+					out[kGIndex] = MAX(out[kGIndex] - (int)((in[kGIndex] * cg * (uint32)out[kGIndex] * in[kAIndex]) >> 24), 0);
 				} else {
 					out[kGIndex] = MAX(out[kGIndex] - (in[kGIndex] * (out[kGIndex]) * in[kAIndex] >> 16), 0);
 				}
 
 				if (cr != 255) {
-					out[kRIndex] = MAX(out[kRIndex] - ((in[kRIndex] * cr * (out[kRIndex]) * in[kAIndex]) >> 24), 0);
+					out[kRIndex] = MAX(out[kRIndex] - (int)((in[kRIndex] * cr * (uint32)out[kRIndex] * in[kAIndex]) >> 24), 0);
 				} else {
 					out[kRIndex] = MAX(out[kRIndex] - (in[kRIndex] * (out[kRIndex]) * in[kAIndex] >> 16), 0);
 				}
@@ -397,6 +392,41 @@ void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 
 }
 
+const BlitProcs &getBlitProcs() {
+	static const BlitProcs generic = {
+		doBlitOpaqueFast, doBlitBinaryFast, doBlitAlphaBlend,
+		doBlitAdditiveBlend, doBlitSubtractiveBlend, doBlitMultiplyBlend
+	};
+	const BlitProcs *neon = nullptr, *sse2 = nullptr, *avx2 = nullptr;
+
+	// The vectorized routines expect the little endian pixel layout
+#ifdef SCUMM_LITTLE_ENDIAN
+#ifdef SCUMMVM_NEON
+	static const BlitProcs neonProcs = {
+		doBlitOpaqueFastNEON, doBlitBinaryFastNEON, doBlitAlphaBlendNEON,
+		doBlitAdditiveBlendNEON, doBlitSubtractiveBlendNEON, doBlitMultiplyBlendNEON
+	};
+	neon = &neonProcs;
+#endif
+#ifdef SCUMMVM_SSE2
+	static const BlitProcs sse2Procs = {
+		doBlitOpaqueFastSSE2, doBlitBinaryFastSSE2, doBlitAlphaBlendSSE2,
+		doBlitAdditiveBlendSSE2, doBlitSubtractiveBlendSSE2, doBlitMultiplyBlendSSE2
+	};
+	sse2 = &sse2Procs;
+#endif
+#ifdef SCUMMVM_AVX2
+	static const BlitProcs avx2Procs = {
+		doBlitOpaqueFastAVX2, doBlitBinaryFastAVX2, doBlitAlphaBlendAVX2,
+		doBlitAdditiveBlendAVX2, doBlitSubtractiveBlendAVX2, doBlitMultiplyBlendAVX2
+	};
+	avx2 = &avx2Procs;
+#endif
+#endif
+
+	return Common::selectSimdProcs(generic, neon, sse2, avx2);
+}
+
 Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int posY, int flipping, Common::Rect *pPartRect, uint color, int width, int height, TSpriteBlendMode blendMode) {
 
 	Common::Rect retSize;
@@ -513,21 +543,22 @@ Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int p
 
 		byte *ino = (byte *)img->getBasePtr(xp, yp);
 		byte *outo = (byte *)target.getBasePtr(posX, posY);
+		const BlitProcs &procs = getBlitProcs();
 
 		if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_OPAQUE) {
-			doBlitOpaqueFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
+			procs.opaque(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
 		} else if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_BINARY) {
-			doBlitBinaryFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
+			procs.binary(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
 		} else {
 			if (blendMode == BLEND_ADDITIVE) {
-				doBlitAdditiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
+				procs.additiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
 			} else if (blendMode == BLEND_SUBTRACTIVE) {
-				doBlitSubtractiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
+				procs.subtractiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
 			} else if (blendMode == BLEND_MULTIPLY) {
-				doBlitMultiplyBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
+				procs.multiplyBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
 			} else {
 				assert(blendMode == BLEND_NORMAL);
-				doBlitAlphaBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
+				procs.alphaBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
 			}
 		}
 
@@ -660,21 +691,22 @@ Common::Rect TransparentSurface::blitClip(Graphics::Surface &target, Common::Rec
 
 		byte *ino = (byte *)img->getBasePtr(xp, yp);
 		byte *outo = (byte *)target.getBasePtr(posX, posY);
+		const BlitProcs &procs = getBlitProcs();
 
 		if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_OPAQUE) {
-			doBlitOpaqueFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
+			procs.opaque(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
 		} else if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_BINARY) {
-			doBlitBinaryFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
+			procs.binary(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
 		} else {
 			if (blendMode == BLEND_ADDITIVE) {
-				doBlitAdditiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
+				procs.additiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
 			} else if (blendMode == BLEND_SUBTRACTIVE) {
-				doBlitSubtractiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
+				procs.subtractiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
 			} else if (blendMode == BLEND_MULTIPLY) {
-				doBlitMultiplyBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
+				procs.multiplyBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
 			} else {
 				assert(blendMode == BLEND_NORMAL);
-				doBlitAlphaBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
+				procs.alphaBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
 			}
 		}
 
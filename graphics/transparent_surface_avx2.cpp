@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/transparent_surface_simd.h"
+
+#ifdef SCUMMVM_AVX2
+
+#include <immintrin.h>
+
+namespace Graphics {
+
+struct BlitOpsAVX2 {
+	typedef __m256i Pixels;
+	typedef __m256i Vec;
+	enum { kPixels = 8 };
+
+	// Unpacking and packing work on each 128-bit half separately, which
+	// keeps the pixels in order as long as both are used together
+	static inline Pixels load(const byte *p) { return _mm256_loadu_si256((const __m256i *)p); }
+	static inline Pixels loadReversed(const byte *p) {
+		// p points to the first of eight pixels stored backwards
+		return _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i *)(p - 28)), _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+	}
+	static inline void store(byte *p, Pixels v) { _mm256_storeu_si256((__m256i *)p, v); }
+
+	static inline Vec unpackLo(Pixels v) { return _mm256_unpacklo_epi8(v, _mm256_setzero_si256()); }
+	static inline Vec unpackHi(Pixels v) { return _mm256_unpackhi_epi8(v, _mm256_setzero_si256()); }
+	static inline Pixels pack(Vec lo, Vec hi) { return _mm256_packus_epi16(lo, hi); }
+
+	static inline Vec set1(uint16 v) { return _mm256_set1_epi16((short)v); }
+	static inline Vec setPixel(uint16 a, uint16 b, uint16 g, uint16 r) {
+		return _mm256_set1_epi64x((int64)(((uint64)r << 48) | ((uint64)g << 32) | ((uint64)b << 16) | a));
+	}
+
+	static inline Vec add(Vec a, Vec b) { return _mm256_add_epi16(a, b); }
+	static inline Vec sub(Vec a, Vec b) { return _mm256_sub_epi16(a, b); }
+	static inline Vec mullo(Vec a, Vec b) { return _mm256_mullo_epi16(a, b); }
+	static inline Vec mulhi(Vec a, Vec b) { return _mm256_mulhi_epu16(a, b); }
+	static inline Vec shr8(Vec a) { return _mm256_srli_epi16(a, 8); }
+	static inline Vec min(Vec a, Vec b) { return _mm256_min_epi16(a, b); }
+	static inline Vec max(Vec a, Vec b) { return _mm256_max_epi16(a, b); }
+	static inline Vec and_(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+	static inline Vec cmpeq(Vec a, Vec b) { return _mm256_cmpeq_epi16(a, b); }
+	static inline Vec select(Vec mask, Vec a, Vec b) { return _mm256_blendv_epi8(b, a, mask); }
+	static inline Vec broadcastAlpha(Vec v) {
+		return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(v, 0), 0);
+	}
+};
+
+void doBlitOpaqueFastAVX2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep) {
+	blitOpaqueSIMD<BlitOpsAVX2>(ino, outo, width, height, pitch, inStep, inoStep);
+}
+
+void doBlitBinaryFastAVX2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep) {
+	blitBinarySIMD<BlitOpsAVX2>(ino, outo, width, height, pitch, inStep, inoStep);
+}
+
+void doBlitAlphaBlendAVX2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitAlphaBlendSIMD<BlitOpsAVX2>(ino, outo, width, height, pitch, inStep, inoStep, color);
+}
+
+void doBlitAdditiveBlendAVX2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitAdditiveBlendSIMD<BlitOpsAVX2>(ino, outo, width, height, pitch, inStep, inoStep, color);
+}
+
+void doBlitSubtractiveBlendAVX2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitSubtractiveBlendSIMD<BlitOpsAVX2>(ino, outo, width, height, pitch, inStep, inoStep, color);
+}
+
+void doBlitMultiplyBlendAVX2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitMultiplyBlendSIMD<BlitOpsAVX2>(ino, outo, width, height, pitch, inStep, inoStep, color);
+}
+
+} // End of namespace Graphics
+
+#endif
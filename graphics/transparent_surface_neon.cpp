@@ -0,0 +1,104 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/transparent_surface_simd.h"
+
+#ifdef SCUMMVM_NEON
+
+#include <arm_neon.h>
+
+namespace Graphics {
+
+struct BlitOpsNEON {
+	typedef uint8x16_t Pixels;
+	typedef uint16x8_t Vec;
+	enum { kPixels = 4 };
+
+	static inline Pixels load(const byte *p) { return vld1q_u8(p); }
+	static inline Pixels loadReversed(const byte *p) {
+		// p points to the first of four pixels stored backwards
+		const uint32x4_t v = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(p - 12)));
+		return vreinterpretq_u8_u32(vextq_u32(v, v, 2));
+	}
+	static inline void store(byte *p, Pixels v) { vst1q_u8(p, v); }
+
+	static inline Vec unpackLo(Pixels v) { return vmovl_u8(vget_low_u8(v)); }
+	static inline Vec unpackHi(Pixels v) { return vmovl_u8(vget_high_u8(v)); }
+	static inline Pixels pack(Vec lo, Vec hi) { return vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi)); }
+
+	static inline Vec set1(uint16 v) { return vdupq_n_u16(v); }
+	static inline Vec setPixel(uint16 a, uint16 b, uint16 g, uint16 r) {
+		return vreinterpretq_u16_u64(vdupq_n_u64(((uint64)r << 48) | ((uint64)g << 32) | ((uint64)b << 16) | a));
+	}
+
+	static inline Vec add(Vec a, Vec b) { return vaddq_u16(a, b); }
+	static inline Vec sub(Vec a, Vec b) { return vsubq_u16(a, b); }
+	static inline Vec mullo(Vec a, Vec b) { return vmulq_u16(a, b); }
+	static inline Vec mulhi(Vec a, Vec b) {
+		return vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(a), vget_low_u16(b)), 16),
+		                    vshrn_n_u32(vmull_u16(vget_high_u16(a), vget_high_u16(b)), 16));
+	}
+	static inline Vec shr8(Vec a) { return vshrq_n_u16(a, 8); }
+	static inline Vec min(Vec a, Vec b) {
+		return vreinterpretq_u16_s16(vminq_s16(vreinterpretq_s16_u16(a), vreinterpretq_s16_u16(b)));
+	}
+	static inline Vec max(Vec a, Vec b) {
+		return vreinterpretq_u16_s16(vmaxq_s16(vreinterpretq_s16_u16(a), vreinterpretq_s16_u16(b)));
+	}
+	static inline Vec and_(Vec a, Vec b) { return vandq_u16(a, b); }
+	static inline Vec cmpeq(Vec a, Vec b) { return vceqq_u16(a, b); }
+	static inline Vec select(Vec mask, Vec a, Vec b) { return vbslq_u16(mask, a, b); }
+	static inline Vec broadcastAlpha(Vec v) {
+		uint64x2_t a = vandq_u64(vreinterpretq_u64_u16(v), vdupq_n_u64(0xFFFF));
+		a = vorrq_u64(a, vshlq_n_u64(a, 16));
+		a = vorrq_u64(a, vshlq_n_u64(a, 32));
+		return vreinterpretq_u16_u64(a);
+	}
+};
+
+void doBlitOpaqueFastNEON(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep) {
+	blitOpaqueSIMD<BlitOpsNEON>(ino, outo, width, height, pitch, inStep, inoStep);
+}
+
+void doBlitBinaryFastNEON(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep) {
+	blitBinarySIMD<BlitOpsNEON>(ino, outo, width, height, pitch, inStep, inoStep);
+}
+
+void doBlitAlphaBlendNEON(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitAlphaBlendSIMD<BlitOpsNEON>(ino, outo, width, height, pitch, inStep, inoStep, color);
+}
+
+void doBlitAdditiveBlendNEON(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitAdditiveBlendSIMD<BlitOpsNEON>(ino, outo, width, height, pitch, inStep, inoStep, color);
+}
+
+void doBlitSubtractiveBlendNEON(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitSubtractiveBlendSIMD<BlitOpsNEON>(ino, outo, width, height, pitch, inStep, inoStep, color);
+}
+
+void doBlitMultiplyBlendNEON(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitMultiplyBlendSIMD<BlitOpsNEON>(ino, outo, width, height, pitch, inStep, inoStep, color);
+}
+
+} // End of namespace Graphics
+
+#endif
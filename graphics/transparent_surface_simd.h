@@ -0,0 +1,295 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_TRANSPARENTSURFACE_SIMD_H
+#define GRAPHICS_TRANSPARENTSURFACE_SIMD_H
+
+#include "graphics/transparent_surface_intern.h"
+
+namespace Graphics {
+
+/*
+ * Vectorized versions of the blit routines in transparent_surface.cpp,
+ * shared by the SSE2, AVX2 and NEON implementations.
+ *
+ * The instruction set is abstracted by an Ops class, which provides a
+ * Pixels type holding Ops::kPixels 32-bit pixels and a Vec type holding
+ * half as many pixels with one 16-bit lane per channel. The lanes of a
+ * pixel hold A, B, G and R in this order, which is the memory layout of
+ * TransparentSurface pixels on little endian machines.
+ *
+ * Every kernel reproduces the integer arithmetic of the scalar routine,
+ * including where the scalar code truncates to a byte, so the results
+ * are bit-exact.
+ */
+
+/**
+ * Run @p kernel over all rows, handling Ops::kPixels pixels at a time.
+ * The remaining pixels of each row are handed to the scalar routine.
+ */
+template<class Ops, class Kernel>
+void blitRowsSIMD(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, const Kernel &kernel) {
+	typedef typename Ops::Pixels Pixels;
+	typedef typename Ops::Vec Vec;
+
+	for (uint32 i = 0; i < height; i++) {
+		byte *in = ino;
+		byte *out = outo;
+		uint32 j = 0;
+
+		for (; j + Ops::kPixels <= width; j += Ops::kPixels) {
+			const Pixels src = (inStep < 0) ? Ops::loadReversed(in) : Ops::load(in);
+			const Pixels dst = Ops::load(out);
+
+			const Vec lo = kernel(Ops::unpackLo(src), Ops::unpackLo(dst));
+			const Vec hi = kernel(Ops::unpackHi(src), Ops::unpackHi(dst));
+			Ops::store(out, Ops::pack(lo, hi));
+
+			in += inStep * Ops::kPixels;
+			out += 4 * Ops::kPixels;
+		}
+
+		if (j < width)
+			kernel.tail(in, out, width - j, pitch, inStep, inoStep);
+
+		outo += pitch;
+		ino += inoStep;
+	}
+}
+
+/** Lane mask selecting the alpha channel of every pixel. */
+template<class Ops>
+inline typename Ops::Vec alphaLanes() {
+	return Ops::setPixel(0xFFFF, 0, 0, 0);
+}
+
+/** Color modulation factors, with the alpha factor in the alpha lanes. */
+template<class Ops>
+inline typename Ops::Vec colorLanes(uint32 color) {
+	return Ops::setPixel((color >> 24) & 0xFF, color & 0xFF, (color >> 8) & 0xFF, (color >> 16) & 0xFF);
+}
+
+template<class Ops>
+struct BlitOpaqueKernel {
+	typedef typename Ops::Vec Vec;
+	const Vec _alpha;
+
+	BlitOpaqueKernel() : _alpha(Ops::setPixel(0xFF, 0, 0, 0)) {}
+
+	Vec operator()(Vec in, Vec out) const {
+		return Ops::max(in, _alpha);
+	}
+
+	void tail(byte *in, byte *out, uint32 width, uint32 pitch, int32 inStep, int32 inoStep) const {
+		doBlitOpaqueFast(in, out, width, 1, pitch, inStep, inoStep);
+	}
+};
+
+template<class Ops>
+struct BlitBinaryKernel {
+	typedef typename Ops::Vec Vec;
+	const Vec _alpha;
+
+	BlitBinaryKernel() : _alpha(Ops::setPixel(0xFF, 0, 0, 0)) {}
+
+	Vec operator()(Vec in, Vec out) const {
+		const Vec transparent = Ops::cmpeq(Ops::broadcastAlpha(in), Ops::set1(0));
+		return Ops::select(transparent, out, Ops::max(in, _alpha));
+	}
+
+	void tail(byte *in, byte *out, uint32 width, uint32 pitch, int32 inStep, int32 inoStep) const {
+		doBlitBinaryFast(in, out, width, 1, pitch, inStep, inoStep);
+	}
+};
+
+template<class Ops>
+struct BlitAlphaBlendKernel {
+	typedef typename Ops::Vec Vec;
+	const uint32 _color;
+	const Vec _alphaLanes, _colorLanes, _alphaMod;
+
+	explicit BlitAlphaBlendKernel(uint32 color) : _color(color),
+		_alphaLanes(alphaLanes<Ops>()), _colorLanes(colorLanes<Ops>(color)), _alphaMod(Ops::set1((color >> 24) & 0xFF)) {}
+
+	Vec operator()(Vec in, Vec out) const {
+		const Vec c255 = Ops::set1(255);
+		Vec ina = Ops::broadcastAlpha(in);
+		Vec result;
+
+		if (_color == 0xFFFFFFFF) {
+			// (in * a + out * (255 - a)) >> 8, which never exceeds 16 bits
+			result = Ops::shr8(Ops::add(Ops::mullo(in, ina), Ops::mullo(out, Ops::sub(c255, ina))));
+		} else {
+			ina = Ops::shr8(Ops::mullo(ina, _alphaMod));
+			const Vec dst = Ops::shr8(Ops::mullo(out, Ops::sub(c255, ina)));
+			const Vec src = Ops::mulhi(Ops::mullo(in, ina), _colorLanes);
+			result = Ops::and_(Ops::add(dst, src), c255);
+		}
+
+		result = Ops::select(_alphaLanes, c255, result);
+		return Ops::select(Ops::cmpeq(ina, Ops::set1(0)), out, result);
+	}
+
+	void tail(byte *in, byte *out, uint32 width, uint32 pitch, int32 inStep, int32 inoStep) const {
+		doBlitAlphaBlend(in, out, width, 1, pitch, inStep, inoStep, _color);
+	}
+};
+
+template<class Ops>
+struct BlitAdditiveBlendKernel {
+	typedef typename Ops::Vec Vec;
+	const uint32 _color;
+	const Vec _alphaLanes, _colorLanes, _alphaMod, _fullColor;
+
+	explicit BlitAdditiveBlendKernel(uint32 color) : _color(color),
+		_alphaLanes(alphaLanes<Ops>()), _colorLanes(colorLanes<Ops>(color)), _alphaMod(Ops::set1((color >> 24) & 0xFF)),
+		_fullColor(Ops::cmpeq(colorLanes<Ops>(color), Ops::set1(255))) {}
+
+	Vec operator()(Vec in, Vec out) const {
+		const Vec c255 = Ops::set1(255);
+		Vec ina = Ops::broadcastAlpha(in);
+		Vec src;
+
+		if (_color == 0xFFFFFFFF) {
+			src = Ops::shr8(Ops::mullo(in, ina));
+		} else {
+			// Channels with a modulation of 255 use a cheaper formula in
+			// the scalar code, which rounds differently
+			ina = Ops::shr8(Ops::mullo(ina, _alphaMod));
+			const Vec scaled = Ops::mullo(in, ina);
+			src = Ops::select(_fullColor, Ops::shr8(scaled), Ops::mulhi(scaled, _colorLanes));
+		}
+
+		const Vec result = Ops::min(Ops::add(out, src), c255);
+		return Ops::select(_alphaLanes, out, result);
+	}
+
+	void tail(byte *in, byte *out, uint32 width, uint32 pitch, int32 inStep, int32 inoStep) const {
+		doBlitAdditiveBlend(in, out, width, 1, pitch, inStep, inoStep, _color);
+	}
+};
+
+template<class Ops>
+struct BlitSubtractiveBlendKernel {
+	typedef typename Ops::Vec Vec;
+	const uint32 _color;
+	const Vec _alphaLanes, _colorLanes, _fullColor;
+
+	explicit BlitSubtractiveBlendKernel(uint32 color) : _color(color),
+		_alphaLanes(alphaLanes<Ops>()), _colorLanes(colorLanes<Ops>(color)),
+		_fullColor(Ops::cmpeq(colorLanes<Ops>(color), Ops::set1(255))) {}
+
+	Vec operator()(Vec in, Vec out) const {
+		const Vec c255 = Ops::set1(255);
+		const Vec ina = Ops::broadcastAlpha(in);
+
+		// (in * out * a) >> 16
+		const Vec sub = Ops::mulhi(Ops::mullo(in, out), ina);
+
+		if (_color == 0xFFFFFFFF)
+			return Ops::select(_alphaLanes, out, Ops::sub(out, sub));
+
+		// (in * c * out * a) >> 24, from the upper half of the product of
+		// two 16-bit factors
+		const Vec subMod = Ops::shr8(Ops::mulhi(Ops::mullo(in, _colorLanes), Ops::mullo(out, ina)));
+		Vec result = Ops::select(_fullColor, Ops::sub(out, sub), Ops::sub(out, subMod));
+		result = Ops::and_(Ops::max(result, Ops::set1(0)), c255);
+		return Ops::select(_alphaLanes, c255, result);
+	}
+
+	void tail(byte *in, byte *out, uint32 width, uint32 pitch, int32 inStep, int32 inoStep) const {
+		doBlitSubtractiveBlend(in, out, width, 1, pitch, inStep, inoStep, _color);
+	}
+};
+
+template<class Ops>
+struct BlitMultiplyBlendKernel {
+	typedef typename Ops::Vec Vec;
+	const uint32 _color;
+	const Vec _alphaLanes, _colorLanes, _alphaMod, _fullColor;
+
+	explicit BlitMultiplyBlendKernel(uint32 color) : _color(color),
+		_alphaLanes(alphaLanes<Ops>()), _colorLanes(colorLanes<Ops>(color)), _alphaMod(Ops::set1((color >> 24) & 0xFF)),
+		_fullColor(Ops::cmpeq(colorLanes<Ops>(color), Ops::set1(255))) {}
+
+	Vec operator()(Vec in, Vec out) const {
+		const Vec c255 = Ops::set1(255);
+		Vec ina = Ops::broadcastAlpha(in);
+		Vec src;
+
+		if (_color == 0xFFFFFFFF) {
+			src = Ops::shr8(Ops::mullo(in, ina));
+		} else {
+			ina = Ops::shr8(Ops::mullo(ina, _alphaMod));
+			const Vec scaled = Ops::mullo(in, ina);
+			src = Ops::select(_fullColor, Ops::shr8(scaled), Ops::mulhi(scaled, _colorLanes));
+		}
+
+		Vec result = Ops::min(Ops::shr8(Ops::mullo(src, out)), c255);
+		result = Ops::select(_alphaLanes, out, result);
+
+		// Without color modulation, fully transparent pixels are skipped
+		if (_color == 0xFFFFFFFF)
+			result = Ops::select(Ops::cmpeq(ina, Ops::set1(0)), out, result);
+		return result;
+	}
+
+	void tail(byte *in, byte *out, uint32 width, uint32 pitch, int32 inStep, int32 inoStep) const {
+		doBlitMultiplyBlend(in, out, width, 1, pitch, inStep, inoStep, _color);
+	}
+};
+
+template<class Ops>
+void blitOpaqueSIMD(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep) {
+	// Like the scalar routine, this copies every row front to back,
+	// regardless of inStep
+	blitRowsSIMD<Ops>(ino, outo, width, height, pitch, 4, inoStep, BlitOpaqueKernel<Ops>());
+}
+
+template<class Ops>
+void blitBinarySIMD(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep) {
+	blitRowsSIMD<Ops>(ino, outo, width, height, pitch, inStep, inoStep, BlitBinaryKernel<Ops>());
+}
+
+template<class Ops>
+void blitAlphaBlendSIMD(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitRowsSIMD<Ops>(ino, outo, width, height, pitch, inStep, inoStep, BlitAlphaBlendKernel<Ops>(color));
+}
+
+template<class Ops>
+void blitAdditiveBlendSIMD(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitRowsSIMD<Ops>(ino, outo, width, height, pitch, inStep, inoStep, BlitAdditiveBlendKernel<Ops>(color));
+}
+
+template<class Ops>
+void blitSubtractiveBlendSIMD(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitRowsSIMD<Ops>(ino, outo, width, height, pitch, inStep, inoStep, BlitSubtractiveBlendKernel<Ops>(color));
+}
+
+template<class Ops>
+void blitMultiplyBlendSIMD(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitRowsSIMD<Ops>(ino, outo, width, height, pitch, inStep, inoStep, BlitMultiplyBlendKernel<Ops>(color));
+}
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/transparent_surface_simd.h"
+
+#ifdef SCUMMVM_SSE2
+
+#include <emmintrin.h>
+
+namespace Graphics {
+
+struct BlitOpsSSE2 {
+	typedef __m128i Pixels;
+	typedef __m128i Vec;
+	enum { kPixels = 4 };
+
+	static inline Pixels load(const byte *p) { return _mm_loadu_si128((const __m128i *)p); }
+	static inline Pixels loadReversed(const byte *p) {
+		// p points to the first of four pixels stored backwards
+		return _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(p - 12)), 0x1B);
+	}
+	static inline void store(byte *p, Pixels v) { _mm_storeu_si128((__m128i *)p, v); }
+
+	static inline Vec unpackLo(Pixels v) { return _mm_unpacklo_epi8(v, _mm_setzero_si128()); }
+	static inline Vec unpackHi(Pixels v) { return _mm_unpackhi_epi8(v, _mm_setzero_si128()); }
+	static inline Pixels pack(Vec lo, Vec hi) { return _mm_packus_epi16(lo, hi); }
+
+	static inline Vec set1(uint16 v) { return _mm_set1_epi16((short)v); }
+	static inline Vec setPixel(uint16 a, uint16 b, uint16 g, uint16 r) {
+		return _mm_set_epi16((short)r, (short)g, (short)b, (short)a, (short)r, (short)g, (short)b, (short)a);
+	}
+
+	static inline Vec add(Vec a, Vec b) { return _mm_add_epi16(a, b); }
+	static inline Vec sub(Vec a, Vec b) { return _mm_sub_epi16(a, b); }
+	static inline Vec mullo(Vec a, Vec b) { return _mm_mullo_epi16(a, b); }
+	static inline Vec mulhi(Vec a, Vec b) { return _mm_mulhi_epu16(a, b); }
+	static inline Vec shr8(Vec a) { return _mm_srli_epi16(a, 8); }
+	static inline Vec min(Vec a, Vec b) { return _mm_min_epi16(a, b); }
+	static inline Vec max(Vec a, Vec b) { return _mm_max_epi16(a, b); }
+	static inline Vec and_(Vec a, Vec b) { return _mm_and_si128(a, b); }
+	static inline Vec cmpeq(Vec a, Vec b) { return _mm_cmpeq_epi16(a, b); }
+	static inline Vec select(Vec mask, Vec a, Vec b) {
+		return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+	}
+	static inline Vec broadcastAlpha(Vec v) {
+		return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0), 0);
+	}
+};
+
+void doBlitOpaqueFastSSE2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep) {
+	blitOpaqueSIMD<BlitOpsSSE2>(ino, outo, width, height, pitch, inStep, inoStep);
+}
+
+void doBlitBinaryFastSSE2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep) {
+	blitBinarySIMD<BlitOpsSSE2>(ino, outo, width, height, pitch, inStep, inoStep);
+}
+
+void doBlitAlphaBlendSSE2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitAlphaBlendSIMD<BlitOpsSSE2>(ino, outo, width, height, pitch, inStep, inoStep, color);
+}
+
+void doBlitAdditiveBlendSSE2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitAdditiveBlendSIMD<BlitOpsSSE2>(ino, outo, width, height, pitch, inStep, inoStep, color);
+}
+
+void doBlitSubtractiveBlendSSE2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitSubtractiveBlendSIMD<BlitOpsSSE2>(ino, outo, width, height, pitch, inStep, inoStep, color);
+}
+
+void doBlitMultiplyBlendSSE2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	blitMultiplyBlendSIMD<BlitOpsSSE2>(ino, outo, width, height, pitch, inStep, inoStep, color);
+}
+
+} // End of namespace Graphics
+
+#endif
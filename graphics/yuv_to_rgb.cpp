@@ -83,8 +83,10 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/simd.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
@@ -203,259 +205,303 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+static void initRowParams(YUVToRGBRowParams &params, const YUVToRGBLookup *lookup, const int16 *colorTab) {
+	const Graphics::PixelFormat format = lookup->getFormat();
+
+	params.rgbToPix = lookup->getRGBToPix();
+	params.alphaToPix = lookup->getAlphaToPix();
+	params.colorTab = colorTab;
+
+	params.bytesPerPixel = format.bytesPerPixel;
+	params.itu = lookup->getScale() == YUVToRGBManager::kScaleITU;
+	params.rLoss = format.rLoss;
+	params.gLoss = format.gLoss;
+	params.bLoss = format.bLoss;
+	params.aLoss = format.aLoss;
+	params.rShift = format.rShift;
+	params.gShift = format.gShift;
+	params.bShift = format.bShift;
+	params.aShift = format.aShift;
+}
+
 #define PUT_PIXEL(s, d) \
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
 
+#define PUT_PIXELA(s, a, d) \
+	L = &rgbToPix[(s)]; \
+	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b] | aToPix[a])
+
 template<typename PixelInt>
-void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+static void convertRowYUV444ToRGB(byte *dstPtr, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
 	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = colorTab;
+	const int16 *Cr_r_tab = params.colorTab;
 	const int16 *Cr_g_tab = Cr_r_tab + 256;
 	const int16 *Cb_g_tab = Cr_g_tab + 256;
 	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const uint32 *rgbToPix = lookup->getRGBToPix();
+	const uint32 *rgbToPix = params.rgbToPix;
 
-	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < yWidth; w++) {
-			const uint32 *L;
-
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
-
-			PUT_PIXEL(*ySrc, dstPtr);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-		}
+	for (int w = 0; w < width; w++) {
+		const uint32 *L;
+
+		int16 cr_r  = Cr_r_tab[*vSrc];
+		int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
+		int16 cb_b  = Cb_b_tab[*uSrc];
+		++uSrc;
+		++vSrc;
 
-		dstPtr += dstPitch - yWidth * sizeof(PixelInt);
-		ySrc += yPitch - yWidth;
-		uSrc += uvPitch - yWidth;
-		vSrc += uvPitch - yWidth;
+		PUT_PIXEL(*ySrc, dstPtr);
+		ySrc++;
+		dstPtr += sizeof(PixelInt);
 	}
 }
 
-void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Sanity checks
-	assert(dst && dst->getPixels());
-	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
-	assert(ySrc && uSrc && vSrc);
-
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
-
+void convertYUV444RowToRGB(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
 	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	if (params.bytesPerPixel == 2)
+		convertRowYUV444ToRGB<uint16>(dst, ySrc, uSrc, vSrc, width, params);
 	else
-		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertRowYUV444ToRGB<uint32>(dst, ySrc, uSrc, vSrc, width, params);
 }
 
 template<typename PixelInt>
-void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	int halfHeight = yHeight >> 1;
-	int halfWidth = yWidth >> 1;
+static void convertRowsYUV420ToRGB(byte *dstPtr0, byte *dstPtr1, const byte *ySrc0, const byte *ySrc1, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
+	const int16 *Cr_r_tab = params.colorTab;
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+	const uint32 *rgbToPix = params.rgbToPix;
+
+	for (int w = 0; w < width; w += 2) {
+		const uint32 *L;
+
+		int16 cr_r  = Cr_r_tab[*vSrc];
+		int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
+		int16 cb_b  = Cb_b_tab[*uSrc];
+		++uSrc;
+		++vSrc;
+
+		PUT_PIXEL(ySrc0[w], dstPtr0);
+		PUT_PIXEL(ySrc1[w], dstPtr1);
+		dstPtr0 += sizeof(PixelInt);
+		dstPtr1 += sizeof(PixelInt);
+		PUT_PIXEL(ySrc0[w + 1], dstPtr0);
+		PUT_PIXEL(ySrc1[w + 1], dstPtr1);
+		dstPtr0 += sizeof(PixelInt);
+		dstPtr1 += sizeof(PixelInt);
+	}
+}
 
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = colorTab;
+template<typename PixelInt>
+static void convertRowsYUVA420ToRGBA(byte *dstPtr0, byte *dstPtr1, const byte *ySrc0, const byte *ySrc1, const byte *aSrc0, const byte *aSrc1, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
+	const int16 *Cr_r_tab = params.colorTab;
 	const int16 *Cr_g_tab = Cr_r_tab + 256;
 	const int16 *Cb_g_tab = Cr_g_tab + 256;
 	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const uint32 *rgbToPix = lookup->getRGBToPix();
-
-	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
-			const uint32 *L;
-
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
-
-			PUT_PIXEL(*ySrc, dstPtr);
-			PUT_PIXEL(*(ySrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-			PUT_PIXEL(*ySrc, dstPtr);
-			PUT_PIXEL(*(ySrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-		}
+	const uint32 *rgbToPix = params.rgbToPix;
+	const uint32 *aToPix = params.alphaToPix;
+
+	for (int w = 0; w < width; w += 2) {
+		const uint32 *L;
+
+		int16 cr_r  = Cr_r_tab[*vSrc];
+		int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
+		int16 cb_b  = Cb_b_tab[*uSrc];
+		++uSrc;
+		++vSrc;
+
+		PUT_PIXELA(ySrc0[w], aSrc0[w], dstPtr0);
+		PUT_PIXELA(ySrc1[w], aSrc1[w], dstPtr1);
+		dstPtr0 += sizeof(PixelInt);
+		dstPtr1 += sizeof(PixelInt);
+		PUT_PIXELA(ySrc0[w + 1], aSrc0[w + 1], dstPtr0);
+		PUT_PIXELA(ySrc1[w + 1], aSrc1[w + 1], dstPtr1);
+		dstPtr0 += sizeof(PixelInt);
+		dstPtr1 += sizeof(PixelInt);
+	}
+}
+
+#undef PUT_PIXEL
+#undef PUT_PIXELA
 
-		dstPtr += dstPitch;
-		ySrc += (yPitch << 1) - yWidth;
-		uSrc += uvPitch - halfWidth;
-		vSrc += uvPitch - halfWidth;
+void convertYUV420RowsToRGB(byte *dst0, byte *dst1, const byte *ySrc0, const byte *ySrc1, const byte *aSrc0, const byte *aSrc1, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
+	if (aSrc0) {
+		if (params.bytesPerPixel == 2)
+			convertRowsYUVA420ToRGBA<uint16>(dst0, dst1, ySrc0, ySrc1, aSrc0, aSrc1, uSrc, vSrc, width, params);
+		else
+			convertRowsYUVA420ToRGBA<uint32>(dst0, dst1, ySrc0, ySrc1, aSrc0, aSrc1, uSrc, vSrc, width, params);
+	} else {
+		if (params.bytesPerPixel == 2)
+			convertRowsYUV420ToRGB<uint16>(dst0, dst1, ySrc0, ySrc1, uSrc, vSrc, width, params);
+		else
+			convertRowsYUV420ToRGB<uint32>(dst0, dst1, ySrc0, ySrc1, uSrc, vSrc, width, params);
 	}
 }
 
-void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Sanity checks
+const YUVToRGBProcs &getYUVToRGBProcs() {
+	static const YUVToRGBProcs generic = { convertYUV444RowToRGB, convertYUV420RowsToRGB };
+	const YUVToRGBProcs *neon = nullptr, *sse2 = nullptr, *avx2 = nullptr;
+
+	// The vectorized routines store the pixels in little endian order
+#ifdef SCUMM_LITTLE_ENDIAN
+#ifdef SCUMMVM_NEON
+	static const YUVToRGBProcs neonProcs = { convertYUV444RowToRGBNEON, convertYUV420RowsToRGBNEON };
+	neon = &neonProcs;
+#endif
+#ifdef SCUMMVM_SSE2
+	static const YUVToRGBProcs sse2Procs = { convertYUV444RowToRGBSSE2, convertYUV420RowsToRGBSSE2 };
+	sse2 = &sse2Procs;
+#endif
+#ifdef SCUMMVM_AVX2
+	static const YUVToRGBProcs avx2Procs = { convertYUV444RowToRGBAVX2, convertYUV420RowsToRGBAVX2 };
+	avx2 = &avx2Procs;
+#endif
+#endif
+
+	return Common::selectSimdProcs(generic, neon, sse2, avx2);
+}
+
+void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	assert(dst && dst->getPixels());
-	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
+	convert444((byte *)dst->getPixels(), dst->pitch, dst->format, scale, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+}
+
+void YUVToRGBManager::convert444(byte *dst, int dstPitch, const Graphics::PixelFormat &format, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	// Sanity checks
+	assert(dst);
+	assert(format.bytesPerPixel == 2 || format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
-	assert((yWidth & 1) == 0);
-	assert((yHeight & 1) == 0);
 
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	YUVToRGBRowParams params;
+	initRowParams(params, getLookup(format, scale), _colorTab);
+	const YUVToRGBRow444Proc row444 = getYUVToRGBProcs().row444;
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	for (int h = 0; h < yHeight; h++) {
+		row444(dst, ySrc, uSrc, vSrc, yWidth, params);
+
+		dst += dstPitch;
+		ySrc += yPitch;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
 }
 
-#define PUT_PIXELA(s, a, d) \
-	L = &rgbToPix[(s)]; \
-	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b] | aToPix[a])
+void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	assert(dst && dst->getPixels());
+	convert420((byte *)dst->getPixels(), dst->pitch, dst->format, scale, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+}
 
-template<typename PixelInt>
-void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	int halfHeight = yHeight >> 1;
-	int halfWidth = yWidth >> 1;
+void YUVToRGBManager::convert420(byte *dst, int dstPitch, const Graphics::PixelFormat &format, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	// Sanity checks
+	assert(dst);
+	assert(format.bytesPerPixel == 2 || format.bytesPerPixel == 4);
+	assert(ySrc && uSrc && vSrc);
+	assert((yWidth & 1) == 0);
+	assert((yHeight & 1) == 0);
 
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = colorTab;
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const uint32 *rgbToPix = lookup->getRGBToPix();
-	const uint32 *aToPix = lookup->getAlphaToPix();
-
-	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
-			const uint32 *L;
-
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
-
-			PUT_PIXELA(*ySrc, *aSrc, dstPtr);
-			PUT_PIXELA(*(ySrc + yPitch), *(aSrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			aSrc++;
-			dstPtr += sizeof(PixelInt);
-			PUT_PIXELA(*ySrc, *aSrc, dstPtr);
-			PUT_PIXELA(*(ySrc + yPitch), *(aSrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			aSrc++;
-			dstPtr += sizeof(PixelInt);
-		}
+	YUVToRGBRowParams params;
+	initRowParams(params, getLookup(format, scale), _colorTab);
+	const YUVToRGBRow420Proc row420 = getYUVToRGBProcs().row420;
 
-		dstPtr += dstPitch;
-		ySrc += (yPitch << 1) - yWidth;
-		aSrc += (yPitch << 1) - yWidth;
-		uSrc += uvPitch - halfWidth;
-		vSrc += uvPitch - halfWidth;
+	for (int h = 0; h < yHeight; h += 2) {
+		row420(dst, dst + dstPitch, ySrc, ySrc + yPitch, nullptr, nullptr, uSrc, vSrc, yWidth, params);
+
+		dst += dstPitch << 1;
+		ySrc += yPitch << 1;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
 	}
 }
 
 void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Sanity checks
 	assert(dst && dst->getPixels());
-	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
-	assert(ySrc && uSrc && vSrc);
+	convert420Alpha((byte *)dst->getPixels(), dst->pitch, dst->format, scale, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+}
+
+void YUVToRGBManager::convert420Alpha(byte *dst, int dstPitch, const Graphics::PixelFormat &format, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	// Sanity checks
+	assert(dst);
+	assert(format.bytesPerPixel == 2 || format.bytesPerPixel == 4);
+	assert(ySrc && uSrc && vSrc && aSrc);
 	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale, true);
+	YUVToRGBRowParams params;
+	initRowParams(params, getLookup(format, scale, true), _colorTab);
+	const YUVToRGBRow420Proc row420 = getYUVToRGBProcs().row420;
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
-}
+	for (int h = 0; h < yHeight; h += 2) {
+		row420(dst, dst + dstPitch, ySrc, ySrc + yPitch, aSrc, aSrc + yPitch, uSrc, vSrc, yWidth, params);
 
-#define READ_QUAD(ptr, prefix) \
-	byte prefix##A = ptr[index]; \
-	byte prefix##B = ptr[index + 1]; \
-	byte prefix##C = ptr[index + uvPitch]; \
-	byte prefix##D = ptr[index + uvPitch + 1]
-
-#define DO_INTERPOLATION(out) \
-	out = (out##A * (4 - xDiff) * (4 - yDiff) + out##B * xDiff * (4 - yDiff) + \
-			out##C * yDiff * (4 - xDiff) + out##D * xDiff * yDiff) >> 4
-
-#define DO_YUV410_PIXEL() \
-	DO_INTERPOLATION(u); \
-	DO_INTERPOLATION(v); \
-	\
-	cr_r  = Cr_r_tab[v]; \
-	crb_g = Cr_g_tab[v] + Cb_g_tab[u]; \
-	cb_b  = Cb_b_tab[u]; \
-	\
-	PUT_PIXEL(*ySrc, dstPtr); \
-	dstPtr += sizeof(PixelInt); \
-	\
-	ySrc++; \
-	xDiff++
+		dst += dstPitch << 1;
+		ySrc += yPitch << 1;
+		aSrc += yPitch << 1;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+}
 
-template<typename PixelInt>
-void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = colorTab;
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const uint32 *rgbToPix = lookup->getRGBToPix();
+/**
+ * Perform bilinear interpolation on the chroma values of one row of a
+ * YUV410 image.
+ *
+ * Based on the algorithm found here: http://tech-algorithm.com/articles/bilinear-image-scaling/
+ * The interpolation is done vertically first, which gives the same result
+ * as weighting all four neighbours at once.
+ */
+static void interpolateYUV410Row(byte *dst, const byte *src, int uvPitch, int yDiff, int width) {
+	int left = src[0] * (4 - yDiff) + src[uvPitch] * yDiff;
 
-	int quarterWidth = yWidth >> 2;
+	for (int x = 0; x < width; x += 4) {
+		++src;
+		int right = src[0] * (4 - yDiff) + src[uvPitch] * yDiff;
 
-	for (int y = 0; y < yHeight; y++) {
-		for (int x = 0; x < quarterWidth; x++) {
-			// Perform bilinear interpolation on the the chroma values
-			// Based on the algorithm found here: http://tech-algorithm.com/articles/bilinear-image-scaling/
-			// Feel free to optimize further
-			int targetY = y >> 2;
-			int xDiff = 0;
-			int yDiff = y & 3;
-			int index = targetY * uvPitch + x;
-
-			// Declare some variables for the following macros
-			byte u, v;
-			int16 cr_r, crb_g, cb_b;
-			const uint32 *L;
-
-			READ_QUAD(uSrc, u);
-			READ_QUAD(vSrc, v);
-
-			DO_YUV410_PIXEL();
-			DO_YUV410_PIXEL();
-			DO_YUV410_PIXEL();
-			DO_YUV410_PIXEL();
-		}
+		for (int xDiff = 0; xDiff < 4; xDiff++)
+			*dst++ = (left * (4 - xDiff) + right * xDiff) >> 4;
 
-		dstPtr += dstPitch - yWidth * sizeof(PixelInt);
-		ySrc += yPitch - yWidth;
+		left = right;
 	}
 }
 
-#undef READ_QUAD
-#undef DO_INTERPOLATION
-#undef DO_YUV410_PIXEL
-
 void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Sanity checks
 	assert(dst && dst->getPixels());
-	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
+	convert410((byte *)dst->getPixels(), dst->pitch, dst->format, scale, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+}
+
+void YUVToRGBManager::convert410(byte *dst, int dstPitch, const Graphics::PixelFormat &format, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	// Sanity checks
+	assert(dst);
+	assert(format.bytesPerPixel == 2 || format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
 	assert((yWidth & 3) == 0);
 	assert((yHeight & 3) == 0);
 
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	YUVToRGBRowParams params;
+	initRowParams(params, getLookup(format, scale), _colorTab);
+	const YUVToRGBRow444Proc row444 = getYUVToRGBProcs().row444;
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV410ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	// The chroma rows are upsampled to full resolution in chunks, which are
+	// then converted like YUV444.
+	enum { kChunkWidth = 256 };
+	byte uRow[kChunkWidth];
+	byte vRow[kChunkWidth];
+
+	for (int y = 0; y < yHeight; y++) {
+		const byte *uChroma = uSrc + (y >> 2) * uvPitch;
+		const byte *vChroma = vSrc + (y >> 2) * uvPitch;
+		int yDiff = y & 3;
+
+		for (int x = 0; x < yWidth; x += kChunkWidth) {
+			int width = MIN<int>(kChunkWidth, yWidth - x);
+
+			interpolateYUV410Row(uRow, uChroma + (x >> 2), uvPitch, yDiff, width);
+			interpolateYUV410Row(vRow, vChroma + (x >> 2), uvPitch, yDiff, width);
+			row444(dst + x * format.bytesPerPixel, ySrc + x, uRow, vRow, width, params);
+		}
+
+		dst += dstPitch;
+		ySrc += yPitch;
+	}
 }
 
 } // End of namespace Graphics
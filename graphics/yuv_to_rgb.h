@@ -30,6 +30,8 @@
  * - PSXStreamDecoder
  * - TheoraDecoder
  * - SVQ1Decoder
+ *
+ * The conversion uses SSE2, AVX2 or NEON where the CPU supports it.
  */
 
 #ifndef GRAPHICS_YUV_TO_RGB_H
@@ -66,6 +68,19 @@ public:
 	 */
 	void convert444(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Convert a YUV444 image straight into a buffer of the given format,
+	 * such as a locked screen or a backend overlay, without going through
+	 * an intermediate surface.
+	 *
+	 * @param dst      the first target pixel
+	 * @param dstPitch the pitch of the target buffer
+	 * @param format   the pixel format of the target buffer
+	 *
+	 * The other parameters are the same as for the surface variant.
+	 */
+	void convert444(byte *dst, int dstPitch, const Graphics::PixelFormat &format, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+
 	/**
 	 * Convert a YUV420 image to an RGB surface
 	 *
@@ -81,6 +96,19 @@ public:
 	 */
 	void convert420(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Convert a YUV420 image straight into a buffer of the given format,
+	 * such as a locked screen or a backend overlay, without going through
+	 * an intermediate surface.
+	 *
+	 * @param dst      the first target pixel
+	 * @param dstPitch the pitch of the target buffer
+	 * @param format   the pixel format of the target buffer
+	 *
+	 * The other parameters are the same as for the surface variant.
+	 */
+	void convert420(byte *dst, int dstPitch, const Graphics::PixelFormat &format, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+
 	/**
 	 * Convert a YUV420 image with Alpha component to an ARGB surface
 	 *
@@ -97,6 +125,18 @@ public:
 	 */
 	void convert420Alpha(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Convert a YUV420 image with Alpha component straight into a buffer of
+	 * the given format, without going through an intermediate surface.
+	 *
+	 * @param dst      the first target pixel
+	 * @param dstPitch the pitch of the target buffer
+	 * @param format   the pixel format of the target buffer
+	 *
+	 * The other parameters are the same as for the surface variant.
+	 */
+	void convert420Alpha(byte *dst, int dstPitch, const Graphics::PixelFormat &format, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+
 	/**
 	 * Convert a YUV410 image to an RGB surface
 	 *
@@ -118,6 +158,19 @@ public:
 	 */
 	void convert410(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Convert a YUV410 image straight into a buffer of the given format,
+	 * such as a locked screen or a backend overlay, without going through
+	 * an intermediate surface.
+	 *
+	 * @param dst      the first target pixel
+	 * @param dstPitch the pitch of the target buffer
+	 * @param format   the pixel format of the target buffer
+	 *
+	 * The other parameters are the same as for the surface variant.
+	 */
+	void convert410(byte *dst, int dstPitch, const Graphics::PixelFormat &format, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+
 private:
 	friend class Common::Singleton<SingletonBaseType>;
 	YUVToRGBManager();
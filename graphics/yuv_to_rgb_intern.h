@@ -0,0 +1,108 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_YUV_TO_RGB_INTERN_H
+#define GRAPHICS_YUV_TO_RGB_INTERN_H
+
+#include "common/scummsys.h"
+
+namespace Graphics {
+
+/**
+ * Everything the row routines need to know about a conversion.
+ *
+ * The scalar routines go through the lookup tables of the manager. The
+ * vectorized ones compute the same values arithmetically from the color
+ * tables' formulas and the pixel format, see yuv_to_rgb_simd.h.
+ */
+struct YUVToRGBRowParams {
+	const uint32 *rgbToPix;
+	const uint32 *alphaToPix;
+	const int16 *colorTab;
+
+	uint bytesPerPixel;
+	bool itu;
+	int rLoss, gLoss, bLoss, aLoss;
+	int rShift, gShift, bShift, aShift;
+};
+
+/**
+ * Convert one row of a YUV444 image.
+ *
+ * @param dst    the first target pixel
+ * @param ySrc   the y values of the row
+ * @param uSrc   the u values of the row
+ * @param vSrc   the v values of the row
+ * @param width  the number of pixels
+ * @param params the conversion
+ */
+typedef void (*YUVToRGBRow444Proc)(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params);
+
+/**
+ * Convert two rows of a YUV420 image, which share one row of chroma
+ * values.
+ *
+ * @param dst0   the first target pixel of the upper row
+ * @param dst1   the first target pixel of the lower row
+ * @param ySrc0  the y values of the upper row
+ * @param ySrc1  the y values of the lower row
+ * @param aSrc0  the alpha values of the upper row, or nullptr for opaque
+ *               output
+ * @param aSrc1  the alpha values of the lower row, or nullptr
+ * @param uSrc   the u values, one per two pixels
+ * @param vSrc   the v values, one per two pixels
+ * @param width  the number of pixels (must be divisible by 2)
+ * @param params the conversion
+ */
+typedef void (*YUVToRGBRow420Proc)(byte *dst0, byte *dst1, const byte *ySrc0, const byte *ySrc1, const byte *aSrc0, const byte *aSrc1, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params);
+
+struct YUVToRGBProcs {
+	YUVToRGBRow444Proc row444;
+	YUVToRGBRow420Proc row420;
+};
+
+void convertYUV444RowToRGB(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params);
+void convertYUV420RowsToRGB(byte *dst0, byte *dst1, const byte *ySrc0, const byte *ySrc1, const byte *aSrc0, const byte *aSrc1, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params);
+
+#ifdef SCUMMVM_SSE2
+void convertYUV444RowToRGBSSE2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params);
+void convertYUV420RowsToRGBSSE2(byte *dst0, byte *dst1, const byte *ySrc0, const byte *ySrc1, const byte *aSrc0, const byte *aSrc1, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params);
+#endif
+
+#ifdef SCUMMVM_AVX2
+void convertYUV444RowToRGBAVX2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params);
+void convertYUV420RowsToRGBAVX2(byte *dst0, byte *dst1, const byte *ySrc0, const byte *ySrc1, const byte *aSrc0, const byte *aSrc1, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params);
+#endif
+
+#ifdef SCUMMVM_NEON
+void convertYUV444RowToRGBNEON(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params);
+void convertYUV420RowsToRGBNEON(byte *dst0, byte *dst1, const byte *ySrc0, const byte *ySrc1, const byte *aSrc0, const byte *aSrc1, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params);
+#endif
+
+/**
+ * Return the fastest row routines the CPU supports.
+ */
+const YUVToRGBProcs &getYUVToRGBProcs();
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,93 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/endian.h"
+#include "graphics/yuv_to_rgb_simd.h"
+
+#ifdef SCUMMVM_NEON
+
+#include <arm_neon.h>
+
+namespace Graphics {
+
+struct YUVOpsNEON {
+	typedef int16x8_t Vec;
+	enum { kLanes = 8 };
+
+	static inline Vec load(const byte *p) { return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p))); }
+	static inline Vec loadHalf(const byte *p) {
+		const uint8x8_t v = vreinterpret_u8_u32(vdup_n_u32(READ_UINT32(p)));
+		return vreinterpretq_s16_u16(vmovl_u8(vzip_u8(v, v).val[0]));
+	}
+	static inline Vec set1(int v) { return vdupq_n_s16((int16)v); }
+
+	static inline Vec add(Vec a, Vec b) { return vaddq_s16(a, b); }
+	static inline Vec sub(Vec a, Vec b) { return vsubq_s16(a, b); }
+	static inline Vec min(Vec a, Vec b) { return vminq_s16(a, b); }
+	static inline Vec max(Vec a, Vec b) { return vmaxq_s16(a, b); }
+	static inline Vec mullo(Vec a, Vec b) { return vmulq_s16(a, b); }
+	static inline Vec mulhiU(Vec a, Vec b) {
+		const uint16x8_t ua = vreinterpretq_u16_s16(a);
+		const uint16x8_t ub = vreinterpretq_u16_s16(b);
+		const uint32x4_t lo = vmull_u16(vget_low_u16(ua), vget_low_u16(ub));
+		const uint32x4_t hi = vmull_u16(vget_high_u16(ua), vget_high_u16(ub));
+		return vreinterpretq_s16_u16(vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16)));
+	}
+	static inline Vec sign(Vec a) { return vshrq_n_s16(a, 15); }
+	static inline Vec bitXor(Vec a, Vec b) { return veorq_s16(a, b); }
+	static inline Vec bitOr(Vec a, Vec b) { return vorrq_s16(a, b); }
+	static inline Vec srl(Vec a, int n) {
+		return vreinterpretq_s16_u16(vshlq_u16(vreinterpretq_u16_s16(a), vdupq_n_s16(-n)));
+	}
+	static inline Vec sll(Vec a, int n) {
+		return vreinterpretq_s16_u16(vshlq_u16(vreinterpretq_u16_s16(a), vdupq_n_s16(n)));
+	}
+
+	static inline void store16(byte *dst, Vec v) { vst1q_u8(dst, vreinterpretq_u8_s16(v)); }
+
+	static inline uint32x4_t widen(Vec v, bool high, int shift) {
+		const uint16x8_t u = vreinterpretq_u16_s16(v);
+		const uint32x4_t w = vmovl_u16(high ? vget_high_u16(u) : vget_low_u16(u));
+		return vshlq_u32(w, vdupq_n_s32(shift));
+	}
+	static inline uint32x4_t pack32(Vec r, Vec g, Vec b, Vec a, bool high, const YUVToRGBRowParams &params) {
+		const uint32x4_t rg = vorrq_u32(widen(r, high, params.rShift), widen(g, high, params.gShift));
+		const uint32x4_t ba = vorrq_u32(widen(b, high, params.bShift), widen(a, high, params.aShift));
+		return vorrq_u32(rg, ba);
+	}
+	static inline void store32(byte *dst, Vec r, Vec g, Vec b, Vec a, const YUVToRGBRowParams &params) {
+		vst1q_u8(dst, vreinterpretq_u8_u32(pack32(r, g, b, a, false, params)));
+		vst1q_u8(dst + 16, vreinterpretq_u8_u32(pack32(r, g, b, a, true, params)));
+	}
+};
+
+void convertYUV444RowToRGBNEON(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
+	yuv444RowToRGBSIMD<YUVOpsNEON>(dst, ySrc, uSrc, vSrc, width, params);
+}
+
+void convertYUV420RowsToRGBNEON(byte *dst0, byte *dst1, const byte *ySrc0, const byte *ySrc1, const byte *aSrc0, const byte *aSrc1, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
+	yuv420RowsToRGBSIMD<YUVOpsNEON>(dst0, dst1, ySrc0, ySrc1, aSrc0, aSrc1, uSrc, vSrc, width, params);
+}
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,189 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_YUV_TO_RGB_SIMD_H
+#define GRAPHICS_YUV_TO_RGB_SIMD_H
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+namespace Graphics {
+
+/*
+ * Vectorized versions of the row routines in yuv_to_rgb.cpp, shared by the
+ * SSE2, AVX2 and NEON implementations.
+ *
+ * The scalar code looks every channel up in a table, indexed by the luma
+ * value plus offsets from the chroma tables. Both kinds of tables have a
+ * closed form, which is evaluated here instead:
+ *
+ * - A chroma offset is the chroma value minus 128, multiplied by a constant
+ *   and truncated towards zero. The product is taken of the magnitude with
+ *   a 1.15 fixed point constant, which gives the same result as the double
+ *   precision math of the tables for all 256 values.
+ * - A channel is the luma value plus its offsets, clamped to [0, 255]. For
+ *   the ITU scale it is clamped to [16, 235] instead and then stretched by
+ *   255 / 219, using the reciprocal of 219 in 0.22 fixed point which again
+ *   matches the integer division for every input.
+ *
+ * The output is thus bit-exact. Channels are packed with the losses and
+ * shifts of the pixel format, like PixelFormat::ARGBToColor().
+ *
+ * The instruction set is abstracted by an Ops class, which provides a Vec
+ * type holding Ops::kLanes 16-bit integers.
+ */
+
+enum {
+	kYUVCrToR = 45919, // 0.419 / 0.299
+	kYUVCrToG = 23383, // 0.299 / 0.419
+	kYUVCbToG = 11286, // 0.114 / 0.331
+	kYUVCbToB = 58111, // 0.587 / 0.331
+	kYUVITUScale = 19153
+};
+
+/**
+ * Multiply the signed lanes by a positive 1.15 fixed point constant and
+ * truncate the products towards zero.
+ */
+template<class Ops>
+inline typename Ops::Vec yuvMulTruncSIMD(typename Ops::Vec c, int k) {
+	typedef typename Ops::Vec Vec;
+
+	const Vec sign = Ops::sign(c);
+	const Vec mag = Ops::sub(Ops::bitXor(c, sign), sign);
+	const Vec prod = Ops::mulhiU(Ops::add(mag, mag), Ops::set1(k));
+	return Ops::sub(Ops::bitXor(prod, sign), sign);
+}
+
+/**
+ * Compute the offsets that the chroma values add to the red, green and
+ * blue channels.
+ */
+template<class Ops>
+inline void yuvChromaSIMD(typename Ops::Vec u, typename Ops::Vec v, typename Ops::Vec &dr, typename Ops::Vec &dg, typename Ops::Vec &db) {
+	typedef typename Ops::Vec Vec;
+
+	const Vec cr = Ops::sub(v, Ops::set1(128));
+	const Vec cb = Ops::sub(u, Ops::set1(128));
+	dr = yuvMulTruncSIMD<Ops>(cr, kYUVCrToR);
+	dg = Ops::sub(Ops::set1(0), Ops::add(yuvMulTruncSIMD<Ops>(cr, kYUVCrToG), yuvMulTruncSIMD<Ops>(cb, kYUVCbToG)));
+	db = yuvMulTruncSIMD<Ops>(cb, kYUVCbToB);
+}
+
+template<class Ops, bool kITU>
+inline typename Ops::Vec yuvChannelSIMD(typename Ops::Vec v) {
+	if (kITU) {
+		v = Ops::min(Ops::max(v, Ops::set1(16)), Ops::set1(235));
+		v = Ops::mullo(Ops::sub(v, Ops::set1(16)), Ops::set1(255));
+		return Ops::srl(Ops::mulhiU(v, Ops::set1(kYUVITUScale)), 6);
+	}
+
+	return Ops::min(Ops::max(v, Ops::set1(0)), Ops::set1(255));
+}
+
+template<class Ops, bool kITU, uint kBytesPerPixel>
+inline void yuvPutPixelsSIMD(byte *dst, typename Ops::Vec y, typename Ops::Vec dr, typename Ops::Vec dg, typename Ops::Vec db, typename Ops::Vec a, const YUVToRGBRowParams &params) {
+	typedef typename Ops::Vec Vec;
+
+	const Vec r = Ops::srl(yuvChannelSIMD<Ops, kITU>(Ops::add(y, dr)), params.rLoss);
+	const Vec g = Ops::srl(yuvChannelSIMD<Ops, kITU>(Ops::add(y, dg)), params.gLoss);
+	const Vec b = Ops::srl(yuvChannelSIMD<Ops, kITU>(Ops::add(y, db)), params.bLoss);
+	a = Ops::srl(a, params.aLoss);
+
+	if (kBytesPerPixel == 2) {
+		const Vec rg = Ops::bitOr(Ops::sll(r, params.rShift), Ops::sll(g, params.gShift));
+		const Vec ba = Ops::bitOr(Ops::sll(b, params.bShift), Ops::sll(a, params.aShift));
+		Ops::store16(dst, Ops::bitOr(rg, ba));
+	} else {
+		Ops::store32(dst, r, g, b, a, params);
+	}
+}
+
+template<class Ops, bool kITU, uint kBytesPerPixel>
+void yuv444RowSIMD(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
+	typedef typename Ops::Vec Vec;
+
+	const Vec opaque = Ops::set1(255);
+	int x = 0;
+
+	for (; x + Ops::kLanes <= width; x += Ops::kLanes) {
+		Vec dr, dg, db;
+		yuvChromaSIMD<Ops>(Ops::load(uSrc + x), Ops::load(vSrc + x), dr, dg, db);
+		yuvPutPixelsSIMD<Ops, kITU, kBytesPerPixel>(dst + x * kBytesPerPixel, Ops::load(ySrc + x), dr, dg, db, opaque, params);
+	}
+
+	if (x < width)
+		convertYUV444RowToRGB(dst + x * kBytesPerPixel, ySrc + x, uSrc + x, vSrc + x, width - x, params);
+}
+
+template<class Ops, bool kITU, uint kBytesPerPixel>
+void yuv420RowsSIMD(byte *dst0, byte *dst1, const byte *ySrc0, const byte *ySrc1, const byte *aSrc0, const byte *aSrc1, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
+	typedef typename Ops::Vec Vec;
+
+	const Vec opaque = Ops::set1(255);
+	int x = 0;
+
+	for (; x + Ops::kLanes <= width; x += Ops::kLanes) {
+		Vec dr, dg, db;
+		yuvChromaSIMD<Ops>(Ops::loadHalf(uSrc + x / 2), Ops::loadHalf(vSrc + x / 2), dr, dg, db);
+		yuvPutPixelsSIMD<Ops, kITU, kBytesPerPixel>(dst0 + x * kBytesPerPixel, Ops::load(ySrc0 + x), dr, dg, db, aSrc0 ? Ops::load(aSrc0 + x) : opaque, params);
+		yuvPutPixelsSIMD<Ops, kITU, kBytesPerPixel>(dst1 + x * kBytesPerPixel, Ops::load(ySrc1 + x), dr, dg, db, aSrc1 ? Ops::load(aSrc1 + x) : opaque, params);
+	}
+
+	if (x < width) {
+		convertYUV420RowsToRGB(dst0 + x * kBytesPerPixel, dst1 + x * kBytesPerPixel, ySrc0 + x, ySrc1 + x,
+				aSrc0 ? aSrc0 + x : nullptr, aSrc1 ? aSrc1 + x : nullptr, uSrc + x / 2, vSrc + x / 2, width - x, params);
+	}
+}
+
+template<class Ops>
+void yuv444RowToRGBSIMD(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
+	if (params.bytesPerPixel == 2) {
+		if (params.itu)
+			yuv444RowSIMD<Ops, true, 2>(dst, ySrc, uSrc, vSrc, width, params);
+		else
+			yuv444RowSIMD<Ops, false, 2>(dst, ySrc, uSrc, vSrc, width, params);
+	} else {
+		if (params.itu)
+			yuv444RowSIMD<Ops, true, 4>(dst, ySrc, uSrc, vSrc, width, params);
+		else
+			yuv444RowSIMD<Ops, false, 4>(dst, ySrc, uSrc, vSrc, width, params);
+	}
+}
+
+template<class Ops>
+void yuv420RowsToRGBSIMD(byte *dst0, byte *dst1, const byte *ySrc0, const byte *ySrc1, const byte *aSrc0, const byte *aSrc1, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
+	if (params.bytesPerPixel == 2) {
+		if (params.itu)
+			yuv420RowsSIMD<Ops, true, 2>(dst0, dst1, ySrc0, ySrc1, aSrc0, aSrc1, uSrc, vSrc, width, params);
+		else
+			yuv420RowsSIMD<Ops, false, 2>(dst0, dst1, ySrc0, ySrc1, aSrc0, aSrc1, uSrc, vSrc, width, params);
+	} else {
+		if (params.itu)
+			yuv420RowsSIMD<Ops, true, 4>(dst0, dst1, ySrc0, ySrc1, aSrc0, aSrc1, uSrc, vSrc, width, params);
+		else
+			yuv420RowsSIMD<Ops, false, 4>(dst0, dst1, ySrc0, ySrc1, aSrc0, aSrc1, uSrc, vSrc, width, params);
+	}
+}
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,84 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/endian.h"
+#include "graphics/yuv_to_rgb_simd.h"
+
+#ifdef SCUMMVM_SSE2
+
+#include <emmintrin.h>
+
+namespace Graphics {
+
+struct YUVOpsSSE2 {
+	typedef __m128i Vec;
+	enum { kLanes = 8 };
+
+	static inline Vec load(const byte *p) {
+		return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)p), _mm_setzero_si128());
+	}
+	static inline Vec loadHalf(const byte *p) {
+		const __m128i v = _mm_cvtsi32_si128(READ_UINT32(p));
+		return _mm_unpacklo_epi8(_mm_unpacklo_epi8(v, v), _mm_setzero_si128());
+	}
+	static inline Vec set1(int v) { return _mm_set1_epi16((int16)v); }
+
+	static inline Vec add(Vec a, Vec b) { return _mm_add_epi16(a, b); }
+	static inline Vec sub(Vec a, Vec b) { return _mm_sub_epi16(a, b); }
+	static inline Vec min(Vec a, Vec b) { return _mm_min_epi16(a, b); }
+	static inline Vec max(Vec a, Vec b) { return _mm_max_epi16(a, b); }
+	static inline Vec mullo(Vec a, Vec b) { return _mm_mullo_epi16(a, b); }
+	static inline Vec mulhiU(Vec a, Vec b) { return _mm_mulhi_epu16(a, b); }
+	static inline Vec sign(Vec a) { return _mm_srai_epi16(a, 15); }
+	static inline Vec bitXor(Vec a, Vec b) { return _mm_xor_si128(a, b); }
+	static inline Vec bitOr(Vec a, Vec b) { return _mm_or_si128(a, b); }
+	static inline Vec srl(Vec a, int n) { return _mm_srl_epi16(a, _mm_cvtsi32_si128(n)); }
+	static inline Vec sll(Vec a, int n) { return _mm_sll_epi16(a, _mm_cvtsi32_si128(n)); }
+
+	static inline void store16(byte *dst, Vec v) { _mm_storeu_si128((__m128i *)dst, v); }
+
+	static inline __m128i widen(Vec v, bool high, int shift) {
+		const __m128i w = high ? _mm_unpackhi_epi16(v, _mm_setzero_si128()) : _mm_unpacklo_epi16(v, _mm_setzero_si128());
+		return _mm_sll_epi32(w, _mm_cvtsi32_si128(shift));
+	}
+	static inline __m128i pack32(Vec r, Vec g, Vec b, Vec a, bool high, const YUVToRGBRowParams &params) {
+		const __m128i rg = _mm_or_si128(widen(r, high, params.rShift), widen(g, high, params.gShift));
+		const __m128i ba = _mm_or_si128(widen(b, high, params.bShift), widen(a, high, params.aShift));
+		return _mm_or_si128(rg, ba);
+	}
+	static inline void store32(byte *dst, Vec r, Vec g, Vec b, Vec a, const YUVToRGBRowParams &params) {
+		_mm_storeu_si128((__m128i *)dst, pack32(r, g, b, a, false, params));
+		_mm_storeu_si128((__m128i *)(dst + 16), pack32(r, g, b, a, true, params));
+	}
+};
+
+void convertYUV444RowToRGBSSE2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
+	yuv444RowToRGBSIMD<YUVOpsSSE2>(dst, ySrc, uSrc, vSrc, width, params);
+}
+
+void convertYUV420RowsToRGBSSE2(byte *dst0, byte *dst1, const byte *ySrc0, const byte *ySrc1, const byte *aSrc0, const byte *aSrc1, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBRowParams &params) {
+	yuv420RowsToRGBSIMD<YUVOpsSSE2>(dst0, dst1, ySrc0, ySrc1, aSrc0, aSrc1, uSrc, vSrc, width, params);
+}
+
+} // End of namespace Graphics
+
+#endif
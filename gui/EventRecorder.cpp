@@ -30,7 +30,9 @@ DECLARE_SINGLETON(GUI::EventRecorder);
 }
 
 #include "common/debug-channels.h"
+#ifdef SDL_BACKEND
 #include "backends/timer/sdl/sdl-timer.h"
+#endif
 #include "backends/mixer/mixer.h"
 #include "common/config-manager.h"
 #include "common/md5.h"
@@ -420,7 +422,12 @@ void EventRecorder::registerTimerManager(DefaultTimerManager *timerManager) {
 void EventRecorder::switchTimerManagers() {
 	delete _timerManager;
 	if (_recordMode == kPassthrough) {
+#ifdef SDL_BACKEND
 		_timerManager = new SdlTimerManager();
+#else
+		// Backends without a timer thread poll the timers themselves
+		_timerManager = new DefaultTimerManager();
+#endif
 	} else {
 		_timerManager = new DefaultTimerManager();
 	}
@@ -609,10 +616,12 @@ void EventRecorder::setFileHeader() {
 	_playbackFile->getHeader().name = _name;
 }
 
+#ifdef SDL_BACKEND
 SDL_Surface *EventRecorder::getSurface(int width, int height) {
 	// Create a RGB565 surface of the requested dimensions.
 	return SDL_CreateRGBSurface(SDL_SWSURFACE, width, height, 16, 0xF800, 0x07E0, 0x001F, 0x0000);
 }
+#endif
 
 bool EventRecorder::switchMode() {
 	const Plugin *plugin = EngineMan.findPlugin(ConfMan.get("engineid"));
@@ -39,7 +39,11 @@
 #include "backends/mixer/mixer.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#ifdef SDL_BACKEND
 #include "backends/timer/sdl/sdl-timer.h"
+#else
+#include "backends/timer/default/default-timer.h"
+#endif
 #include "common/config-manager.h"
 #include "common/recorderfile.h"
 #include "backends/saves/recorder/recorder-saves.h"
@@ -79,6 +83,8 @@ public:
 
 	void init(Common::String recordFileName, RecordMode mode);
 	void deinit();
+	/** Return the current operation mode */
+	RecordMode getRecordMode() const { return _recordMode; }
 	bool processDelayMillis();
 	uint32 getRandomSeed(const Common::String &name);
 	void processMillis(uint32 &millis, bool skipRecord);
@@ -164,7 +170,9 @@ public:
 	Common::String generateRecordFileName(const Common::String &target);
 
 	Common::SaveFileManager *getSaveManager(Common::SaveFileManager *realSaveManager);
+#ifdef SDL_BACKEND
 	SDL_Surface *getSurface(int width, int height);
+#endif
 	void RegisterEventSource();
 
 	/** Retrieve game screenshot and compute its checksum for comparison */
@@ -25,6 +25,8 @@
 
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/file.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #ifndef DISABLE_MD5
@@ -77,6 +79,7 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+	registerCmd("profile",			WRAP_METHOD(Debugger, cmdProfile));
 }
 
 Debugger::~Debugger() {
@@ -780,6 +783,34 @@ bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdProfile(int argc, const char **argv) {
+	if (argc < 2) {
+		debugPrintf("profile [on | off | reset | dump <filename>]\n");
+		debugPrintf("Profiler is %s, %u zones recorded\n", Common::Profiler::isEnabled() ? "on" : "off", Common::Profiler::getZoneCount());
+	} else if (!scumm_stricmp(argv[1], "on")) {
+		Common::Profiler::setEnabled(true);
+		debugPrintf("Enabled the profiler\n");
+	} else if (!scumm_stricmp(argv[1], "off")) {
+		Common::Profiler::setEnabled(false);
+		debugPrintf("Disabled the profiler\n");
+	} else if (!scumm_stricmp(argv[1], "reset")) {
+		Common::Profiler::reset();
+		debugPrintf("Discarded all recorded zones\n");
+	} else if (!scumm_stricmp(argv[1], "dump") && argc == 3) {
+		Common::DumpFile out;
+		if (!out.open(argv[2])) {
+			debugPrintf("Failed to open '%s'\n", argv[2]);
+		} else {
+			Common::Profiler::writeTrace(out);
+			out.finalize();
+			debugPrintf("Wrote %u zones to '%s', open it in chrome://tracing\n", Common::Profiler::getZoneCount(), argv[2]);
+		}
+	} else {
+		debugPrintf("profile [on | off | reset | dump <filename>]\n");
+	}
+	return true;
+}
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
@@ -0,0 +1,47 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer_intern.h"
+
+#include "test/system.h"
+
+class MixerTestSuite : public CxxTest::TestSuite
+{
+	enum {
+		kCommandsPerProducer = 1000
+	};
+
+	static int producerProc(void *param) {
+		Audio::MixerImpl *mixer = (Audio::MixerImpl *)param;
+		for (int i = 0; i < kCommandsPerProducer; ++i)
+			mixer->setVolumeForSoundType(Audio::Mixer::kSFXSoundType, i & 0xFF);
+		return 0;
+	}
+
+public:
+	void test_full_ring_two_producers() {
+		TestSystemScope scope;
+
+		for (int round = 0; round < 20; ++round) {
+			// Without a running callback, producers finding the ring full
+			// apply the queued commands themselves
+			Audio::MixerImpl mixer(44100);
+
+			OSystem::ThreadRef producers[2];
+			for (int i = 0; i < 2; ++i)
+				producers[i] = g_system->createThread(producerProc, &mixer);
+
+			if (!producers[0] || !producers[1]) {
+				TS_WARN("No thread support");
+				return;
+			}
+
+			for (int i = 0; i < 2; ++i)
+				g_system->waitThread(producers[i]);
+
+			mixer.processCommands();
+			TS_ASSERT_EQUALS(mixer._commandsPushed, 2 * kCommandsPerProducer);
+			TS_ASSERT_EQUALS(mixer._commandsDone, 2 * kCommandsPerProducer);
+			TS_ASSERT_EQUALS(mixer._queueHead, mixer._queueTail);
+		}
+	}
+};
@@ -0,0 +1,116 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer.h"
+#include "audio/rate_intern.h"
+
+#include "test/cpu.h"
+#include "test/random.h"
+
+class RateTestSuite : public CxxTest::TestSuite
+{
+	enum {
+		kFrames = 1027
+	};
+
+	uint32 _seed;
+
+	int16 nextSample() {
+		const uint32 r = nextRandom(_seed);
+		// Bias towards the extremes to exercise the clamping
+		switch (r & 7) {
+		case 0:
+			return 32767;
+		case 1:
+			return -32768;
+		default:
+			return (int16)(r >> 8);
+		}
+	}
+
+	void fill(int16 *buf, int count) {
+		for (int i = 0; i < count; ++i)
+			buf[i] = nextSample();
+	}
+
+	void checkStereo(Audio::MixStereoProc proc) {
+		static const Audio::st_volume_t volumes[] = { 0, 1, 127, 255, Audio::Mixer::kMaxMixerVolume };
+		int16 in[kFrames * 2], expected[kFrames * 2], actual[kFrames * 2];
+
+		for (int rev = 0; rev < 2; ++rev) {
+			for (int l = 0; l < ARRAYSIZE(volumes); ++l) {
+				for (int r = 0; r < ARRAYSIZE(volumes); ++r) {
+					fill(in, kFrames * 2);
+					fill(expected, kFrames * 2);
+					memcpy(actual, expected, sizeof(actual));
+
+					Audio::mixStereoGeneric(expected, in, kFrames, volumes[l], volumes[r], rev != 0);
+					proc(actual, in, kFrames, volumes[l], volumes[r], rev != 0);
+					TS_ASSERT_SAME_DATA(expected, actual, sizeof(actual));
+				}
+			}
+		}
+	}
+
+	void checkMono(Audio::MixMonoProc proc) {
+		static const Audio::st_volume_t volumes[] = { 0, 1, 127, 255, Audio::Mixer::kMaxMixerVolume };
+		int16 in[kFrames], expected[kFrames * 2], actual[kFrames * 2];
+
+		for (int l = 0; l < ARRAYSIZE(volumes); ++l) {
+			for (int r = 0; r < ARRAYSIZE(volumes); ++r) {
+				fill(in, kFrames);
+				fill(expected, kFrames * 2);
+				memcpy(actual, expected, sizeof(actual));
+
+				Audio::mixMonoGeneric(expected, in, kFrames, volumes[l], volumes[r]);
+				proc(actual, in, kFrames, volumes[l], volumes[r]);
+				TS_ASSERT_SAME_DATA(expected, actual, sizeof(actual));
+			}
+		}
+	}
+
+public:
+	void setUp() {
+		_seed = 0x1234567;
+	}
+
+	void test_generic_clamping() {
+		int16 in[4] = { 32767, -32768, 1000, -1000 };
+		int16 out[4] = { 32000, -32000, 1, -1 };
+
+		Audio::mixStereoGeneric(out, in, 2, Audio::Mixer::kMaxMixerVolume, 128, false);
+		TS_ASSERT_EQUALS(out[0], 32767);
+		TS_ASSERT_EQUALS(out[1], -32768);
+		TS_ASSERT_EQUALS(out[2], 1001);
+		TS_ASSERT_EQUALS(out[3], -501);
+	}
+
+	void test_sse2() {
+#if defined(SCUMMVM_SSE2) && !defined(OUTPUT_UNSIGNED_AUDIO)
+		if (!testCpuFeature(OSystem::kFeatureCpuSSE2))
+			return;
+
+		checkStereo(Audio::mixStereoSSE2);
+		checkMono(Audio::mixMonoSSE2);
+#endif
+	}
+
+	void test_avx2() {
+#if defined(SCUMMVM_AVX2) && !defined(OUTPUT_UNSIGNED_AUDIO)
+		if (!testCpuFeature(OSystem::kFeatureCpuAVX2))
+			return;
+
+		checkStereo(Audio::mixStereoAVX2);
+		checkMono(Audio::mixMonoAVX2);
+#endif
+	}
+
+	void test_neon() {
+#if defined(SCUMMVM_NEON) && !defined(OUTPUT_UNSIGNED_AUDIO)
+		if (!testCpuFeature(OSystem::kFeatureCpuNEON))
+			return;
+
+		checkStereo(Audio::mixStereoNEON);
+		checkMono(Audio::mixMonoNEON);
+#endif
+	}
+};
@@ -0,0 +1,96 @@
+#include "test/bench/bench.h"
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "audio/decoders/adpcm.h"
+#include "audio/decoders/raw.h"
+#include "common/array.h"
+#include "common/memstream.h"
+
+#include "test/random.h"
+
+namespace {
+
+enum {
+	kRate = 22050,
+	kSeconds = 2
+};
+
+// Two seconds of a mono 16-bit sawtooth, stored little endian.
+void makeSamples(Common::Array<byte> &data) {
+	data.resize(kRate * kSeconds * 2);
+	for (uint i = 0; i < data.size() / 2; ++i)
+		WRITE_LE_UINT16(&data[i * 2], (uint16)((i * 731) & 0xFFFF));
+}
+
+// Pseudo random DVI ADPCM nibbles; decoding costs the same for any input.
+void makeADPCM(Common::Array<byte> &data) {
+	uint32 seed = 3;
+	data.resize(kRate * kSeconds / 2);
+	for (uint i = 0; i < data.size(); ++i) {
+		data[i] = nextRandom(seed) >> 16;
+	}
+}
+
+uint32 drain(Audio::AudioStream &stream, int16 *buffer, int size) {
+	uint32 total = 0;
+	int samples;
+	while ((samples = stream.readBuffer(buffer, size)) > 0)
+		total += samples;
+	return total;
+}
+
+} // End of anonymous namespace
+
+BENCHMARK(audio, raw_read_16bit) {
+	Common::Array<byte> data;
+	makeSamples(data);
+	state.setBytesPerIteration(data.size());
+
+	int16 buffer[2048];
+	uint32 sum = 0;
+	while (state.keepRunning()) {
+		Audio::AudioStream *stream = Audio::makeRawStream(data.begin(), data.size(), kRate,
+			Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN, DisposeAfterUse::NO);
+		sum += drain(*stream, buffer, ARRAYSIZE(buffer));
+		delete stream;
+	}
+	Bench::consume(sum);
+}
+
+BENCHMARK(audio, adpcm_dvi_decode) {
+	Common::Array<byte> data;
+	makeADPCM(data);
+	state.setBytesPerIteration(data.size() * 4);
+
+	int16 buffer[2048];
+	uint32 sum = 0;
+	while (state.keepRunning()) {
+		Common::MemoryReadStream *input = new Common::MemoryReadStream(data.begin(), data.size());
+		Audio::AudioStream *stream = Audio::makeADPCMStream(input, DisposeAfterUse::YES, data.size(), Audio::kADPCMDVI, kRate, 1);
+		sum += drain(*stream, buffer, ARRAYSIZE(buffer));
+		delete stream;
+	}
+	Bench::consume(sum);
+}
+
+BENCHMARK(audio, rate_convert_22k_to_44k) {
+	Common::Array<byte> data;
+	makeSamples(data);
+	// Output is 16-bit stereo at twice the input rate
+	state.setBytesPerIteration(data.size() * 4);
+
+	Common::Array<Audio::st_sample_t> output(kRate * kSeconds * 2 * 2);
+	Audio::RateConverter *converter = Audio::makeRateConverter(kRate, kRate * 2, false);
+	uint32 sum = 0;
+	while (state.keepRunning()) {
+		Audio::AudioStream *stream = Audio::makeRawStream(data.begin(), data.size(), kRate,
+			Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN, DisposeAfterUse::NO);
+		sum += converter->flow(*stream, output.begin(), output.size() / 2, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+		delete stream;
+	}
+	Bench::consume(sum);
+
+	delete converter;
+}
@@ -0,0 +1,78 @@
+#ifndef TEST_BENCH_BENCH_H
+#define TEST_BENCH_BENCH_H
+
+#include "common/scummsys.h"
+
+/**
+ * Micro-benchmarks, run with "make bench".
+ *
+ * A benchmark is a function which does its setup, then runs the code to
+ * measure once per iteration of a loop over state.keepRunning(). The runner
+ * calls it repeatedly: first to calibrate the iteration count so that a
+ * batch takes long enough to time reliably, then for warm-up batches which
+ * are discarded, and finally for the batches that are reported.
+ *
+ *	BENCHMARK(common, string_append) {
+ *		Common::String str;
+ *		while (state.keepRunning()) {
+ *			str += 'x';
+ *		}
+ *		Bench::consume(str.size());
+ *	}
+ */
+namespace Bench {
+
+class State {
+public:
+	State(uint32 iterations);
+
+	/**
+	 * Returns true as long as another iteration has to run. The timer
+	 * starts with the first call and stops once it returns false.
+	 */
+	bool keepRunning();
+
+	/** Number of iterations in this batch. */
+	uint32 getIterations() const { return _iterations; }
+
+	/** Amount of data one iteration handles, reported as throughput. */
+	void setBytesPerIteration(uint32 bytes) { _bytesPerIteration = bytes; }
+	uint32 getBytesPerIteration() const { return _bytesPerIteration; }
+
+	/** Time the batch took in nanoseconds. */
+	double getElapsedNanos() const { return _elapsed; }
+
+private:
+	uint32 _iterations;
+	uint32 _remaining;
+	bool _started;
+	double _start;
+	double _elapsed;
+	uint32 _bytesPerIteration;
+};
+
+typedef void (*BenchmarkProc)(State &state);
+
+/**
+ * Adds a benchmark to the runner at static initialization time.
+ * Use the BENCHMARK() macro instead of instantiating this directly.
+ */
+class Registration {
+public:
+	Registration(const char *group, const char *name, BenchmarkProc proc);
+};
+
+/**
+ * Feed a result into a global sink so that the compiler cannot drop the
+ * code computing it.
+ */
+void consume(uint32 value);
+
+} // End of namespace Bench
+
+#define BENCHMARK(group, name) \
+	static void bench_##group##_##name(Bench::State &state); \
+	static Bench::Registration registration_##group##_##name(#group, #name, bench_##group##_##name); \
+	static void bench_##group##_##name(Bench::State &state)
+
+#endif
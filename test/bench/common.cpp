@@ -0,0 +1,290 @@
+#include "test/bench/bench.h"
+
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/flathashmap.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/str.h"
+#include "common/substream.h"
+#include "common/zlib.h"
+#include "test/random.h"
+
+namespace {
+
+void makeIntKeys(Common::Array<int> &keys, uint count) {
+	uint32 seed = 1;
+	for (uint i = 0; i < count; ++i)
+		keys.push_back((int)nextRandom(seed));
+}
+
+void makeStringKeys(Common::Array<Common::String> &keys, uint count) {
+	uint32 seed = 1;
+	for (uint i = 0; i < count; ++i)
+		keys.push_back(Common::String::format("resource.%03d/%u", i % 1000, nextRandom(seed)));
+}
+
+// Compressible data, a mix of runs and text like most game resources
+void makeData(Common::Array<byte> &data, uint size) {
+	uint32 seed = 7;
+	data.resize(size);
+	for (uint i = 0; i < size; ) {
+		uint32 r = nextRandom(seed);
+		uint run = MIN<uint>(1 + (r & 31), size - i);
+		byte value = (r & 0x100) ? 'a' + (r >> 9) % 26 : 0;
+		for (uint j = 0; j < run; ++j, ++i)
+			data[i] = value ? value + (j & 3) : 0;
+	}
+}
+
+// Raw deflate data: the gzip writer's output without its 10 byte header
+// and 8 byte trailer
+void deflateData(const Common::Array<byte> &data, Common::Array<byte> &packed) {
+	Common::MemoryWriteStreamDynamic *out = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+	Common::WriteStream *gzip = Common::wrapCompressedWriteStream(out);
+	gzip->write(data.begin(), data.size());
+	gzip->finalize();
+
+	packed = Common::Array<byte>(out->getData() + 10, out->size() - 18);
+
+	byte *gz = out->getData();
+	delete gzip;
+	free(gz);
+}
+
+template<class Map>
+void benchmarkIntInsert(Bench::State &state) {
+	Common::Array<int> keys;
+	makeIntKeys(keys, 10000);
+
+	while (state.keepRunning()) {
+		Map map;
+		for (uint i = 0; i < keys.size(); ++i)
+			map[keys[i]] = (int)i;
+		Bench::consume(map.size());
+	}
+}
+
+template<class Map>
+void benchmarkIntLookup(Bench::State &state) {
+	Common::Array<int> keys;
+	makeIntKeys(keys, 20000);
+
+	// Every other key is missing from the map
+	Map map;
+	for (uint i = 0; i < keys.size(); i += 2)
+		map[keys[i]] = (int)i;
+
+	uint32 sum = 0;
+	while (state.keepRunning()) {
+		for (uint i = 0; i < keys.size(); ++i)
+			sum += map.getVal(keys[i], 1);
+	}
+	Bench::consume(sum);
+}
+
+template<class Map>
+void benchmarkStringLookup(Bench::State &state) {
+	Common::Array<Common::String> keys;
+	makeStringKeys(keys, 2000);
+
+	Map map;
+	for (uint i = 0; i < keys.size(); ++i)
+		map[keys[i]] = (int)i;
+
+	uint32 sum = 0;
+	while (state.keepRunning()) {
+		for (uint i = 0; i < keys.size(); ++i)
+			sum += map.getVal(keys[i], 1);
+	}
+	Bench::consume(sum);
+}
+
+} // End of anonymous namespace
+
+BENCHMARK(string, append_char) {
+	while (state.keepRunning()) {
+		Common::String str;
+		for (int i = 0; i < 1000; ++i)
+			str += (char)('a' + i % 26);
+		Bench::consume(str.size());
+	}
+}
+
+BENCHMARK(string, format) {
+	uint32 sum = 0;
+	int i = 0;
+	while (state.keepRunning()) {
+		Common::String str = Common::String::format("%s.%03d", "resource", i++ % 1000);
+		sum += str.size();
+	}
+	Bench::consume(sum);
+}
+
+BENCHMARK(string, compare_ignore_case) {
+	Common::Array<Common::String> keys;
+	makeStringKeys(keys, 1000);
+
+	int sum = 0;
+	while (state.keepRunning()) {
+		for (uint i = 1; i < keys.size(); ++i)
+			sum += keys[i].compareToIgnoreCase(keys[i - 1]);
+	}
+	Bench::consume(sum);
+}
+
+BENCHMARK(string, hash_ignore_case) {
+	Common::Array<Common::String> keys;
+	makeStringKeys(keys, 1000);
+
+	Common::IgnoreCase_Hash hash;
+	uint32 sum = 0;
+	while (state.keepRunning()) {
+		for (uint i = 0; i < keys.size(); ++i)
+			sum += hash(keys[i]);
+	}
+	Bench::consume(sum);
+}
+
+BENCHMARK(array, push_back) {
+	while (state.keepRunning()) {
+		Common::Array<int> array;
+		for (int i = 0; i < 10000; ++i)
+			array.push_back(i);
+		Bench::consume(array.size());
+	}
+}
+
+BENCHMARK(array, sort) {
+	Common::Array<int> keys;
+	makeIntKeys(keys, 10000);
+
+	while (state.keepRunning()) {
+		Common::Array<int> array = keys;
+		Common::sort(array.begin(), array.end());
+		Bench::consume(array[0]);
+	}
+}
+
+BENCHMARK(hashmap, int_insert) {
+	benchmarkIntInsert<Common::HashMap<int, int> >(state);
+}
+
+BENCHMARK(hashmap, int_lookup) {
+	benchmarkIntLookup<Common::HashMap<int, int> >(state);
+}
+
+BENCHMARK(hashmap, string_lookup) {
+	benchmarkStringLookup<Common::HashMap<Common::String, int> >(state);
+}
+
+BENCHMARK(flathashmap, int_insert) {
+	benchmarkIntInsert<Common::FlatHashMap<int, int> >(state);
+}
+
+BENCHMARK(flathashmap, int_lookup) {
+	benchmarkIntLookup<Common::FlatHashMap<int, int> >(state);
+}
+
+BENCHMARK(flathashmap, string_lookup) {
+	benchmarkStringLookup<Common::FlatHashMap<Common::String, int> >(state);
+}
+
+BENCHMARK(stream, memory_read_uint32) {
+	Common::Array<byte> data;
+	makeData(data, 64 * 1024);
+	state.setBytesPerIteration(data.size());
+
+	uint32 sum = 0;
+	while (state.keepRunning()) {
+		Common::MemoryReadStream stream(data.begin(), data.size());
+		for (uint i = 0; i < data.size() / 4; ++i)
+			sum += stream.readUint32LE();
+	}
+	Bench::consume(sum);
+}
+
+BENCHMARK(stream, memory_read_block) {
+	Common::Array<byte> data;
+	makeData(data, 64 * 1024);
+	state.setBytesPerIteration(data.size());
+
+	byte buffer[4096];
+	while (state.keepRunning()) {
+		Common::MemoryReadStream stream(data.begin(), data.size());
+		while (stream.read(buffer, sizeof(buffer)) == sizeof(buffer))
+			;
+	}
+	Bench::consume(buffer[0]);
+}
+
+BENCHMARK(stream, subread_uint16) {
+	Common::Array<byte> data;
+	makeData(data, 64 * 1024);
+	state.setBytesPerIteration(data.size() / 2);
+
+	Common::MemoryReadStream parent(data.begin(), data.size());
+	uint32 sum = 0;
+	while (state.keepRunning()) {
+		Common::SeekableSubReadStream stream(&parent, data.size() / 4, data.size() * 3 / 4);
+		for (uint i = 0; i < data.size() / 4; ++i)
+			sum += stream.readUint16BE();
+	}
+	Bench::consume(sum);
+}
+
+BENCHMARK(md5, compute_1mb) {
+	Common::Array<byte> data;
+	makeData(data, 1024 * 1024);
+	state.setBytesPerIteration(data.size());
+
+	uint8 digest[16];
+	while (state.keepRunning()) {
+		Common::MemoryReadStream stream(data.begin(), data.size());
+		Common::computeStreamMD5(stream, digest);
+	}
+	Bench::consume(digest[0]);
+}
+
+#ifdef USE_ZLIB
+
+BENCHMARK(zlib, inflate_headerless_1mb) {
+	Common::Array<byte> data, packed, output;
+	makeData(data, 1024 * 1024);
+	deflateData(data, packed);
+	output.resize(data.size());
+	state.setBytesPerIteration(data.size());
+
+	while (state.keepRunning())
+		Common::inflateZlibHeaderless(output.begin(), output.size(), packed.begin(), packed.size());
+	Bench::consume(output[output.size() - 1]);
+}
+
+BENCHMARK(zlib, gzip_read_stream_1mb) {
+	Common::Array<byte> data;
+	makeData(data, 1024 * 1024);
+	state.setBytesPerIteration(data.size());
+
+	Common::MemoryWriteStreamDynamic *out = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+	Common::WriteStream *gzip = Common::wrapCompressedWriteStream(out);
+	gzip->write(data.begin(), data.size());
+	gzip->finalize();
+	byte *gz = out->getData();
+	uint32 gzSize = out->size();
+	delete gzip;
+
+	byte buffer[4096];
+	while (state.keepRunning()) {
+		Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(new Common::MemoryReadStream(gz, gzSize));
+		while (stream->read(buffer, sizeof(buffer)) == sizeof(buffer))
+			;
+		delete stream;
+	}
+	Bench::consume(buffer[0]);
+
+	free(gz);
+}
+
+#endif
@@ -0,0 +1,44 @@
+#include "test/bench/bench.h"
+
+#include "common/memstream.h"
+#include "graphics/surface.h"
+#include "image/bmp.h"
+
+namespace {
+
+// Encodes a 640x480 true color gradient as a BMP file.
+Common::MemoryWriteStreamDynamic *makeBitmap() {
+	Graphics::Surface surface;
+	surface.create(640, 480, Graphics::PixelFormat(3, 8, 8, 8, 0, 16, 8, 0, 0));
+	for (int y = 0; y < surface.h; ++y) {
+		byte *row = (byte *)surface.getBasePtr(0, y);
+		for (int x = 0; x < surface.w; ++x) {
+			row[x * 3 + 0] = x;
+			row[x * 3 + 1] = y;
+			row[x * 3 + 2] = x ^ y;
+		}
+	}
+
+	Common::MemoryWriteStreamDynamic *out = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+	Image::writeBMP(*out, surface);
+	surface.free();
+	return out;
+}
+
+} // End of anonymous namespace
+
+BENCHMARK(image, bmp_decode_640x480) {
+	Common::MemoryWriteStreamDynamic *bitmap = makeBitmap();
+	state.setBytesPerIteration(bitmap->size());
+
+	uint32 sum = 0;
+	while (state.keepRunning()) {
+		Common::MemoryReadStream stream(bitmap->getData(), bitmap->size());
+		Image::BitmapDecoder decoder;
+		decoder.loadStream(stream);
+		sum += decoder.getSurface()->w;
+	}
+	Bench::consume(sum);
+
+	delete bitmap;
+}
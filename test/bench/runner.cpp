@@ -0,0 +1,247 @@
+// The runner is a standalone program which prints with stdio and reads the
+// clock directly.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/bench/timer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test/bench/bench.h"
+
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/str.h"
+
+namespace Bench {
+
+struct Entry {
+	Common::String name;
+	BenchmarkProc proc;
+
+	bool operator<(const Entry &other) const { return name < other.name; }
+};
+
+static Common::Array<Entry> &getRegistry() {
+	// Function local, so that it exists before the first registration
+	static Common::Array<Entry> registry;
+	return registry;
+}
+
+Registration::Registration(const char *group, const char *name, BenchmarkProc proc) {
+	Entry entry;
+	entry.name = Common::String::format("%s/%s", group, name);
+	entry.proc = proc;
+	getRegistry().push_back(entry);
+}
+
+static volatile uint32 g_sink = 0;
+
+void consume(uint32 value) {
+	g_sink = g_sink + value;
+}
+
+State::State(uint32 iterations) : _iterations(iterations), _remaining(iterations), _started(false),
+	_start(0), _elapsed(0), _bytesPerIteration(0) {
+}
+
+bool State::keepRunning() {
+	if (!_started) {
+		_started = true;
+		_start = benchNanos();
+	}
+
+	if (_remaining == 0) {
+		_elapsed = benchNanos() - _start;
+		return false;
+	}
+
+	--_remaining;
+	return true;
+}
+
+struct Options {
+	const char *filter;
+	const char *jsonFile;
+	uint samples;
+	uint warmup;
+	double minBatchNanos;
+	bool list;
+};
+
+struct Result {
+	Common::String name;
+	uint32 iterations;
+	uint32 bytesPerIteration;
+	double minNanos;
+	double meanNanos;
+	double p50Nanos;
+	double p90Nanos;
+	double p99Nanos;
+};
+
+static double runBatch(BenchmarkProc proc, uint32 iterations, uint32 &bytesPerIteration) {
+	State state(iterations);
+	proc(state);
+	bytesPerIteration = state.getBytesPerIteration();
+	return state.getElapsedNanos();
+}
+
+// Nearest rank percentile of sorted samples
+static double percentile(const Common::Array<double> &sorted, uint p) {
+	uint rank = (p * sorted.size() + 99) / 100;
+	return sorted[MAX<uint>(rank, 1) - 1];
+}
+
+static Result runBenchmark(const Entry &entry, const Options &options) {
+	Result result;
+	result.name = entry.name;
+
+	// Grow the batch until it runs long enough for the clock
+	uint32 iterations = 1;
+	for (;;) {
+		double elapsed = runBatch(entry.proc, iterations, result.bytesPerIteration);
+		if (elapsed >= options.minBatchNanos || iterations >= (1u << 30))
+			break;
+
+		double scale = elapsed > 0 ? options.minBatchNanos * 1.2 / elapsed : 10.0;
+		scale = CLIP(scale, 2.0, 10.0);
+		iterations = (uint32)MIN<double>(iterations * scale, 1u << 30);
+	}
+	result.iterations = iterations;
+
+	for (uint i = 0; i < options.warmup; ++i)
+		runBatch(entry.proc, iterations, result.bytesPerIteration);
+
+	Common::Array<double> samples;
+	double sum = 0;
+	for (uint i = 0; i < options.samples; ++i) {
+		double perIteration = runBatch(entry.proc, iterations, result.bytesPerIteration) / iterations;
+		samples.push_back(perIteration);
+		sum += perIteration;
+	}
+	Common::sort(samples.begin(), samples.end());
+
+	result.minNanos = samples[0];
+	result.meanNanos = sum / samples.size();
+	result.p50Nanos = percentile(samples, 50);
+	result.p90Nanos = percentile(samples, 90);
+	result.p99Nanos = percentile(samples, 99);
+	return result;
+}
+
+static double getMegabytesPerSecond(const Result &result) {
+	if (!result.bytesPerIteration || result.p50Nanos <= 0)
+		return 0;
+	return result.bytesPerIteration / result.p50Nanos * 1e9 / (1024 * 1024);
+}
+
+static void printResult(const Result &result) {
+	printf("%-40s %10u %14.1f %14.1f %14.1f %14.1f", result.name.c_str(), result.iterations,
+	       result.p50Nanos, result.p90Nanos, result.p99Nanos, result.minNanos);
+	if (result.bytesPerIteration)
+		printf(" %10.1f", getMegabytesPerSecond(result));
+	printf("\n");
+	fflush(stdout);
+}
+
+static bool writeJson(const char *fileName, const Common::Array<Result> &results, const Options &options) {
+	FILE *file = fopen(fileName, "w");
+	if (!file)
+		return false;
+
+	fprintf(file, "{\n\t\"samples\": %u,\n\t\"warmup\": %u,\n\t\"benchmarks\": [", options.samples, options.warmup);
+	for (uint i = 0; i < results.size(); ++i) {
+		const Result &result = results[i];
+		fprintf(file, "%s\n\t\t{\"name\": \"%s\", \"iterations\": %u, \"min_ns\": %.2f, \"mean_ns\": %.2f, "
+		        "\"p50_ns\": %.2f, \"p90_ns\": %.2f, \"p99_ns\": %.2f, \"bytes_per_iteration\": %u, \"mb_per_s\": %.2f}",
+		        i ? "," : "", result.name.c_str(), result.iterations, result.minNanos, result.meanNanos,
+		        result.p50Nanos, result.p90Nanos, result.p99Nanos, result.bytesPerIteration, getMegabytesPerSecond(result));
+	}
+	fprintf(file, "\n\t]\n}\n");
+
+	return fclose(file) == 0;
+}
+
+static void printUsage(const char *program) {
+	printf("Usage: %s [options]\n"
+	       "  --list               list the benchmarks and exit\n"
+	       "  --filter=TEXT        only run benchmarks whose name contains TEXT\n"
+	       "  --samples=N          number of timed batches (default 20)\n"
+	       "  --warmup=N           number of discarded batches (default 2)\n"
+	       "  --min-batch-ms=N     minimum duration of a batch (default 10)\n"
+	       "  --json=FILE          also write the results to FILE as JSON\n", program);
+}
+
+static bool parseOptions(int argc, char *argv[], Options &options) {
+	options.filter = nullptr;
+	options.jsonFile = nullptr;
+	options.samples = 20;
+	options.warmup = 2;
+	options.minBatchNanos = 10e6;
+	options.list = false;
+
+	for (int i = 1; i < argc; ++i) {
+		const char *arg = argv[i];
+		if (!strcmp(arg, "--list"))
+			options.list = true;
+		else if (!strncmp(arg, "--filter=", 9))
+			options.filter = arg + 9;
+		else if (!strncmp(arg, "--samples=", 10))
+			options.samples = MAX(atoi(arg + 10), 1);
+		else if (!strncmp(arg, "--warmup=", 9))
+			options.warmup = MAX(atoi(arg + 9), 0);
+		else if (!strncmp(arg, "--min-batch-ms=", 15))
+			options.minBatchNanos = MAX(atof(arg + 15), 0.001) * 1e6;
+		else if (!strncmp(arg, "--json=", 7))
+			options.jsonFile = arg + 7;
+		else
+			return false;
+	}
+	return true;
+}
+
+} // End of namespace Bench
+
+int main(int argc, char *argv[]) {
+	Bench::Options options;
+	if (!Bench::parseOptions(argc, argv, options)) {
+		Bench::printUsage(argv[0]);
+		return 1;
+	}
+
+	Common::Array<Bench::Entry> &registry = Bench::getRegistry();
+	Common::sort(registry.begin(), registry.end());
+
+	if (options.filter) {
+		for (uint i = 0; i < registry.size(); ) {
+			if (strstr(registry[i].name.c_str(), options.filter))
+				++i;
+			else
+				registry.remove_at(i);
+		}
+	}
+
+	if (options.list) {
+		for (uint i = 0; i < registry.size(); ++i)
+			printf("%s\n", registry[i].name.c_str());
+		return 0;
+	}
+
+	printf("%-40s %10s %14s %14s %14s %14s %10s\n", "Benchmark", "Iterations",
+	       "p50 ns/iter", "p90 ns/iter", "p99 ns/iter", "min ns/iter", "MB/s");
+
+	Common::Array<Bench::Result> results;
+	for (uint i = 0; i < registry.size(); ++i) {
+		results.push_back(Bench::runBenchmark(registry[i], options));
+		Bench::printResult(results.back());
+	}
+
+	if (options.jsonFile && !Bench::writeJson(options.jsonFile, results, options)) {
+		fprintf(stderr, "Could not write %s\n", options.jsonFile);
+		return 1;
+	}
+
+	return 0;
+}
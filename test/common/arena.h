@@ -0,0 +1,107 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/arena.h"
+
+class ArenaTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_alignment() {
+		Common::Arena arena(1024);
+
+		for (int i = 0; i < 100; ++i) {
+			byte *c = (byte *)arena.allocate(1, 1);
+			*c = 0xFF;
+			size_t align = (size_t)1 << (i % 5);
+			void *ptr = arena.allocate(3, align);
+			TS_ASSERT_EQUALS((size_t)ptr & (align - 1), 0u);
+		}
+
+		void *large = arena.allocate(4000, 64);
+		TS_ASSERT_EQUALS((size_t)large & 63, 0u);
+		memset(large, 0, 4000);
+		TS_ASSERT_EQUALS(arena.getStats().largeAllocations, 1u);
+	}
+
+	void test_allocations_are_distinct() {
+		Common::Arena arena(256);
+		uint32 *ptrs[200];
+
+		for (uint32 i = 0; i < 200; ++i) {
+			ptrs[i] = arena.allocateArray<uint32>(3);
+			ptrs[i][0] = ptrs[i][1] = ptrs[i][2] = i;
+		}
+		for (uint32 i = 0; i < 200; ++i)
+			TS_ASSERT(ptrs[i][0] == i && ptrs[i][1] == i && ptrs[i][2] == i);
+
+		TS_ASSERT(arena.getStats().blocks > 1);
+		TS_ASSERT_EQUALS(arena.getStats().allocations, 200u);
+	}
+
+	void test_reset_reuses_blocks() {
+		Common::Arena arena(1024);
+
+		void *first = arena.allocate(100);
+		for (int i = 0; i < 50; ++i)
+			arena.allocate(100);
+		uint32 blocks = arena.getStats().blocks;
+		size_t peak = arena.getStats().peakBytesUsed;
+		TS_ASSERT(peak >= 51 * 100);
+
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.getStats().bytesUsed, 0u);
+		TS_ASSERT_EQUALS(arena.allocate(100), first);
+		for (int i = 0; i < 50; ++i)
+			arena.allocate(100);
+		TS_ASSERT_EQUALS(arena.getStats().blocks, blocks);
+		TS_ASSERT_EQUALS(arena.getStats().peakBytesUsed, peak);
+
+		arena.reset();
+		arena.freeUnusedBlocks();
+		TS_ASSERT_EQUALS(arena.getStats().blocks, 0u);
+		TS_ASSERT_EQUALS(arena.getStats().bytesReserved, 0u);
+	}
+
+	void test_scope() {
+		Common::Arena arena(512);
+		char *kept = arena.copyString("kept");
+		size_t used = arena.getStats().bytesUsed;
+
+		void *inner;
+		{
+			Common::Arena::Scope scope(arena);
+			inner = arena.allocate(16);
+			for (int i = 0; i < 40; ++i)
+				arena.allocate(24);
+			arena.allocate(1000);
+			TS_ASSERT(arena.getStats().bytesUsed > used);
+		}
+
+		TS_ASSERT_EQUALS(arena.getStats().bytesUsed, used);
+		TS_ASSERT_EQUALS(arena.getStats().bytesReserved, arena.getStats().blocks * 512);
+		TS_ASSERT_EQUALS(arena.allocate(16), inner);
+		TS_ASSERT_EQUALS(strcmp(kept, "kept"), 0);
+	}
+
+	void test_arena_array() {
+		Common::Arena arena;
+		Common::ArenaArray<int> array(arena);
+		TS_ASSERT(array.empty());
+
+		for (int i = 0; i < 1000; ++i)
+			array.push_back(i * 3);
+		TS_ASSERT_EQUALS(array.size(), 1000u);
+		TS_ASSERT(array.capacity() >= 1000u);
+
+		int sum = 0;
+		for (Common::ArenaArray<int>::const_iterator i = array.begin(); i != array.end(); ++i)
+			sum += *i;
+		TS_ASSERT_EQUALS(sum, 3 * 999 * 1000 / 2);
+		TS_ASSERT_EQUALS(array.back(), 2997);
+
+		array.pop_back();
+		array.resize(10);
+		TS_ASSERT_EQUALS(array[9], 27);
+		array.clear();
+		TS_ASSERT(array.empty());
+	}
+};
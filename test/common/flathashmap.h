@@ -0,0 +1,199 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/flathashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/str.h"
+#include "test/random.h"
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		Common::FlatHashMap<Common::String, Common::String> container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "baz";
+		TS_ASSERT_EQUALS(container2["foo"], "baz");
+	}
+
+	void test_contains() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(container.contains(0));
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.contains(17));
+		TS_ASSERT(!container.contains(-1));
+
+		Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("foo"));
+		TS_ASSERT(container2.contains("QUUX"));
+		TS_ASSERT(!container2.contains("bar"));
+		TS_ASSERT(!container2.contains("asdf"));
+	}
+
+	void test_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT_EQUALS(container[1], 42);
+		container.erase(container.find(0));
+		container.erase(container.find(1));
+		TS_ASSERT(!container.empty());
+		container.erase(2);
+		TS_ASSERT(container.empty());
+		container.erase(2);
+		TS_ASSERT(container.empty());
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+
+		// We take a const ref now to ensure that the map
+		// is not modified by getVal.
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef.getVal(0), 17);
+		TS_ASSERT_EQUALS(containerRef.getVal(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getVal(0, -10), 17);
+		TS_ASSERT_EQUALS(containerRef.getVal(17, -10), -10);
+		TS_ASSERT_EQUALS(containerRef[1], -1);
+
+		int out = 0;
+		TS_ASSERT(containerRef.tryGetVal(1, out));
+		TS_ASSERT_EQUALS(out, -1);
+		TS_ASSERT(!containerRef.tryGetVal(2, out));
+		TS_ASSERT_EQUALS(container.size(), 2u);
+	}
+
+	void test_iterator() {
+		Common::FlatHashMap<int, int> container;
+
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		container.erase(1);
+		container[1] = 42;
+		container.erase(0);
+		container.erase(1);
+
+		int found = 0;
+		Common::FlatHashMap<int, int>::iterator i;
+		for (i = container.begin(); i != container.end(); ++i) {
+			int key = i->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT(!(found & (1 << key)));
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4);
+
+		found = 0;
+		Common::FlatHashMap<int, int>::const_iterator j;
+		for (j = container.begin(); j != container.end(); ++j) {
+			int key = j->_key;
+			TS_ASSERT(!(found & (1 << key)));
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4);
+	}
+
+	void test_copy() {
+		Common::FlatHashMap<Common::String, int> map1;
+		for (int i = 0; i < 100; ++i)
+			map1[Common::String::format("key%d", i)] = i;
+		map1.erase("key50");
+
+		Common::FlatHashMap<Common::String, int> map2(map1), map3;
+		map3["other"] = 1;
+		map3 = map1;
+		map1.clear();
+
+		TS_ASSERT_EQUALS(map2.size(), 99u);
+		TS_ASSERT_EQUALS(map3.size(), 99u);
+		TS_ASSERT(!map3.contains("other"));
+		TS_ASSERT(!map2.contains("key50"));
+		for (int i = 0; i < 100; ++i) {
+			if (i == 50)
+				continue;
+			const Common::String key = Common::String::format("key%d", i);
+			TS_ASSERT_EQUALS(map2.getVal(key, -1), i);
+			TS_ASSERT_EQUALS(map3.getVal(key, -1), i);
+		}
+	}
+
+	void test_collision() {
+		// Keys which are equal in their low bits end up in the same
+		// group and have to be told apart by their control bytes.
+		Common::FlatHashMap<int, int> h;
+		for (int i = 0; i < 64; ++i)
+			h[i << 16] = i;
+		for (int i = 0; i < 64; i += 2)
+			h.erase(i << 16);
+		for (int i = 0; i < 64; ++i)
+			TS_ASSERT_EQUALS(h.contains(i << 16), (i & 1) != 0);
+		TS_ASSERT_EQUALS(h.size(), 32u);
+	}
+
+	void test_against_hashmap() {
+		// Run the same random inserts and erases on both maps, which
+		// exercises growing and reusing deleted slots.
+		Common::FlatHashMap<int, int> flat;
+		Common::HashMap<int, int> reference;
+		uint32 seed = 1;
+
+		for (int i = 0; i < 20000; ++i) {
+			const int key = nextRandom(seed) % 2000;
+			if (nextRandom(seed) % 3 == 0) {
+				flat.erase(key);
+				reference.erase(key);
+			} else {
+				flat[key] = i;
+				reference[key] = i;
+			}
+		}
+
+		TS_ASSERT_EQUALS(flat.size(), reference.size());
+		for (int key = 0; key < 2000; ++key) {
+			TS_ASSERT_EQUALS(flat.contains(key), reference.contains(key));
+			TS_ASSERT_EQUALS(flat.getVal(key, -1), reference.getVal(key, -1));
+		}
+
+		uint count = 0;
+		for (Common::FlatHashMap<int, int>::const_iterator i = flat.begin(); i != flat.end(); ++i, ++count)
+			TS_ASSERT_EQUALS(i->_value, reference[i->_key]);
+		TS_ASSERT_EQUALS(count, flat.size());
+
+		flat.reserve(5000);
+		TS_ASSERT_EQUALS(flat.size(), reference.size());
+		for (int key = 0; key < 2000; ++key)
+			TS_ASSERT_EQUALS(flat.getVal(key, -1), reference.getVal(key, -1));
+	}
+};
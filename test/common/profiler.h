@@ -0,0 +1,74 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/profiler.h"
+#include "common/str.h"
+
+class ProfilerTestSuite : public CxxTest::TestSuite
+{
+	static Common::String trace() {
+		Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
+		Common::Profiler::writeTrace(stream);
+		return Common::String((const char *)stream.getData(), stream.size());
+	}
+
+	public:
+	void tearDown() {
+		Common::Profiler::setEnabled(false);
+		Common::Profiler::reset();
+	}
+
+	void test_disabled() {
+		Common::Profiler::reset();
+		{
+			PROFILE_ZONE("disabled");
+		}
+		TS_ASSERT_EQUALS(Common::Profiler::getZoneCount(), 0u);
+		TS_ASSERT(!trace().contains("disabled"));
+	}
+
+	void test_nested_zones() {
+		Common::Profiler::reset();
+		Common::Profiler::setEnabled(true);
+		{
+			PROFILE_ZONE("outer");
+			PROFILE_ZONE("inner");
+		}
+		Common::Profiler::setEnabled(false);
+		{
+			PROFILE_ZONE("after");
+		}
+
+		TS_ASSERT_EQUALS(Common::Profiler::getZoneCount(), 2u);
+		Common::String json = trace();
+		TS_ASSERT(json.hasPrefix("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+		TS_ASSERT(json.hasSuffix("]}\n"));
+		TS_ASSERT(json.contains("{\"name\":\"outer\",\"ph\":\"X\""));
+		TS_ASSERT(json.contains("{\"name\":\"inner\",\"ph\":\"X\""));
+		TS_ASSERT(json.contains("\"thread_name\""));
+		TS_ASSERT(!json.contains("after"));
+
+		Common::Profiler::reset();
+		TS_ASSERT_EQUALS(Common::Profiler::getZoneCount(), 0u);
+	}
+
+	void test_ring_buffer() {
+		Common::Profiler::reset();
+		Common::Profiler::setEnabled(true);
+		Common::Profiler::addZone("old", 1, 2);
+		for (uint i = 0; i < Common::Profiler::kEventsPerThread; ++i)
+			Common::Profiler::addZone("new", 10 + i, 11 + i);
+
+		// The oldest zone has been overwritten, time stamps start at it
+		TS_ASSERT_EQUALS(Common::Profiler::getZoneCount(), Common::Profiler::kEventsPerThread);
+		Common::String json = trace();
+		TS_ASSERT(!json.contains("old"));
+		TS_ASSERT(json.contains("\"ts\":0.000,\"dur\":0.001}"));
+	}
+
+	void test_monotonic() {
+		uint64 first = Common::Profiler::getNanos();
+		uint64 second = Common::Profiler::getNanos();
+		TS_ASSERT_LESS_THAN_EQUALS(first, second);
+	}
+};
@@ -0,0 +1,184 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/memstream.h"
+#include "common/readahead.h"
+#include "common/substream.h"
+#include "common/mutex.h"
+
+#include "../system.h"
+#include "test/random.h"
+
+class ReadAheadTestSuite : public CxxTest::TestSuite
+{
+	// Counts the reads reaching the wrapped stream.
+	class CountingStream : public Common::MemoryReadStream {
+	public:
+		CountingStream(const byte *data, uint32 size) : Common::MemoryReadStream(data, size), reads(0) {}
+
+		uint32 read(void *dataPtr, uint32 dataSize) override {
+			++reads;
+			return Common::MemoryReadStream::read(dataPtr, dataSize);
+		}
+
+		uint reads;
+	};
+
+	// Blocks every read until it is released, so a load stays in progress.
+	class BlockingStream : public Common::MemoryReadStream {
+	public:
+		BlockingStream(const byte *data, uint32 size) : Common::MemoryReadStream(data, size), reads(0) {}
+
+		uint32 read(void *dataPtr, uint32 dataSize) override {
+			++reads;
+			started.post();
+			release.wait();
+			return Common::MemoryReadStream::read(dataPtr, dataSize);
+		}
+
+		Common::Semaphore started;
+		Common::Semaphore release;
+		uint reads;
+	};
+
+	struct Deleter {
+		Common::SeekableReadStream *stream;
+		volatile bool done;
+	};
+
+	static int deleteStream(void *param) {
+		Deleter *deleter = (Deleter *)param;
+		delete deleter->stream;
+		deleter->done = true;
+		return 0;
+	}
+
+	static void fillData(Common::Array<byte> &data, uint32 size) {
+		uint32 seed = 1;
+		data.resize(size);
+		for (uint32 i = 0; i < size; ++i)
+			data[i] = (nextRandom(seed) >> 8) & 0xFF;
+	}
+
+	public:
+	void test_sequential() {
+		Common::Array<byte> data;
+		fillData(data, 200000);
+		CountingStream *parent = new CountingStream(data.begin(), data.size());
+		Common::SeekableReadStream *stream = Common::wrapReadAheadStream(parent, 64 * 1024, DisposeAfterUse::YES);
+		TS_ASSERT_EQUALS(stream->size(), 200000);
+
+		Common::Array<byte> out(data.size());
+		uint32 pos = 0;
+		uint32 len = 1;
+		while (pos < data.size()) {
+			uint32 n = stream->read(out.begin() + pos, MIN<uint32>(len, data.size() - pos));
+			TS_ASSERT(n > 0);
+			pos += n;
+			len = len * 3 + 1;
+			if (len > 50000)
+				len = 7;
+		}
+		TS_ASSERT(!stream->eos());
+		TS_ASSERT(memcmp(out.begin(), data.begin(), data.size()) == 0);
+
+		// The parent is only read in whole chunks
+		TS_ASSERT_EQUALS(parent->reads, (200000u + 32767) / 32768);
+
+		byte b;
+		TS_ASSERT_EQUALS(stream->read(&b, 1), 0u);
+		TS_ASSERT(stream->eos());
+		TS_ASSERT(!stream->err());
+		delete stream;
+	}
+
+	void test_seek() {
+		Common::Array<byte> data;
+		fillData(data, 100000);
+		Common::SeekableReadStream *stream = Common::wrapReadAheadStream(new Common::MemoryReadStream(data.begin(), data.size()), 32 * 1024, DisposeAfterUse::YES);
+
+		const uint32 offsets[] = { 99990, 5, 32760, 70000, 0, 65535, 40000 };
+		for (uint i = 0; i < ARRAYSIZE(offsets); ++i) {
+			byte buf[100];
+			TS_ASSERT(stream->seek(offsets[i]));
+			uint32 n = stream->read(buf, sizeof(buf));
+			TS_ASSERT_EQUALS(n, MIN<uint32>(sizeof(buf), data.size() - offsets[i]));
+			TS_ASSERT(memcmp(buf, data.begin() + offsets[i], n) == 0);
+			TS_ASSERT_EQUALS(stream->pos(), (int32)(offsets[i] + n));
+		}
+
+		TS_ASSERT(stream->seek(-10, SEEK_END));
+		TS_ASSERT_EQUALS(stream->pos(), 99990);
+		TS_ASSERT(stream->seek(-90, SEEK_CUR));
+		TS_ASSERT_EQUALS(stream->pos(), 99900);
+		TS_ASSERT(!stream->seek(100001));
+		TS_ASSERT(!stream->seek(-1));
+		delete stream;
+	}
+
+	void test_prefetch_hint() {
+		Common::Array<byte> data;
+		fillData(data, 100000);
+		Common::SeekableReadStream *stream = Common::wrapReadAheadStream(new Common::MemoryReadStream(data.begin(), data.size()), 0, DisposeAfterUse::YES);
+
+		// Hints never change what is read, also through substreams
+		stream->prefetch(50000, 40000);
+		stream->prefetch(-5, 10);
+		stream->prefetch(99999, 100);
+		Common::SeekableSubReadStream sub(stream, 1000, 91000);
+		sub.prefetch(0, 200000);
+
+		byte buf[64];
+		TS_ASSERT(sub.seek(60000));
+		TS_ASSERT_EQUALS(sub.read(buf, sizeof(buf)), sizeof(buf));
+		TS_ASSERT(memcmp(buf, data.begin() + 61000, sizeof(buf)) == 0);
+		delete stream;
+	}
+
+	void test_cancel_while_reading() {
+#ifdef POSIX
+		TestSystemScope scope;
+		Common::setDefaultReadAheadSize(0);
+
+		Common::Array<byte> data;
+		fillData(data, 200000);
+		BlockingStream parent(data.begin(), data.size());
+		Deleter deleter = { Common::wrapReadAheadStream(&parent, 64 * 1024, DisposeAfterUse::NO), false };
+
+		// The I/O thread blocks in the first load, the second one stays queued
+		deleter.stream->prefetch(3 * 32768, 1);
+		deleter.stream->prefetch(5 * 32768, 1);
+		TS_ASSERT(parent.started.wait(5000));
+
+		// Deleting the stream drops the queued load and waits for the other
+		OSystem::ThreadRef thread = g_system->createThread(deleteStream, &deleter);
+		TS_ASSERT(thread);
+		g_system->delayMillis(50);
+		TS_ASSERT(!deleter.done);
+
+		parent.release.post();
+		g_system->waitThread(thread);
+		TS_ASSERT(deleter.done);
+		TS_ASSERT_EQUALS(parent.reads, 1u);
+
+		Common::shutdownReadAhead();
+#endif
+	}
+
+	void test_default_size() {
+		byte small[16] = { 0 };
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream(small, sizeof(small));
+		TS_ASSERT_EQUALS(Common::getDefaultReadAheadSize(), 0u);
+		TS_ASSERT_EQUALS(Common::wrapDefaultReadAheadStream(stream), stream);
+
+		Common::setDefaultReadAheadSize(9);
+		TS_ASSERT_EQUALS(Common::wrapDefaultReadAheadStream(stream), stream);
+		Common::setDefaultReadAheadSize(8);
+		Common::SeekableReadStream *wrapped = Common::wrapDefaultReadAheadStream(stream);
+		TS_ASSERT_DIFFERS(wrapped, stream);
+		Common::setDefaultReadAheadSize(0);
+
+		TS_ASSERT_EQUALS(wrapped->size(), 16);
+		delete wrapped;
+	}
+};
@@ -0,0 +1,54 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/simd.h"
+
+#include "../system.h"
+
+class SimdTestSuite : public CxxTest::TestSuite
+{
+	// Claims the CPU features given to the constructor.
+	class FeatureSystem : public TestSystem {
+	public:
+		FeatureSystem(bool sse2, bool avx2, bool neon) : _sse2(sse2), _avx2(avx2), _neon(neon) {}
+
+		bool hasFeature(Feature f) override {
+			return (f == kFeatureCpuSSE2 && _sse2) || (f == kFeatureCpuAVX2 && _avx2) || (f == kFeatureCpuNEON && _neon);
+		}
+
+	private:
+		bool _sse2, _avx2, _neon;
+	};
+
+	static void detect(bool sse2, bool avx2, bool neon) {
+		FeatureSystem features(sse2, avx2, neon);
+		OSystem *previous = g_system;
+		g_system = &features;
+		Common::initSimdFeatures();
+		g_system = previous;
+	}
+
+	public:
+	void test_select() {
+		const int generic = 0, neon = 1, sse2 = 2, avx2 = 3;
+
+		// Nothing is detected before the backend is initialized
+		TS_ASSERT(!Common::hasSimdFeature(OSystem::kFeatureCpuSSE2));
+		TS_ASSERT_EQUALS(Common::selectSimdProcs(generic, &neon, &sse2, &avx2), generic);
+
+		detect(true, true, false);
+		TS_ASSERT(Common::hasSimdFeature(OSystem::kFeatureCpuAVX2));
+		TS_ASSERT(!Common::hasSimdFeature(OSystem::kFeatureCpuNEON));
+		TS_ASSERT_EQUALS(Common::selectSimdProcs(generic, &neon, &sse2, &avx2), avx2);
+
+		// Variants which are not built are skipped
+		TS_ASSERT_EQUALS(Common::selectSimdProcs(generic, &neon, &sse2, (const int *)nullptr), sse2);
+		TS_ASSERT_EQUALS(Common::selectSimdProcs(generic, &neon, (const int *)nullptr, (const int *)nullptr), generic);
+
+		detect(false, false, true);
+		TS_ASSERT_EQUALS(Common::selectSimdProcs(generic, &neon, &sse2, &avx2), neon);
+
+		// Leave the other suites with the scalar code
+		detect(false, false, false);
+		TS_ASSERT_EQUALS(Common::selectSimdProcs(generic, &neon, &sse2, &avx2), generic);
+	}
+};
@@ -0,0 +1,51 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/str-pool.h"
+
+class StringPoolTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_intern() {
+		Common::StringPool pool;
+		Common::String name("sprite");
+
+		const char *first = pool.intern(name);
+		TS_ASSERT(first != name.c_str());
+		TS_ASSERT_EQUALS(Common::String(first), "sprite");
+
+		// Equal contents give the same pointer, whatever they came from
+		TS_ASSERT_EQUALS(pool.intern("sprite"), first);
+		TS_ASSERT_EQUALS(pool.intern(Common::StringView("sprites", 6)), first);
+		TS_ASSERT(pool.intern("Sprite") != first);
+		TS_ASSERT_EQUALS(pool.size(), 2u);
+
+		TS_ASSERT_EQUALS(pool.find("sprite"), first);
+		TS_ASSERT(pool.find("castMember") == nullptr);
+
+		TS_ASSERT_EQUALS(Common::String(pool.intern("")), "");
+	}
+
+	void test_many() {
+		Common::StringPool pool;
+		Common::Array<const char *> interned;
+
+		// Spread over several blocks, with a long string in between
+		for (int i = 0; i < 2000; ++i)
+			interned.push_back(pool.intern(Common::String::format("identifier%d", i)));
+		Common::String longString('x');
+		for (int i = 0; i < 12; ++i)
+			longString += longString;
+		const char *longCopy = pool.intern(longString);
+
+		TS_ASSERT_EQUALS(pool.size(), 2001u);
+		for (int i = 0; i < 2000; ++i) {
+			TS_ASSERT_EQUALS(Common::String(interned[i]), Common::String::format("identifier%d", i));
+			TS_ASSERT_EQUALS(pool.intern(Common::String::format("identifier%d", i)), interned[i]);
+		}
+		TS_ASSERT_EQUALS(Common::String(longCopy), longString);
+
+		pool.clear();
+		TS_ASSERT_EQUALS(pool.size(), 0u);
+		TS_ASSERT(pool.find("identifier0") == nullptr);
+	}
+};
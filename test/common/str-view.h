@@ -0,0 +1,118 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/str-view.h"
+#include "common/tokenizer.h"
+
+class StringViewTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_basics() {
+		Common::StringView empty;
+		TS_ASSERT(empty.empty());
+		TS_ASSERT_EQUALS(empty.size(), 0u);
+		TS_ASSERT_EQUALS(empty.firstChar(), 0);
+
+		const char *text = "Hello, world";
+		Common::StringView view(text);
+		TS_ASSERT_EQUALS(view.size(), 12u);
+		TS_ASSERT_EQUALS(view.data(), text);
+		TS_ASSERT_EQUALS(view[4], 'o');
+		TS_ASSERT_EQUALS(view.lastChar(), 'd');
+
+		Common::StringView word = view.substr(7);
+		TS_ASSERT(word == "world");
+		TS_ASSERT_EQUALS(word.data(), text + 7);
+		TS_ASSERT(view.substr(0, 5) == "Hello");
+		TS_ASSERT(view.substr(20).empty());
+		TS_ASSERT(view.substr(10, 100) == "ld");
+	}
+
+	void test_compare() {
+		Common::StringView view("Hello, world", 5);
+		TS_ASSERT(view == "Hello");
+		TS_ASSERT(view != "Hello, world");
+		TS_ASSERT(view.equalsIgnoreCase("hELLO"));
+		TS_ASSERT(!view.equalsIgnoreCase("hELL"));
+		TS_ASSERT(view.compareTo("Help") < 0);
+		TS_ASSERT(view.compareTo("Hell") > 0);
+		TS_ASSERT_EQUALS(view.compareToIgnoreCase("HELLO"), 0);
+
+		TS_ASSERT(view.hasPrefix("He"));
+		TS_ASSERT(view.hasSuffix("llo"));
+		TS_ASSERT(!view.hasSuffix("world"));
+		TS_ASSERT(view.hasPrefixIgnoreCase("hE"));
+		TS_ASSERT(view.hasSuffixIgnoreCase("LO"));
+
+		TS_ASSERT_EQUALS(view.find('l'), 2u);
+		TS_ASSERT_EQUALS(view.find('l', 3), 3u);
+		TS_ASSERT_EQUALS(view.find(','), Common::StringView::npos);
+		TS_ASSERT_EQUALS(view.find("lo"), 3u);
+		TS_ASSERT(!view.contains("world"));
+
+		TS_ASSERT(Common::StringView(" \tword \n").trim() == "word");
+		TS_ASSERT(Common::StringView("   ").trim().empty());
+	}
+
+	void test_string_interop() {
+		Common::String str("Hello, world");
+		Common::StringView view(str);
+		TS_ASSERT(view == str);
+		TS_ASSERT(str == view);
+
+		Common::String copy(view.substr(7));
+		TS_ASSERT_EQUALS(copy, "world");
+
+		str += Common::StringView("!!!", 1);
+		TS_ASSERT_EQUALS(str, "Hello, world!");
+
+		// Appending a view of the string itself
+		str += Common::StringView(str).substr(0, 5);
+		TS_ASSERT_EQUALS(str, "Hello, world!Hello");
+	}
+
+	void test_hash() {
+		const char *strings[] = { "", "a", "Hello", "\xE4\xF6\xFC" };
+		for (uint i = 0; i < ARRAYSIZE(strings); ++i) {
+			Common::String str(strings[i]);
+			Common::StringView view(str);
+			TS_ASSERT_EQUALS(view.hash(), str.hash());
+			TS_ASSERT_EQUALS(Common::IgnoreCase_Hash()(view), Common::IgnoreCase_Hash()(str));
+		}
+		TS_ASSERT_EQUALS(Common::IgnoreCase_Hash()(Common::StringView("KEY.bin")), Common::IgnoreCase_Hash()(Common::String("key.BIN")));
+	}
+
+	void test_hashmap_lookup() {
+		Common::HashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> map;
+		map["music_volume"] = 192;
+		map["subtitles"] = 1;
+
+		Common::StringView key("SUBTITLES=true", 9);
+		TS_ASSERT(map.containsAs(key));
+		TS_ASSERT_EQUALS(map.getValAs(key), 1);
+		TS_ASSERT_EQUALS(map.findAs(key)->_value, 1);
+		TS_ASSERT(map.findAs(Common::StringView("subtitle")) == map.end());
+		TS_ASSERT_EQUALS(map.getValAs(Common::StringView("missing")), 0);
+
+		int val = 0;
+		TS_ASSERT(map.tryGetValAs(Common::StringView("Music_Volume"), val));
+		TS_ASSERT_EQUALS(val, 192);
+		TS_ASSERT(!map.tryGetValAs(Common::StringView("music"), val));
+
+		Common::HashMap<Common::String, int, Common::CaseSensitiveString_Hash, Common::CaseSensitiveString_EqualTo> caseSensitive;
+		caseSensitive["Lingo"] = 3;
+		TS_ASSERT(caseSensitive.containsAs(Common::StringView("Lingo")));
+		TS_ASSERT(!caseSensitive.containsAs(Common::StringView("lingo")));
+	}
+
+	void test_tokenizer_view() {
+		Common::String text("  set  the volume ");
+		Common::StringTokenizer tokenizer(text);
+		TS_ASSERT(tokenizer.nextTokenView() == "set");
+		TS_ASSERT(tokenizer.nextTokenView() == "the");
+		TS_ASSERT_EQUALS(tokenizer.nextToken(), "volume");
+		TS_ASSERT(tokenizer.empty());
+		TS_ASSERT(tokenizer.nextTokenView().empty());
+	}
+};
@@ -0,0 +1,206 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/array.h"
+#include "common/memstream.h"
+#include "common/unzip.h"
+#include "common/zlib.h"
+
+#include "test/random.h"
+
+class UnzipTestSuite : public CxxTest::TestSuite
+{
+	struct Member {
+		const char *name;
+		bool deflate;
+		Common::Array<byte> data;
+		Common::Array<byte> packed;
+		uint32 crc;
+	};
+
+	// Compressible pseudo random data, spread over many deflate blocks.
+	static void fillData(Common::Array<byte> &data, uint32 size, uint32 seed) {
+		data.resize(size);
+		for (uint32 i = 0; i < size; ++i)
+			data[i] = 'a' + ((nextRandom(seed) >> 8) & 15);
+	}
+
+	// Deflates the member through the gzip writer, whose output is the
+	// raw deflate data framed by a 10 byte header and an 8 byte trailer
+	// holding the CRC.
+	static void packMember(Member &member) {
+		Common::MemoryWriteStreamDynamic *out = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *gzip = Common::wrapCompressedWriteStream(out);
+		gzip->write(member.data.begin(), member.data.size());
+		gzip->finalize();
+
+		const byte *gz = out->getData();
+		uint32 gzSize = out->size();
+		member.crc = READ_LE_UINT32(gz + gzSize - 8);
+		if (member.deflate)
+			member.packed = Common::Array<byte>(gz + 10, gzSize - 18);
+		else
+			member.packed = member.data;
+
+		delete gzip;
+		free(const_cast<byte *>(gz));
+	}
+
+	static Common::SeekableReadStream *buildZip(Common::Array<Member> &members) {
+		Common::MemoryWriteStreamDynamic zip(DisposeAfterUse::NO);
+		Common::MemoryWriteStreamDynamic dir(DisposeAfterUse::YES);
+
+		for (uint i = 0; i < members.size(); ++i) {
+			Member &member = members[i];
+			packMember(member);
+			uint32 nameSize = strlen(member.name);
+			uint32 offset = zip.pos();
+
+			zip.writeUint32LE(0x04034b50);
+			zip.writeUint16LE(20);
+			zip.writeUint16LE(0);
+			zip.writeUint16LE(member.deflate ? 8 : 0);
+			zip.writeUint32LE(0);
+			zip.writeUint32LE(member.crc);
+			zip.writeUint32LE(member.packed.size());
+			zip.writeUint32LE(member.data.size());
+			zip.writeUint16LE(nameSize);
+			zip.writeUint16LE(0);
+			zip.write(member.name, nameSize);
+			zip.write(member.packed.begin(), member.packed.size());
+
+			dir.writeUint32LE(0x02014b50);
+			dir.writeUint16LE(20);
+			dir.writeUint16LE(20);
+			dir.writeUint16LE(0);
+			dir.writeUint16LE(member.deflate ? 8 : 0);
+			dir.writeUint32LE(0);
+			dir.writeUint32LE(member.crc);
+			dir.writeUint32LE(member.packed.size());
+			dir.writeUint32LE(member.data.size());
+			dir.writeUint16LE(nameSize);
+			dir.writeUint16LE(0);
+			dir.writeUint16LE(0);
+			dir.writeUint16LE(0);
+			dir.writeUint16LE(0);
+			dir.writeUint32LE(0);
+			dir.writeUint32LE(offset);
+			dir.write(member.name, nameSize);
+		}
+
+		uint32 dirOffset = zip.pos();
+		zip.write(dir.getData(), dir.size());
+
+		zip.writeUint32LE(0x06054b50);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(members.size());
+		zip.writeUint16LE(members.size());
+		zip.writeUint32LE(dir.size());
+		zip.writeUint32LE(dirOffset);
+		zip.writeUint16LE(0);
+
+		return new Common::MemoryReadStream(zip.getData(), zip.size(), DisposeAfterUse::YES);
+	}
+
+	static void addMember(Common::Array<Member> &members, const char *name, bool deflate, uint32 size) {
+		members.push_back(Member());
+		Member &member = members.back();
+		member.name = name;
+		member.deflate = deflate;
+		fillData(member.data, size, members.size());
+	}
+
+	static Common::Archive *makeTestArchive(Common::Array<Member> &members) {
+		addMember(members, "stored.txt", false, 100000);
+		addMember(members, "small.bin", true, 5000);
+		addMember(members, "large.bin", true, 3 * 1024 * 1024 + 123);
+		return Common::makeZipArchive(buildZip(members));
+	}
+
+	static bool readMatches(Common::SeekableReadStream &stream, const Member &member, uint32 offset, uint32 size) {
+		byte buf[256];
+		assert(size <= sizeof(buf));
+		if (!stream.seek(offset))
+			return false;
+		if (stream.read(buf, size) != size)
+			return false;
+		return memcmp(buf, member.data.begin() + offset, size) == 0 && stream.pos() == (int32)(offset + size);
+	}
+
+	public:
+	void test_members() {
+#ifdef USE_ZLIB
+		Common::Array<Member> members;
+		Common::Archive *archive = makeTestArchive(members);
+		TS_ASSERT(archive);
+
+		TS_ASSERT(archive->hasFile("stored.txt"));
+		TS_ASSERT(archive->hasFile("LARGE.BIN"));
+		TS_ASSERT(!archive->hasFile("missing.bin"));
+
+		Common::ArchiveMemberList list;
+		TS_ASSERT_EQUALS(archive->listMembers(list), 3);
+
+		for (uint i = 0; i < members.size(); ++i) {
+			Common::SeekableReadStream *stream = archive->createReadStreamForMember(members[i].name);
+			TS_ASSERT(stream);
+			TS_ASSERT_EQUALS(stream->size(), (int32)members[i].data.size());
+
+			Common::Array<byte> data(members[i].data.size() + 1);
+			TS_ASSERT_EQUALS(stream->read(data.begin(), data.size()), members[i].data.size());
+			TS_ASSERT(stream->eos());
+			TS_ASSERT(!stream->err());
+			TS_ASSERT(memcmp(data.begin(), members[i].data.begin(), members[i].data.size()) == 0);
+			delete stream;
+		}
+
+		delete archive;
+#endif
+	}
+
+	void test_seek() {
+#ifdef USE_ZLIB
+		Common::Array<Member> members;
+		Common::Archive *archive = makeTestArchive(members);
+
+		for (uint i = 0; i < members.size(); ++i) {
+			const Member &member = members[i];
+			Common::SeekableReadStream *stream = archive->createReadStreamForMember(member.name);
+			uint32 size = member.data.size();
+
+			// Forward, then backward across the checkpoints of the large member
+			TS_ASSERT(readMatches(*stream, member, size / 2, 200));
+			TS_ASSERT(readMatches(*stream, member, size - 100, 100));
+			TS_ASSERT(readMatches(*stream, member, size / 3, 200));
+			TS_ASSERT(readMatches(*stream, member, 0, 200));
+			TS_ASSERT(readMatches(*stream, member, size - 1000, 200));
+			TS_ASSERT(readMatches(*stream, member, size / 2 + 77, 200));
+
+			TS_ASSERT(stream->seek(-10, SEEK_END));
+			TS_ASSERT_EQUALS(stream->pos(), (int32)size - 10);
+			TS_ASSERT(!stream->err());
+			delete stream;
+		}
+
+		delete archive;
+#endif
+	}
+
+	void test_stream_outlives_archive() {
+#ifdef USE_ZLIB
+		Common::Array<Member> members;
+		Common::Archive *archive = makeTestArchive(members);
+		Common::SeekableReadStream *stored = archive->createReadStreamForMember("stored.txt");
+		Common::SeekableReadStream *large = archive->createReadStreamForMember("large.bin");
+		delete archive;
+
+		TS_ASSERT(readMatches(*stored, members[0], 5000, 100));
+		TS_ASSERT(readMatches(*large, members[2], 2000000, 100));
+		TS_ASSERT(readMatches(*stored, members[0], 10, 100));
+
+		delete stored;
+		delete large;
+#endif
+	}
+};
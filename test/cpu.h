@@ -0,0 +1,45 @@
+#ifndef TEST_CPU_H
+#define TEST_CPU_H
+
+#include <cxxtest/TestSuite.h>
+
+#include "common/scummsys.h"
+#include "common/system.h"
+
+/**
+ * Check whether the SIMD code for the kFeatureCpu* feature @p f was built
+ * and the CPU running the tests supports it. Warns about the skipped test
+ * if not.
+ *
+ * The test runner generator does not see preprocessor conditionals, so
+ * the tests of SIMD code exist in every build. Their bodies are compiled
+ * only along with the SIMD code, and they return early when this fails.
+ */
+inline bool testCpuFeature(OSystem::Feature f) {
+	bool supported = false;
+#ifdef SCUMMVM_SSE2
+	// SSE2 is part of the base x86-64 instruction set
+	if (f == OSystem::kFeatureCpuSSE2)
+		supported = true;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (f == OSystem::kFeatureCpuAVX2) {
+#ifdef __GNUC__
+		supported = __builtin_cpu_supports("avx2");
+#else
+		supported = true;
+#endif
+	}
+#endif
+#ifdef SCUMMVM_NEON
+	// NEON is part of the base ARMv8 instruction set
+	if (f == OSystem::kFeatureCpuNEON)
+		supported = true;
+#endif
+
+	if (!supported)
+		TS_WARN("Skipped, the CPU does not support the instructions under test");
+	return supported;
+}
+
+#endif
@@ -0,0 +1,163 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/rect.h"
+#include "graphics/dirty_region.h"
+#include "test/random.h"
+
+class DirtyRegionTestSuite : public CxxTest::TestSuite
+{
+	enum {
+		kWidth = 64,
+		kHeight = 48
+	};
+
+	static Common::Rect randomRect(uint32 &seed) {
+		int16 x = nextRandom(seed) % kWidth;
+		int16 y = nextRandom(seed) % kHeight;
+		int16 w = 1 + nextRandom(seed) % 20;
+		int16 h = 1 + nextRandom(seed) % 12;
+		return Common::Rect(x, y, MIN<int16>(x + w, kWidth), MIN<int16>(y + h, kHeight));
+	}
+
+	static void paint(byte *bitmap, const Common::Rect &r) {
+		for (int y = r.top; y < r.bottom; ++y)
+			for (int x = r.left; x < r.right; ++x)
+				bitmap[y * kWidth + x] = 1;
+	}
+
+	// Counts how often every pixel is covered, returns false on overlaps.
+	static bool cover(byte *bitmap, const Common::Array<Common::Rect> &rects) {
+		memset(bitmap, 0, kWidth * kHeight);
+		for (uint i = 0; i < rects.size(); ++i) {
+			for (int y = rects[i].top; y < rects[i].bottom; ++y) {
+				for (int x = rects[i].left; x < rects[i].right; ++x) {
+					if (bitmap[y * kWidth + x])
+						return false;
+					bitmap[y * kWidth + x] = 1;
+				}
+			}
+		}
+		return true;
+	}
+
+	static bool isBanded(const Common::Array<Common::Rect> &rects) {
+		for (uint i = 1; i < rects.size(); ++i) {
+			const Common::Rect &prev = rects[i - 1];
+			const Common::Rect &cur = rects[i];
+			if (cur.top == prev.top) {
+				if (cur.bottom != prev.bottom || cur.left <= prev.right)
+					return false;
+			} else if (cur.top < prev.bottom) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	public:
+	void test_empty() {
+		Graphics::DirtyRegion region;
+		TS_ASSERT(region.isEmpty());
+
+		region.add(Common::Rect(5, 5, 5, 10));
+		TS_ASSERT(region.isEmpty());
+		TS_ASSERT(region.getBounds().isEmpty());
+		TS_ASSERT(!region.intersects(Common::Rect(0, 0, 10, 10)));
+	}
+
+	void test_overlap_is_split() {
+		Graphics::DirtyRegion region;
+		region.add(Common::Rect(0, 0, 10, 10));
+		region.add(Common::Rect(5, 5, 15, 15));
+
+		// Top band, the widened middle band and the bottom band
+		const Common::Array<Common::Rect> &rects = region.getRects();
+		TS_ASSERT_EQUALS(rects.size(), 3u);
+		TS_ASSERT(rects[0] == Common::Rect(0, 0, 10, 5));
+		TS_ASSERT(rects[1] == Common::Rect(0, 5, 15, 10));
+		TS_ASSERT(rects[2] == Common::Rect(5, 10, 15, 15));
+		TS_ASSERT_EQUALS(region.getArea(), 175u);
+		TS_ASSERT(region.getBounds() == Common::Rect(0, 0, 15, 15));
+
+		TS_ASSERT(region.contains(12, 7));
+		TS_ASSERT(!region.contains(12, 2));
+		TS_ASSERT(region.intersects(Common::Rect(14, 14, 20, 20)));
+		TS_ASSERT(!region.intersects(Common::Rect(10, 0, 20, 5)));
+	}
+
+	void test_adjacent_bands_coalesce() {
+		Graphics::DirtyRegion region;
+		region.add(Common::Rect(0, 0, 10, 5));
+		region.add(Common::Rect(0, 5, 10, 10));
+		region.add(Common::Rect(10, 0, 20, 10));
+		region.add(Common::Rect(2, 2, 8, 8));
+
+		TS_ASSERT_EQUALS(region.getRects().size(), 1u);
+		TS_ASSERT(region.getRects()[0] == Common::Rect(0, 0, 20, 10));
+	}
+
+	void test_random_matches_bitmap() {
+		uint32 seed = 1;
+		byte expected[kWidth * kHeight];
+		byte actual[kWidth * kHeight];
+
+		for (int run = 0; run < 50; ++run) {
+			Graphics::DirtyRegion region;
+			memset(expected, 0, sizeof(expected));
+
+			const int count = 1 + nextRandom(seed) % 40;
+			for (int i = 0; i < count; ++i) {
+				Common::Rect r = randomRect(seed);
+				region.add(r);
+				paint(expected, r);
+			}
+
+			TS_ASSERT(isBanded(region.getRects()));
+			TS_ASSERT(cover(actual, region.getRects()));
+			TS_ASSERT(memcmp(expected, actual, sizeof(expected)) == 0);
+
+			// Update rects are disjoint and cover the region, never
+			// costing more than the banded rects
+			Common::Array<Common::Rect> update;
+			region.getUpdateRects(update, 64);
+			TS_ASSERT(cover(actual, update));
+			TS_ASSERT(update.size() <= region.getRects().size());
+			for (int i = 0; i < kWidth * kHeight; ++i)
+				TS_ASSERT(actual[i] >= expected[i]);
+
+			uint32 cost = 0;
+			for (uint i = 0; i < update.size(); ++i)
+				cost += update[i].width() * update[i].height() + 64;
+			TS_ASSERT(cost <= region.getArea() + 64 * region.getRects().size());
+		}
+	}
+
+	void test_update_rect_cost() {
+		Graphics::DirtyRegion region;
+		region.add(Common::Rect(0, 0, 4, 4));
+		region.add(Common::Rect(6, 0, 10, 4));
+
+		// The gap costs 8 pixels
+		Common::Array<Common::Rect> update;
+		region.getUpdateRects(update, 7);
+		TS_ASSERT_EQUALS(update.size(), 2u);
+
+		region.getUpdateRects(update, 8);
+		TS_ASSERT_EQUALS(update.size(), 1u);
+		TS_ASSERT(update[0] == Common::Rect(0, 0, 10, 4));
+	}
+
+	void test_clip() {
+		Graphics::DirtyRegion region;
+		region.add(Common::Rect(-10, -10, 10, 10));
+		region.add(Common::Rect(20, 20, 30, 30));
+		region.clip(Common::Rect(0, 0, 25, 25));
+
+		TS_ASSERT_EQUALS(region.getRects().size(), 2u);
+		TS_ASSERT_EQUALS(region.getArea(), 125u);
+
+		region.translate(5, 5);
+		TS_ASSERT(region.getBounds() == Common::Rect(5, 5, 30, 30));
+	}
+};
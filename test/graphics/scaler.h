@@ -0,0 +1,143 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "graphics/scaler.h"
+#include "graphics/scaler/simd_intern.h"
+#include "test/cpu.h"
+#include "test/random.h"
+
+class ScalerTestSuite : public CxxTest::TestSuite
+{
+#ifdef USE_SCALERS
+	enum {
+		// A multiple of every vector width, plus a few columns for the C code
+		kWidth = 69,
+		kHeight = 12,
+		kBorder = 2,
+		kSrcPitch = (kWidth + 2 * kBorder) * 2,
+		kMaxScale = 3
+	};
+
+	// Mostly a handful of colors, so that the scalers find edges and
+	// patterns, with some noise for the interpolations.
+	static void fillImage(Common::Array<uint16> &src, uint32 seed, bool rgb565) {
+		uint16 palette[4];
+		for (int i = 0; i < 4; ++i)
+			palette[i] = nextRandom(seed) * 2 + (nextRandom(seed) & 1);
+
+		src.resize((kHeight + 2 * kBorder) * kSrcPitch / 2);
+		for (uint i = 0; i < src.size(); ++i) {
+			const uint32 r = nextRandom(seed);
+			uint16 color = (r & 7) ? palette[r & 3] : (uint16)(nextRandom(seed) * 2 + (r >> 14));
+			src[i] = rgb565 ? color : (color & 0x7FFF);
+		}
+	}
+
+	static const uint8 *origin(const Common::Array<uint16> &src) {
+		return (const uint8 *)&src[kBorder * kSrcPitch / 2 + kBorder];
+	}
+
+	// Compares the columns a vectorized scaler claims to have done with
+	// the output of the C scaler, which is used as there is no backend.
+	static void checkColumns(ScalerProc *reference, ScalerColumnsProc proc, int scale, int lanes) {
+		const uint32 dstPitch = kWidth * scale * 2;
+		Common::Array<uint16> src;
+		Common::Array<uint16> expected(kWidth * kHeight * scale * scale);
+		Common::Array<uint16> actual(kWidth * kHeight * scale * scale);
+
+		for (int format = 0; format < 2; ++format) {
+			const bool rgb565 = (format == 0);
+			InitScalers(rgb565 ? 565 : 555);
+
+			for (uint32 seed = 1; seed <= 8; ++seed) {
+				fillImage(src, seed, rgb565);
+				reference(origin(src), kSrcPitch, (uint8 *)expected.begin(), dstPitch, kWidth, kHeight);
+
+				memset(actual.begin(), 0, actual.size() * 2);
+				const int columns = proc(origin(src), kSrcPitch, (uint8 *)actual.begin(), dstPitch, kWidth, kHeight, rgb565);
+				TS_ASSERT_EQUALS(columns, kWidth - kWidth % lanes);
+
+				for (int y = 0; y < kHeight * scale; ++y) {
+					const uint16 *e = &expected[y * kWidth * scale];
+					const uint16 *a = &actual[y * kWidth * scale];
+					TS_ASSERT(memcmp(e, a, columns * scale * 2) == 0);
+				}
+			}
+		}
+	}
+
+	static void checkPatterns(HQxPatternProc proc) {
+		uint32 seed = 7;
+		uint16 pixels[3][kHQxPatternChunk + 2];
+		uint32 yuv[3][kHQxPatternChunk + 2];
+		uint8 expected[kHQxPatternChunk];
+		uint8 actual[kHQxPatternChunk];
+
+		for (int run = 0; run < 20; ++run) {
+			// Channels close to the thresholds of diffYUV()
+			const int base = 0x806060;
+			for (int r = 0; r < 3; ++r) {
+				for (int i = 0; i < kHQxPatternChunk + 2; ++i) {
+					pixels[r][i] = nextRandom(seed) & 3;
+					const int y = (int)(nextRandom(seed) % 121) - 60;
+					const int u = (int)(nextRandom(seed) % 19) - 9;
+					const int v = (int)(nextRandom(seed) % 17) - 8;
+					yuv[r][i] = base + (y << 16) + (u << 8) + v;
+				}
+			}
+
+			const int width = kHQxPatternChunk - run;
+			hqxPattern(expected, &pixels[1][1], kHQxPatternChunk + 2, yuv[0], yuv[1], yuv[2], width);
+			proc(actual, &pixels[1][1], kHQxPatternChunk + 2, yuv[0], yuv[1], yuv[2], width);
+			TS_ASSERT(memcmp(expected, actual, width) == 0);
+		}
+	}
+
+	static void checkAll(ScalerColumnsProc advMame2x, ScalerColumnsProc advMame3x, ScalerColumnsProc sai, ScalerColumnsProc superSai, ScalerColumnsProc superEagle, HQxPatternProc hqx, int lanes) {
+		checkColumns(AdvMame2x, advMame2x, 2, lanes);
+		checkColumns(AdvMame3x, advMame3x, 3, lanes);
+		checkColumns(_2xSaI, sai, 2, lanes);
+		checkColumns(Super2xSaI, superSai, 2, lanes);
+		checkColumns(SuperEagle, superEagle, 2, lanes);
+		checkPatterns(hqx);
+	}
+#endif
+
+	public:
+	void test_scalar_procs() {
+#ifdef USE_SCALERS
+		// Without a backend no CPU features are detected, the C code does all the work
+		const ScalerProcs &procs = getScalerProcs();
+		TS_ASSERT(!procs.advMame2x);
+		TS_ASSERT(!procs._2xSaI);
+		TS_ASSERT_EQUALS(procs.hqxPattern, hqxPattern);
+#endif
+	}
+
+	void test_sse2() {
+#if defined(USE_SCALERS) && defined(SCUMMVM_SSE2) && defined(SCUMM_LITTLE_ENDIAN)
+		if (!testCpuFeature(OSystem::kFeatureCpuSSE2))
+			return;
+
+		checkAll(advMame2xSSE2, advMame3xSSE2, _2xSaISSE2, super2xSaISSE2, superEagleSSE2, hqxPatternSSE2, 8);
+#endif
+	}
+
+	void test_avx2() {
+#if defined(USE_SCALERS) && defined(SCUMMVM_AVX2) && defined(SCUMM_LITTLE_ENDIAN)
+		if (!testCpuFeature(OSystem::kFeatureCpuAVX2))
+			return;
+
+		checkAll(advMame2xAVX2, advMame3xAVX2, _2xSaIAVX2, super2xSaIAVX2, superEagleAVX2, hqxPatternAVX2, 16);
+#endif
+	}
+
+	void test_neon() {
+#if defined(USE_SCALERS) && defined(SCUMMVM_NEON) && defined(SCUMM_LITTLE_ENDIAN)
+		if (!testCpuFeature(OSystem::kFeatureCpuNEON))
+			return;
+
+		checkAll(advMame2xNEON, advMame3xNEON, _2xSaINEON, super2xSaINEON, superEagleNEON, hqxPatternNEON, 8);
+#endif
+	}
+};
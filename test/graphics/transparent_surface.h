@@ -0,0 +1,174 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/util.h"
+#include "graphics/transparent_surface_intern.h"
+
+#include "test/cpu.h"
+#include "test/random.h"
+
+class TransparentSurfaceTestSuite : public CxxTest::TestSuite
+{
+	enum {
+		kMaxWidth = 37,
+		kHeight = 3,
+		kPitch = (kMaxWidth + 2) * 4,
+		// Like the scalar routine, the opaque blit copies flipped rows
+		// front to back and thus reads past them, hence the extra row
+		kSourceSize = kMaxWidth * (kHeight + 1) * 4
+	};
+
+	uint32 _seed;
+
+	byte nextByte() {
+		return (byte)(nextRandom(_seed) >> 8);
+	}
+
+	// Bias towards fully transparent and fully opaque pixels, which take
+	// separate paths in the scalar code
+	byte nextAlpha() {
+		switch (nextByte() & 3) {
+		case 0:
+			return 0;
+		case 1:
+			return 255;
+		default:
+			return nextByte();
+		}
+	}
+
+	void fill(byte *buf, int count) {
+		for (int i = 0; i < count; i += 4) {
+			buf[i] = nextAlpha();
+			buf[i + 1] = nextByte();
+			buf[i + 2] = nextByte();
+			buf[i + 3] = nextByte();
+		}
+	}
+
+	/**
+	 * Compute the source pointer and steps for a (possibly flipped)
+	 * blit of a width x kHeight sprite, the same way TransparentSurface
+	 * sets them up.
+	 */
+	static byte *setupSource(byte *src, uint32 width, bool flipH, bool flipV, int32 &inStep, int32 &inoStep) {
+		inStep = 4;
+		inoStep = width * 4;
+		if (flipH) {
+			src += (width - 1) * 4;
+			inStep = -inStep;
+		}
+		if (flipV) {
+			src += (kHeight - 1) * width * 4;
+			inoStep = -inoStep;
+		}
+		return src;
+	}
+
+	void checkFast(Graphics::BlitFastProc proc, Graphics::BlitFastProc generic) {
+		static const uint32 widths[] = { 1, 3, 4, 7, 8, 9, 16, kMaxWidth };
+		byte src[kSourceSize];
+		byte expected[kPitch * kHeight], actual[kPitch * kHeight];
+
+		for (int w = 0; w < ARRAYSIZE(widths); ++w) {
+			for (int flip = 0; flip < 4; ++flip) {
+				int32 inStep, inoStep;
+				fill(src, sizeof(src));
+				fill(expected, sizeof(expected));
+				memcpy(actual, expected, sizeof(actual));
+
+				byte *ino = setupSource(src, widths[w], (flip & 1) != 0, (flip & 2) != 0, inStep, inoStep);
+				generic(ino, expected, widths[w], kHeight, kPitch, inStep, inoStep);
+				proc(ino, actual, widths[w], kHeight, kPitch, inStep, inoStep);
+				TS_ASSERT_SAME_DATA(expected, actual, sizeof(actual));
+			}
+		}
+	}
+
+	void checkBlend(Graphics::BlitBlendProc proc, Graphics::BlitBlendProc generic) {
+		static const uint32 widths[] = { 1, 3, 4, 7, 8, 9, 16, kMaxWidth };
+		// Full color, random colors, and colors where only some channels
+		// are 255, which the scalar code treats specially
+		uint32 colors[] = { 0xFFFFFFFF, 0x80FFFFFF, 0xFF00FF7F, 0x40FF10FF, 0xFF123456, 0x00FFFFFF, 0 };
+		colors[ARRAYSIZE(colors) - 1] = (nextByte() << 24) | (nextByte() << 16) | (nextByte() << 8) | nextByte();
+		byte src[kSourceSize];
+		byte expected[kPitch * kHeight], actual[kPitch * kHeight];
+
+		for (int c = 0; c < ARRAYSIZE(colors); ++c) {
+			for (int w = 0; w < ARRAYSIZE(widths); ++w) {
+				for (int flip = 0; flip < 4; ++flip) {
+					int32 inStep, inoStep;
+					fill(src, sizeof(src));
+					fill(expected, sizeof(expected));
+					memcpy(actual, expected, sizeof(actual));
+
+					byte *ino = setupSource(src, widths[w], (flip & 1) != 0, (flip & 2) != 0, inStep, inoStep);
+					generic(ino, expected, widths[w], kHeight, kPitch, inStep, inoStep, colors[c]);
+					proc(ino, actual, widths[w], kHeight, kPitch, inStep, inoStep, colors[c]);
+					TS_ASSERT_SAME_DATA(expected, actual, sizeof(actual));
+				}
+			}
+		}
+	}
+
+public:
+	void setUp() {
+		_seed = 0x7654321;
+	}
+
+	void test_generic_subtractive() {
+		// A = 255, B = 200, G = 100, R = 255 on little endian. The red
+		// product exceeds the range of int.
+		byte in[4] = { 255, 200, 100, 255 };
+		byte out[4] = { 0, 255, 255, 255 };
+
+#ifdef SCUMM_LITTLE_ENDIAN
+		Graphics::doBlitSubtractiveBlend(in, out, 1, 1, 4, 4, 4, 0xFFFEFFFF);
+		TS_ASSERT_EQUALS(out[0], 255);
+		TS_ASSERT_EQUALS(out[1], 57);
+		TS_ASSERT_EQUALS(out[2], 156);
+		TS_ASSERT_EQUALS(out[3], 4);
+#endif
+	}
+
+	void test_sse2() {
+#if defined(SCUMMVM_SSE2) && defined(SCUMM_LITTLE_ENDIAN)
+		if (!testCpuFeature(OSystem::kFeatureCpuSSE2))
+			return;
+
+		checkFast(Graphics::doBlitOpaqueFastSSE2, Graphics::doBlitOpaqueFast);
+		checkFast(Graphics::doBlitBinaryFastSSE2, Graphics::doBlitBinaryFast);
+		checkBlend(Graphics::doBlitAlphaBlendSSE2, Graphics::doBlitAlphaBlend);
+		checkBlend(Graphics::doBlitAdditiveBlendSSE2, Graphics::doBlitAdditiveBlend);
+		checkBlend(Graphics::doBlitSubtractiveBlendSSE2, Graphics::doBlitSubtractiveBlend);
+		checkBlend(Graphics::doBlitMultiplyBlendSSE2, Graphics::doBlitMultiplyBlend);
+#endif
+	}
+
+	void test_avx2() {
+#if defined(SCUMMVM_AVX2) && defined(SCUMM_LITTLE_ENDIAN)
+		if (!testCpuFeature(OSystem::kFeatureCpuAVX2))
+			return;
+
+		checkFast(Graphics::doBlitOpaqueFastAVX2, Graphics::doBlitOpaqueFast);
+		checkFast(Graphics::doBlitBinaryFastAVX2, Graphics::doBlitBinaryFast);
+		checkBlend(Graphics::doBlitAlphaBlendAVX2, Graphics::doBlitAlphaBlend);
+		checkBlend(Graphics::doBlitAdditiveBlendAVX2, Graphics::doBlitAdditiveBlend);
+		checkBlend(Graphics::doBlitSubtractiveBlendAVX2, Graphics::doBlitSubtractiveBlend);
+		checkBlend(Graphics::doBlitMultiplyBlendAVX2, Graphics::doBlitMultiplyBlend);
+#endif
+	}
+
+	void test_neon() {
+#if defined(SCUMMVM_NEON) && defined(SCUMM_LITTLE_ENDIAN)
+		if (!testCpuFeature(OSystem::kFeatureCpuNEON))
+			return;
+
+		checkFast(Graphics::doBlitOpaqueFastNEON, Graphics::doBlitOpaqueFast);
+		checkFast(Graphics::doBlitBinaryFastNEON, Graphics::doBlitBinaryFast);
+		checkBlend(Graphics::doBlitAlphaBlendNEON, Graphics::doBlitAlphaBlend);
+		checkBlend(Graphics::doBlitAdditiveBlendNEON, Graphics::doBlitAdditiveBlend);
+		checkBlend(Graphics::doBlitSubtractiveBlendNEON, Graphics::doBlitSubtractiveBlend);
+		checkBlend(Graphics::doBlitMultiplyBlendNEON, Graphics::doBlitMultiplyBlend);
+#endif
+	}
+};
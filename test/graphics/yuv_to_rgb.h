@@ -0,0 +1,205 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "graphics/pixelformat.h"
+#include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include "test/cpu.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite
+{
+	enum {
+		// Every u value appears in a row and every v value in a column
+		kSize = 256,
+		kFormats = 4
+	};
+
+	static Graphics::PixelFormat getFormat(int index) {
+		switch (index) {
+		case 0:
+			return Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		case 1:
+			return Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0);
+		case 2:
+			return Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		default:
+			return Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15);
+		}
+	}
+
+	// The vectorized routines only fall back to the lookup tables for the
+	// last few pixels of a row, which the tests never have.
+	static void initParams(Graphics::YUVToRGBRowParams &params, const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		memset(&params, 0, sizeof(params));
+		params.bytesPerPixel = format.bytesPerPixel;
+		params.itu = scale == Graphics::YUVToRGBManager::kScaleITU;
+		params.rLoss = format.rLoss;
+		params.gLoss = format.gLoss;
+		params.bLoss = format.bLoss;
+		params.aLoss = format.aLoss;
+		params.rShift = format.rShift;
+		params.gShift = format.gShift;
+		params.bShift = format.bShift;
+		params.aShift = format.aShift;
+	}
+
+	struct Planes {
+		Common::Array<byte> y, u, v, a;
+
+		explicit Planes(byte lumaBase) : y(kSize * kSize), u(kSize * kSize), v(kSize * kSize), a(kSize * kSize) {
+			for (int row = 0; row < kSize; ++row) {
+				for (int col = 0; col < kSize; ++col) {
+					y[row * kSize + col] = lumaBase + row * 7 + col * 13;
+					u[row * kSize + col] = col;
+					v[row * kSize + col] = row;
+					a[row * kSize + col] = row ^ col;
+				}
+			}
+		}
+	};
+
+	/**
+	 * Compare the given 444 row routine with the scalar conversion, for
+	 * every combination of u and v with a spread of y values.
+	 */
+	void check444(Graphics::YUVToRGBRow444Proc row444) {
+		for (int f = 0; f < kFormats; ++f) {
+			const Graphics::PixelFormat format = getFormat(f);
+			const int pitch = kSize * format.bytesPerPixel;
+			Common::Array<byte> expected(pitch * kSize), actual(pitch * kSize);
+
+			for (int s = 0; s < 2; ++s) {
+				const Graphics::YUVToRGBManager::LuminanceScale scale = s ? Graphics::YUVToRGBManager::kScaleITU : Graphics::YUVToRGBManager::kScaleFull;
+				Graphics::YUVToRGBRowParams params;
+				initParams(params, format, scale);
+
+				for (int lumaBase = 0; lumaBase < 256; lumaBase += 5) {
+					Planes planes(lumaBase);
+					YUVToRGBMan.convert444(expected.begin(), pitch, format, scale, planes.y.begin(), planes.u.begin(), planes.v.begin(), kSize, kSize, kSize, kSize);
+
+					for (int row = 0; row < kSize; ++row) {
+						const int offset = row * kSize;
+						row444(actual.begin() + row * pitch, planes.y.begin() + offset, planes.u.begin() + offset, planes.v.begin() + offset, kSize, params);
+					}
+
+					TS_ASSERT(memcmp(expected.begin(), actual.begin(), expected.size()) == 0);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Compare the given 420 row routine with the scalar conversion, with
+	 * and without alpha.
+	 */
+	void check420(Graphics::YUVToRGBRow420Proc row420) {
+		Planes planes(0);
+
+		for (int f = 0; f < kFormats; ++f) {
+			const Graphics::PixelFormat format = getFormat(f);
+			const int pitch = kSize * format.bytesPerPixel;
+			Common::Array<byte> expected(pitch * kSize), actual(pitch * kSize);
+
+			for (int s = 0; s < 4; ++s) {
+				const Graphics::YUVToRGBManager::LuminanceScale scale = (s & 1) ? Graphics::YUVToRGBManager::kScaleITU : Graphics::YUVToRGBManager::kScaleFull;
+				const bool alpha = s >= 2;
+				Graphics::YUVToRGBRowParams params;
+				initParams(params, format, scale);
+
+				// 420 uses the first half of every chroma row
+				if (alpha)
+					YUVToRGBMan.convert420Alpha(expected.begin(), pitch, format, scale, planes.y.begin(), planes.u.begin(), planes.v.begin(), planes.a.begin(), kSize, kSize, kSize, kSize);
+				else
+					YUVToRGBMan.convert420(expected.begin(), pitch, format, scale, planes.y.begin(), planes.u.begin(), planes.v.begin(), kSize, kSize, kSize, kSize);
+
+				for (int row = 0; row < kSize; row += 2) {
+					const int offset = row * kSize;
+					const byte *aSrc = alpha ? planes.a.begin() + offset : nullptr;
+					row420(actual.begin() + row * pitch, actual.begin() + (row + 1) * pitch,
+					       planes.y.begin() + offset, planes.y.begin() + offset + kSize,
+					       aSrc, aSrc ? aSrc + kSize : nullptr,
+					       planes.u.begin() + offset / 2, planes.v.begin() + offset / 2, kSize, params);
+				}
+
+				TS_ASSERT(memcmp(expected.begin(), actual.begin(), expected.size()) == 0);
+			}
+		}
+	}
+
+	public:
+	void test_surface_matches_buffer() {
+		Planes planes(0);
+		const Graphics::PixelFormat format = getFormat(0);
+		Graphics::Surface surface;
+		surface.create(kSize, kSize, format);
+		Common::Array<byte> buffer(surface.pitch * kSize);
+
+		YUVToRGBMan.convert420(&surface, Graphics::YUVToRGBManager::kScaleITU, planes.y.begin(), planes.u.begin(), planes.v.begin(), kSize, kSize, kSize, kSize);
+		YUVToRGBMan.convert420(buffer.begin(), surface.pitch, format, Graphics::YUVToRGBManager::kScaleITU, planes.y.begin(), planes.u.begin(), planes.v.begin(), kSize, kSize, kSize, kSize);
+		TS_ASSERT(memcmp(surface.getPixels(), buffer.begin(), buffer.size()) == 0);
+
+		surface.free();
+	}
+
+	void test_410_interpolation() {
+		// Bilinear scaling of the chroma planes, weighting all four
+		// neighbours at once
+		Planes planes(0);
+		const int uvPitch = kSize / 4 + 1;
+		Common::Array<byte> u(uvPitch * (kSize / 4 + 1)), v(u.size());
+		for (uint i = 0; i < u.size(); ++i) {
+			u[i] = planes.u[i] * 3 + planes.v[i];
+			v[i] = planes.y[i];
+		}
+
+		Common::Array<byte> uFull(kSize * kSize), vFull(kSize * kSize);
+		for (int y = 0; y < kSize; ++y) {
+			for (int x = 0; x < kSize; ++x) {
+				const int index = (y >> 2) * uvPitch + (x >> 2);
+				const int xDiff = x & 3, yDiff = y & 3;
+				uFull[y * kSize + x] = (u[index] * (4 - xDiff) * (4 - yDiff) + u[index + 1] * xDiff * (4 - yDiff) +
+						u[index + uvPitch] * yDiff * (4 - xDiff) + u[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+				vFull[y * kSize + x] = (v[index] * (4 - xDiff) * (4 - yDiff) + v[index + 1] * xDiff * (4 - yDiff) +
+						v[index + uvPitch] * yDiff * (4 - xDiff) + v[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+			}
+		}
+
+		const Graphics::PixelFormat format = getFormat(2);
+		const int pitch = kSize * format.bytesPerPixel;
+		Common::Array<byte> expected(pitch * kSize), actual(pitch * kSize);
+		YUVToRGBMan.convert444(expected.begin(), pitch, format, Graphics::YUVToRGBManager::kScaleFull, planes.y.begin(), uFull.begin(), vFull.begin(), kSize, kSize, kSize, kSize);
+		YUVToRGBMan.convert410(actual.begin(), pitch, format, Graphics::YUVToRGBManager::kScaleFull, planes.y.begin(), u.begin(), v.begin(), kSize, kSize, kSize, uvPitch);
+		TS_ASSERT(memcmp(expected.begin(), actual.begin(), expected.size()) == 0);
+	}
+
+	void test_sse2() {
+#if defined(SCUMMVM_SSE2) && defined(SCUMM_LITTLE_ENDIAN)
+		if (!testCpuFeature(OSystem::kFeatureCpuSSE2))
+			return;
+
+		check444(Graphics::convertYUV444RowToRGBSSE2);
+		check420(Graphics::convertYUV420RowsToRGBSSE2);
+#endif
+	}
+
+	void test_avx2() {
+#if defined(SCUMMVM_AVX2) && defined(SCUMM_LITTLE_ENDIAN)
+		if (!testCpuFeature(OSystem::kFeatureCpuAVX2))
+			return;
+
+		check444(Graphics::convertYUV444RowToRGBAVX2);
+		check420(Graphics::convertYUV420RowsToRGBAVX2);
+#endif
+	}
+
+	void test_neon() {
+#if defined(SCUMMVM_NEON) && defined(SCUMM_LITTLE_ENDIAN)
+		if (!testCpuFeature(OSystem::kFeatureCpuNEON))
+			return;
+
+		check444(Graphics::convertYUV444RowToRGBNEON);
+		check420(Graphics::convertYUV420RowsToRGBNEON);
+#endif
+	}
+};
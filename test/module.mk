@@ -2,11 +2,17 @@
 # Unit/regression tests, based on CxxTest.
 # Use the 'test' target to run them.
 # Edit TESTS and TESTLIBS to add more tests.
+# Micro-benchmarks live in test/bench, use the 'bench' target to run them.
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h
-TEST_LIBS    := audio/libaudio.a math/libmath.a common/libcommon.a
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/graphics/*.h $(srcdir)/test/math/*.h
+TEST_LIBS    := audio/libaudio.a graphics/libgraphics.a math/libmath.a common/libcommon.a
+
+ifdef USE_BINK
+	TESTS += $(srcdir)/test/video/*.h
+	TEST_LIBS := video/libvideo.a $(TEST_LIBS)
+endif
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -18,6 +24,9 @@ ifeq ($(ENABLE_ULTIMA), STATIC_PLUGIN)
 	TEST_LIBS += engines/ultima/libultima.a
 endif
 
+BENCH_SRCS   := $(wildcard $(srcdir)/test/bench/*.cpp)
+BENCH_LIBS   := image/libimage.a audio/libaudio.a graphics/libgraphics.a common/libcommon.a
+
 #
 TEST_FLAGS   := --runner=StdioPrinter --no-std --no-eh --include=$(srcdir)/test/cxxtest_mingw.h
 TEST_CFLAGS  := $(CFLAGS) -I$(srcdir)/test/cxxtest
@@ -51,8 +60,14 @@ test/runner.cpp: $(TESTS)
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+bench: test/bench/runner
+	./test/bench/runner $(BENCHFLAGS)
+test/bench/runner: $(BENCH_SRCS) $(BENCH_LIBS)
+	@mkdir -p test/bench
+	$(QUIET_CXX)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) $(TEST_CFLAGS) -o $@ $+ $(TEST_LDFLAGS)
+
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner
+	-$(RM) test/runner.cpp test/runner test/bench/runner
 
-.PHONY: test clean-test
+.PHONY: test bench clean-test
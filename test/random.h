@@ -0,0 +1,15 @@
+#ifndef TEST_RANDOM_H
+#define TEST_RANDOM_H
+
+#include "common/scummsys.h"
+
+/**
+ * Deterministic pseudo random numbers for the tests and benchmarks, as
+ * rand() is off limits. Returns 24 bit values and advances the seed.
+ */
+inline uint32 nextRandom(uint32 &seed) {
+	seed = seed * 1664525 + 1013904223;
+	return seed >> 8;
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef TEST_SYSTEM_H
+#define TEST_SYSTEM_H
+
+#include "common/scummsys.h"
+#include "common/system.h"
+
+#ifdef POSIX
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+#endif
+
+/**
+ * Minimal OSystem for tests which need mutexes, threads and semaphores.
+ * There is no screen, no mixer and no event handling. Threads are only
+ * available on POSIX hosts, elsewhere createThread() fails just like on
+ * backends without thread support.
+ *
+ * Tests install it for their own duration with TestSystemScope, as the
+ * other suites rely on g_system being unset.
+ */
+class TestSystem : public OSystem {
+public:
+	Graphics::PixelFormat getScreenFormat() const override { return Graphics::PixelFormat::createFormatCLUT8(); }
+	Common::List<Graphics::PixelFormat> getSupportedFormats() const override { return Common::List<Graphics::PixelFormat>(); }
+	void initSize(uint width, uint height, const Graphics::PixelFormat *format) override {}
+	int16 getHeight() override { return 0; }
+	int16 getWidth() override { return 0; }
+	PaletteManager *getPaletteManager() override { return nullptr; }
+	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override {}
+	Graphics::Surface *lockScreen() override { return nullptr; }
+	void unlockScreen() override {}
+	void fillScreen(uint32 col) override {}
+	void updateScreen() override {}
+	void setShakePos(int shakeXOffset, int shakeYOffset) override {}
+	void showOverlay() override {}
+	void hideOverlay() override {}
+	bool isOverlayVisible() const override { return false; }
+	Graphics::PixelFormat getOverlayFormat() const override { return Graphics::PixelFormat(); }
+	void clearOverlay() override {}
+	void grabOverlay(void *buf, int pitch) override {}
+	void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) override {}
+	int16 getOverlayHeight() override { return 0; }
+	int16 getOverlayWidth() override { return 0; }
+	bool showMouse(bool visible) override { return false; }
+	void warpMouse(int x, int y) override {}
+	void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale, const Graphics::PixelFormat *format) override {}
+	void getTimeAndDate(TimeDate &t) const override { memset(&t, 0, sizeof(t)); }
+	Audio::Mixer *getMixer() override { return nullptr; }
+	void quit() override {}
+	void displayMessageOnOSD(const Common::U32String &msg) override {}
+	void displayActivityIconOnOSD(const Graphics::Surface *icon) override {}
+	void logMessage(LogMessageType::Type type, const char *message) override {}
+
+#ifdef POSIX
+	uint32 getMillis(bool skipRecord = false) override {
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint32)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+	}
+
+	void delayMillis(uint msecs) override {
+		timespec ts;
+		ts.tv_sec = msecs / 1000;
+		ts.tv_nsec = (msecs % 1000) * 1000000;
+		while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+		}
+	}
+
+	MutexRef createMutex() override {
+		pthread_mutexattr_t attr;
+		pthread_mutexattr_init(&attr);
+		pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+
+		pthread_mutex_t *mutex = new pthread_mutex_t;
+		pthread_mutex_init(mutex, &attr);
+		pthread_mutexattr_destroy(&attr);
+		return (MutexRef)mutex;
+	}
+
+	void lockMutex(MutexRef mutex) override { pthread_mutex_lock((pthread_mutex_t *)mutex); }
+	void unlockMutex(MutexRef mutex) override { pthread_mutex_unlock((pthread_mutex_t *)mutex); }
+
+	void deleteMutex(MutexRef mutex) override {
+		pthread_mutex_destroy((pthread_mutex_t *)mutex);
+		delete (pthread_mutex_t *)mutex;
+	}
+
+	ThreadRef createThread(ThreadProc proc, void *param) override {
+		Thread *thread = new Thread;
+		thread->proc = proc;
+		thread->param = param;
+		thread->status = 0;
+		if (pthread_create(&thread->thread, nullptr, threadMain, thread) != 0) {
+			delete thread;
+			return 0;
+		}
+		return (ThreadRef)thread;
+	}
+
+	int waitThread(ThreadRef ref) override {
+		Thread *thread = (Thread *)ref;
+		pthread_join(thread->thread, nullptr);
+		const int status = thread->status;
+		delete thread;
+		return status;
+	}
+
+	uint getCpuCount() override { return 4; }
+
+	SemaphoreRef createSemaphore(uint value) override {
+		Semaphore *sem = new Semaphore;
+		pthread_mutex_init(&sem->mutex, nullptr);
+		pthread_cond_init(&sem->cond, nullptr);
+		sem->value = value;
+		return (SemaphoreRef)sem;
+	}
+
+	void waitSemaphore(SemaphoreRef ref) override {
+		Semaphore *sem = (Semaphore *)ref;
+		pthread_mutex_lock(&sem->mutex);
+		while (!sem->value)
+			pthread_cond_wait(&sem->cond, &sem->mutex);
+		--sem->value;
+		pthread_mutex_unlock(&sem->mutex);
+	}
+
+	bool waitSemaphoreTimeout(SemaphoreRef ref, uint msecs) override {
+		Semaphore *sem = (Semaphore *)ref;
+		timespec deadline;
+		clock_gettime(CLOCK_REALTIME, &deadline);
+		deadline.tv_sec += msecs / 1000;
+		deadline.tv_nsec += (msecs % 1000) * 1000000;
+		if (deadline.tv_nsec >= 1000000000) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000;
+		}
+
+		pthread_mutex_lock(&sem->mutex);
+		while (!sem->value) {
+			if (pthread_cond_timedwait(&sem->cond, &sem->mutex, &deadline) == ETIMEDOUT)
+				break;
+		}
+		const bool acquired = sem->value != 0;
+		if (acquired)
+			--sem->value;
+		pthread_mutex_unlock(&sem->mutex);
+		return acquired;
+	}
+
+	void postSemaphore(SemaphoreRef ref) override {
+		Semaphore *sem = (Semaphore *)ref;
+		pthread_mutex_lock(&sem->mutex);
+		++sem->value;
+		pthread_cond_signal(&sem->cond);
+		pthread_mutex_unlock(&sem->mutex);
+	}
+
+	void deleteSemaphore(SemaphoreRef ref) override {
+		Semaphore *sem = (Semaphore *)ref;
+		pthread_cond_destroy(&sem->cond);
+		pthread_mutex_destroy(&sem->mutex);
+		delete sem;
+	}
+
+private:
+	struct Thread {
+		pthread_t thread;
+		ThreadProc proc;
+		void *param;
+		int status;
+	};
+
+	struct Semaphore {
+		pthread_mutex_t mutex;
+		pthread_cond_t cond;
+		uint value;
+	};
+
+	static void *threadMain(void *param) {
+		Thread *thread = (Thread *)param;
+		thread->status = thread->proc(thread->param);
+		return nullptr;
+	}
+#else
+	uint32 getMillis(bool skipRecord = false) override { return 0; }
+	void delayMillis(uint msecs) override {}
+	MutexRef createMutex() override { return (MutexRef)this; }
+	void lockMutex(MutexRef mutex) override {}
+	void unlockMutex(MutexRef mutex) override {}
+	void deleteMutex(MutexRef mutex) override {}
+#endif
+};
+
+/** Installs a TestSystem as g_system while in scope. */
+class TestSystemScope {
+public:
+	TestSystemScope() : _previous(g_system) { g_system = &_system; }
+	~TestSystemScope() { g_system = _previous; }
+
+private:
+	TestSystem _system;
+	OSystem *_previous;
+};
+
+#endif
@@ -0,0 +1,164 @@
+#include <cxxtest/TestSuite.h>
+
+#include "video/bink_dsp.h"
+
+#include "test/cpu.h"
+#include "test/random.h"
+
+class BinkDSPTestSuite : public CxxTest::TestSuite
+{
+	enum {
+		kWidth = 64,
+		kHeight = 48,
+		kFrames = 8
+	};
+
+	uint32 _seed;
+
+	// Mostly sparse coefficients like in real streams, with the occasional
+	// huge one to exercise the wrap-around of the 32-bit arithmetic
+	void fillCoefficients(int32 *block) {
+		memset(block, 0, 64 * sizeof(int32));
+		block[0] = (int32)(nextRandom(_seed) % 4096) - 1024;
+
+		const int count = nextRandom(_seed) % 12;
+		for (int i = 0; i < count; ++i) {
+			int32 value = (int32)(nextRandom(_seed) % 2048) - 1024;
+			if ((nextRandom(_seed) & 31) == 0)
+				value *= 40000;
+			block[nextRandom(_seed) % 64] = value;
+		}
+	}
+
+	void fillResidue(int16 *block) {
+		for (int i = 0; i < 64; ++i)
+			block[i] = (int16)(nextRandom(_seed) % 512) - 256;
+	}
+
+	static uint32 checksum(const byte *data, uint32 size) {
+		uint32 a = 1, b = 0;
+		for (uint32 i = 0; i < size; ++i) {
+			a = (a + data[i]) % 65521;
+			b = (b + a) % 65521;
+		}
+		return (b << 16) | a;
+	}
+
+	/**
+	 * Decode a few frames of random intra, inter and residue blocks into
+	 * a plane, using the given routines, and return the checksum of every
+	 * frame.
+	 */
+	void decodeFrames(const Video::BinkDSPProcs &procs, uint32 *checksums) {
+		byte plane[kWidth * kHeight];
+		int32 coeffs[64];
+		int16 residue[64];
+
+		_seed = 0x1234567;
+		memset(plane, 0x80, sizeof(plane));
+
+		for (int frame = 0; frame < kFrames; ++frame) {
+			for (int y = 0; y < kHeight; y += 8) {
+				for (int x = 0; x < kWidth; x += 8) {
+					byte *dest = plane + y * kWidth + x;
+
+					switch (nextRandom(_seed) % 4) {
+					case 0:
+						fillCoefficients(coeffs);
+						procs.idctPut(dest, kWidth, coeffs);
+						break;
+					case 1:
+						fillCoefficients(coeffs);
+						procs.idctAdd(dest, kWidth, coeffs);
+						break;
+					case 2:
+						fillResidue(residue);
+						procs.addResidue(dest, kWidth, residue);
+						break;
+					default:
+						// Scaled intra blocks run the IDCT in place
+						fillCoefficients(coeffs);
+						procs.idct(coeffs);
+						for (int i = 0; i < 64; ++i)
+							dest[(i / 8) * kWidth + i % 8] = coeffs[i];
+						break;
+					}
+				}
+			}
+
+			checksums[frame] = checksum(plane, sizeof(plane));
+		}
+	}
+
+	void checkProcs(const Video::BinkDSPProcs &procs) {
+		const Video::BinkDSPProcs scalar = {
+			Video::binkIDCT, Video::binkIDCTPut, Video::binkIDCTAdd, Video::binkAddResidue
+		};
+
+		uint32 expected[kFrames], actual[kFrames];
+		decodeFrames(scalar, expected);
+		decodeFrames(procs, actual);
+
+		for (int frame = 0; frame < kFrames; ++frame)
+			TS_ASSERT_EQUALS(expected[frame], actual[frame]);
+
+		// The in-place transform must also match coefficient for coefficient
+		int32 expectedBlock[64], actualBlock[64];
+		_seed = 0x7654321;
+		for (int i = 0; i < 200; ++i) {
+			fillCoefficients(expectedBlock);
+			memcpy(actualBlock, expectedBlock, sizeof(actualBlock));
+			Video::binkIDCT(expectedBlock);
+			procs.idct(actualBlock);
+			TS_ASSERT_SAME_DATA(expectedBlock, actualBlock, sizeof(actualBlock));
+		}
+	}
+
+public:
+	void test_dc_only() {
+		int32 block[64];
+		byte dest[8 * 8];
+		memset(block, 0, sizeof(block));
+		block[0] = 1024;
+
+		Video::binkIDCTPut(dest, 8, block);
+		for (int i = 0; i < 64; ++i)
+			TS_ASSERT_EQUALS(dest[i], 4);
+	}
+
+	void test_sse2() {
+#ifdef SCUMMVM_SSE2
+		if (!testCpuFeature(OSystem::kFeatureCpuSSE2))
+			return;
+
+		const Video::BinkDSPProcs procs = {
+			Video::binkIDCTSSE2, Video::binkIDCTPutSSE2, Video::binkIDCTAddSSE2, Video::binkAddResidueSSE2
+		};
+		checkProcs(procs);
+#endif
+	}
+
+	void test_avx2() {
+#ifdef SCUMMVM_AVX2
+		if (!testCpuFeature(OSystem::kFeatureCpuAVX2))
+			return;
+
+		const Video::BinkDSPProcs procs = {
+			Video::binkIDCTAVX2, Video::binkIDCTPutAVX2, Video::binkIDCTAddAVX2, Video::binkAddResidueAVX2
+		};
+		checkProcs(procs);
+#endif
+	}
+
+	void test_neon() {
+#ifdef SCUMMVM_NEON
+		if (!testCpuFeature(OSystem::kFeatureCpuNEON))
+			return;
+
+		const Video::BinkDSPProcs procs = {
+			Video::binkIDCTNEON, Video::binkIDCTPutNEON, Video::binkIDCTAddNEON, Video::binkAddResidueNEON
+		};
+		checkProcs(procs);
+#endif
+	}
+};
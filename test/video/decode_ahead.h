@@ -0,0 +1,164 @@
+#include <cxxtest/TestSuite.h>
+
+#include "video/video_decoder.h"
+#include "graphics/surface.h"
+
+#include "../system.h"
+
+class DecodeAheadTestSuite : public CxxTest::TestSuite
+{
+	enum {
+		kFrameCount = 10,
+		kFrameRate = 10,
+		kDecodeAhead = 3
+	};
+
+	// A video of kFrameCount CLUT8 frames, each filled with its frame number
+	class FakeDecoder : public Video::VideoDecoder {
+	public:
+		FakeDecoder() : _decodedFrames(0) {
+			for (int i = 0; i < kFrameCount; ++i)
+				_timeToNextFrame[i] = 0xFFFFFFFF;
+		}
+
+		bool loadStream(Common::SeekableReadStream *stream) override { return false; }
+
+		void load() { addTrack(new FakeTrack()); }
+
+		// Written by the decoding thread, only read once it was stopped
+		uint32 _timeToNextFrame[kFrameCount];
+
+	protected:
+		void onFrameDecoded() override {
+			if (_decodedFrames < kFrameCount)
+				_timeToNextFrame[_decodedFrames++] = getTimeToNextDecodedFrame();
+		}
+
+	private:
+		int _decodedFrames;
+
+		class FakeTrack : public FixedRateVideoTrack {
+		public:
+			FakeTrack() : _curFrame(-1) {
+				_surface.create(4, 4, Graphics::PixelFormat::createFormatCLUT8());
+			}
+
+			~FakeTrack() override { _surface.free(); }
+
+			bool endOfTrack() const override { return _curFrame >= kFrameCount - 1; }
+			bool isSeekable() const override { return true; }
+
+			bool seek(const Audio::Timestamp &time) override {
+				_curFrame = getFrameAtTime(time) - 1;
+				return true;
+			}
+
+			uint16 getWidth() const override { return _surface.w; }
+			uint16 getHeight() const override { return _surface.h; }
+			Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
+			int getCurFrame() const override { return _curFrame; }
+			int getFrameCount() const override { return kFrameCount; }
+
+			const Graphics::Surface *decodeNextFrame() override {
+				++_curFrame;
+				memset(_surface.getPixels(), _curFrame, _surface.pitch * _surface.h);
+				return &_surface;
+			}
+
+		protected:
+			Common::Rational getFrameRate() const override { return kFrameRate; }
+
+		private:
+			Graphics::Surface _surface;
+			int _curFrame;
+		};
+	};
+
+	static int getFrameNumber(const Graphics::Surface *frame) {
+		return frame ? *(const byte *)frame->getPixels() : -1;
+	}
+
+	public:
+	void test_decode_ahead_start() {
+		TestSystemScope scope;
+		FakeDecoder decoder;
+		TS_ASSERT(decoder.setDecodeAhead(kDecodeAhead));
+		decoder.load();
+
+		for (int i = 0; i < kFrameCount; ++i) {
+			TS_ASSERT(!decoder.endOfVideo());
+			TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), i);
+			TS_ASSERT_EQUALS(decoder.getCurFrame(), i);
+		}
+
+#ifdef POSIX
+		// The frames did come from the decoding thread, TestSystem only has
+		// threads on POSIX hosts
+		TS_ASSERT_EQUALS(decoder.getDecodeAhead(), (uint)kDecodeAhead);
+#endif
+	}
+
+	void test_decode_ahead_seek() {
+		TestSystemScope scope;
+		FakeDecoder decoder;
+		TS_ASSERT(decoder.setDecodeAhead(kDecodeAhead));
+		decoder.load();
+
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 0);
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 1);
+
+		// Seeking cancels the frames decoded so far, forwards and backwards
+		TS_ASSERT(decoder.seekToFrame(6));
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 6);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 6);
+
+		TS_ASSERT(decoder.seekToFrame(2));
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 2);
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 3);
+
+		// And so does rewinding, even right after the thread was started
+		TS_ASSERT(decoder.rewind());
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 0);
+		TS_ASSERT(decoder.rewind());
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 0);
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 1);
+	}
+
+	void test_decode_ahead_end_of_stream() {
+		TestSystemScope scope;
+		FakeDecoder decoder;
+		TS_ASSERT(decoder.setDecodeAhead(kDecodeAhead));
+		decoder.load();
+
+		for (int i = 0; i < kFrameCount; ++i)
+			TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), i);
+
+		TS_ASSERT(decoder.endOfVideo());
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 0u);
+
+		// Decoding past the end must neither block nor return a frame
+		TS_ASSERT(!decoder.decodeNextFrame());
+		TS_ASSERT(!decoder.decodeNextFrame());
+		TS_ASSERT(decoder.endOfVideo());
+	}
+
+	void test_decode_ahead_time_to_next_decoded_frame() {
+		TestSystemScope scope;
+		FakeDecoder decoder;
+		TS_ASSERT(decoder.setDecodeAhead(kDecodeAhead));
+		decoder.load();
+
+		for (int i = 0; i < kFrameCount; ++i)
+			decoder.decodeNextFrame();
+
+		// Stop the decoding thread before looking at what it recorded
+		decoder.rewind();
+
+		// Without audio, the lead is measured from the start of the video.
+		// It is taken from the frame decoded, not from the frame handed out.
+		for (int i = 0; i < kFrameCount - 1; ++i)
+			TS_ASSERT_EQUALS(decoder._timeToNextFrame[i], (uint32)((i + 1) * 1000 / kFrameRate));
+
+		TS_ASSERT_EQUALS(decoder._timeToNextFrame[kFrameCount - 1], 0u);
+	}
+};
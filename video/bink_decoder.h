@@ -59,6 +59,8 @@ struct Surface;
 
 namespace Video {
 
+struct BinkDSPProcs;
+
 /**
  * Decoder for Bink videos.
  *
@@ -329,6 +331,9 @@ private:
 		void IDCT(int32 *block);
 		void IDCTPut(DecodeContext &ctx, int32 *block);
 		void IDCTAdd(DecodeContext &ctx, int32 *block);
+
+		/** The block routines best suited for the CPU. */
+		const BinkDSPProcs *_dsp;
 	};
 
 	class BinkAudioTrack : public AudioTrack {
@@ -0,0 +1,93 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef VIDEO_BINK_DSP_H
+#define VIDEO_BINK_DSP_H
+
+#include "common/scummsys.h"
+
+namespace Video {
+
+/**
+ * Inverse DCT of an 8x8 block of coefficients, in place.
+ */
+typedef void (*BinkIDCTProc)(int32 *block);
+
+/**
+ * Inverse DCT of an 8x8 block, written to (put) or added to (add) an 8x8
+ * block of plane pixels. Like the scalar code, results are truncated to
+ * a byte rather than clamped. The contents of @p block are undefined
+ * afterwards.
+ *
+ * @param dest  top left pixel of the target block
+ * @param pitch distance in bytes between two rows of the plane
+ * @param block the coefficients
+ */
+typedef void (*BinkIDCTBlitProc)(byte *dest, uint32 pitch, int32 *block);
+
+/**
+ * Add an 8x8 block of residue values to the plane pixels, wrapping
+ * around on overflow.
+ */
+typedef void (*BinkAddResidueProc)(byte *dest, uint32 pitch, const int16 *block);
+
+struct BinkDSPProcs {
+	BinkIDCTProc idct;
+	BinkIDCTBlitProc idctPut;
+	BinkIDCTBlitProc idctAdd;
+	BinkAddResidueProc addResidue;
+};
+
+void binkIDCT(int32 *block);
+void binkIDCTPut(byte *dest, uint32 pitch, int32 *block);
+void binkIDCTAdd(byte *dest, uint32 pitch, int32 *block);
+void binkAddResidue(byte *dest, uint32 pitch, const int16 *block);
+
+#ifdef SCUMMVM_SSE2
+void binkIDCTSSE2(int32 *block);
+void binkIDCTPutSSE2(byte *dest, uint32 pitch, int32 *block);
+void binkIDCTAddSSE2(byte *dest, uint32 pitch, int32 *block);
+void binkAddResidueSSE2(byte *dest, uint32 pitch, const int16 *block);
+#endif
+
+#ifdef SCUMMVM_AVX2
+void binkIDCTAVX2(int32 *block);
+void binkIDCTPutAVX2(byte *dest, uint32 pitch, int32 *block);
+void binkIDCTAddAVX2(byte *dest, uint32 pitch, int32 *block);
+void binkAddResidueAVX2(byte *dest, uint32 pitch, const int16 *block);
+#endif
+
+#ifdef SCUMMVM_NEON
+void binkIDCTNEON(int32 *block);
+void binkIDCTPutNEON(byte *dest, uint32 pitch, int32 *block);
+void binkIDCTAddNEON(byte *dest, uint32 pitch, int32 *block);
+void binkAddResidueNEON(byte *dest, uint32 pitch, const int16 *block);
+#endif
+
+/**
+ * Return the fastest block routines the CPU supports.
+ */
+const BinkDSPProcs &getBinkDSPProcs();
+
+} // End of namespace Video
+
+#endif
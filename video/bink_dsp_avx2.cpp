@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "video/bink_dsp_simd.h"
+
+#ifdef SCUMMVM_AVX2
+
+#include <immintrin.h>
+
+namespace Video {
+
+struct BinkOpsAVX2 {
+	typedef __m256i Vec;
+	enum { kLanes = 8 };
+
+	static inline Vec load(const int32 *p) { return _mm256_loadu_si256((const __m256i *)p); }
+	static inline void store(int32 *p, Vec v) { _mm256_storeu_si256((__m256i *)p, v); }
+	static inline Vec set1(int32 v) { return _mm256_set1_epi32(v); }
+
+	static inline Vec add(Vec a, Vec b) { return _mm256_add_epi32(a, b); }
+	static inline Vec sub(Vec a, Vec b) { return _mm256_sub_epi32(a, b); }
+	static inline Vec mul(Vec a, int32 c) { return _mm256_mullo_epi32(a, _mm256_set1_epi32(c)); }
+	static inline Vec shr11(Vec a) { return _mm256_srai_epi32(a, 11); }
+	static inline Vec shr8(Vec a) { return _mm256_srai_epi32(a, 8); }
+
+	static inline void transpose(Vec (&m)[8][1]) {
+		const __m256i t0 = _mm256_unpacklo_epi32(m[0][0], m[1][0]);
+		const __m256i t1 = _mm256_unpackhi_epi32(m[0][0], m[1][0]);
+		const __m256i t2 = _mm256_unpacklo_epi32(m[2][0], m[3][0]);
+		const __m256i t3 = _mm256_unpackhi_epi32(m[2][0], m[3][0]);
+		const __m256i t4 = _mm256_unpacklo_epi32(m[4][0], m[5][0]);
+		const __m256i t5 = _mm256_unpackhi_epi32(m[4][0], m[5][0]);
+		const __m256i t6 = _mm256_unpacklo_epi32(m[6][0], m[7][0]);
+		const __m256i t7 = _mm256_unpackhi_epi32(m[6][0], m[7][0]);
+
+		const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+		const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+		const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+		const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+		const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+		const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+		const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+		const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+		m[0][0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+		m[1][0] = _mm256_permute2x128_si256(u1, u5, 0x20);
+		m[2][0] = _mm256_permute2x128_si256(u2, u6, 0x20);
+		m[3][0] = _mm256_permute2x128_si256(u3, u7, 0x20);
+		m[4][0] = _mm256_permute2x128_si256(u0, u4, 0x31);
+		m[5][0] = _mm256_permute2x128_si256(u1, u5, 0x31);
+		m[6][0] = _mm256_permute2x128_si256(u2, u6, 0x31);
+		m[7][0] = _mm256_permute2x128_si256(u3, u7, 0x31);
+	}
+
+	// Truncate a row of results to 16-bit lanes holding the low byte
+	static inline __m128i lowBytes(const Vec *row) {
+		const __m256i v = _mm256_and_si256(row[0], _mm256_set1_epi32(0xFF));
+		return _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+	}
+	static inline void addBytes(byte *dest, __m128i v) {
+		const __m128i d = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)dest), _mm_setzero_si128());
+		const __m128i sum = _mm_and_si128(_mm_add_epi16(d, v), _mm_set1_epi16(0xFF));
+		_mm_storel_epi64((__m128i *)dest, _mm_packus_epi16(sum, sum));
+	}
+
+	static inline void putRow(byte *dest, const Vec *row) {
+		const __m128i v = lowBytes(row);
+		_mm_storel_epi64((__m128i *)dest, _mm_packus_epi16(v, v));
+	}
+	static inline void addRow(byte *dest, const Vec *row) { addBytes(dest, lowBytes(row)); }
+	static inline void addResidueRow(byte *dest, const int16 *src) {
+		addBytes(dest, _mm_loadu_si128((const __m128i *)src));
+	}
+};
+
+void binkIDCTAVX2(int32 *block) {
+	binkIDCTSIMD<BinkOpsAVX2>(block);
+}
+
+void binkIDCTPutAVX2(byte *dest, uint32 pitch, int32 *block) {
+	binkIDCTPutSIMD<BinkOpsAVX2>(dest, pitch, block);
+}
+
+void binkIDCTAddAVX2(byte *dest, uint32 pitch, int32 *block) {
+	binkIDCTAddSIMD<BinkOpsAVX2>(dest, pitch, block);
+}
+
+void binkAddResidueAVX2(byte *dest, uint32 pitch, const int16 *block) {
+	binkAddResidueSIMD<BinkOpsAVX2>(dest, pitch, block);
+}
+
+} // End of namespace Video
+
+#endif
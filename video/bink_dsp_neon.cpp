@@ -0,0 +1,87 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "video/bink_dsp_simd.h"
+
+#ifdef SCUMMVM_NEON
+
+#include <arm_neon.h>
+
+namespace Video {
+
+struct BinkOpsNEON {
+	typedef int32x4_t Vec;
+	enum { kLanes = 4 };
+
+	static inline Vec load(const int32 *p) { return vld1q_s32(p); }
+	static inline void store(int32 *p, Vec v) { vst1q_s32(p, v); }
+	static inline Vec set1(int32 v) { return vdupq_n_s32(v); }
+
+	static inline Vec add(Vec a, Vec b) { return vaddq_s32(a, b); }
+	static inline Vec sub(Vec a, Vec b) { return vsubq_s32(a, b); }
+	static inline Vec mul(Vec a, int32 c) { return vmulq_n_s32(a, c); }
+	static inline Vec shr11(Vec a) { return vshrq_n_s32(a, 11); }
+	static inline Vec shr8(Vec a) { return vshrq_n_s32(a, 8); }
+
+	static inline void transpose4(Vec &r0, Vec &r1, Vec &r2, Vec &r3) {
+		const int32x4x2_t t01 = vtrnq_s32(r0, r1);
+		const int32x4x2_t t23 = vtrnq_s32(r2, r3);
+		r0 = vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+		r1 = vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+		r2 = vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+		r3 = vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+	}
+	static inline void transpose(Vec (&m)[8][2]) { binkTransposeTiles<BinkOpsNEON>(m); }
+
+	// The narrowing moves truncate, just like the scalar code
+	static inline uint8x8_t lowBytes(const Vec *row) {
+		const int16x8_t v = vcombine_s16(vmovn_s32(row[0]), vmovn_s32(row[1]));
+		return vmovn_u16(vreinterpretq_u16_s16(v));
+	}
+
+	static inline void putRow(byte *dest, const Vec *row) { vst1_u8(dest, lowBytes(row)); }
+	static inline void addRow(byte *dest, const Vec *row) { vst1_u8(dest, vadd_u8(vld1_u8(dest), lowBytes(row))); }
+	static inline void addResidueRow(byte *dest, const int16 *src) {
+		const uint8x8_t v = vmovn_u16(vreinterpretq_u16_s16(vld1q_s16(src)));
+		vst1_u8(dest, vadd_u8(vld1_u8(dest), v));
+	}
+};
+
+void binkIDCTNEON(int32 *block) {
+	binkIDCTSIMD<BinkOpsNEON>(block);
+}
+
+void binkIDCTPutNEON(byte *dest, uint32 pitch, int32 *block) {
+	binkIDCTPutSIMD<BinkOpsNEON>(dest, pitch, block);
+}
+
+void binkIDCTAddNEON(byte *dest, uint32 pitch, int32 *block) {
+	binkIDCTAddSIMD<BinkOpsNEON>(dest, pitch, block);
+}
+
+void binkAddResidueNEON(byte *dest, uint32 pitch, const int16 *block) {
+	binkAddResidueSIMD<BinkOpsNEON>(dest, pitch, block);
+}
+
+} // End of namespace Video
+
+#endif
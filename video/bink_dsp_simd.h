@@ -0,0 +1,178 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef VIDEO_BINK_DSP_SIMD_H
+#define VIDEO_BINK_DSP_SIMD_H
+
+#include "video/bink_dsp.h"
+
+namespace Video {
+
+/*
+ * Vectorized versions of the block routines in bink_dsp.cpp, shared by
+ * the SSE2, AVX2 and NEON implementations.
+ *
+ * The instruction set is abstracted by an Ops class, which provides a Vec
+ * type holding Ops::kLanes 32-bit integers. An 8x8 block is kept as eight
+ * rows of 8 / Ops::kLanes vectors each. Both passes of the IDCT run on
+ * columns, with lanes going across the block, and the block is transposed
+ * in between and afterwards.
+ *
+ * The transform wraps around and shifts like the 32-bit integer code of
+ * the scalar routines, and the results are truncated to a byte in the same
+ * way, so the output is bit-exact.
+ */
+
+enum {
+	kBinkA1 = 2896,
+	kBinkA2 = 2217,
+	kBinkA3 = 3784,
+	kBinkA4 = -5352
+};
+
+/**
+ * One 1D IDCT of eight rows of lanes. The second pass also rounds and
+ * scales down the result.
+ */
+template<class Ops>
+inline void binkTransformSIMD(typename Ops::Vec *v, bool round) {
+	typedef typename Ops::Vec Vec;
+
+	const Vec a0 = Ops::add(v[0], v[4]);
+	const Vec a1 = Ops::sub(v[0], v[4]);
+	const Vec a2 = Ops::add(v[2], v[6]);
+	const Vec a3 = Ops::shr11(Ops::mul(Ops::sub(v[2], v[6]), kBinkA1));
+	const Vec a4 = Ops::add(v[5], v[3]);
+	const Vec a5 = Ops::sub(v[5], v[3]);
+	const Vec a6 = Ops::add(v[1], v[7]);
+	const Vec a7 = Ops::sub(v[1], v[7]);
+	const Vec b0 = Ops::add(a4, a6);
+	const Vec b1 = Ops::shr11(Ops::mul(Ops::add(a5, a7), kBinkA3));
+	const Vec b2 = Ops::add(Ops::sub(Ops::shr11(Ops::mul(a5, kBinkA4)), b0), b1);
+	const Vec b3 = Ops::sub(Ops::shr11(Ops::mul(Ops::sub(a6, a4), kBinkA1)), b2);
+	const Vec b4 = Ops::sub(Ops::add(Ops::shr11(Ops::mul(a7, kBinkA2)), b3), b1);
+
+	const Vec c0 = Ops::add(a0, a2);
+	const Vec c1 = Ops::sub(Ops::add(a1, a3), a2);
+	const Vec c2 = Ops::add(Ops::sub(a1, a3), a2);
+	const Vec c3 = Ops::sub(a0, a2);
+
+	v[0] = Ops::add(c0, b0);
+	v[1] = Ops::add(c1, b2);
+	v[2] = Ops::add(c2, b3);
+	v[3] = Ops::sub(c3, b4);
+	v[4] = Ops::add(c3, b4);
+	v[5] = Ops::sub(c2, b3);
+	v[6] = Ops::sub(c1, b2);
+	v[7] = Ops::sub(c0, b0);
+
+	if (round) {
+		const Vec bias = Ops::set1(0x7F);
+		for (int i = 0; i < 8; i++)
+			v[i] = Ops::shr8(Ops::add(v[i], bias));
+	}
+}
+
+/**
+ * Transpose an 8x8 block made of 4x4 tiles, for Ops with four lanes.
+ */
+template<class Ops>
+inline void binkTransposeTiles(typename Ops::Vec (&m)[8][2]) {
+	Ops::transpose4(m[0][0], m[1][0], m[2][0], m[3][0]);
+	Ops::transpose4(m[0][1], m[1][1], m[2][1], m[3][1]);
+	Ops::transpose4(m[4][0], m[5][0], m[6][0], m[7][0]);
+	Ops::transpose4(m[4][1], m[5][1], m[6][1], m[7][1]);
+
+	// The off-diagonal tiles trade places
+	for (int i = 0; i < 4; i++) {
+		const typename Ops::Vec t = m[i][1];
+		m[i][1] = m[4 + i][0];
+		m[4 + i][0] = t;
+	}
+}
+
+/**
+ * Run the 2D IDCT on @p block and leave the result rows in @p m.
+ */
+template<class Ops>
+inline void binkIDCTRowsSIMD(const int32 *block, typename Ops::Vec (&m)[8][8 / Ops::kLanes]) {
+	enum { kGroups = 8 / Ops::kLanes };
+	typename Ops::Vec v[8];
+
+	for (int g = 0; g < kGroups; g++) {
+		for (int i = 0; i < 8; i++)
+			v[i] = Ops::load(block + 8 * i + g * Ops::kLanes);
+		binkTransformSIMD<Ops>(v, false);
+		for (int i = 0; i < 8; i++)
+			m[i][g] = v[i];
+	}
+
+	Ops::transpose(m);
+
+	for (int g = 0; g < kGroups; g++) {
+		for (int i = 0; i < 8; i++)
+			v[i] = m[i][g];
+		binkTransformSIMD<Ops>(v, true);
+		for (int i = 0; i < 8; i++)
+			m[i][g] = v[i];
+	}
+
+	Ops::transpose(m);
+}
+
+template<class Ops>
+void binkIDCTSIMD(int32 *block) {
+	typename Ops::Vec m[8][8 / Ops::kLanes];
+	binkIDCTRowsSIMD<Ops>(block, m);
+
+	for (int i = 0; i < 8; i++)
+		for (int g = 0; g < 8 / Ops::kLanes; g++)
+			Ops::store(block + 8 * i + g * Ops::kLanes, m[i][g]);
+}
+
+template<class Ops>
+void binkIDCTPutSIMD(byte *dest, uint32 pitch, int32 *block) {
+	typename Ops::Vec m[8][8 / Ops::kLanes];
+	binkIDCTRowsSIMD<Ops>(block, m);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		Ops::putRow(dest, m[i]);
+}
+
+template<class Ops>
+void binkIDCTAddSIMD(byte *dest, uint32 pitch, int32 *block) {
+	typename Ops::Vec m[8][8 / Ops::kLanes];
+	binkIDCTRowsSIMD<Ops>(block, m);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		Ops::addRow(dest, m[i]);
+}
+
+template<class Ops>
+void binkAddResidueSIMD(byte *dest, uint32 pitch, const int16 *block) {
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8)
+		Ops::addResidueRow(dest, block);
+}
+
+} // End of namespace Video
+
+#endif
@@ -0,0 +1,103 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "video/bink_dsp_simd.h"
+
+#ifdef SCUMMVM_SSE2
+
+#include <emmintrin.h>
+
+namespace Video {
+
+struct BinkOpsSSE2 {
+	typedef __m128i Vec;
+	enum { kLanes = 4 };
+
+	static inline Vec load(const int32 *p) { return _mm_loadu_si128((const __m128i *)p); }
+	static inline void store(int32 *p, Vec v) { _mm_storeu_si128((__m128i *)p, v); }
+	static inline Vec set1(int32 v) { return _mm_set1_epi32(v); }
+
+	static inline Vec add(Vec a, Vec b) { return _mm_add_epi32(a, b); }
+	static inline Vec sub(Vec a, Vec b) { return _mm_sub_epi32(a, b); }
+	static inline Vec mul(Vec a, int32 c) {
+		// SSE2 has no 32-bit mullo. The low halves of the unsigned 64-bit
+		// products are the same as those of the signed ones.
+		const __m128i b = _mm_set1_epi32(c);
+		const __m128i even = _mm_mul_epu32(a, b);
+		const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), b);
+		return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, 0x08), _mm_shuffle_epi32(odd, 0x08));
+	}
+	static inline Vec shr11(Vec a) { return _mm_srai_epi32(a, 11); }
+	static inline Vec shr8(Vec a) { return _mm_srai_epi32(a, 8); }
+
+	static inline void transpose4(Vec &r0, Vec &r1, Vec &r2, Vec &r3) {
+		const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+		const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+		const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+		const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+		r0 = _mm_unpacklo_epi64(t0, t1);
+		r1 = _mm_unpackhi_epi64(t0, t1);
+		r2 = _mm_unpacklo_epi64(t2, t3);
+		r3 = _mm_unpackhi_epi64(t2, t3);
+	}
+	static inline void transpose(Vec (&m)[8][2]) { binkTransposeTiles<BinkOpsSSE2>(m); }
+
+	// Truncate a row of results to 16-bit lanes holding the low byte
+	static inline __m128i lowBytes(const Vec *row) {
+		const __m128i mask = _mm_set1_epi32(0xFF);
+		return _mm_packs_epi32(_mm_and_si128(row[0], mask), _mm_and_si128(row[1], mask));
+	}
+	static inline void addBytes(byte *dest, __m128i v) {
+		const __m128i d = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)dest), _mm_setzero_si128());
+		const __m128i sum = _mm_and_si128(_mm_add_epi16(d, v), _mm_set1_epi16(0xFF));
+		_mm_storel_epi64((__m128i *)dest, _mm_packus_epi16(sum, sum));
+	}
+
+	static inline void putRow(byte *dest, const Vec *row) {
+		const __m128i v = lowBytes(row);
+		_mm_storel_epi64((__m128i *)dest, _mm_packus_epi16(v, v));
+	}
+	static inline void addRow(byte *dest, const Vec *row) { addBytes(dest, lowBytes(row)); }
+	static inline void addResidueRow(byte *dest, const int16 *src) {
+		addBytes(dest, _mm_loadu_si128((const __m128i *)src));
+	}
+};
+
+void binkIDCTSSE2(int32 *block) {
+	binkIDCTSIMD<BinkOpsSSE2>(block);
+}
+
+void binkIDCTPutSSE2(byte *dest, uint32 pitch, int32 *block) {
+	binkIDCTPutSIMD<BinkOpsSSE2>(dest, pitch, block);
+}
+
+void binkIDCTAddSSE2(byte *dest, uint32 pitch, int32 *block) {
+	binkIDCTAddSIMD<BinkOpsSSE2>(dest, pitch, block);
+}
+
+void binkAddResidueSSE2(byte *dest, uint32 pitch, const int16 *block) {
+	binkAddResidueSIMD<BinkOpsSSE2>(dest, pitch, block);
+}
+
+} // End of namespace Video
+
+#endif
@@ -86,10 +86,6 @@ void QuickTimeDecoder::close() {
 const Graphics::Surface *QuickTimeDecoder::decodeNextFrame() {
 	const Graphics::Surface *frame = VideoDecoder::decodeNextFrame();
 
-	// Update audio buffers too
-	// (needs to be done after we find the next track)
-	updateAudioBuffer();
-
 	// We have to initialize the scaled surface
 	if (frame && (_scaleFactorX != 1 || _scaleFactorY != 1)) {
 		if (!_scaledSurface) {
@@ -104,6 +100,12 @@ const Graphics::Surface *QuickTimeDecoder::decodeNextFrame() {
 	return frame;
 }
 
+void QuickTimeDecoder::onFrameDecoded() {
+	// Update audio buffers too
+	// (needs to be done after we find the next track)
+	updateAudioBuffer();
+}
+
 Common::QuickTimeParser::SampleDesc *QuickTimeDecoder::readSampleDesc(Common::QuickTimeParser::Track *track, uint32 format, uint32 descSize) {
 	if (track->codecType == CODEC_TYPE_VIDEO) {
 		debug(0, "Video Codec FourCC: \'%s\'", tag2str(format));
@@ -277,7 +279,7 @@ void QuickTimeDecoder::AudioTrackHandler::updateBuffer() {
 	if (_decoder->endOfVideoTracks()) // If we have no video left (or no video), there's nothing to base our buffer against
 		_audioTrack->queueRemainingAudio();
 	else // Otherwise, queue enough to get us to the next frame plus another half second spare
-		_audioTrack->queueAudio(Audio::Timestamp(_decoder->getTimeToNextFrame() + 500, 1000));
+		_audioTrack->queueAudio(Audio::Timestamp(_decoder->getTimeToNextDecodedFrame() + 500, 1000));
 }
 
 Audio::SeekableAudioStream *QuickTimeDecoder::AudioTrackHandler::getSeekableAudioStream() const {
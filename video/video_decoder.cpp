@@ -25,14 +25,232 @@
 #include "audio/audiostream.h"
 #include "audio/mixer.h" // for kMaxChannelVolume
 
+#include "common/atomic.h"
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/mutex.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #include "graphics/palette.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
+/**
+ * The part of the track state the calling thread needs to know while
+ * the tracks themselves are busy decoding ahead.
+ */
+struct VideoDecoder::FrameState {
+	int curFrame;
+	bool hasNextTrack;
+	uint32 nextFrameStartTime;
+};
+
+/**
+ * A ring of frames which a thread decodes ahead of their presentation.
+ *
+ * Once the thread is started, only it accesses the video tracks and calls
+ * readNextPacket(). The calling thread takes frames out of the ring and
+ * answers its queries from the state recorded along with each frame. The
+ * frame handed out last stays in the ring until the next one is taken, so
+ * the surface remains valid just like with synchronous decoding.
+ */
+class VideoDecoder::DecodeAheadQueue {
+public:
+	DecodeAheadQueue(VideoDecoder *decoder, uint frames);
+	~DecodeAheadQueue();
+
+	/**
+	 * Start the decoding thread.
+	 * @return true on success, false if the backend has no thread support
+	 */
+	bool start();
+
+	/**
+	 * Take the next frame out of the ring, waiting for the decoding
+	 * thread if it has not caught up yet.
+	 *
+	 * @param palette set to the new palette, or 0 if it did not change
+	 * @return the frame, or 0 when the video tracks have ended
+	 */
+	const Graphics::Surface *nextFrame(const byte *&palette);
+
+	/**
+	 * Get the state of the tracks right after the frame handed out last
+	 * was decoded.
+	 */
+	const FrameState &getState() const { return _state; }
+
+private:
+	struct Frame {
+		Graphics::Surface surface;
+		bool hasSurface;
+		bool dirtyPalette;
+		byte palette[256 * 3];
+		FrameState state;
+	};
+
+	static int decodeThread(void *param);
+	bool decodeFrame();
+
+	VideoDecoder *_decoder;
+	Frame *_frames;
+	uint _size;
+
+	// Guarded by _mutex
+	Common::Mutex _mutex;
+	uint _read;
+	uint _count;
+
+	// Only accessed by the calling thread
+	bool _presenting;
+	FrameState _state;
+
+	// Posted whenever a frame was decoded or decoding finished
+	Common::Semaphore _decoded;
+	// Posted whenever a slot was freed or the thread has to stop
+	Common::Semaphore _freed;
+
+	OSystem::ThreadRef _thread;
+	volatile int32 _stop;
+	volatile int32 _finished;
+};
+
+VideoDecoder::DecodeAheadQueue::DecodeAheadQueue(VideoDecoder *decoder, uint frames) {
+	_decoder = decoder;
+	// One more slot for the frame which is currently presented
+	_size = frames + 1;
+	_frames = new Frame[_size];
+	for (uint i = 0; i < _size; ++i)
+		_frames[i].hasSurface = false;
+
+	_read = 0;
+	_count = 0;
+	_presenting = false;
+	_decoder->getFrameState(_state);
+
+	_thread = 0;
+	_stop = 0;
+	_finished = 0;
+}
+
+VideoDecoder::DecodeAheadQueue::~DecodeAheadQueue() {
+	if (_thread) {
+		Common::atomicStore(&_stop, 1);
+		_freed.post();
+		g_system->waitThread(_thread);
+	}
+
+	for (uint i = 0; i < _size; ++i)
+		_frames[i].surface.free();
+	delete[] _frames;
+}
+
+bool VideoDecoder::DecodeAheadQueue::start() {
+	_thread = g_system->createThread(decodeThread, this);
+	return _thread != 0;
+}
+
+int VideoDecoder::DecodeAheadQueue::decodeThread(void *param) {
+	DecodeAheadQueue *queue = (DecodeAheadQueue *)param;
+
+	while (!Common::atomicLoad(&queue->_stop)) {
+		// Sleep while the ring is full or there is nothing left to decode
+		if (!queue->decodeFrame())
+			queue->_freed.wait();
+	}
+
+	Common::Profiler::releaseThread();
+	return 0;
+}
+
+bool VideoDecoder::DecodeAheadQueue::decodeFrame() {
+	if (Common::atomicLoad(&_finished))
+		return false;
+
+	uint slot;
+	{
+		Common::StackLock lock(_mutex);
+		if (_count == _size)
+			return false;
+
+		slot = (_read + _count) % _size;
+	}
+
+	if (!_decoder->_nextVideoTrack) {
+		Common::atomicStore(&_finished, 1);
+		_decoded.post();
+		return false;
+	}
+
+	// The slot is not visible to the calling thread until _count grows
+	Frame &frame = _frames[slot];
+	const byte *palette;
+	const Graphics::Surface *surface = _decoder->decodeFrameIntern(palette);
+
+	frame.hasSurface = surface != 0;
+	if (surface) {
+		if (frame.surface.w != surface->w || frame.surface.h != surface->h || frame.surface.format != surface->format) {
+			frame.surface.free();
+			frame.surface.create(surface->w, surface->h, surface->format);
+		}
+
+		for (int y = 0; y < surface->h; ++y)
+			memcpy(frame.surface.getBasePtr(0, y), surface->getBasePtr(0, y), surface->w * surface->format.bytesPerPixel);
+	}
+
+	frame.dirtyPalette = palette != 0;
+	if (palette)
+		memcpy(frame.palette, palette, sizeof(frame.palette));
+
+	_decoder->getFrameState(frame.state);
+
+	{
+		Common::StackLock lock(_mutex);
+		++_count;
+	}
+
+	_decoded.post();
+	return true;
+}
+
+const Graphics::Surface *VideoDecoder::DecodeAheadQueue::nextFrame(const byte *&palette) {
+	palette = 0;
+
+	for (;;) {
+		{
+			Common::StackLock lock(_mutex);
+			const uint presented = _presenting ? 1 : 0;
+
+			if (_count > presented) {
+				// Release the frame handed out last
+				if (_presenting) {
+					_read = (_read + 1) % _size;
+					--_count;
+					_freed.post();
+				}
+
+				_presenting = true;
+				break;
+			}
+		}
+
+		if (Common::atomicLoad(&_finished))
+			return 0;
+
+		// The decoding thread has fallen behind
+		_decoded.wait();
+	}
+
+	Frame &frame = _frames[_read];
+	_state = frame.state;
+	if (frame.dirtyPalette)
+		palette = frame.palette;
+
+	return frame.hasSurface ? &frame.surface : 0;
+}
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -49,6 +267,8 @@ VideoDecoder::VideoDecoder() {
 	_nextVideoTrack = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
+	_decodeAheadFrames = 0;
+	_decodeAheadQueue = 0;
 
 	// Find the best format for output
 	_defaultHighColorFormat = g_system->getScreenFormat();
@@ -57,10 +277,17 @@ VideoDecoder::VideoDecoder() {
 		_defaultHighColorFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 }
 
+VideoDecoder::~VideoDecoder() {
+	// The decoding thread must not outlive the decoder
+	stopDecodeAhead();
+}
+
 void VideoDecoder::close() {
 	if (isPlaying())
 		stop();
 
+	stopDecodeAhead();
+
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		delete *it;
 
@@ -185,31 +412,99 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_needsUpdate = false;
 	_canSetDither = false;
 
+	// Hand the tracks over to the decoding thread on the first frame
+	// after loading, seeking or rewinding
+	if (_decodeAheadFrames && !_decodeAheadQueue && _nextVideoTrack) {
+		_decodeAheadQueue = new DecodeAheadQueue(this, _decodeAheadFrames);
+
+		if (!_decodeAheadQueue->start()) {
+			delete _decodeAheadQueue;
+			_decodeAheadQueue = 0;
+			_decodeAheadFrames = 0;
+		}
+	}
+
+	const byte *palette;
+	const Graphics::Surface *frame;
+
+	if (_decodeAheadQueue)
+		frame = _decodeAheadQueue->nextFrame(palette);
+	else
+		frame = decodeFrameIntern(palette);
+
+	if (palette) {
+		if (_decodeAheadQueue) {
+			memcpy(_decodeAheadPalette, palette, sizeof(_decodeAheadPalette));
+			palette = _decodeAheadPalette;
+		}
+
+		_palette = palette;
+		_dirtyPalette = true;
+	}
+
+	return frame;
+}
+
+const Graphics::Surface *VideoDecoder::decodeFrameIntern(const byte *&palette) {
 	readNextPacket();
 
+	const Graphics::Surface *frame = 0;
+	palette = 0;
+
 	// If we have no next video track at this point, there shouldn't be
 	// any frame available for us to display.
-	if (!_nextVideoTrack)
-		return 0;
+	if (_nextVideoTrack) {
+		frame = _nextVideoTrack->decodeNextFrame();
 
-	const Graphics::Surface *frame = _nextVideoTrack->decodeNextFrame();
+		if (_nextVideoTrack->hasDirtyPalette())
+			palette = _nextVideoTrack->getPalette();
 
-	if (_nextVideoTrack->hasDirtyPalette()) {
-		_palette = _nextVideoTrack->getPalette();
-		_dirtyPalette = true;
+		// Look for the next video track here for the next decode.
+		findNextVideoTrack();
 	}
 
-	// Look for the next video track here for the next decode.
-	findNextVideoTrack();
-
+	onFrameDecoded();
 	return frame;
 }
 
+bool VideoDecoder::setDecodeAhead(uint frames) {
+	// If a frame was already decoded, we can't set it now.
+	if (!_canSetDither)
+		return false;
+
+	// Decoding ahead only goes forward
+	if (frames && _nextVideoTrack && _nextVideoTrack->isReversed())
+		return false;
+
+	_decodeAheadFrames = frames;
+	return true;
+}
+
+void VideoDecoder::stopDecodeAhead() {
+	delete _decodeAheadQueue;
+	_decodeAheadQueue = 0;
+}
+
+void VideoDecoder::getFrameState(FrameState &state) const {
+	state.curFrame = -1;
+
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
+			state.curFrame += ((VideoTrack *)*it)->getCurFrame() + 1;
+
+	state.hasNextTrack = _nextVideoTrack != 0;
+	state.nextFrameStartTime = _nextVideoTrack ? _nextVideoTrack->getNextFrameStartTime() : 0;
+}
+
 bool VideoDecoder::setReverse(bool reverse) {
 	// Can only reverse video-only videos
 	if (reverse && hasAudio())
 		return false;
 
+	// Decoding ahead only goes forward
+	if (reverse && _decodeAheadFrames)
+		return false;
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
@@ -230,13 +525,12 @@ const byte *VideoDecoder::getPalette() {
 }
 
 int VideoDecoder::getCurFrame() const {
-	int32 frame = -1;
-
-	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)*it)->getCurFrame() + 1;
+	if (_decodeAheadQueue)
+		return _decodeAheadQueue->getState().curFrame;
 
-	return frame;
+	FrameState state;
+	getFrameState(state);
+	return state.curFrame;
 }
 
 uint32 VideoDecoder::getFrameCount() const {
@@ -271,13 +565,29 @@ uint32 VideoDecoder::getTime() const {
 }
 
 uint32 VideoDecoder::getTimeToNextFrame() const {
-	if (endOfVideo() || _needsUpdate || !_nextVideoTrack)
+	if (endOfVideo() || _needsUpdate)
 		return 0;
 
+	uint32 nextFrameStartTime;
+	bool reversed = false;
+
+	if (_decodeAheadQueue) {
+		const FrameState &state = _decodeAheadQueue->getState();
+		if (!state.hasNextTrack)
+			return 0;
+
+		nextFrameStartTime = state.nextFrameStartTime;
+	} else {
+		if (!_nextVideoTrack)
+			return 0;
+
+		nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+		reversed = _nextVideoTrack->isReversed();
+	}
+
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
 
-	if (_nextVideoTrack->isReversed()) {
+	if (reversed) {
 		// For reversed videos, we need to handle the time difference the opposite way.
 		if (nextFrameStartTime >= currentTime)
 			return 0;
@@ -296,6 +606,14 @@ bool VideoDecoder::endOfVideo() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		const Track *track = *it;
 
+		// The video tracks are busy decoding ahead
+		if (_decodeAheadQueue && track->getTrackType() == Track::kTrackTypeVideo) {
+			if (hasFramesLeft())
+				return false;
+
+			continue;
+		}
+
 		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
 		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
@@ -320,6 +638,8 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	stopDecodeAhead();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -358,6 +678,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (isPlaying())
 		stopAudio();
 
+	stopDecodeAhead();
+
 	// Do the actual seeking
 	if (!seekIntern(time))
 		return false;
@@ -867,6 +1189,34 @@ bool VideoDecoder::endOfVideoTracks() const {
 	return true;
 }
 
+uint32 VideoDecoder::getTimeToNextDecodedFrame() const {
+	if (!_nextVideoTrack)
+		return 0;
+
+	// The clock of the calling thread may change while decoding ahead,
+	// but the mixer is safe to query and the time of the last seek only
+	// changes while the decoding thread is stopped.
+	uint32 currentTime = _lastTimeChange.msecs();
+
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeAudio) {
+			uint32 time = ((const AudioTrack *)*it)->getRunningTime();
+
+			if (time != 0) {
+				currentTime += time;
+				break;
+			}
+		}
+	}
+
+	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+
+	if (nextFrameStartTime <= currentTime)
+		return 0;
+
+	return nextFrameStartTime - currentTime;
+}
+
 VideoDecoder::VideoTrack *VideoDecoder::findNextVideoTrack() {
 	_nextVideoTrack = 0;
 	uint32 bestTime = 0xFFFFFFFF;
@@ -915,6 +1265,14 @@ bool VideoDecoder::hasFramesLeft() const {
 	// This is similar to endOfVideo(), except it doesn't take Audio into account (and returns true if not the end of the video)
 	// This is only used for needsUpdate() atm so that setEndTime() works properly
 	// And unlike endOfVideoTracks(), this takes into account _endTime
+	if (_decodeAheadQueue) {
+		// The next video track has the earliest start time of all video
+		// tracks which have not ended yet
+		const FrameState &state = _decodeAheadQueue->getState();
+		bool videoEndTimeReached = _endTimeSet && state.nextFrameStartTime >= (uint)_endTime.msecs();
+		return state.hasNextTrack && !(isPlaying() && videoEndTimeReached);
+	}
+
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() != Track::kTrackTypeVideo)
 			continue;
@@ -52,7 +52,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -396,6 +396,32 @@ public:
 	 */
 	bool setDitheringPalette(const byte *palette);
 
+	/**
+	 * Decode frames ahead of time on a background thread.
+	 *
+	 * When enabled, readNextPacket() and the video tracks run on a thread
+	 * of their own, which keeps up to the given number of frames decoded
+	 * and converted in advance. decodeNextFrame() then only has to hand
+	 * out the next ready frame. Seeking and rewinding discard the frames
+	 * decoded so far.
+	 *
+	 * This should be called before the first decodeNextFrame() call and
+	 * stays in effect when loading another video. Playing backwards is
+	 * not possible while it is enabled. On backends without thread
+	 * support, frames keep being decoded on the calling thread and
+	 * getDecodeAhead() returns 0 once that was detected.
+	 *
+	 * @param frames The number of frames to decode ahead, 0 to disable
+	 * @return true on success, false otherwise
+	 */
+	bool setDecodeAhead(uint frames);
+
+	/**
+	 * Get the number of frames decoded ahead, 0 if disabled.
+	 * @see setDecodeAhead()
+	 */
+	uint getDecodeAhead() const { return _decodeAheadFrames; }
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -826,6 +852,19 @@ protected:
 	 */
 	virtual void readNextPacket() {}
 
+	/**
+	 * Called after a video track decoded a frame and the next video track
+	 * was looked up.
+	 *
+	 * When decoding ahead, this runs on the decoding thread just like
+	 * readNextPacket(), so a subclass reading more data from its stream
+	 * here does not race with it. It must not use the queries about the
+	 * frames handed out though, such as getTimeToNextFrame(), as those
+	 * belong to the calling thread. Use getTimeToNextDecodedFrame() and
+	 * endOfVideoTracks() instead.
+	 */
+	virtual void onFrameDecoded() {}
+
 	/**
 	 * Define a track to be used by this class.
 	 *
@@ -865,6 +904,16 @@ protected:
 	 */
 	bool endOfVideoTracks() const;
 
+	/**
+	 * Get the time until the next frame of the video tracks is due, as far
+	 * as they were decoded, measured against the audio played so far.
+	 *
+	 * Unlike getTimeToNextFrame(), this does not look at the frames handed
+	 * out, so it may be called from onFrameDecoded() when decoding ahead.
+	 * This is useful to figure out how much audio needs to be buffered.
+	 */
+	uint32 getTimeToNextDecodedFrame() const;
+
 	/**
 	 * Get the default high color format
 	 */
@@ -949,7 +998,18 @@ private:
 	// Default PixelFormat settings
 	Graphics::PixelFormat _defaultHighColorFormat;
 
+	// Decode-ahead settings, see setDecodeAhead()
+	class DecodeAheadQueue;
+	struct FrameState;
+	uint _decodeAheadFrames;
+	DecodeAheadQueue *_decodeAheadQueue;
+	// Copy of the palette of a decoded ahead frame, as its ring slot gets reused
+	byte _decodeAheadPalette[256 * 3];
+
 	// Internal helper functions
+	const Graphics::Surface *decodeFrameIntern(const byte *&palette);
+	void getFrameState(FrameState &state) const;
+	void stopDecodeAhead();
 	void stopAudio();
 	void startAudio();
 	void startAudioLimit(const Audio::Timestamp &limit);